@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+
+#######################################################
+###
+### Convergence benchmark for quasi-random sampling of initial conditions
+### (program option --quasi-random-sequence)
+###
+### Estimates the DCO merger rate (the fraction of binaries that form a double
+### compact object that merges in a Hubble time) from independent replicate
+### populations of increasing size, for each sampling sequence, and reports the
+### scatter of the estimates between replicates.  Replicates differ by random
+### seed and by scramble seed.
+###
+### The scatter of a pseudo-random estimate falls as N^-1/2; a quasi-random
+### estimate of a smooth rate should fall faster.
+###
+### Usage:  python3 quasiRandomConvergence.py [--compas PATH] [--sizes N ...] [--replicates R]
+###
+### For User Instructions, see 'docs/sampling.md'
+###
+#######################################################
+
+import argparse
+import csv
+import math
+import os
+import shutil
+import subprocess
+import tempfile
+
+
+def dco_merger_rate(compas, sequence, n, replicate, extra, workdir):
+    """
+    Evolve a population of n binaries and return the fraction that form a DCO that merges in a Hubble time
+    """
+    container = 'qr_{}_{}_{}'.format(sequence, n, replicate)
+    command = [compas, '--number-of-systems', str(n),
+                       '--quasi-random-sequence', sequence,
+                       '--logfile-type', 'CSV',
+                       '--output-path', workdir,
+                       '--output-container', container,
+                       '--quiet']
+    # each replicate has its own random seed (so its own pseudo-random draws, both for the initial
+    # conditions with NONE and for the draws made during evolution, e.g. kicks) and its own scramble
+    # seed (so its own scramble of the sequence).  The random seed also indexes the quasi-random point
+    # used for a binary, so replicate r uses points [r * n, (r + 1) * n) - with n a power of 2 that is
+    # an aligned block of a Sobol sequence, which retains the low-discrepancy property
+    command += ['--random-seed', str(replicate * n),
+                '--quasi-random-scramble-seed', str(replicate)]
+    command += extra
+
+    subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, check=True)
+
+    mergers  = 0
+    filename = os.path.join(workdir, container, 'BSE_Double_Compact_Objects.csv')
+    if os.path.isfile(filename):
+        with open(filename) as f:
+            rows = list(csv.reader(f))
+        header = [column.strip() for column in rows[2]]                                     # rows 0 and 1 are data types and units
+        column = header.index('Merges_Hubble_Time')
+        mergers = sum(1 for row in rows[3:] if row[column].strip() in ('1', 'TRUE'))
+
+    shutil.rmtree(os.path.join(workdir, container), ignore_errors=True)
+
+    return mergers / n
+
+
+def main():
+    default_compas = os.path.join(os.environ.get('COMPAS_ROOT_DIR', '..'), 'src/COMPAS')
+
+    parser = argparse.ArgumentParser(description='Convergence benchmark for quasi-random sampling of initial conditions')
+    parser.add_argument('--compas',     default=default_compas, help='COMPAS executable (default: %(default)s)')
+    parser.add_argument('--sizes',      type=int, nargs='+', default=[256, 1024, 4096], help='population sizes (powers of 2 suit SOBOL) (default: %(default)s)')
+    parser.add_argument('--replicates', type=int, default=8, help='independent populations per size and sequence (default: %(default)s)')
+    parser.add_argument('--sequences',  nargs='+', default=['NONE', 'SOBOL', 'HALTON'], help='sequences to compare (default: %(default)s)')
+    parser.add_argument('extra', nargs=argparse.REMAINDER, help='further COMPAS options (after --)')
+    args = parser.parse_args()
+
+    extra = [option for option in args.extra if option != '--']
+
+    workdir = tempfile.mkdtemp(prefix='qrbench_')
+    try:
+        print('{:>8} {:>8} {:>14} {:>14}'.format('Sequence', 'N', 'Mean rate', 'Std dev'))
+        for sequence in args.sequences:
+            for n in args.sizes:
+                rates = [dco_merger_rate(args.compas, sequence, n, r, extra, workdir) for r in range(args.replicates)]
+                mean  = sum(rates) / len(rates)
+                sdev  = math.sqrt(sum((rate - mean)**2 for rate in rates) / (len(rates) - 1)) if len(rates) > 1 else 0.0
+                print('{:>8} {:>8} {:>14.6e} {:>14.6e}'.format(sequence, n, mean, sdev), flush=True)
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,272 @@
+#include <gsl/gsl_cdf.h>
+
+#include "AIS.h"
+#include "Options.h"
+#include "Rand.h"
+#include "Log.h"
+#include "utils.h"
+#include "BinaryStar.h"
+#include "BaseBinaryStar.h"
+
+
+/*
+ * Constructor
+ *
+ * The number of systems drawn in the exploratory phase and the width of the Gaussians
+ * are fixed here from the program options.
+ */
+AIS::AIS() {
+
+    m_Phase         = AIS_PHASE::EXPLORATION;
+
+    m_PriorFraction = OPTIONS->AISExploratoryFraction();
+    m_nExploratory  = std::max((size_t)1, (size_t)std::ceil(m_PriorFraction * (double)OPTIONS->nObjectsToEvolve()));
+    m_nDrawn        = 0;
+    m_nRejected     = 0;
+
+    // average distance between exploratory samples in the unit cube, scaled by kappa
+    m_Sigma         = OPTIONS->AISKappa() * PPOW((double)m_nExploratory, -1.0 / (double)AIS_DIMENSIONS);
+
+    m_Means         = {};
+    m_Normalisation = {};
+    m_Current       = DBL_VECTOR(AIS_DIMENSIONS, 0.0);
+
+    m_RejectedDraws = {};
+}
+
+
+/*
+ * Draw the initial conditions for the next system
+ *
+ * Draws a location in the unit cube from the distribution for the current phase (the prior
+ * during exploration, the defensive Gaussian mixture during refinement), and returns the
+ * options string to be applied for the system (as though it were a grid file record), and
+ * the importance weight of the system.
+ *
+ * The eccentricity and metallicity (which are not importance sampled) are drawn from the
+ * distributions specified by the user, unless the user specified their values, and are
+ * included in the options string so the binary is constructed from exactly the initial
+ * conditions checked here.  Initial conditions that cannot make a valid binary (see
+ * BaseBinaryStar::InitialConditionsOk_Static()) are rejected, and a new location (and new
+ * eccentricity and metallicity) drawn - the whole draw is rejected, rather than just the
+ * parameters that are not importance sampled, so the systems evolved are distributed as the
+ * proposal restricted to valid initial conditions.  Rejected draws are counted (nRejected()),
+ * and are available until the next call (RejectedDraws()) - the rate of an outcome per draw
+ * is estimated with the rejected draws counted as draws without the outcome.
+ *
+ * If no valid initial conditions are drawn in MAX_BSE_INITIAL_CONDITIONS_ITERATIONS attempts
+ * the last draw is returned (the binary will then be flagged as having invalid initial
+ * conditions by the BaseBinaryStar constructor).
+ *
+ * Uses the random number generator, so should be called after the generator has been
+ * seeded for the system.
+ *
+ *
+ * std::tuple<std::string, double> DrawSample()
+ *
+ * @return                                      Tuple: <options string, importance weight>
+ */
+std::tuple<std::string, double> AIS::DrawSample() {
+
+    m_RejectedDraws.clear();
+
+    bool eccentricitySpecified = OPTIONS->OptionSpecified("eccentricity") == 1;
+    bool metallicitySpecified  = OPTIONS->OptionSpecified("metallicity") == 1;
+
+    double      weight = 1.0;                                                                   // exploration - sampled from the prior
+    std::string optionsString;
+
+    bool ok    = false;
+    int  tries = 0;
+    do {
+        if (m_Phase == AIS_PHASE::EXPLORATION || RAND->Random() < m_PriorFraction) {            // sample from the prior?
+            for (size_t d = 0; d < AIS_DIMENSIONS; d++) m_Current[d] = RAND->Random();          // yes - uniform in the unit cube
+        }
+        else {                                                                                  // no - sample from one of the Gaussians
+            size_t k = (size_t)RAND->RandomInt((int)m_Means.size());                            // choose a Gaussian
+            for (size_t d = 0; d < AIS_DIMENSIONS; d++) {                                       // inverse transform sample the truncated Gaussian
+                double lower = gsl_cdf_ugaussian_P(-m_Means[k][d] / m_Sigma);                   // CDF at 0.0
+                double u     = m_Means[k][d] + m_Sigma * gsl_cdf_ugaussian_Pinv(lower + RAND->Random() * m_Normalisation[k][d]);
+                m_Current[d] = std::min(std::max(u, 0.0), 1.0);                                 // guard against round-off at the edges of the cube
+            }
+        }
+
+        if (m_Phase == AIS_PHASE::REFINEMENT) weight = 1.0 / MixtureDensity(m_Current);         // prior density in the unit cube is 1
+
+        double mass1;
+        double mass2;
+        double semiMajorAxis;
+        std::tie(mass1, mass2, semiMajorAxis) = InitialConditions(m_Current);
+
+        double eccentricity = eccentricitySpecified
+                                ? OPTIONS->Eccentricity()
+                                : utils::SampleEccentricity(OPTIONS->EccentricityDistribution(), 
+                                                            OPTIONS->EccentricityDistributionMax(), 
+                                                            OPTIONS->EccentricityDistributionMin());
+
+        double metallicity  = metallicitySpecified
+                                ? OPTIONS->Metallicity()
+                                : utils::SampleMetallicity(OPTIONS->MetallicityDistribution(), 
+                                                           OPTIONS->MetallicityDistributionMax(), 
+                                                           OPTIONS->MetallicityDistributionMin());
+
+        optionsString = utils::vFormat("--initial-mass-1 %.17g --initial-mass-2 %.17g --semi-major-axis %.17g", mass1, mass2, semiMajorAxis);
+        if (!eccentricitySpecified) optionsString += utils::vFormat(" --eccentricity %.17g", eccentricity);
+        if (!metallicitySpecified)  optionsString += utils::vFormat(" --metallicity %.17g", metallicity);
+
+        ok = BaseBinaryStar::InitialConditionsOk_Static(mass1, mass2, metallicity, semiMajorAxis, eccentricity);
+        if (!ok && tries + 1 < MAX_BSE_INITIAL_CONDITIONS_ITERATIONS) {                         // invalid initial conditions, and will draw again?
+            m_nRejected++;                                                                      // yes - count the rejection
+            m_RejectedDraws.push_back({mass1 + mass2, metallicity, false, weight});             // and record it, with its weight (for star-forming mass accounting)
+        }                                                                                       // (the last draw is returned - the BaseBinaryStar constructor records it)
+
+    } while (!ok && ++tries < MAX_BSE_INITIAL_CONDITIONS_ITERATIONS);
+
+    m_nDrawn++;
+
+    return std::make_tuple(optionsString, weight);
+}
+
+
+/*
+ * Determine whether the evolved binary is a hit - that is, whether it satisfies the
+ * outcome predicate specified by the ais-* program options
+ *
+ *
+ * bool IsHit(BinaryStar* p_Binary) const
+ *
+ * @param   [IN]    p_Binary                    The evolved binary
+ * @return                                      True if the binary is a hit, otherwise false
+ */
+bool AIS::IsHit(BinaryStar* p_Binary) const {
+
+    bool hit = false;
+
+    switch (OPTIONS->AISDCOType()) {                                                            // which DCOs?
+        case AIS_DCO_TYPE::ALL : hit = p_Binary->IsDCO();     break;
+        case AIS_DCO_TYPE::BBH : hit = p_Binary->IsBHandBH(); break;
+        case AIS_DCO_TYPE::BNS : hit = p_Binary->IsNSandNS(); break;
+        case AIS_DCO_TYPE::BHNS: hit = p_Binary->IsNSandBH(); break;
+        default                : hit = false;                                                   // unknown DCO type - shouldn't happen
+    }
+
+    if (hit && OPTIONS->AISHubble())      hit = p_Binary->MergesInHubbleTime();                 // must merge in a Hubble time
+    if (hit && OPTIONS->AISPessimistic()) hit = !p_Binary->OptimisticCommonEnvelope();          // must not have survived an optimistic CE
+    if (hit && OPTIONS->AISRLOF())        hit = !p_Binary->ImmediateRLOFPostCEE();              // must not have had immediate RLOF post CE
+
+    return hit;
+}
+
+
+/*
+ * Record the outcome of the most recently drawn system
+ *
+ * Hits found during exploration become the means of the refinement Gaussians.  Adapts
+ * and moves to the refinement phase once the exploratory phase is complete and at least
+ * one hit has been found.
+ *
+ *
+ * void RecordOutcome(const bool p_Hit)
+ *
+ * @param   [IN]    p_Hit                       Whether the most recently drawn system is a hit
+ */
+void AIS::RecordOutcome(const bool p_Hit) {
+
+    if (m_Phase != AIS_PHASE::EXPLORATION) return;                                              // only exploration hits are used to adapt
+
+    if (p_Hit) m_Means.push_back(m_Current);                                                    // record location of hit
+
+    if (m_nDrawn >= m_nExploratory && !m_Means.empty()) Adapt();                                // done exploring?
+}
+
+
+/*
+ * Adapt the sampling distribution to the exploratory hits, and move to the refinement phase
+ *
+ * Calculates the probability mass inside the unit cube of each Gaussian (per dimension) -
+ * the normalisation of the truncated Gaussians.
+ *
+ *
+ * void Adapt()
+ */
+void AIS::Adapt() {
+
+    m_Normalisation.clear();
+    for (auto& mean : m_Means) {
+        DBL_VECTOR norm(AIS_DIMENSIONS, 0.0);
+        for (size_t d = 0; d < AIS_DIMENSIONS; d++) {
+            norm[d] = gsl_cdf_ugaussian_P((1.0 - mean[d]) / m_Sigma) - gsl_cdf_ugaussian_P(-mean[d] / m_Sigma);
+        }
+        m_Normalisation.push_back(norm);
+    }
+
+    m_Phase = AIS_PHASE::REFINEMENT;
+
+    if (!OPTIONS->Quiet()) {
+        SAY("\nAIS: " << m_nDrawn << " systems explored, " << m_Means.size() << " hits - refining with " << m_Means.size() << " Gaussians of width " << m_Sigma << "\n");
+    }
+}
+
+
+/*
+ * Calculate the density of the refinement mixture at a location in the unit cube
+ *
+ *
+ * double MixtureDensity(const DBL_VECTOR p_U) const
+ *
+ * @param   [IN]    p_U                         Location in the unit cube
+ * @return                                      Density of the mixture at p_U
+ */
+double AIS::MixtureDensity(const DBL_VECTOR p_U) const {
+
+    double gaussians = 0.0;
+    for (size_t k = 0; k < m_Means.size(); k++) {
+        double density = 1.0;
+        for (size_t d = 0; d < AIS_DIMENSIONS; d++) {
+            double z = (p_U[d] - m_Means[k][d]) / m_Sigma;
+            density *= exp(-0.5 * z * z) / (sqrt(_2_PI) * m_Sigma * m_Normalisation[k][d]);
+        }
+        gaussians += density;
+    }
+
+    return m_PriorFraction + (1.0 - m_PriorFraction) * gaussians / (double)m_Means.size();
+}
+
+
+/*
+ * Calculate the initial conditions for a location in the unit cube
+ *
+ * The unit cube coordinates are transformed to the primary mass, mass ratio and semi-major
+ * axis by the inverse transform samplers for the distributions specified by the user.
+ *
+ *
+ * std::tuple<double, double, double> InitialConditions(const DBL_VECTOR p_U) const
+ *
+ * @param   [IN]    p_U                         Location in the unit cube
+ * @return                                      Tuple: <primary mass (Msol), secondary mass (Msol), semi-major axis (AU)>
+ */
+std::tuple<double, double, double> AIS::InitialConditions(const DBL_VECTOR p_U) const {
+
+    double mass1 = utils::SampleInitialMass(OPTIONS->InitialMassFunction(),
+                                            OPTIONS->InitialMassFunctionMax(),
+                                            OPTIONS->InitialMassFunctionMin(),
+                                            OPTIONS->InitialMassFunctionPower(),
+                                            p_U[0]);
+
+    double mass2 = mass1 * utils::SampleMassRatio(OPTIONS->MassRatioDistribution(),
+                                                  OPTIONS->MassRatioDistributionMax(),
+                                                  OPTIONS->MassRatioDistributionMin(),
+                                                  p_U[1]);
+
+    double semiMajorAxis = utils::SampleSemiMajorAxis(OPTIONS->SemiMajorAxisDistribution(),
+                                                      OPTIONS->SemiMajorAxisDistributionMax(),
+                                                      OPTIONS->SemiMajorAxisDistributionMin(),
+                                                      OPTIONS->SemiMajorAxisDistributionPower(),
+                                                      OPTIONS->OrbitalPeriodDistributionMax(),
+                                                      OPTIONS->OrbitalPeriodDistributionMin(),
+                                                      mass1,
+                                                      mass2,
+                                                      p_U[2]);
+
+    return std::make_tuple(mass1, mass2, semiMajorAxis);
+}
@@ -0,0 +1,105 @@
+#ifndef __AIS_h__
+#define __AIS_h__
+
+#include <tuple>
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+class BinaryStar;
+
+
+/*
+ * AIS - Adaptive Importance Sampling of binary initial conditions
+ *
+ * This is an in-process implementation of the STROOPWAFEL algorithm (Broekgaarden et al. 2019,
+ * https://arxiv.org/abs/1905.00910) that preProcessing/stroopwafelInterface.py drives by launching
+ * COMPAS once per batch with a generated grid file and re-reading the output files to find hits.
+ *
+ * The sampled dimensions are the primary mass, the mass ratio and the semi-major axis.  Samples
+ * are drawn in the unit cube [0, 1)^3 and transformed to physical values by the inverse transform
+ * samplers in utils (so the prior density in the unit cube is 1 everywhere), and are applied to the
+ * binary as though they had been read from a grid file record.
+ *
+ * The algorithm has two phases:
+ *
+ *    Exploration: the first ais-exploratory-fraction * number-of-systems systems are drawn from
+ *                 the prior (the distributions specified by the user).  Systems that satisfy the
+ *                 outcome predicate (see IsHit()) are recorded as hits.  Each system has weight 1.
+ *
+ *                 If no hits have been found when the exploratory phase would end, exploration
+ *                 continues until the first hit is found.
+ *
+ *    Refinement:  a Gaussian is placed at each hit found during exploration, with width
+ *                 ais-kappa * (average distance between exploratory samples) in each dimension,
+ *                 truncated to the unit cube.  Systems are drawn from the defensive mixture
+ *
+ *                     q(u) = f + (1 - f) * (1/K) * sum_k G_k(u)
+ *
+ *                 where f = ais-exploratory-fraction and K is the number of Gaussians.  The prior
+ *                 component keeps the weights bounded (<= 1/f) and the estimator unbiased over the
+ *                 whole parameter space.  Each system has weight 1/q(u).
+ *
+ * Draws that cannot make a valid binary (e.g. the secondary mass is below the minimum, or the
+ * stars are touching or overflowing their Roche lobes at birth) are rejected before a binary is
+ * constructed, and the whole draw repeated (see DrawSample()).
+ *
+ * The weight of each system is recorded in the BSE system parameters file (Mixture_Weight).  The
+ * rate of any outcome per system drawn from the prior is estimated by sum(weight * outcome) / N,
+ * where N is the total number of draws - the systems evolved and the draws rejected (a rejected
+ * draw has no outcome).  The numbers of draws evolved and rejected are written to the star-forming
+ * mass summary (N_Evolved and N_Rejected - see StarFormingMass.h).
+ */
+
+class AIS {
+
+public:
+
+    AIS();
+
+
+    // getters
+    size_t      nExploratory() const                                                { return m_nExploratory; }
+    size_t      nGaussians() const                                                  { return m_Means.size(); }
+    size_t      nRejected() const                                                   { return m_nRejected; }
+    AIS_PHASE   Phase() const                                                       { return m_Phase; }
+
+    const std::vector<InitialConditionsDrawT>& RejectedDraws() const                { return m_RejectedDraws; }
+
+
+    // member functions
+    std::tuple<std::string, double> DrawSample();
+    bool                            IsHit(BinaryStar* p_Binary) const;
+    void                            RecordOutcome(const bool p_Hit);
+
+
+private:
+
+    static const size_t AIS_DIMENSIONS = 3;                                                 // primary mass, mass ratio, semi-major axis
+
+    void        Adapt();
+
+    double      MixtureDensity(const DBL_VECTOR p_U) const;
+
+    std::tuple<double, double, double> InitialConditions(const DBL_VECTOR p_U) const;
+
+
+    AIS_PHASE               m_Phase;                                                        // Current phase of the algorithm
+
+    size_t                  m_nExploratory;                                                 // Number of systems to draw in the exploratory phase
+    size_t                  m_nDrawn;                                                       // Number of systems drawn so far (not counting rejected draws)
+    size_t                  m_nRejected;                                                    // Number of draws rejected so far (invalid initial conditions)
+
+    double                  m_PriorFraction;                                                // Weight of the prior in the refinement mixture
+    double                  m_Sigma;                                                        // Width of the Gaussians (unit cube)
+
+    std::vector<DBL_VECTOR> m_Means;                                                        // Locations of the exploratory hits - the means of the Gaussians (unit cube)
+    std::vector<DBL_VECTOR> m_Normalisation;                                                // Probability mass of each Gaussian inside the unit cube, per dimension
+
+    DBL_VECTOR              m_Current;                                                      // Location of the most recently drawn sample (unit cube)
+
+    std::vector<InitialConditionsDrawT> m_RejectedDraws;                                    // Draws rejected by the most recent call to DrawSample()
+};
+
+#endif // __AIS_h__
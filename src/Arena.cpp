@@ -0,0 +1,144 @@
+#include "Arena.h"
+
+
+thread_local Arena* Arena::m_Current = nullptr;
+
+
+// Default constructor - no chunks are taken from the heap until the first allocation
+Arena::Arena() : m_Chunks(nullptr), m_Next(nullptr), m_End(nullptr) {
+
+    for (auto &freeBlocks : m_FreeBlocks) freeBlocks = nullptr;
+
+    m_Stats = {};
+}
+
+
+/*
+ * Allocate memory
+ *
+ * Allocates p_Size bytes from the current arena, or from the heap if there is no current arena
+ * or p_Size is larger than ARENA_MAX_BLOCK_SIZE.  The memory is aligned for any type.
+ *
+ * Throws std::bad_alloc if the memory cannot be allocated (as operator new does).
+ *
+ *
+ * void* Allocate(const std::size_t p_Size)
+ *
+ * @param   [IN]    p_Size                      Number of bytes to allocate
+ * @return                                      Pointer to the allocated memory
+ */
+void* Arena::Allocate(const std::size_t p_Size) {
+
+    Arena *arena = m_Current;
+
+    if (arena && p_Size > 0 && p_Size <= ARENA_MAX_BLOCK_SIZE) {                            // allocate from the arena?
+        return arena->AllocateBlock((p_Size - 1) / ARENA_ALIGNMENT);                        // yes - size class is the number of ARENA_ALIGNMENT units, less 1
+    }
+
+    if (arena) arena->m_Stats.heapAllocations++;
+
+    BlockHeaderT *header = static_cast<BlockHeaderT*>(::operator new(sizeof(BlockHeaderT) + p_Size));
+    header->block.arena     = nullptr;                                                      // from the heap
+    header->block.sizeClass = 0;
+
+    return header + 1;
+}
+
+
+/*
+ * Allocate a block from the arena
+ *
+ * Reuses a freed block of the size class if there is one, otherwise takes the block from the
+ * current chunk (taking a new chunk from the heap if the current chunk is exhausted - the
+ * remainder of the exhausted chunk is not used).
+ *
+ *
+ * void* AllocateBlock(const std::size_t p_SizeClass)
+ *
+ * @param   [IN]    p_SizeClass                 Size class of the block - the block holds (p_SizeClass + 1) * ARENA_ALIGNMENT bytes
+ * @return                                      Pointer to the memory after the block header
+ */
+void* Arena::AllocateBlock(const std::size_t p_SizeClass) {
+
+    m_Stats.allocations++;
+
+    BlockHeaderT *header;
+
+    if (m_FreeBlocks[p_SizeClass]) {                                                        // freed block available?
+        header = reinterpret_cast<BlockHeaderT*>(m_FreeBlocks[p_SizeClass]);                // yes - reuse it
+        m_FreeBlocks[p_SizeClass] = m_FreeBlocks[p_SizeClass]->next;
+        m_Stats.reused++;
+    }
+    else {                                                                                  // no - take it from the current chunk
+        std::size_t blockSize = sizeof(BlockHeaderT) + (p_SizeClass + 1) * ARENA_ALIGNMENT;
+
+        if (!m_Next || static_cast<std::size_t>(m_End - m_Next) < blockSize) {              // current chunk exhausted (or no chunk yet)?
+            ChunkT *chunk = static_cast<ChunkT*>(::operator new(ARENA_CHUNK_SIZE));         // yes - take a new chunk from the heap
+            chunk->next   = m_Chunks;
+            m_Chunks      = chunk;
+            m_Next        = reinterpret_cast<char*>(chunk) + ARENA_ALIGNMENT;               // the chunk link takes the first ARENA_ALIGNMENT bytes
+            m_End         = reinterpret_cast<char*>(chunk) + ARENA_CHUNK_SIZE;
+            m_Stats.chunks++;
+        }
+
+        header  = reinterpret_cast<BlockHeaderT*>(m_Next);
+        m_Next += blockSize;
+    }
+
+    header->block.arena     = this;
+    header->block.sizeClass = p_SizeClass;
+
+    return header + 1;
+}
+
+
+/*
+ * Free memory allocated by Allocate()
+ *
+ * Memory from an arena is kept by the arena for reuse; memory from the heap is returned to the heap.
+ *
+ *
+ * void Deallocate(void* p_Ptr)
+ *
+ * @param   [IN]    p_Ptr                       Pointer returned by Allocate() (nullptr is ignored)
+ */
+void Arena::Deallocate(void* p_Ptr) noexcept {
+
+    if (!p_Ptr) return;
+
+    BlockHeaderT *header    = static_cast<BlockHeaderT*>(p_Ptr) - 1;
+    Arena        *arena     = header->block.arena;
+    std::size_t   sizeClass = header->block.sizeClass;
+
+    if (arena) {                                                                            // from an arena?
+        FreeBlockT *block = reinterpret_cast<FreeBlockT*>(header);                          // yes - put it on the free list for its size class (overwrites the header)
+        block->next = arena->m_FreeBlocks[sizeClass];
+        arena->m_FreeBlocks[sizeClass] = block;
+    }
+    else {                                                                                  // no - from the heap
+        ::operator delete(header);
+    }
+}
+
+
+/*
+ * Release the memory of the arena
+ *
+ * Returns all chunks to the heap, in one operation.  Any memory allocated from the arena is
+ * invalid after this.
+ *
+ *
+ * void Release()
+ */
+void Arena::Release() {
+
+    while (m_Chunks) {
+        ChunkT *next = m_Chunks->next;
+        ::operator delete(m_Chunks);
+        m_Chunks = next;
+    }
+
+    m_Next = nullptr;
+    m_End  = nullptr;
+    for (auto &freeBlocks : m_FreeBlocks) freeBlocks = nullptr;
+}
@@ -0,0 +1,159 @@
+#ifndef __Arena_h__
+#define __Arena_h__
+
+#include <cstddef>
+#include <new>
+
+
+/*
+ * Arena - memory resource scoped to the evolution of one binary
+ *
+ * The objects and vectors that are created while a binary evolves (its BinaryConstituentStars,
+ * the copies of the donor made by the root solvers, the coefficient and parameter vectors
+ * (DBL_VECTOR) of the stars, etc.) draw their memory from the arena of the binary, rather than
+ * from the heap.  The arena takes memory from the heap in large chunks and hands it out in
+ * blocks; freed blocks are kept, by size, for reuse by later allocations of the same size, and
+ * the chunks are returned to the heap in one operation when the arena is destroyed (with the
+ * binary - see BaseBinaryStar::m_Arena).
+ *
+ * Allocations are made from the arena that is current for the thread - set by an ArenaScope
+ * object for its lifetime (see BaseBinaryStar).  If there is no current arena (e.g. for SSE),
+ * or the allocation is larger than ARENA_MAX_BLOCK_SIZE, memory is taken from the heap.  Each
+ * block records where it came from, so it is always freed to the right place, and containers
+ * using ArenaAllocator can hold a mix of arena and heap memory.  Memory from an arena must not
+ * outlive the arena - so only objects owned by the binary should be created in its scope.
+ *
+ * The current arena is per thread, so a multi-threaded driver gets one arena per worker (the
+ * arena of the binary the worker is evolving).  An arena is not itself thread-safe - it must
+ * only be used by one thread at a time.
+ *
+ * Building with COMPAS_NO_ARENA defined ('make ARENA=off') disables the arenas - all memory is
+ * taken from the heap (e.g. to compare the two).
+ */
+
+class Arena {
+
+public:
+
+    Arena();
+    ~Arena()                                                                        { Release(); }
+
+    Arena(const Arena&) = delete;                                                   // not copyable (owns its chunks)
+    Arena& operator = (const Arena&) = delete;
+
+
+    // allocation counts
+    typedef struct Statistics {
+        unsigned long int allocations;                                              // blocks allocated from the arena
+        unsigned long int reused;                                                   // of which reused a freed block
+        unsigned long int chunks;                                                   // chunks taken from the heap
+        unsigned long int heapAllocations;                                          // allocations taken from the heap while the arena was current (too large)
+    } StatisticsT;
+
+
+    // member functions
+    static  void*           Allocate(const std::size_t p_Size);
+    static  Arena*          Current()                                               { return m_Current; }
+    static  void            Deallocate(void* p_Ptr) noexcept;
+
+            void            Release();
+            StatisticsT     Stats() const                                           { return m_Stats; }
+
+
+private:
+
+    friend class ArenaScope;
+
+    static const std::size_t ARENA_ALIGNMENT      = alignof(std::max_align_t);      // alignment of blocks (and of the block header)
+    static const std::size_t ARENA_CHUNK_SIZE     = 64 * 1024;                      // size of the chunks taken from the heap (bytes)
+    static const std::size_t ARENA_MAX_BLOCK_SIZE = 4 * 1024;                       // largest block allocated from the arena (bytes) - larger allocations are taken from the heap
+    static const std::size_t ARENA_SIZE_CLASSES   = ARENA_MAX_BLOCK_SIZE / ARENA_ALIGNMENT;
+
+    // header at the start of every block - the arena the block came from (nullptr = heap), and its size class
+    typedef union BlockHeader {
+        struct {
+            Arena*      arena;
+            std::size_t sizeClass;
+        } block;
+        alignas(ARENA_ALIGNMENT) unsigned char pad[ARENA_ALIGNMENT];                // keeps the memory after the header aligned
+    } BlockHeaderT;
+
+    // freed block, on the free list for its size class
+    typedef struct FreeBlock {
+        struct FreeBlock *next;
+    } FreeBlockT;
+
+    // chunk taken from the heap - the chunks are a linked list, so they can be released
+    typedef struct Chunk {
+        struct Chunk *next;
+    } ChunkT;
+
+    static thread_local Arena *m_Current;                                           // current arena for this thread (nullptr = none)
+
+    ChunkT      *m_Chunks;                                                          // chunks taken from the heap
+    char        *m_Next;                                                            // next unallocated byte in the current chunk
+    char        *m_End;                                                             // end of the current chunk
+    FreeBlockT  *m_FreeBlocks[ARENA_SIZE_CLASSES];                                  // freed blocks, by size class
+
+    StatisticsT  m_Stats;
+
+    void*       AllocateBlock(const std::size_t p_SizeClass);
+};
+
+
+/*
+ * ArenaScope - makes an arena current for the thread for the lifetime of the ArenaScope object,
+ * then restores the previously current arena
+ *
+ * p_Arena may be nullptr (no arena - allocations are taken from the heap)
+ */
+
+class ArenaScope {
+
+public:
+
+#ifdef COMPAS_NO_ARENA
+    explicit ArenaScope(Arena* p_Arena) : m_Previous(nullptr)                       { }
+    ~ArenaScope()                                                                   { }
+#else
+    explicit ArenaScope(Arena* p_Arena) : m_Previous(Arena::m_Current)              { Arena::m_Current = p_Arena; }
+    ~ArenaScope()                                                                   { Arena::m_Current = m_Previous; }
+#endif
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator = (const ArenaScope&) = delete;
+
+private:
+
+    Arena *m_Previous;
+};
+
+
+/*
+ * ArenaAllocator - standard library allocator that allocates from the current arena (see Arena)
+ *
+ * The allocator is stateless (the block header records where each block came from), so all
+ * ArenaAllocators are equal and containers can be copied, swapped and assigned freely.
+ */
+
+template <class T>
+class ArenaAllocator {
+
+public:
+
+    typedef T value_type;
+
+    ArenaAllocator() noexcept { }
+    template <class U> ArenaAllocator(const ArenaAllocator<U>&) noexcept { }
+
+    T*      allocate(const std::size_t p_N)                                         { return static_cast<T*>(Arena::Allocate(p_N * sizeof(T))); }
+    void    deallocate(T* p_Ptr, const std::size_t p_N) noexcept                    { Arena::Deallocate(p_Ptr); }
+};
+
+template <class T, class U>
+bool operator == (const ArenaAllocator<T>&, const ArenaAllocator<U>&) noexcept      { return true; }
+
+template <class T, class U>
+bool operator != (const ArenaAllocator<T>&, const ArenaAllocator<U>&) noexcept      { return false; }
+
+#endif // __Arena_h__
@@ -38,6 +38,8 @@ public:
                                                                                                                                           
 protected:
 
+    friend class Star;                                                                      // so Star can call member functions directly (see STAR_DISPATCH in Star.h)
+
     void Initialise() {
         m_StellarType = STELLAR_TYPE::BLACK_HOLE;                                                                                                       // Set stellar type
         CalculateTimescales();                                                                                                                          // Initialise timescales
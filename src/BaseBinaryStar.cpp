@@ -18,16 +18,15 @@
 // binary is generated according to distributions specified in program options
 BaseBinaryStar::BaseBinaryStar(const unsigned long int p_Seed, const long int p_Id) {
 
+    ArenaScope arenaScope(&m_Arena);                                                                                                    // the binary's stars etc. are allocated from its arena
+
     SetInitialValues(p_Seed, p_Id);                                                                                                     // start construction of the binary
                         
     // generate initial properties of binary
     // check that the constituent stars are not touching
     // also check m2 > m2min
 
-    bool done                            = false;
-    bool merger                          = false;
-    bool rlof                            = false;
-    bool secondarySmallerThanMinimumMass = false;
+    bool done = false;
 
     // determine if any if the initial conditions are sampled
     // we consider eccentricity distribution = ECCENTRICITY_DISTRIBUTION::ZERO to be not sampled!
@@ -82,15 +81,35 @@ BaseBinaryStar::BaseBinaryStar(const unsigned long int p_Seed, const long int p_
     // initial conditions (so might leave the insufficient space for the  (say) one to be
     // sampled...)
 
+    // if the user specified a quasi-random sequence, the first attempt at sampling the initial conditions
+    // uses the point of the sequence indexed by the random seed of the binary (so populations evolved in
+    // several runs with different random seeds form a single sequence) - if those initial conditions are
+    // rejected, further attempts sample the initial conditions using the pseudo random number generator
+
+    DBL_VECTOR quasiRandom = OPTIONS->QuasiRandomSequence() == QUASI_RANDOM_SEQUENCE::NONE                                             // quasi-random sequence specified?
+                                ? DBL_VECTOR()                                                                                          // no
+                                : utils::QuasiRandomPoint(OPTIONS->QuasiRandomSequence(), p_Seed, OPTIONS->QuasiRandomScrambleSeed());  // yes - point for this binary
+
+    m_Star1 = nullptr;                                                                                                                  // no stars yet
+    m_Star2 = nullptr;
+
     int tries = 0;
     do {
 
+        bool useQuasiRandom = tries == 0 && !quasiRandom.empty();                                                                       // use quasi-random point for this attempt?
+
         double mass1 = OPTIONS->OptionSpecified("initial-mass-1") == 1                                                                  // user specified primary mass?
                         ? OPTIONS->InitialMass1()                                                                                       // yes, use it
-                        : utils::SampleInitialMass(OPTIONS->InitialMassFunction(), 
-                                                   OPTIONS->InitialMassFunctionMax(), 
-                                                   OPTIONS->InitialMassFunctionMin(), 
-                                                   OPTIONS->InitialMassFunctionPower());                                                // no - asmple it
+                        : useQuasiRandom                                                                                                // no - sample it
+                            ? utils::SampleInitialMass(OPTIONS->InitialMassFunction(), 
+                                                       OPTIONS->InitialMassFunctionMax(), 
+                                                       OPTIONS->InitialMassFunctionMin(), 
+                                                       OPTIONS->InitialMassFunctionPower(),
+                                                       quasiRandom[static_cast<int>(QUASI_RANDOM_DIMENSION::MASS_1)])
+                            : utils::SampleInitialMass(OPTIONS->InitialMassFunction(), 
+                                                       OPTIONS->InitialMassFunctionMax(), 
+                                                       OPTIONS->InitialMassFunctionMin(), 
+                                                       OPTIONS->InitialMassFunctionPower());
 
         double mass2 = 0.0;                      
         if (OPTIONS->OptionSpecified("initial-mass-2") == 1) {                                                                          // user specified secondary mass?
@@ -100,18 +119,28 @@ BaseBinaryStar::BaseBinaryStar(const unsigned long int p_Seed, const long int p_
             // first, determine mass ratio q    
             double q = OPTIONS->OptionSpecified("mass-ratio") == 1                                                                      // user specified mass ratio?
                         ? OPTIONS->MassRatio()                                                                                          // yes, use it
-                        : utils::SampleMassRatio(OPTIONS->MassRatioDistribution(),
-                                                 OPTIONS->MassRatioDistributionMax(), 
-                                                 OPTIONS->MassRatioDistributionMin());                                                  // no - sample it
+                        : useQuasiRandom                                                                                                // no - sample it
+                            ? utils::SampleMassRatio(OPTIONS->MassRatioDistribution(),
+                                                     OPTIONS->MassRatioDistributionMax(), 
+                                                     OPTIONS->MassRatioDistributionMin(),
+                                                     quasiRandom[static_cast<int>(QUASI_RANDOM_DIMENSION::MASS_RATIO)])
+                            : utils::SampleMassRatio(OPTIONS->MassRatioDistribution(),
+                                                     OPTIONS->MassRatioDistributionMax(), 
+                                                     OPTIONS->MassRatioDistributionMin());
 
             mass2 = mass1 * q;                                                                                                          // calculate mass2 using mass ratio                                                                     
         }
 
         double metallicity = OPTIONS->OptionSpecified("metallicity") == 1                                                               // user specified metallicity?
                                 ? OPTIONS->Metallicity()                                                                                // yes, use it
-                                : utils::SampleMetallicity(OPTIONS->MetallicityDistribution(), 
-                                                           OPTIONS->MetallicityDistributionMax(), 
-                                                           OPTIONS->MetallicityDistributionMin());                                      // no, sample it
+                                : useQuasiRandom                                                                                        // no - sample it
+                                    ? utils::SampleMetallicity(OPTIONS->MetallicityDistribution(), 
+                                                               OPTIONS->MetallicityDistributionMax(), 
+                                                               OPTIONS->MetallicityDistributionMin(),
+                                                               quasiRandom[static_cast<int>(QUASI_RANDOM_DIMENSION::METALLICITY)])
+                                    : utils::SampleMetallicity(OPTIONS->MetallicityDistribution(), 
+                                                               OPTIONS->MetallicityDistributionMax(), 
+                                                               OPTIONS->MetallicityDistributionMin());
 
         if (OPTIONS->OptionSpecified("semi-major-axis") == 1) {                                                                         // user specified semi-major axis?
             m_SemiMajorAxis = OPTIONS->SemiMajorAxis();                                                                                 // yes, use it
@@ -123,19 +152,35 @@ BaseBinaryStar::BaseBinaryStar(const unsigned long int p_Seed, const long int p_
             else {                                                                                                                      // no
                 if (OPTIONS->OptionSpecified("semi-major-axis-distribution") == 1 ||                                                    // user specified semi-major axis distribution, or
                     OPTIONS->OptionSpecified("orbital-period-distribution" ) == 0) {                                                    // user did not specify oprbital period distribution
-                    m_SemiMajorAxis = utils::SampleSemiMajorAxis(OPTIONS->SemiMajorAxisDistribution(),                              
-                                                                 OPTIONS->SemiMajorAxisDistributionMax(), 
-                                                                 OPTIONS->SemiMajorAxisDistributionMin(),
-                                                                 OPTIONS->SemiMajorAxisDistributionPower(), 
-                                                                 OPTIONS->OrbitalPeriodDistributionMax(), 
-                                                                 OPTIONS->OrbitalPeriodDistributionMin(), 
-                                                                 mass1, 
-                                                                 mass2);                                                                // yes, sample from semi-major axis distribution (might be default)
+                                                                                                                                        // yes, sample from semi-major axis distribution (might be default)
+                    m_SemiMajorAxis = useQuasiRandom
+                                        ? utils::SampleSemiMajorAxis(OPTIONS->SemiMajorAxisDistribution(),                              
+                                                                     OPTIONS->SemiMajorAxisDistributionMax(), 
+                                                                     OPTIONS->SemiMajorAxisDistributionMin(),
+                                                                     OPTIONS->SemiMajorAxisDistributionPower(), 
+                                                                     OPTIONS->OrbitalPeriodDistributionMax(), 
+                                                                     OPTIONS->OrbitalPeriodDistributionMin(), 
+                                                                     mass1, 
+                                                                     mass2,
+                                                                     quasiRandom[static_cast<int>(QUASI_RANDOM_DIMENSION::SEMI_MAJOR_AXIS)])
+                                        : utils::SampleSemiMajorAxis(OPTIONS->SemiMajorAxisDistribution(),                              
+                                                                     OPTIONS->SemiMajorAxisDistributionMax(), 
+                                                                     OPTIONS->SemiMajorAxisDistributionMin(),
+                                                                     OPTIONS->SemiMajorAxisDistributionPower(), 
+                                                                     OPTIONS->OrbitalPeriodDistributionMax(), 
+                                                                     OPTIONS->OrbitalPeriodDistributionMin(), 
+                                                                     mass1, 
+                                                                     mass2);
                 }
                 else {                                                                                                                  // no - sample from orbital period distribution
-                    double orbitalPeriod = utils::SampleOrbitalPeriod(OPTIONS->OrbitalPeriodDistribution(),                              
-                                                                      OPTIONS->OrbitalPeriodDistributionMax(), 
-                                                                      OPTIONS->OrbitalPeriodDistributionMin());
+                    double orbitalPeriod = useQuasiRandom
+                                            ? utils::SampleOrbitalPeriod(OPTIONS->OrbitalPeriodDistribution(),                              
+                                                                         OPTIONS->OrbitalPeriodDistributionMax(), 
+                                                                         OPTIONS->OrbitalPeriodDistributionMin(),
+                                                                         quasiRandom[static_cast<int>(QUASI_RANDOM_DIMENSION::SEMI_MAJOR_AXIS)])
+                                            : utils::SampleOrbitalPeriod(OPTIONS->OrbitalPeriodDistribution(),                              
+                                                                         OPTIONS->OrbitalPeriodDistributionMax(), 
+                                                                         OPTIONS->OrbitalPeriodDistributionMin());
 
                     m_SemiMajorAxis = utils::ConvertPeriodInDaysToSemiMajorAxisInAU(mass1, mass2, orbitalPeriod);                       // calculate semi-major axis from period
                 }
@@ -144,60 +189,33 @@ BaseBinaryStar::BaseBinaryStar(const unsigned long int p_Seed, const long int p_
 
         m_Eccentricity = OPTIONS->OptionSpecified("eccentricity") == 1                                                                  // user specified eccentricity?
                             ? OPTIONS->Eccentricity()                                                                                   // yes, use it
-                            : utils::SampleEccentricity(OPTIONS->EccentricityDistribution(), 
-                                                        OPTIONS->EccentricityDistributionMax(), 
-                                                        OPTIONS->EccentricityDistributionMin());                                        // no, sample it
+                            : useQuasiRandom                                                                                            // no - sample it
+                                ? utils::SampleEccentricity(OPTIONS->EccentricityDistribution(), 
+                                                            OPTIONS->EccentricityDistributionMax(), 
+                                                            OPTIONS->EccentricityDistributionMin(),
+                                                            quasiRandom[static_cast<int>(QUASI_RANDOM_DIMENSION::ECCENTRICITY)])
+                                : utils::SampleEccentricity(OPTIONS->EccentricityDistribution(), 
+                                                            OPTIONS->EccentricityDistributionMax(), 
+                                                            OPTIONS->EccentricityDistributionMin());
 
         // binary star contains two instances of star to hold masses, radii and luminosities.
         // star 1 initially more massive
-        m_Star1 = OPTIONS->OptionSpecified("rotational-frequency-1") == 1                                                               // user specified primary rotational frequency?
-                    ? new BinaryConstituentStar(m_RandomSeed, mass1, metallicity, kickParameters1, OPTIONS->RotationalFrequency1() * SECONDS_IN_YEAR) // yes - use it (convert from Hz to cycles per year - see BaseStar::CalculateZAMSAngularFrequency())
-                    : new BinaryConstituentStar(m_RandomSeed, mass1, metallicity, kickParameters1);                                     // no - let it be calculated
-
-        m_Star2 = OPTIONS->OptionSpecified("rotational-frequency-2") == 1                                                               // user specified secondary rotational frequency?
-                    ? new BinaryConstituentStar(m_RandomSeed, mass2, metallicity, kickParameters2, OPTIONS->RotationalFrequency2() * SECONDS_IN_YEAR) // yes - use it (convert from Hz to cycles per year - see BaseStar::CalculateZAMSAngularFrequency())
-                    : new BinaryConstituentStar(m_RandomSeed, mass2, metallicity, kickParameters2);                                     // no - let it be calculated
-
-        double rocheLobeTracker1 = (m_Star1->Radius() * RSOL_TO_AU) / (m_SemiMajorAxis * (1.0 - m_Eccentricity) * CalculateRocheLobeRadius_Static(mass1, mass2));
-        double rocheLobeTracker2 = (m_Star2->Radius() * RSOL_TO_AU) / (m_SemiMajorAxis * (1.0 - m_Eccentricity) * CalculateRocheLobeRadius_Static(mass2, mass1));
-
-        m_Flags.massesEquilibrated        = false;                                                                                      // default
-        m_Flags.massesEquilibratedAtBirth = false;                                                                                      // default
-
-        rlof = utils::Compare(rocheLobeTracker1, 1.0) > 0 || utils::Compare(rocheLobeTracker2, 1.0) > 0;					            // either star overflowing Roche Lobe?
-
-        if (rlof && OPTIONS->AllowRLOFAtBirth()) {                                                                                      // over-contact binaries at birth allowed?    
-            m_Flags.massesEquilibratedAtBirth = true;                                                                                   // record that we've equilbrated at birth
-
-            mass1            = (mass1 + mass2) / 2.0;                                                                                   // equilibrate masses
-            mass2            = mass1;                                                                                                   // ditto
-            
-            double M         = mass1 + mass2;
-            double m1m2      = mass1 * mass2;
-            m_SemiMajorAxis *= 16.0 * m1m2 * m1m2 / (M * M * M * M) * (1.0 - (m_Eccentricity * m_Eccentricity));                        // circularise; conserve angular momentum
-
-            m_Eccentricity   = 0.0;                                                                                                     // now circular
+        // the stars are (re)created by CheckInitialConditions_Static() via the lambda - with the
+        // initial masses, and again with the equilibrated masses if the masses are equilibrated
 
-            // create new stars with equal masses - all other ZAMS values recalculated
+        auto createStars = [&](const double p_Mass1, const double p_Mass2) {
             delete m_Star1;
             m_Star1 = OPTIONS->OptionSpecified("rotational-frequency-1") == 1                                                           // user specified primary rotational frequency?
-                        ? new BinaryConstituentStar(m_RandomSeed, mass1, metallicity, kickParameters1, OPTIONS->RotationalFrequency1() * SECONDS_IN_YEAR) // yes - use it (convert from Hz to cycles per year - see BaseStar::CalculateZAMSAngularFrequency())
-                        : new BinaryConstituentStar(m_RandomSeed, mass1, metallicity, kickParameters1);                                 // no - let it be calculated
+                        ? new BinaryConstituentStar(m_RandomSeed, p_Mass1, metallicity, kickParameters1, OPTIONS->RotationalFrequency1() * SECONDS_IN_YEAR) // yes - use it (convert from Hz to cycles per year - see BaseStar::CalculateZAMSAngularFrequency())
+                        : new BinaryConstituentStar(m_RandomSeed, p_Mass1, metallicity, kickParameters1);                               // no - let it be calculated
 
             delete m_Star2;
             m_Star2 = OPTIONS->OptionSpecified("rotational-frequency-2") == 1                                                           // user specified secondary rotational frequency?
-                        ? new BinaryConstituentStar(m_RandomSeed, mass2, metallicity, kickParameters2, OPTIONS->RotationalFrequency2() * SECONDS_IN_YEAR) // yes - use it (convert from Hz to cycles per year - see BaseStar::CalculateZAMSAngularFrequency())
-                        : new BinaryConstituentStar(m_RandomSeed, mass2, metallicity, kickParameters2);                                 // no - let it be calculated
-        
-            rocheLobeTracker1 = (m_Star1->Radius() * RSOL_TO_AU) / (m_SemiMajorAxis * CalculateRocheLobeRadius_Static(mass1, mass2));   //eccentricity already zero
-            rocheLobeTracker2 = (m_Star2->Radius() * RSOL_TO_AU) / (m_SemiMajorAxis * CalculateRocheLobeRadius_Static(mass2, mass1));
-        }
+                        ? new BinaryConstituentStar(m_RandomSeed, p_Mass2, metallicity, kickParameters2, OPTIONS->RotationalFrequency2() * SECONDS_IN_YEAR) // yes - use it (convert from Hz to cycles per year - see BaseStar::CalculateZAMSAngularFrequency())
+                        : new BinaryConstituentStar(m_RandomSeed, p_Mass2, metallicity, kickParameters2);                               // no - let it be calculated
 
-        m_Star1->SetCompanion(m_Star2);
-        m_Star2->SetCompanion(m_Star1);
-
-        merger                          = (m_SemiMajorAxis * AU_TO_RSOL) < (m_Star1->Radius() + m_Star2->Radius());
-        secondarySmallerThanMinimumMass = utils::Compare(mass2, OPTIONS->MinimumMassSecondary()) < 0;
+            return std::make_tuple(m_Star1->Radius(), m_Star2->Radius());
+        };
 
         // check whether our initial conditions are good
         // if they are - evolve the binary
@@ -205,7 +223,14 @@ BaseBinaryStar::BaseBinaryStar(const unsigned long int p_Seed, const long int p_
         //    - if we sampled at least one of them, sample again
         //    - if all were user supplied, set error - Evolve() will show the error and return without evolving
 
-        bool ok = !((!OPTIONS->AllowRLOFAtBirth() && rlof) || (!OPTIONS->AllowTouchingAtBirth() && merger) || secondarySmallerThanMinimumMass);
+        bool ok;
+        std::tie(ok, m_Flags.massesEquilibratedAtBirth) = CheckInitialConditions_Static(mass1, mass2, m_SemiMajorAxis, m_Eccentricity, createStars);
+        m_Flags.massesEquilibrated = false;                                                                                             // default
+
+        m_Star1->SetCompanion(m_Star2);
+        m_Star2->SetCompanion(m_Star1);
+
+        m_InitialConditionsDraws.push_back({mass1 + mass2, metallicity, ok, 1.0});                                                     // record draw for star-forming mass accounting (equilibration conserves total mass)
 
         done = ok;
         if (!sampled && !ok) {
@@ -221,6 +246,108 @@ BaseBinaryStar::BaseBinaryStar(const unsigned long int p_Seed, const long int p_
 }
 
 
+/*
+ * Check initial conditions for a binary
+ *
+ * The secondary mass must not be below the minimum, and, unless allowed by the program options, the
+ * stars must not be touching or overflowing their Roche lobes at birth.  If RLOF at birth is allowed
+ * and either star is overflowing its Roche lobe, the masses are equilibrated and the orbit circularised
+ * (conserving angular momentum) before the touching check - the masses, semi-major axis and eccentricity
+ * passed are updated.
+ *
+ * The ZAMS radii of the stars are provided by the caller: the constructor creates the stars (and
+ * creates them again with the equilibrated masses), InitialConditionsOk_Static() calculates the radii
+ * without constructing stars.
+ *
+ *
+ * std::tuple<bool, bool> CheckInitialConditions_Static(double                                                           &p_Mass1,
+ *                                                      double                                                           &p_Mass2,
+ *                                                      double                                                           &p_SemiMajorAxis,
+ *                                                      double                                                           &p_Eccentricity,
+ *                                                      const std::function<std::tuple<double, double>(const double, const double)> &p_ZAMSRadii)
+ *
+ * @param   [IN/OUT]    p_Mass1                 Initial mass of the primary (Msol)
+ * @param   [IN/OUT]    p_Mass2                 Initial mass of the secondary (Msol)
+ * @param   [IN/OUT]    p_SemiMajorAxis         Initial semi-major axis (AU)
+ * @param   [IN/OUT]    p_Eccentricity          Initial eccentricity
+ * @param   [IN]        p_ZAMSRadii             Function returning the ZAMS radii (Rsol) of the primary and secondary for the masses passed
+ * @return                                      Tuple containing:
+ *                                                  - true if a binary is evolved from the initial conditions, otherwise false
+ *                                                  - true if the masses were equilibrated at birth, otherwise false
+ */
+std::tuple<bool, bool> BaseBinaryStar::CheckInitialConditions_Static(double                                                                      &p_Mass1,
+                                                                     double                                                                      &p_Mass2,
+                                                                     double                                                                      &p_SemiMajorAxis,
+                                                                     double                                                                      &p_Eccentricity,
+                                                                     const std::function<std::tuple<double, double>(const double, const double)> &p_ZAMSRadii) {
+    double radius1, radius2;
+    std::tie(radius1, radius2) = p_ZAMSRadii(p_Mass1, p_Mass2);
+
+    double rocheLobeTracker1 = (radius1 * RSOL_TO_AU) / (p_SemiMajorAxis * (1.0 - p_Eccentricity) * CalculateRocheLobeRadius_Static(p_Mass1, p_Mass2));
+    double rocheLobeTracker2 = (radius2 * RSOL_TO_AU) / (p_SemiMajorAxis * (1.0 - p_Eccentricity) * CalculateRocheLobeRadius_Static(p_Mass2, p_Mass1));
+
+    bool rlof         = utils::Compare(rocheLobeTracker1, 1.0) > 0 || utils::Compare(rocheLobeTracker2, 1.0) > 0;                      // either star overflowing Roche Lobe?
+    bool equilibrated = rlof && OPTIONS->AllowRLOFAtBirth();                                                                            // over-contact binaries at birth allowed?
+
+    if (equilibrated) {                                                                                                                 // yes
+        p_Mass1          = (p_Mass1 + p_Mass2) / 2.0;                                                                                   // equilibrate masses
+        p_Mass2          = p_Mass1;                                                                                                     // ditto
+
+        double M         = p_Mass1 + p_Mass2;
+        double m1m2      = p_Mass1 * p_Mass2;
+        p_SemiMajorAxis *= 16.0 * m1m2 * m1m2 / (M * M * M * M) * (1.0 - (p_Eccentricity * p_Eccentricity));                          // circularise; conserve angular momentum
+
+        p_Eccentricity   = 0.0;                                                                                                         // now circular
+
+        std::tie(radius1, radius2) = p_ZAMSRadii(p_Mass1, p_Mass2);                                                                     // radii with equal masses
+    }
+
+    bool merger                          = (p_SemiMajorAxis * AU_TO_RSOL) < (radius1 + radius2);
+    bool secondarySmallerThanMinimumMass = utils::Compare(p_Mass2, OPTIONS->MinimumMassSecondary()) < 0;
+
+    bool ok = !((!OPTIONS->AllowRLOFAtBirth() && rlof) || (!OPTIONS->AllowTouchingAtBirth() && merger) || secondarySmallerThanMinimumMass);
+
+    return std::make_tuple(ok, equilibrated);
+}
+
+
+/*
+ * Determine whether initial conditions are acceptable for a binary, before the binary is constructed
+ *
+ * Makes the checks the constructor makes on the initial conditions it samples (see
+ * CheckInitialConditions_Static()), with the ZAMS radii calculated without constructing the stars.
+ *
+ * Used to reject initial conditions drawn by adaptive importance sampling (see AIS::DrawSample()) without
+ * constructing a binary.
+ *
+ *
+ * bool InitialConditionsOk_Static(const double p_Mass1, const double p_Mass2, const double p_Metallicity, const double p_SemiMajorAxis, const double p_Eccentricity)
+ *
+ * @param   [IN]    p_Mass1                     Initial mass of the primary (Msol)
+ * @param   [IN]    p_Mass2                     Initial mass of the secondary (Msol)
+ * @param   [IN]    p_Metallicity               Metallicity of the binary
+ * @param   [IN]    p_SemiMajorAxis             Initial semi-major axis (AU)
+ * @param   [IN]    p_Eccentricity              Initial eccentricity
+ * @return                                      True if a binary would be evolved from the initial conditions, otherwise false
+ */
+bool BaseBinaryStar::InitialConditionsOk_Static(const double p_Mass1,
+                                                const double p_Mass2,
+                                                const double p_Metallicity,
+                                                const double p_SemiMajorAxis,
+                                                const double p_Eccentricity) {
+    double mass1         = p_Mass1;
+    double mass2         = p_Mass2;
+    double semiMajorAxis = p_SemiMajorAxis;
+    double eccentricity  = p_Eccentricity;
+
+    auto zamsRadii = [p_Metallicity](const double p_M1, const double p_M2) {
+        return std::make_tuple(BaseStar::CalculateRadiusAtZAMS_Static(p_M1, p_Metallicity), BaseStar::CalculateRadiusAtZAMS_Static(p_M2, p_Metallicity));
+    };
+
+    return std::get<0>(CheckInitialConditions_Static(mass1, mass2, semiMajorAxis, eccentricity, zamsRadii));
+}
+
+
 /*
  * Initiate the construction of the binary - initial values
  *
@@ -239,6 +366,10 @@ void BaseBinaryStar::SetInitialValues(const unsigned long int p_Seed, const long
     m_RandomSeed  = p_Seed;
     m_Id          = p_Id;
 
+    m_ImportanceWeight = 1.0;                                                                           // not importance sampled unless told otherwise
+
+    m_InitialConditionsDraws.clear();                                                                   // no initial conditions drawn yet
+
     if (OPTIONS->PopulationDataPrinting()) {                                                            // user wants to see details of binary?
         SAY("Using supplied random seed " << m_RandomSeed << " for Binary Star id = " << m_ObjectId);   // yes - show them
     }
@@ -403,6 +534,9 @@ void BaseBinaryStar::SetRemainingValues() {
 	m_CircularizationTimescale                   = DEFAULT_INITIAL_DOUBLE_VALUE;
 
     m_PrintExtraDetailedOutput                   = false;
+    m_DetailedOutputSnapshot                     = {false, false, 0.0, STELLAR_TYPE::NONE, STELLAR_TYPE::NONE, false, false, 0, SN_STATE::NONE, MT_TRACKING::NO_MASS_TRANSFER, {}};
+    m_PulsarEvolutionSnapshot                    = m_DetailedOutputSnapshot;
+    m_BeBinarySnapshot                           = m_DetailedOutputSnapshot;
 
 	// RLOF details
     m_RLOFDetails.experiencedRLOF                = false;
@@ -566,9 +700,11 @@ COMPAS_VARIABLE BaseBinaryStar::BinaryPropertyValue(const T_ANY_PROPERTY p_Prope
         case BINARY_PROPERTY::BE_BINARY_CURRENT_RANDOM_SEED:                        value = BeBinaryDetails().currentProps->randomSeed;                         break;
         case BINARY_PROPERTY::BE_BINARY_CURRENT_SEMI_MAJOR_AXIS:                    value = BeBinaryDetails().currentProps->semiMajorAxis;                      break;
         case BINARY_PROPERTY::BE_BINARY_CURRENT_TOTAL_TIME:                         value = BeBinaryDetails().currentProps->totalTime;                          break;
+        case BINARY_PROPERTY::CHIRP_MASS:                                           value = ChirpMass();                                                        break;
         case BINARY_PROPERTY::CIRCULARIZATION_TIMESCALE:                            value = CircularizationTimescale();                                         break;
         case BINARY_PROPERTY::COMMON_ENVELOPE_AT_LEAST_ONCE:                        value = CEAtLeastOnce();                                                    break;
         case BINARY_PROPERTY::COMMON_ENVELOPE_EVENT_COUNT:                          value = CommonEnvelopeEventCount();                                         break;
+        case BINARY_PROPERTY::DELAY_TIME:                                           value = DelayTime();                                                        break;
         case BINARY_PROPERTY::DIMENSIONLESS_KICK_MAGNITUDE:                         value = UK();                                                               break;
         case BINARY_PROPERTY::UNBOUND:                                              value = Unbound();                                                          break;
         case BINARY_PROPERTY::DOUBLE_CORE_COMMON_ENVELOPE:                          value = DoubleCoreCE();                                                     break;
@@ -582,6 +718,7 @@ COMPAS_VARIABLE BaseBinaryStar::BinaryPropertyValue(const T_ANY_PROPERTY p_Prope
         case BINARY_PROPERTY::ERROR:                                                value = Error();                                                            break;
         case BINARY_PROPERTY::ID:                                                   value = ObjectId();                                                         break;
         case BINARY_PROPERTY::IMMEDIATE_RLOF_POST_COMMON_ENVELOPE:                  value = ImmediateRLOFPostCEE();                                             break;
+        case BINARY_PROPERTY::IMPORTANCE_WEIGHT:                                    value = ImportanceWeight();                                                 break;
         case BINARY_PROPERTY::MASS_1_FINAL:                                         value = Mass1Final();                                                       break;
         case BINARY_PROPERTY::MASS_1_POST_COMMON_ENVELOPE:                          value = Mass1PostCEE();                                                     break;
         case BINARY_PROPERTY::MASS_1_PRE_COMMON_ENVELOPE:                           value = Mass1PreCEE();                                                      break;
@@ -590,6 +727,7 @@ COMPAS_VARIABLE BaseBinaryStar::BinaryPropertyValue(const T_ANY_PROPERTY p_Prope
         case BINARY_PROPERTY::MASS_2_PRE_COMMON_ENVELOPE:                           value = Mass2PreCEE();                                                      break;
         case BINARY_PROPERTY::MASS_ENV_1:                                           value = MassEnv1();                                                         break;
         case BINARY_PROPERTY::MASS_ENV_2:                                           value = MassEnv2();                                                         break;
+        case BINARY_PROPERTY::MASS_RATIO:                                           value = MassRatio();                                                        break;
         case BINARY_PROPERTY::MASSES_EQUILIBRATED:                                  value = MassesEquilibrated();                                               break;
         case BINARY_PROPERTY::MASSES_EQUILIBRATED_AT_BIRTH:                         value = MassesEquilibratedAtBirth();                                        break;
         case BINARY_PROPERTY::MASS_TRANSFER_TRACKER_HISTORY:                        value = MassTransferTrackerHistory();                                       break;
@@ -817,6 +955,233 @@ bool BaseBinaryStar::PrintRLOFParameters(const string p_Rec) {
     return ok;
 }
 
+/*
+ * Write detailed output record to logfile if detailed output is enabled
+ *
+ * Records the state of the binary when the record is written (see PrintDetailedOutputDecimated()).
+ *
+ *
+ * bool PrintDetailedOutput(const long int p_Id, const string p_Rec)
+ * 
+ * @param   [IN]    p_Id                        Object id of the binary (used for the detailed output filename)
+ * @param   [IN]    p_Rec                       pre-formatted record to be written to file (default is empty string)
+ * @return                                      Boolean status (true = success, false = failure)
+ * 
+ */
+bool BaseBinaryStar::PrintDetailedOutput(const long int p_Id, const string p_Rec) {
+
+    if (!OPTIONS->DetailedOutput()) return true;                // do not print if printing option off
+
+    RecordLogfileSnapshot(m_DetailedOutputSnapshot, DetailedOutputMonitoredValues());   // record binary state
+
+    return LOGGING->LogBSEDetailedOutput(this, p_Id, p_Rec);    // write to log file
+}
+
+
+/*
+ * Write the per-timestep detailed output record to logfile, subject to decimation
+ *
+ * If neither of the program options --detailed-output-tolerance or --detailed-output-interval
+ * is specified, the record is always written (full resolution).  Otherwise the record is
+ * written only if, since the last record written:
+ *
+ *    - an event has occurred: a change of stellar type of either star, RLOF starting or stopping
+ *      for either star, a common envelope event, a supernova, or a change in the mass transfer
+ *      history, or
+ *    - any of the monitored properties (see DetailedOutputMonitoredValues()) has changed by more
+ *      than the relative tolerance --detailed-output-tolerance (if > 0), or
+ *    - more than --detailed-output-interval Myr has passed (if > 0)
+ *
+ * Records that are written are exact - values are not interpolated.  Records written by
+ * PrintDetailedOutput() directly (initial and final state, stellar type changes during a
+ * timestep) are not subject to decimation.
+ *
+ *
+ * bool PrintDetailedOutputDecimated(const long int p_Id)
+ * 
+ * @param   [IN]    p_Id                        Object id of the binary (used for the detailed output filename)
+ * @return                                      Boolean status (true = success, false = failure)
+ * 
+ */
+bool BaseBinaryStar::PrintDetailedOutputDecimated(const long int p_Id) {
+
+    if (!OPTIONS->DetailedOutput()) return true;                                                            // do not print if printing option off
+
+    double tolerance = OPTIONS->DetailedOutputTolerance();
+    double interval  = OPTIONS->DetailedOutputInterval();
+
+    bool print = !m_DetailedOutputSnapshot.valid || (utils::Compare(tolerance, 0.0) <= 0 && utils::Compare(interval, 0.0) <= 0);   // first record, or no decimation?
+
+    if (!print) print = LogfileEventSince(m_DetailedOutputSnapshot);                                        // check for event
+
+    if (!print && utils::Compare(interval, 0.0) > 0) {                                                      // check time since last record
+        print = (m_Time - m_DetailedOutputSnapshot.time) > interval;
+    }
+
+    if (!print && utils::Compare(tolerance, 0.0) > 0) {                                                     // check monitored properties
+        std::vector<double> values = DetailedOutputMonitoredValues();
+        for (size_t idx = 0; !print && idx < values.size(); idx++) {
+            double previous = m_DetailedOutputSnapshot.values[idx];
+            print = std::abs(values[idx] - previous) > tolerance * std::abs(previous);                     // any change if previous value is 0
+        }
+    }
+
+    return print ? PrintDetailedOutput(p_Id) : true;
+}
+
+
+/*
+ * Values of the properties monitored for detailed output decimation
+ *
+ * The monitored properties are the mass, radius and luminosity of each star, and the
+ * semi-major axis and eccentricity of the binary.
+ *
+ *
+ * std::vector<double> DetailedOutputMonitoredValues()
+ *
+ * @return                                      Vector of monitored property values
+ */
+std::vector<double> BaseBinaryStar::DetailedOutputMonitoredValues() const {
+    return { m_Star1->Mass(), m_Star2->Mass(),
+             m_Star1->Radius(), m_Star2->Radius(),
+             m_Star1->Luminosity(), m_Star2->Luminosity(),
+             m_SemiMajorAxis, m_Eccentricity };
+}
+
+
+/*
+ * Values of the properties monitored for pulsar evolution sampling
+ *
+ * The monitored properties are the spin period and magnetic field of each star (0 for
+ * stars that are not neutron stars).
+ *
+ *
+ * std::vector<double> PulsarEvolutionMonitoredValues()
+ *
+ * @return                                      Vector of monitored property values
+ */
+std::vector<double> BaseBinaryStar::PulsarEvolutionMonitoredValues() const {
+    return { m_Star1->Pulsar_SpinPeriod(), m_Star2->Pulsar_SpinPeriod(),
+             m_Star1->Pulsar_MagneticField(), m_Star2->Pulsar_MagneticField() };
+}
+
+
+/*
+ * Values of the properties monitored for Be binary sampling
+ *
+ * The monitored properties are the mass of each star, and the semi-major axis and
+ * eccentricity of the binary.
+ *
+ *
+ * std::vector<double> BeBinaryMonitoredValues()
+ *
+ * @return                                      Vector of monitored property values
+ */
+std::vector<double> BaseBinaryStar::BeBinaryMonitoredValues() const {
+    return { m_Star1->Mass(), m_Star2->Mass(), m_SemiMajorAxis, m_Eccentricity };
+}
+
+
+/*
+ * Determine whether an event has occurred since a sampled logfile record was written
+ *
+ * The events are: a change of stellar type of either star, RLOF starting or stopping for
+ * either star, a common envelope event, a supernova, or a change in the mass transfer history.
+ *
+ *
+ * bool LogfileEventSince(const LogfileSnapshotT& p_Snapshot)
+ *
+ * @param   [IN]    p_Snapshot                  Binary state when the last record was written
+ * @return                                      Boolean - true if an event has occurred since p_Snapshot was recorded
+ */
+bool BaseBinaryStar::LogfileEventSince(const LogfileSnapshotT& p_Snapshot) const {
+    return m_Star1->StellarType()       != p_Snapshot.stellarType1 ||
+           m_Star2->StellarType()       != p_Snapshot.stellarType2 ||
+           m_Star1->IsRLOF()            != p_Snapshot.isRLOF1      ||
+           m_Star2->IsRLOF()            != p_Snapshot.isRLOF2      ||
+           m_CEDetails.CEEcount         != p_Snapshot.CEEcount     ||
+           m_SupernovaState             != p_Snapshot.SNState      ||
+           m_MassTransferTrackerHistory != p_Snapshot.MTHistory;
+}
+
+
+/*
+ * Record the state of the binary when a sampled logfile record is written
+ *
+ *
+ * void RecordLogfileSnapshot(LogfileSnapshotT& p_Snapshot, const std::vector<double>& p_Values)
+ *
+ * @param   [IN/OUT]    p_Snapshot              Snapshot to be updated
+ * @param   [IN]        p_Values                Current values of the monitored properties of the logfile
+ */
+void BaseBinaryStar::RecordLogfileSnapshot(LogfileSnapshotT& p_Snapshot, const std::vector<double>& p_Values) {
+    p_Snapshot.valid        = true;
+    p_Snapshot.pending      = false;
+    p_Snapshot.time         = m_Time;
+    p_Snapshot.stellarType1 = m_Star1->StellarType();
+    p_Snapshot.stellarType2 = m_Star2->StellarType();
+    p_Snapshot.isRLOF1      = m_Star1->IsRLOF();
+    p_Snapshot.isRLOF2      = m_Star2->IsRLOF();
+    p_Snapshot.CEEcount     = m_CEDetails.CEEcount;
+    p_Snapshot.SNState      = m_SupernovaState;
+    p_Snapshot.MTHistory    = m_MassTransferTrackerHistory;
+    p_Snapshot.values       = p_Values;
+}
+
+
+/*
+ * Determine whether the per-timestep record of a sampled logfile should be written
+ *
+ * The record is always written if p_Sampling is ALL, if no record has yet been written, or if
+ * an event has occurred since the last record was written (see LogfileEventSince()).  Otherwise
+ * the record is written:
+ *
+ *    - CHANGE  : if any of the monitored properties has changed by more than the relative
+ *                tolerance --logfile-sampling-tolerance since the last record was written
+ *    - LOG_TIME: if log10(time) has increased by at least --logfile-sampling-log-time-step
+ *                since the last record was written
+ *    - EVENTS  : never (only events are recorded)
+ *
+ * If the record is not written the snapshot is marked pending, so the caller can write a record
+ * of the final state when evolution stops.
+ *
+ *
+ * bool SampleLogfileRecord(LogfileSnapshotT& p_Snapshot, const LOGFILE_SAMPLING p_Sampling, const std::vector<double>& p_Values)
+ *
+ * @param   [IN/OUT]    p_Snapshot              Binary state when the last record was written
+ * @param   [IN]        p_Sampling              Sampling policy of the logfile
+ * @param   [IN]        p_Values                Current values of the monitored properties of the logfile
+ * @return                                      Boolean - true if the record should be written
+ */
+bool BaseBinaryStar::SampleLogfileRecord(LogfileSnapshotT& p_Snapshot, const LOGFILE_SAMPLING p_Sampling, const std::vector<double>& p_Values) {
+
+    if (p_Sampling == LOGFILE_SAMPLING::ALL || !p_Snapshot.valid || LogfileEventSince(p_Snapshot)) return true;
+
+    bool sample = false;
+
+    switch (p_Sampling) {
+        case LOGFILE_SAMPLING::CHANGE: {                                                                    // check monitored properties
+            double tolerance = OPTIONS->LogfileSamplingTolerance();
+            for (size_t idx = 0; !sample && idx < p_Values.size(); idx++) {
+                double previous = p_Snapshot.values[idx];
+                sample = std::abs(p_Values[idx] - previous) > tolerance * std::abs(previous);              // any change if previous value is 0
+            }
+        } break;
+
+        case LOGFILE_SAMPLING::LOG_TIME:                                                                    // check time since last record
+            sample = utils::Compare(p_Snapshot.time, 0.0) <= 0 ||
+                     m_Time >= p_Snapshot.time * PPOW(10.0, OPTIONS->LogfileSamplingLogTimeStep());
+            break;
+
+        default: break;                                                                                     // EVENTS - events only
+    }
+
+    if (!sample) p_Snapshot.pending = true;                                                                 // record skipped
+
+    return sample;
+}
+
+
 /*
  * Write Be binary parameters to logfile if required
  *
@@ -832,11 +1197,91 @@ bool BaseBinaryStar::PrintBeBinary(const string p_Rec) {
     if (!OPTIONS->BeBinaries()) return true;                    // do not print if printing option off
     
     StashBeBinaryProperties();                                  // stash Be binary properties
+
+    if (OPTIONS->BeBinarySampling() != LOGFILE_SAMPLING::ALL) RecordLogfileSnapshot(m_BeBinarySnapshot, BeBinaryMonitoredValues());  // record binary state for sampling
     
     return LOGGING->LogBeBinary(this, p_Rec);                   // write to log file
 }
 
 
+/*
+ * Write the per-timestep Be binary record to logfile if required, subject to sampling
+ *
+ * The Be binary properties are stashed every timestep; the record is written as determined
+ * by program option --be-binary-sampling (see SampleLogfileRecord()).
+ *
+ *
+ * bool PrintBeBinarySampled()
+ * 
+ * @return                                      Boolean status (true = success, false = failure)
+ * 
+ */
+bool BaseBinaryStar::PrintBeBinarySampled() {
+
+    if (!OPTIONS->BeBinaries()) return true;                                                                // do not print if printing option off
+
+    LOGFILE_SAMPLING sampling = OPTIONS->BeBinarySampling();
+    if (sampling == LOGFILE_SAMPLING::ALL) return PrintBeBinary();                                          // every timestep
+
+    StashBeBinaryProperties();                                                                              // stash Be binary properties
+
+    std::vector<double> values = BeBinaryMonitoredValues();
+    if (!SampleLogfileRecord(m_BeBinarySnapshot, sampling, values)) return true;                            // record skipped
+
+    RecordLogfileSnapshot(m_BeBinarySnapshot, values);                                                      // record binary state
+
+    return LOGGING->LogBeBinary(this, "");                                                                  // write to log file
+}
+
+
+/*
+ * Write pulsar evolution parameters to logfile if required
+ *
+ *
+ * bool PrintPulsarEvolutionParameters(const string p_Rec)
+ * 
+ * @param   [IN]    p_Rec                       pre-formatted record to be written to file (default is empty string)
+ * @return                                      Boolean status (true = success, false = failure)
+ * 
+ */
+bool BaseBinaryStar::PrintPulsarEvolutionParameters(const string p_Rec) {
+
+    if (!OPTIONS->EvolvePulsars()) return true;                 // do not print if printing option off
+
+    if (OPTIONS->PulsarEvolutionSampling() != LOGFILE_SAMPLING::ALL) RecordLogfileSnapshot(m_PulsarEvolutionSnapshot, PulsarEvolutionMonitoredValues());   // record binary state for sampling
+
+    return LOGGING->LogBSEPulsarEvolutionParameters(this, p_Rec);   // write to log file
+}
+
+
+/*
+ * Write the per-timestep pulsar evolution record to logfile if required, subject to sampling
+ *
+ * The record is written as determined by program option --pulsar-evolution-sampling (see
+ * SampleLogfileRecord()).
+ *
+ *
+ * bool PrintPulsarEvolutionParametersSampled()
+ * 
+ * @return                                      Boolean status (true = success, false = failure)
+ * 
+ */
+bool BaseBinaryStar::PrintPulsarEvolutionParametersSampled() {
+
+    if (!OPTIONS->EvolvePulsars()) return true;                                                             // do not print if printing option off
+
+    LOGFILE_SAMPLING sampling = OPTIONS->PulsarEvolutionSampling();
+    if (sampling == LOGFILE_SAMPLING::ALL) return PrintPulsarEvolutionParameters();                         // every timestep
+
+    std::vector<double> values = PulsarEvolutionMonitoredValues();
+    if (!SampleLogfileRecord(m_PulsarEvolutionSnapshot, sampling, values)) return true;                     // record skipped
+
+    RecordLogfileSnapshot(m_PulsarEvolutionSnapshot, values);                                               // record binary state
+
+    return LOGGING->LogBSEPulsarEvolutionParameters(this, "");                                              // write to log file
+}
+
+
 
 /*
  * Squirrel RLOF properties away
@@ -2284,6 +2729,8 @@ void BaseBinaryStar::EvolveOneTimestep(const double p_Dt) {
  */
 EVOLUTION_STATUS BaseBinaryStar::Evolve() {
 
+    ArenaScope arenaScope(&m_Arena);                                                                                                        // allocations while evolving are from the binary's arena
+
     EVOLUTION_STATUS evolutionStatus = EVOLUTION_STATUS::CONTINUE;
 
     if (m_Error != ERROR::NONE) {                                                                                                           // check for error creating binary
@@ -2333,7 +2780,7 @@ EVOLUTION_STATUS BaseBinaryStar::Evolve() {
             }
             else {                                                                                                                          // continue evolution
 
-                (void)PrintDetailedOutput(m_Id);                                                                                            // print (log) detailed output for binary
+                (void)PrintDetailedOutputDecimated(m_Id);                                                                                   // print (log) detailed output for binary - subject to decimation
 
                 if (OPTIONS->RLOFPrinting()) StashRLOFProperties(MASS_TRANSFER_TIMING::PRE_MT);                                            // stash properties immediately pre-Mass Transfer 
 
@@ -2356,14 +2803,14 @@ EVOLUTION_STATUS BaseBinaryStar::Evolve() {
 
                 if (evolutionStatus == EVOLUTION_STATUS::CONTINUE) {                                                                        // continue evolution?
 
-                    if (HasOneOf({ STELLAR_TYPE::NEUTRON_STAR })) (void)PrintPulsarEvolutionParameters();                                   // print (log) pulsar evolution parameters 
+                    if (HasOneOf({ STELLAR_TYPE::NEUTRON_STAR })) (void)PrintPulsarEvolutionParametersSampled();                            // print (log) pulsar evolution parameters - subject to sampling
 
-                    (void)PrintBeBinary();                                                                                                  // print (log) BeBinary properties
+                    (void)PrintBeBinarySampled();                                                                                           // print (log) BeBinary properties - subject to sampling
                         
                     if (IsDCO() && !IsUnbound()) {                                                                                          // bound double compact object?
                         if (m_DCOFormationTime == DEFAULT_INITIAL_DOUBLE_VALUE) {                                                           // DCO not yet evaluated -- to ensure that the coalescence is only resolved once
+                            m_DCOFormationTime = m_Time;                                                                                    // set the DCO formation time (before the DCO record is printed)
                             ResolveCoalescence();                                                                                           // yes - resolve coalescence
-                            m_DCOFormationTime = m_Time;                                                                                    // set the DCO formation time
                         }
 
                         if (!(OPTIONS->EvolvePulsars() && HasOneOf({ STELLAR_TYPE::NEUTRON_STAR }))) {
@@ -2397,12 +2844,17 @@ EVOLUTION_STATUS BaseBinaryStar::Evolve() {
         if (!StellarMerger())
             (void)PrintDetailedOutput(m_Id);                                                                                                // print (log) detailed output for binary
 
+        // sampled logfiles always end with the final state (mergers included)
+        if (m_PulsarEvolutionSnapshot.pending && HasOneOf({ STELLAR_TYPE::NEUTRON_STAR })) (void)PrintPulsarEvolutionParameters();         // print (log) pulsar evolution parameters
+        if (m_BeBinarySnapshot.pending) (void)PrintBeBinary();                                                                              // print (log) BeBinary properties
+
         if (evolutionStatus == EVOLUTION_STATUS::STEPS_UP) {                                                                                // stopped because max timesteps reached?
             SHOW_ERROR(ERROR::BINARY_EVOLUTION_STOPPED);                                                                                    // show error
         }
     }
 
     (void)PrintBinarySystemParameters();                                                                                                    // print (log) binary system parameters
+    (void)LOGGING->ReleaseStagedRecords(this);                                                                                              // write (or discard) records staged for filtered logfiles
 
     return evolutionStatus;
 }
@@ -17,6 +17,7 @@
 #include <boost/math/special_functions/cbrt.hpp>    // For boost::math::cbrt.
 
 #include <tuple>                                    // for std::tuple and std::make_tuple.
+#include <functional>                               // for std::function
 
 
 class Log;
@@ -66,6 +67,10 @@ public:
         m_CosIPrime                        = p_Star.m_CosIPrime;
         m_IPrime                           = p_Star.m_IPrime;
 
+        m_ImportanceWeight                 = p_Star.m_ImportanceWeight;
+
+        m_InitialConditionsDraws           = p_Star.m_InitialConditionsDraws;
+
         m_JLoss                            = p_Star.m_JLoss;
 
         m_Mass1Final                       = p_Star.m_Mass1Final;
@@ -83,6 +88,10 @@ public:
 
         m_OrbitalVelocityPreSN             = p_Star.m_OrbitalVelocityPreSN;
 
+        m_DetailedOutputSnapshot           = p_Star.m_DetailedOutputSnapshot;
+        m_PulsarEvolutionSnapshot          = p_Star.m_PulsarEvolutionSnapshot;
+        m_BeBinarySnapshot                 = p_Star.m_BeBinarySnapshot;
+
         m_PrintExtraDetailedOutput         = p_Star.m_PrintExtraDetailedOutput;
 
         m_RLOFDetails                      = p_Star.m_RLOFDetails;
@@ -129,6 +138,11 @@ public:
         m_Star1     = p_Star.m_Star1 ? new BinaryConstituentStar(*(p_Star.m_Star1)) : nullptr;
         m_Star2     = p_Star.m_Star2 ? new BinaryConstituentStar(*(p_Star.m_Star2)) : nullptr;
 
+        if (m_Star1 && m_Star2) {                                                           // the copied stars are each other's companions (not the source's stars)
+            m_Star1->SetCompanion(m_Star2);
+            m_Star2->SetCompanion(m_Star1);
+        }
+
         m_Donor     = p_Star.m_Donor    ? (p_Star.m_Donor    == p_Star.m_Star1 ? m_Star1 : m_Star2) : nullptr;
         m_Accretor  = p_Star.m_Accretor ? (p_Star.m_Accretor == p_Star.m_Star1 ? m_Star1 : m_Star2) : nullptr;
 
@@ -140,6 +154,8 @@ public:
     // Copy constructor
     BaseBinaryStar(const BaseBinaryStar& p_Star) {
 
+        ArenaScope arenaScope(&m_Arena);                            // the copy allocates from its own arena
+
         m_ObjectId    = globalObjectId++;                           // get unique object id (don't copy source)
         m_ObjectType  = OBJECT_TYPE::BASE_BINARY_STAR;              // can only copy from BASE_BINARY_STAR
         m_StellarType = STELLAR_TYPE::BINARY_STAR;                  // always
@@ -153,6 +169,8 @@ public:
 
         if (this != &p_Star) {                                      // make sure we're not not copying ourselves...
 
+            ArenaScope arenaScope(&m_Arena);
+
             m_ObjectId    = globalObjectId++;                       // get unique object id (don't copy source)
             m_ObjectType  = OBJECT_TYPE::BASE_BINARY_STAR;          // can only copy from BASE_BINARY_STAR
             m_StellarType = STELLAR_TYPE::BINARY_STAR;              // always
@@ -163,7 +181,7 @@ public:
     }
 
 
-    virtual ~BaseBinaryStar() { delete m_Star1; delete m_Star2; }
+    virtual ~BaseBinaryStar() { delete m_Star1; delete m_Star2; }        // m_Arena, and all memory allocated from it, is released after this (it is destroyed last)
 
 
     // object identifiers - all classes have these
@@ -177,9 +195,11 @@ public:
     BeBinaryDetailsT    BeBinaryDetails() const                     { return m_BeBinaryDetails; }
 	bool                CEAtLeastOnce() const                       { return m_CEDetails.CEEcount > 0; }
     unsigned int        CEEventCount() const                        { return m_CEDetails.CEEcount; }
+    double              ChirpMass() const                           { double m1 = m_Star1->Mass(), m2 = m_Star2->Mass(); return PPOW(m1 * m2, 0.6) / PPOW(m1 + m2, 0.2); }
 	double              CircularizationTimescale() const            { return m_CircularizationTimescale; }
 	unsigned int        CommonEnvelopeEventCount() const            { return m_CEDetails.CEEcount; }
     bool                Unbound() const                             { return m_Unbound; }
+    double              DelayTime() const                           { return m_DCOFormationTime == DEFAULT_INITIAL_DOUBLE_VALUE ? DEFAULT_INITIAL_DOUBLE_VALUE : m_DCOFormationTime + m_TimeToCoalescence; }    // Myr: DCO formation time + time to coalescence
     bool                DoubleCoreCE() const                        { return m_CEDetails.doubleCoreCE; }
     double              Dt() const                                  { return m_Dt; }
     double              Eccentricity() const                        { return m_Eccentricity; }
@@ -194,6 +214,8 @@ public:
     bool                HasStarsTouching() const                    { return (utils::Compare(m_SemiMajorAxis, 0.0) > 0) && (m_SemiMajorAxis <= RSOL_TO_AU * (m_Star1->Radius() + m_Star2->Radius())); }
     bool                HasTwoOf(STELLAR_TYPE_LIST p_List) const;
     bool                ImmediateRLOFPostCEE() const                { return m_RLOFDetails.immediateRLOFPostCEE; }
+    double              ImportanceWeight() const                    { return m_ImportanceWeight; }
+    std::vector<InitialConditionsDrawT> InitialConditionsDraws() const { return m_InitialConditionsDraws; }
     STELLAR_TYPE        InitialStellarType1() const                 { return m_Star1->InitialStellarType(); }
     STELLAR_TYPE        InitialStellarType2() const                 { return m_Star2->InitialStellarType(); }
     bool                IsBeBinary() const                          { return HasOneOf({STELLAR_TYPE::NEUTRON_STAR}) && HasOneOf({STELLAR_TYPE::MS_LTE_07, STELLAR_TYPE::MS_GT_07}); }
@@ -211,6 +233,7 @@ public:
     double              Mass2PreCEE() const                         { return m_Star2->MassPreCEE(); }
     double              MassEnv1() const                            { return m_MassEnv1; }
     double              MassEnv2() const                            { return m_MassEnv2; }
+    double              MassRatio() const                           { return std::min(m_Star1->Mass(), m_Star2->Mass()) / std::max(m_Star1->Mass(), m_Star2->Mass()); }  // less massive / more massive
     bool                MassesEquilibrated() const                  { return m_Flags.massesEquilibrated; }
     bool                MassesEquilibratedAtBirth() const           { return m_Flags.massesEquilibratedAtBirth; }
     MT_TRACKING         MassTransferTrackerHistory() const          { return m_MassTransferTrackerHistory; }
@@ -271,17 +294,35 @@ public:
 
             EVOLUTION_STATUS    Evolve();
 
+    static  std::tuple<bool, bool> CheckInitialConditions_Static(double                                                                      &p_Mass1,
+                                                                 double                                                                      &p_Mass2,
+                                                                 double                                                                      &p_SemiMajorAxis,
+                                                                 double                                                                      &p_Eccentricity,
+                                                                 const std::function<std::tuple<double, double>(const double, const double)> &p_ZAMSRadii);
+
+    static  bool                InitialConditionsOk_Static(const double p_Mass1,
+                                                           const double p_Mass2,
+                                                           const double p_Metallicity,
+                                                           const double p_SemiMajorAxis,
+                                                           const double p_Eccentricity);
+
             bool                PrintSwitchLog(const long int p_Id, const bool p_PrimarySwitching) { return OPTIONS->SwitchLog() ? LOGGING->LogBSESwitchLog(this, p_Id, p_PrimarySwitching) : true; }
 
             COMPAS_VARIABLE     PropertyValue(const T_ANY_PROPERTY p_Property) const;
 
+            void                SetImportanceWeight(const double p_Weight)  { m_ImportanceWeight = p_Weight; for (auto& draw : m_InitialConditionsDraws) draw.weight = p_Weight; }  // draws made by the constructor carry the weight of the binary
+
             BinaryConstituentStar* Star1() { return m_Star1; }                              // Returns a pointer to the primary - here mainly to support the BSE Switch Log. Be careful!
             BinaryConstituentStar* Star2() { return m_Star2; }                              // Returns a pointer to the secondary - here mainly to support the BSE Switch Log. Be careful!
 
 private:
 
+    friend class Benchmarks;                                                                // microbenchmarks for private kernels (see benchmarks/Benchmarks.cpp)
+
     BaseBinaryStar() { }
 
+    Arena        m_Arena;                                                                   // Memory for the binary's stars etc. (see Arena.h) - declared first, so destroyed last
+
     OBJECT_ID    m_ObjectId;                                                                // Instantiated object's unique object id
     OBJECT_TYPE  m_ObjectType;                                                              // Instantiated object's object type
     STELLAR_TYPE m_StellarType;                                                             // Stellar type defined in Hurley et al. 2000
@@ -326,6 +367,10 @@ private:
     double              m_CosIPrime;
     double              m_IPrime;
 
+    double              m_ImportanceWeight;                                                 // Importance sampling weight of the initial conditions (1.0 unless sampled by AIS)
+
+    std::vector<InitialConditionsDrawT> m_InitialConditionsDraws;                           // Initial conditions drawn by the constructor (rejected draws, and the accepted draw) - for star-forming mass accounting
+
     double	            m_JLoss;			                                                // Specific angular momentum with which mass is lost during non-conservative mass transfer
 
     double              m_Mass1Final;                                                       // Star1 mass in Msol after losing its envelope (in this case, we asume it loses all of its envelope)
@@ -343,6 +388,10 @@ private:
 
     double              m_OrbitalVelocityPreSN;
 
+    LogfileSnapshotT    m_DetailedOutputSnapshot;                                           // Binary state when the last detailed output record was written (for decimation)
+    LogfileSnapshotT    m_PulsarEvolutionSnapshot;                                          // Binary state when the last pulsar evolution record was written (for sampling)
+    LogfileSnapshotT    m_BeBinarySnapshot;                                                 // Binary state when the last Be binary record was written (for sampling)
+
     bool                m_PrintExtraDetailedOutput;                                         // Flag to ensure that detailed output only gets printed once per timestep
 
     BinaryRLOFDetailsT  m_RLOFDetails;                                                      // RLOF details
@@ -500,6 +549,14 @@ private:
                             const double p_RocheLobe1to2,
                             const double p_RocheLobe2to1);
 
+    std::vector<double> BeBinaryMonitoredValues() const;
+    std::vector<double> DetailedOutputMonitoredValues() const;
+    std::vector<double> PulsarEvolutionMonitoredValues() const;
+
+    bool    LogfileEventSince(const LogfileSnapshotT& p_Snapshot) const;
+    void    RecordLogfileSnapshot(LogfileSnapshotT& p_Snapshot, const std::vector<double>& p_Values);
+    bool    SampleLogfileRecord(LogfileSnapshotT& p_Snapshot, const LOGFILE_SAMPLING p_Sampling, const std::vector<double>& p_Values);
+
     void    StashBeBinaryProperties();
     void    StashRLOFProperties(const MASS_TRANSFER_TIMING p_Which);
 
@@ -508,11 +565,14 @@ private:
     // printing functions
     bool PrintRLOFParameters(const string p_Rec = "");
     bool PrintBinarySystemParameters(const string p_Rec = "") const              { return LOGGING->LogBSESystemParameters(this, p_Rec); }
-    bool PrintDetailedOutput(const long int p_Id, const string p_Rec = "") const { return OPTIONS->DetailedOutput() ? LOGGING->LogBSEDetailedOutput(this, p_Id, p_Rec) : true; }
+    bool PrintDetailedOutput(const long int p_Id, const string p_Rec = "");
+    bool PrintDetailedOutputDecimated(const long int p_Id);
     bool PrintDoubleCompactObjects(const string p_Rec = "") const                { return LOGGING->LogDoubleCompactObject(this, p_Rec); }
     bool PrintCommonEnvelope(const string p_Rec = "") const                      { return LOGGING->LogCommonEnvelope(this, p_Rec); }
     bool PrintBeBinary(const string p_Rec = "");
-    bool PrintPulsarEvolutionParameters(const string p_Rec = "") const           { return OPTIONS->EvolvePulsars() ? LOGGING->LogBSEPulsarEvolutionParameters(this, p_Rec) : true; }
+    bool PrintBeBinarySampled();
+    bool PrintPulsarEvolutionParameters(const string p_Rec = "");
+    bool PrintPulsarEvolutionParametersSampled();
     bool PrintSupernovaDetails(const string p_Rec = "") const                    { return LOGGING->LogBSESupernovaDetails(this, p_Rec); }
 
     
@@ -7,12 +7,17 @@
 
 #include "Rand.h"
 #include "BaseStar.h"
+#include "RemnantTable.h"
 #include "vector3d.h"
 
 using std::max;
 using std::min;
 
 
+size_t LiveStarCounter::m_Live = 0;
+size_t LiveStarCounter::m_Peak = 0;
+
+
 BaseStar::BaseStar() {
 
     // initialise member variables
@@ -54,6 +59,8 @@ BaseStar::BaseStar(const unsigned long int p_RandomSeed,
     m_LogMetallicitySigma = log10(m_Metallicity);
     m_LogMetallicityRho   = m_LogMetallicityXi + 1.0;
 
+    m_LoveridgeMetallicity = CalculateLoveridgeMetallicity_Static(m_Metallicity);
+
 
     // Initialise coefficients, parameters and constants
 
@@ -1007,20 +1014,10 @@ double BaseStar::CalculateLambdaKruckow(const double p_Radius, const double p_Al
  */
 double BaseStar::CalculateLogBindingEnergyLoveridge(bool p_IsMassLoss) const {
 
-    // find closest metallicity covered by Loveridge et al. 2011
-    // (see LOVERIDGE_METALLICITY and LOVERIDGE_METALLICITYValue)
+    // closest metallicity covered by Loveridge et al. 2011 - calculated at construction
+    // (see LOVERIDGE_METALLICITY and LOVERIDGE_METALLICITY_VALUE)
 
-    int lMetallicity = 0;
-    double minDiff   = std::numeric_limits<double>::max();
-
-    // initialise m_MassCutoffs vector - so we have the right number of entries
-    for (int i = 0; i < static_cast<int>(LOVERIDGE_METALLICITY::COUNT); i++) {
-        double thisDiff = std::abs(m_Metallicity - std::get<1>(LOVERIDGE_METALLICITY_VALUE[i]));
-        if (utils::Compare(thisDiff, minDiff) < 0) {
-            lMetallicity = i;
-            minDiff      = thisDiff;
-        }
-    }
+    int lMetallicity = m_LoveridgeMetallicity;
 
     // Determine the evolutionary stage of the star (see LOVERIDGE_GROUP)
 
@@ -1035,12 +1032,13 @@ double BaseStar::CalculateLogBindingEnergyLoveridge(bool p_IsMassLoss) const {
         }
         else {                                                                              // no - low mass star on RGB
 
-            // calculate early / late cutoff for low mass RGB stars
+            // calculate early / late cutoff for low mass RGB stars (polynomial in log10(m), by Horner's method)
             constexpr double deltaM   = 1.0E-5;                                             // JR: todo: what is this for?  Should it be in constants.h?
+                      double logMass  = log10(m_Mass + deltaM);
                       double cutOff   = 0.0;
-                      int    exponent = 0;
-            for (auto const& aCoefficient: LOVERIDGE_LM1_LM2_CUTOFFS[lMetallicity]) {
-                cutOff += aCoefficient * utils::intPow(log10(m_Mass + deltaM), exponent++);
+            const DBL_VECTOR &aCoefficients = LOVERIDGE_LM1_LM2_CUTOFFS[lMetallicity];
+            for (auto iter = aCoefficients.rbegin(); iter != aCoefficients.rend(); ++iter) {
+                cutOff = cutOff * logMass + *iter;
             }
 
             // set evolutionary stage based on cutoff
@@ -1050,10 +1048,7 @@ double BaseStar::CalculateLogBindingEnergyLoveridge(bool p_IsMassLoss) const {
 
     // calculate log10(binding energy)
     constexpr double deltaR           = 1E-5;                                               // JR: todo: what is this for?  Should it be in constants.h?
-              double logBindingEnergy = 0.0;
-    for (auto const& lCoefficients: LOVERIDGE_COEFFICIENTS[lMetallicity][static_cast<int>(lGroup)]) {
-        logBindingEnergy += lCoefficients.alpha_mr * utils::intPow(log10(m_Mass), lCoefficients.m) * utils::intPow(log10(m_Radius + deltaR), lCoefficients.r);
-    }
+              double logBindingEnergy = CalculateLoveridgePolynomial_Static(lMetallicity, lGroup, log10(m_Mass), log10(m_Radius + deltaR));
 
     double MZAMS_Mass = (m_MZAMS - m_Mass) / m_MZAMS;
     logBindingEnergy *= p_IsMassLoss ? 1.0 + (0.25 * MZAMS_Mass * MZAMS_Mass) : 1.0;        // apply mass-loss correction factor (lambda)
@@ -1065,6 +1060,111 @@ double BaseStar::CalculateLogBindingEnergyLoveridge(bool p_IsMassLoss) const {
 }
 
 
+/*
+ * Evaluate the binding energy polynomial of Loveridge et al. 2011, eq 5
+ *
+ * Sum over m and r of alpha(m,r) * log10(M)^m * log10(R)^r, evaluated as a polynomial in log10(M) whose
+ * coefficients are polynomials in log10(R), both by Horner's method (see LoveridgePolynomials_Static()).
+ * No mass-loss correction is applied, and no offset is added (see CalculateLogBindingEnergyLoveridge()).
+ *
+ *
+ * double CalculateLoveridgePolynomial_Static(const int p_LMetallicity, const LOVERIDGE_GROUP p_LGroup, const double p_LogMass, const double p_LogRadius)
+ *
+ * @param   [IN]    p_LMetallicity              Index of the metallicity (LOVERIDGE_METALLICITY)
+ * @param   [IN]    p_LGroup                    Evolutionary stage (LOVERIDGE_GROUP)
+ * @param   [IN]    p_LogMass                   log10(Mass / Msol)
+ * @param   [IN]    p_LogRadius                 log10(Radius / Rsol)
+ * @return                                      Value of the polynomial
+ */
+double BaseStar::CalculateLoveridgePolynomial_Static(const int p_LMetallicity, const LOVERIDGE_GROUP p_LGroup, const double p_LogMass, const double p_LogRadius) {
+
+    const LoveridgePolynomial &polynomial = LoveridgePolynomials_Static()[p_LMetallicity][static_cast<int>(p_LGroup)];
+    const int                  nR         = polynomial.rHigh - polynomial.rLow + 1;
+
+    double value = 0.0;
+    for (int m = polynomial.mHigh - polynomial.mLow; m >= 0; m--) {
+        const double *alpha = &polynomial.alpha[m * nR];
+        double rSum = 0.0;
+        for (int r = nR - 1; r >= 0; r--) rSum = rSum * p_LogRadius + alpha[r];
+        value = value * p_LogMass + rSum;
+    }
+
+    return value * utils::intPow(p_LogMass, polynomial.mLow) * utils::intPow(p_LogRadius, polynomial.rLow);    // lowest powers (factored out)
+}
+
+
+/*
+ * Find the metallicity covered by Loveridge et al. 2011 closest to a given metallicity
+ *
+ *
+ * int CalculateLoveridgeMetallicity_Static(const double p_Metallicity)
+ *
+ * @param   [IN]    p_Metallicity               Metallicity
+ * @return                                      Index of the closest metallicity (LOVERIDGE_METALLICITY) - index into
+ *                                              LOVERIDGE_METALLICITY_VALUE, LOVERIDGE_COEFFICIENTS etc.
+ */
+int BaseStar::CalculateLoveridgeMetallicity_Static(const double p_Metallicity) {
+
+    int lMetallicity = 0;
+    double minDiff   = std::numeric_limits<double>::max();
+
+    for (int i = 0; i < static_cast<int>(LOVERIDGE_METALLICITY::COUNT); i++) {
+        double thisDiff = std::abs(p_Metallicity - std::get<1>(LOVERIDGE_METALLICITY_VALUE[i]));
+        if (utils::Compare(thisDiff, minDiff) < 0) {
+            lMetallicity = i;
+            minDiff      = thisDiff;
+        }
+    }
+
+    return lMetallicity;
+}
+
+
+/*
+ * The binding energy polynomials of Loveridge et al. 2011, eq 5, for nested Horner evaluation
+ *
+ * Built from LOVERIDGE_COEFFICIENTS on the first call: one dense array of coefficients (see struct
+ * LoveridgePolynomial) per metallicity and evolutionary stage, indexed as LOVERIDGE_COEFFICIENTS.
+ *
+ *
+ * const std::vector<std::vector<LoveridgePolynomial>>& LoveridgePolynomials_Static()
+ *
+ * @return                                      The polynomials, indexed by metallicity (LOVERIDGE_METALLICITY) and
+ *                                              evolutionary stage (LOVERIDGE_GROUP)
+ */
+const std::vector<std::vector<LoveridgePolynomial>>& BaseStar::LoveridgePolynomials_Static() {
+
+    static const std::vector<std::vector<LoveridgePolynomial>> polynomials = [] {
+
+        std::vector<std::vector<LoveridgePolynomial>> result;
+
+        for (auto const& metallicityCoefficients: LOVERIDGE_COEFFICIENTS) {                 // for each metallicity
+            std::vector<LoveridgePolynomial> groups;
+            for (auto const& groupCoefficients: metallicityCoefficients) {                  // for each evolutionary stage
+                LoveridgePolynomial polynomial = { 0, 0, 0, 0, {} };
+                for (auto const& lCoefficients: groupCoefficients) {                        // range of exponents of the polynomial
+                    polynomial.mLow  = std::min(polynomial.mLow,  lCoefficients.m);
+                    polynomial.mHigh = std::max(polynomial.mHigh, lCoefficients.m);
+                    polynomial.rLow  = std::min(polynomial.rLow,  lCoefficients.r);
+                    polynomial.rHigh = std::max(polynomial.rHigh, lCoefficients.r);
+                }
+                int nR = polynomial.rHigh - polynomial.rLow + 1;
+                polynomial.alpha.assign((polynomial.mHigh - polynomial.mLow + 1) * nR, 0.0);
+                for (auto const& lCoefficients: groupCoefficients) {                        // coefficients (summed, should a term appear more than once)
+                    polynomial.alpha[(lCoefficients.m - polynomial.mLow) * nR + (lCoefficients.r - polynomial.rLow)] += lCoefficients.alpha_mr;
+                }
+                groups.push_back(polynomial);
+            }
+            result.push_back(groups);
+        }
+
+        return result;
+    }();
+
+    return polynomials;
+}
+
+
 /*
  * Calculata lambda parameter from the so-called energy formalism of CE (Webbink 1984).
  *
@@ -1285,14 +1385,14 @@ double BaseStar::CalculateLuminosityGivenCoreMass(const double p_CoreMass) const
  * Tout et al. 1996, eq 2
  *
  *
- * double CalculateRadiusAtZAMS(const double p_MZAMS)
+ * double CalculateRadiusAtZAMS_Static(const double p_MZAMS, const DBL_VECTOR &p_RCoefficients)
  *
  * @param   [IN]    p_MZAMS                     Zero age main sequence mass in Msol
+ * @param   [IN]    p_RCoefficients             Radius coefficients (see CalculateRCoefficients())
  * @return                                      Radius in units of Rsol (RZAMS)
- * Uses class member m_RCoefficients as radius coefficients
  */
-double BaseStar::CalculateRadiusAtZAMS(const double p_MZAMS) const {
-#define coeff(x) m_RCoefficients[static_cast<int>(R_Coeff::x)]  // for convenience and readability - undefined at end of function
+double BaseStar::CalculateRadiusAtZAMS_Static(const double p_MZAMS, const DBL_VECTOR &p_RCoefficients) {
+#define coeff(x) p_RCoefficients[static_cast<int>(R_Coeff::x)]  // for convenience and readability - undefined at end of function
 
     // pow() is slow - use multiplication where it makes sense
     // sqrt() is much faster than pow()
@@ -1317,6 +1417,29 @@ double BaseStar::CalculateRadiusAtZAMS(const double p_MZAMS) const {
 }
 
 
+/*
+ * Calculate radius at ZAMS in units of Rsol, for a given metallicity
+ * Tout et al. 1996, eq 2
+ *
+ * Calculates the radius coefficients for the metallicity, so can be used before a star is
+ * constructed (e.g. to check initial conditions - see BaseBinaryStar::InitialConditionsOk_Static())
+ *
+ *
+ * double CalculateRadiusAtZAMS_Static(const double p_MZAMS, const double p_Metallicity)
+ *
+ * @param   [IN]    p_MZAMS                     Zero age main sequence mass in Msol
+ * @param   [IN]    p_Metallicity               Metallicity
+ * @return                                      Radius in units of Rsol (RZAMS)
+ */
+double BaseStar::CalculateRadiusAtZAMS_Static(const double p_MZAMS, const double p_Metallicity) {
+
+    DBL_VECTOR rCoefficients;
+    CalculateRCoefficients(log10(p_Metallicity / ZSOL), rCoefficients);
+
+    return CalculateRadiusAtZAMS_Static(p_MZAMS, rCoefficients);
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////
 //                                                                                   //
 //                                 MASS CALCULATIONS                                 //
@@ -2494,6 +2617,9 @@ double BaseStar::DrawRemnantKickMuller(const double p_COCoreMass) const {
 /*
  * Draw kick magnitude per Mandel and Mueller, 2020
  *
+ * The kick is muKick * (1 + sigma * N(0, 1)), with the Gaussian truncated so that the kick is not
+ * negative, sampled by inverse transform (so the kick increases with p_Rand)
+ *
  * double DrawRemnantKickMullerMandel(const double p_COCoreMass, 
  *                                    const double p_Rand,
  *                                    const double p_RemnantMass)
@@ -2506,9 +2632,7 @@ double BaseStar::DrawRemnantKickMuller(const double p_COCoreMass) const {
 double BaseStar::DrawRemnantKickMullerMandel(const double p_COCoreMass, 
                                              const double p_Rand,
                                              const double p_RemnantMass) const {					
-	double remnantKick = -1.0;
-	double muKick      = 0.0;
-    double rand        = p_Rand;    //makes it possible to adjust if p_Rand is too low, to avoid getting stuck
+	double muKick = 0.0;
 
 	if (utils::Compare(p_RemnantMass, MULLERMANDEL_MAXNS) <  0) {
 		muKick = max(OPTIONS->MullerMandelKickMultiplierNS() * (p_COCoreMass - p_RemnantMass) / p_RemnantMass, 0.0);
@@ -2517,12 +2641,7 @@ double BaseStar::DrawRemnantKickMullerMandel(const double p_COCoreMass,
 		muKick = max(OPTIONS->MullerMandelKickMultiplierBH() * (p_COCoreMass - p_RemnantMass) / p_RemnantMass, 0.0);
 	}
 
-	while (remnantKick < 0.0) {
-		remnantKick = muKick * (1.0 + gsl_cdf_gaussian_Pinv(rand, MULLERMANDEL_SIGMAKICK));
-		rand        = min(rand + p_Rand + 0.0001, 1.0);
-	}
-
-	return remnantKick;
+	return muKick * Rand::TruncatedGaussianInverseCDF(1.0, MULLERMANDEL_SIGMAKICK, 0.0, std::numeric_limits<double>::infinity(), p_Rand);   // kick can't be negative
 }
 
 
@@ -2530,24 +2649,27 @@ double BaseStar::DrawRemnantKickMullerMandel(const double p_COCoreMass,
  * Draw a kick magnitude from the user-specified distribution
  *
  *
- * double DrawSNKickMagnitude(const double p_Sigma,
- *                           const double p_COCoreMass,
- *                           const double p_Rand,
- *                           const double p_EjectaMass,
- *                           const double p_RemnantMass)
+ * double DrawSNKickMagnitude(const double       p_Sigma,
+ *                            const double       p_COCoreMass,
+ *                            const double       p_Rand,
+ *                            const double       p_EjectaMass,
+ *                            const double       p_RemnantMass,
+ *                            const STELLAR_TYPE p_StellarType)
  *
  * @param   [IN]    p_Sigma                     Distribution scale parameter - affects the spread of the distribution
  * @param   [IN]    p_COCoreMass                Carbon Oxygen core mass of exploding star (Msol)
  * @param   [IN]    p_Rand                      Random number between 0 and 1 used for drawing from the distribution
  * @param   [IN]    p_EjectaMass                Change in mass of the exploding star (i.e. mass of the ejecta) (Msol)
  * @param   [IN]    p_RemnantMass               Mass of the remnant (Msol)
+ * @param   [IN]    p_StellarType               Expected remnant type
  * @return                                      Drawn kick magnitude (km s^-1)
  */
-double BaseStar::DrawSNKickMagnitude(const double p_Sigma,
-                                     const double p_COCoreMass,
-                                     const double p_Rand,
-                                     const double p_EjectaMass,
-                                     const double p_RemnantMass) const {
+double BaseStar::DrawSNKickMagnitude(const double       p_Sigma,
+                                     const double       p_COCoreMass,
+                                     const double       p_Rand,
+                                     const double       p_EjectaMass,
+                                     const double       p_RemnantMass,
+                                     const STELLAR_TYPE p_StellarType) const {
 	double kickMagnitude;
 
     switch (OPTIONS->KickMagnitudeDistribution()) {                                              // which distribution
@@ -2587,6 +2709,16 @@ double BaseStar::DrawSNKickMagnitude(const double p_Sigma,
             kickMagnitude = DrawRemnantKickMullerMandel(p_COCoreMass, p_Rand, p_RemnantMass);
             break;
 
+        case KICK_MAGNITUDE_DISTRIBUTION::TABULATED:                                             // TABULATED
+            if (REMNANT_TABLE->HasKicks()) {
+                kickMagnitude = REMNANT_TABLE->DrawKick(p_COCoreMass, m_SupernovaDetails.HeCoreMassAtCOFormation, m_Metallicity, MassTransferCase(), p_StellarType, p_Rand);
+            }
+            else {                                                                              // no table, or no kicks tabulated
+                SHOW_WARN(ERROR::INVALID_REMNANT_TABLE, "No kicks tabulated - using default: MAXWELL");  // show warning
+                kickMagnitude = DrawKickMagnitudeDistributionMaxwell(p_Sigma, p_Rand);
+            }
+            break;
+
         default:                                                                                // unknown distribution
             SHOW_WARN(ERROR::UNKNOWN_KICK_MAGNITUDE_DISTRIBUTION, "Using default: MAXWELL");     // show warning
             kickMagnitude = DrawKickMagnitudeDistributionMaxwell(p_Sigma, p_Rand);
@@ -2663,7 +2795,8 @@ double BaseStar::CalculateSNKickMagnitude(const double p_RemnantMass, const doub
                                     m_SupernovaDetails.COCoreMassAtCOFormation, 
                                     m_SupernovaDetails.kickMagnitudeRandom,
                                     p_EjectaMass, 
-                                    p_RemnantMass);
+                                    p_RemnantMass,
+                                    p_StellarType);
         }
     }
     else {                                                                                          // user supplied kick parameters and wants to use supplied kick magnitude, so ...
@@ -3030,6 +3163,46 @@ void BaseStar::AgeOneTimestepPreamble(const double p_DeltaTime) {
 }
 
 
+/*
+ * Determine the mass transfer case of the star, from its mass transfer donor history
+ *
+ * The case is that of the most recent episode of mass transfer in which the star was the donor:
+ *
+ *     NONE     the star was never a donor - effectively a single star
+ *     A        donor on the MS
+ *     B        donor on the HG, FGB or CHeB
+ *     C        donor on the EAGB or TPAGB
+ *     OTHER    donor of any other stellar type (e.g. stripped stars - probably ultra-stripped)
+ *
+ *
+ * MT_CASE MassTransferCase()
+ *
+ * @return                                      Mass transfer case
+ */
+MT_CASE BaseStar::MassTransferCase() const {
+
+    if (m_MassTransferDonorHistory.empty()) return MT_CASE::NONE;                                       // never a donor
+
+    STELLAR_TYPE mostRecentDonorType = m_MassTransferDonorHistory.back();
+
+    if (utils::IsOneOf(mostRecentDonorType, { STELLAR_TYPE::MS_LTE_07,
+                                              STELLAR_TYPE::MS_GT_07 })) {                              // CASE A Mass Transfer - from MS
+        return MT_CASE::A;
+    }
+    if (utils::IsOneOf(mostRecentDonorType, { STELLAR_TYPE::HERTZSPRUNG_GAP,
+                                              STELLAR_TYPE::FIRST_GIANT_BRANCH,
+                                              STELLAR_TYPE::CORE_HELIUM_BURNING })) {                   // CASE B Mass Transfer - from HG, FGB, or CHeB
+        return MT_CASE::B;
+    }
+    if (utils::IsOneOf(mostRecentDonorType, { STELLAR_TYPE::EARLY_ASYMPTOTIC_GIANT_BRANCH,
+                                              STELLAR_TYPE::THERMALLY_PULSING_ASYMPTOTIC_GIANT_BRANCH })) {  // CASE C Mass Transfer - from EAGB or TPAGB
+        return MT_CASE::C;
+    }
+
+    return MT_CASE::OTHER;
+}
+
+
 /*
  * Convert Mass Transfer Donor History vector into string
  *
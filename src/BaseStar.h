@@ -15,6 +15,32 @@
 #include "Errors.h"
 
 
+/*
+ * LiveStarCounter - counts the BaseStar objects in existence (see BaseStar::LiveStars())
+ *
+ * A member of BaseStar, rather than counted by the BaseStar constructors, so that objects created
+ * by the implicitly-defined copy constructor of BaseStar (e.g. when a star switches stellar type, or
+ * its state is saved) are counted.  Used for memory footprint reporting.
+ */
+class LiveStarCounter {
+
+public:
+
+    LiveStarCounter()                                                               { if (++m_Live > m_Peak) m_Peak = m_Live; }
+    LiveStarCounter(const LiveStarCounter&) : LiveStarCounter()                     { }
+    LiveStarCounter& operator = (const LiveStarCounter&)                            { return *this; }      // assignment doesn't create an object
+    ~LiveStarCounter()                                                              { m_Live--; }
+
+    static size_t Live()                                                            { return m_Live; }
+    static size_t Peak()                                                            { return m_Peak; }
+
+private:
+
+    static size_t m_Live;                                                           // number of objects in existence
+    static size_t m_Peak;                                                           // peak number of objects in existence
+};
+
+
 class BaseStar {
 
 public:
@@ -30,6 +56,11 @@ public:
     virtual ~BaseStar() {}
 
 
+    // number of BaseStar objects in existence (for memory footprint reporting)
+    static  size_t              LiveStars()                                                     { return LiveStarCounter::Live(); }
+    static  size_t              LiveStarsPeak()                                                 { return LiveStarCounter::Peak(); }
+
+
     // object identifiers - all classes have these
     OBJECT_ID           ObjectId() const                                                        { return m_ObjectId; }
     OBJECT_TYPE         ObjectType() const                                                      { return m_ObjectType; }
@@ -82,6 +113,7 @@ public:
             double              Mass() const                                                    { return m_Mass; }
             double              Mass0() const                                                   { return m_Mass0; }
             double              MassPrev() const                                                { return m_MassPrev; }
+            MT_CASE             MassTransferCase() const;
             STYPE_VECTOR        MassTransferDonorHistory() const                                { return m_MassTransferDonorHistory; }
             std::string         MassTransferDonorHistoryString() const;
             double              Mdot() const                                                    { return m_Mdot; }
@@ -172,6 +204,8 @@ public:
             double          CalculateRadialChange() const                                                       { return (utils::Compare(m_RadiusPrev,0)<=0)? 0 : std::abs(m_Radius - m_RadiusPrev) / m_RadiusPrev; }                    // Return fractional radial change (if previous radius is negative or zero, return 0 to avoid NaN
 
             double          CalculateRadialExpansionTimescale() const                                           { return CalculateRadialExpansionTimescale_Static(m_StellarType, m_StellarTypePrev, m_Radius, m_RadiusPrev, m_DtPrev); } // Use class member variables
+
+    static  double          CalculateRadiusAtZAMS_Static(const double p_MZAMS, const double p_Metallicity);
     
             void            CalculateSNAnomalies(const double p_Eccentricity);
 
@@ -231,6 +265,10 @@ public:
 
 protected:
 
+    friend class Benchmarks;                                                    // microbenchmarks for protected kernels (see benchmarks/Benchmarks.cpp)
+
+    LiveStarCounter         m_LiveStarCounter;                          // Counts the BaseStar objects in existence
+
     OBJECT_ID               m_ObjectId;                                 // Instantiated object's unique object id
     OBJECT_TYPE             m_ObjectType;                               // Instantiated object's object type
     STELLAR_TYPE            m_InitialStellarType;                       // Stellar type at birth, defined in Hurley et al. 2000
@@ -291,6 +329,7 @@ protected:
     double                  m_LogMetallicitySigma;                      // log10(Metallicity)           - called sigma in Hurley et al 2000
     double                  m_LogMetallicityXi;                         // log10(Metallicity / Zsol)    - called xi in Hurley et al 2000
     double                  m_Metallicity;                              // Metallicity
+    int                     m_LoveridgeMetallicity;                     // Index of the metallicity of Loveridge et al. 2011 closest to Metallicity (LOVERIDGE_METALLICITY)
 
     // Metallicity dependent constants
     double                  m_Alpha1;                                   // alpha1 in Hurly et al. 2000, just after eq 49
@@ -396,6 +435,9 @@ protected:
             double              CalculateLifetimeToBGB(const double p_Mass) const;
 
             double              CalculateLogBindingEnergyLoveridge(bool p_IsMassLoss) const;
+    static  double              CalculateLoveridgePolynomial_Static(const int p_LMetallicity, const LOVERIDGE_GROUP p_LGroup, const double p_LogMass, const double p_LogRadius);
+    static  int                 CalculateLoveridgeMetallicity_Static(const double p_Metallicity);
+    static  const std::vector<std::vector<LoveridgePolynomial>>& LoveridgePolynomials_Static();
 
             double              CalculateLuminosityAtBAGB(double p_Mass) const;
     virtual double              CalculateLuminosityAtPhaseEnd() const                                                   { return m_Luminosity; }                                                    // Default is NO-OP
@@ -451,11 +493,12 @@ protected:
             virtual double      CalculateRadialExtentConvectiveEnvelope() const                                         { return m_Radius; }                                                        // default for stars with no convective envelope
 
     virtual double              CalculateRadiusAtPhaseEnd() const                                                       { return m_Radius; }                                                        // Default is NO-OP
-            double              CalculateRadiusAtZAMS(const double p_MZAMS) const;
+            double              CalculateRadiusAtZAMS(const double p_MZAMS) const                                       { return CalculateRadiusAtZAMS_Static(p_MZAMS, m_RCoefficients); }          // Use class member variables
+    static  double              CalculateRadiusAtZAMS_Static(const double p_MZAMS, const DBL_VECTOR &p_RCoefficients);
     virtual double              CalculateRadiusOnPhase() const                                                          { return m_Radius; }                                                        // Default is NO-OP
     virtual std::tuple <double, STELLAR_TYPE> CalculateRadiusAndStellarTypeOnPhase() const                              { return std::make_tuple(CalculateRadiusOnPhase(), m_StellarType); }
 
-            void                CalculateRCoefficients(const double p_LogMetallicityXi, DBL_VECTOR &p_RCoefficients);
+    static  void                CalculateRCoefficients(const double p_LogMetallicityXi, DBL_VECTOR &p_RCoefficients);
 
             double              CalculateRotationalVelocity(double p_MZAMS) const;
 
@@ -494,11 +537,12 @@ protected:
                                                             const double p_Rand,
                                                             const double p_RemnantMass) const;
 
-            double              DrawSNKickMagnitude(const double p_Sigma,
-                                                    const double p_COCoreMass,
-                                                    const double p_Rand,
-                                                    const double p_EjectaMass,
-                                                    const double p_RemnantMass) const;
+            double              DrawSNKickMagnitude(const double       p_Sigma,
+                                                    const double       p_COCoreMass,
+                                                    const double       p_Rand,
+                                                    const double       p_EjectaMass,
+                                                    const double       p_RemnantMass,
+                                                    const STELLAR_TYPE p_StellarType) const;
 
     virtual void                EvolveOneTimestepPreamble() { };                                                                                                                                    // Default is NO-OP
 
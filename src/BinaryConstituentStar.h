@@ -17,6 +17,11 @@ class BinaryConstituentStar: virtual public Star {
 public:
 
 
+    // BinaryConstituentStars are allocated from the current arena, if any (see Arena.h)
+    static void* operator new(const std::size_t p_Size)                                                 { return Arena::Allocate(p_Size); }
+    static void  operator delete(void* p_Ptr) noexcept                                                  { Arena::Deallocate(p_Ptr); }
+
+
     BinaryConstituentStar() : Star() {
         m_ObjectId   = globalObjectId++;
         m_ObjectType = OBJECT_TYPE::BINARY_CONSTITUENT_STAR;
@@ -65,9 +65,20 @@ public:
 
     // member functions
     long int            Id()                        { return m_BinaryStar->Id(); }
+    ERROR               Error()                     { return m_BinaryStar->Error(); }
     EVOLUTION_STATUS    Evolve()                    { return m_BinaryStar->Evolve(); }
+    bool                ImmediateRLOFPostCEE()      { return m_BinaryStar->ImmediateRLOFPostCEE(); }
+    double              ImportanceWeight()          { return m_BinaryStar->ImportanceWeight(); }
+    std::vector<InitialConditionsDrawT> InitialConditionsDraws() { return m_BinaryStar->InitialConditionsDraws(); }
+    bool                IsBHandBH()                 { return m_BinaryStar->IsBHandBH(); }
+    bool                IsDCO()                     { return m_BinaryStar->IsDCO(); }
+    bool                IsNSandBH()                 { return m_BinaryStar->IsNSandBH(); }
+    bool                IsNSandNS()                 { return m_BinaryStar->IsNSandNS(); }
+    bool                MergesInHubbleTime()        { return m_BinaryStar->MergesInHubbleTime(); }
+    bool                OptimisticCommonEnvelope()  { return m_BinaryStar->OptimisticCommonEnvelope(); }
     bool                RevertState();
     void                SaveState();
+    void                SetImportanceWeight(const double p_Weight) { m_BinaryStar->SetImportanceWeight(p_Weight); }
     STELLAR_TYPE        Star1InitialType()          { return m_BinaryStar->InitialStellarType1(); }
     STELLAR_TYPE        Star1Type()                 { return m_BinaryStar->StellarType1(); }
     STELLAR_TYPE        Star2InitialType()          { return m_BinaryStar->InitialStellarType2(); }
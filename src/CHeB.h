@@ -46,6 +46,8 @@ public:
 
 protected:
 
+    friend class Star;                                                                      // so Star can call member functions directly (see STAR_DISPATCH in Star.h)
+
     void Initialise() {
     #define massCutoffs(x) m_MassCutoffs[static_cast<int>(MASS_CUTOFF::x)]  // for convenience and readability - undefined at end of function
 
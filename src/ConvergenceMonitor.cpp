@@ -0,0 +1,157 @@
+#include "ConvergenceMonitor.h"
+#include "Options.h"
+#include "utils.h"
+#include "BinaryStar.h"
+
+
+/*
+ * Constructor
+ */
+ConvergenceMonitor::ConvergenceMonitor() {
+
+    m_Outcome  = OPTIONS->ConvergenceOutcome();
+
+    m_nDraws   = 0;
+    m_nSystems = 0;
+    m_nHits    = 0;
+
+    m_Mean     = 0.0;
+    m_M2       = 0.0;
+}
+
+
+/*
+ * Determine whether the rate estimate has converged
+ *
+ *
+ * bool Converged() const
+ *
+ * @return                                      True if at least CONVERGENCE_MINIMUM_HITS binaries have had the outcome
+ *                                              and the relative uncertainty of the rate is within tolerance, otherwise false
+ */
+bool ConvergenceMonitor::Converged() const {
+    return Enabled() && m_nHits >= (size_t)CONVERGENCE_MINIMUM_HITS && RelativeUncertainty() <= OPTIONS->ConvergenceTolerance();
+}
+
+
+/*
+ * Determine whether the evolved binary has the outcome specified by the convergence-* program options
+ *
+ *
+ * bool IsOutcome(BinaryStar* p_Binary) const
+ *
+ * @param   [IN]    p_Binary                    The evolved binary
+ * @return                                      True if the binary has the outcome, otherwise false
+ */
+bool ConvergenceMonitor::IsOutcome(BinaryStar* p_Binary) const {
+
+    bool outcome = false;
+
+    switch (m_Outcome) {                                                                        // which outcome?
+        case CONVERGENCE_OUTCOME::DCO : outcome = p_Binary->IsDCO();     break;
+        case CONVERGENCE_OUTCOME::BBH : outcome = p_Binary->IsBHandBH(); break;
+        case CONVERGENCE_OUTCOME::BNS : outcome = p_Binary->IsNSandNS(); break;
+        case CONVERGENCE_OUTCOME::BHNS: outcome = p_Binary->IsNSandBH(); break;
+        default                       : outcome = false;                                        // NONE, or unknown outcome - shouldn't happen
+    }
+
+    if (outcome && OPTIONS->ConvergenceHubble()) outcome = p_Binary->MergesInHubbleTime();     // must merge in a Hubble time
+
+    return outcome;
+}
+
+
+/*
+ * Record the outcome of an evolved binary
+ *
+ * Draws rejected by the BaseBinaryStar constructor before the initial conditions of the binary
+ * were accepted are recorded first (see RecordRejected()).
+ *
+ *
+ * void Record(BinaryStar* p_Binary)
+ *
+ * @param   [IN]    p_Binary                    The evolved binary
+ */
+void ConvergenceMonitor::Record(BinaryStar* p_Binary) {
+
+    size_t nRejected = 0;
+    for (auto& draw : p_Binary->InitialConditionsDraws()) {                                    // count draws rejected by the constructor
+        if (!draw.accepted) nRejected++;
+    }
+    RecordRejected(nRejected);
+
+    bool   hit   = IsOutcome(p_Binary);
+    double value = hit ? (OPTIONS->ConvergenceWeighted() ? p_Binary->ImportanceWeight() : 1.0) : 0.0;
+
+    m_nDraws++;
+    m_nSystems++;
+    if (hit) m_nHits++;
+
+    double delta = value - m_Mean;                                                              // Welford's online mean and variance
+    m_Mean += delta / (double)m_nDraws;
+    m_M2   += delta * (value - m_Mean);
+}
+
+
+/*
+ * Record draws of initial conditions that were rejected (not evolved)
+ *
+ * A rejected draw does not have the outcome (x = 0), but counts towards the number of draws N.
+ * The p_nRejected zero values are added to the running mean and variance in one step (Chan et al.'s
+ * parallel update of Welford's method, with a batch of mean 0 and no variance).
+ *
+ *
+ * void RecordRejected(const size_t p_nRejected)
+ *
+ * @param   [IN]    p_nRejected                 Number of rejected draws
+ */
+void ConvergenceMonitor::RecordRejected(const size_t p_nRejected) {
+
+    if (p_nRejected == 0) return;                                                               // nothing to do
+
+    double nPrevious = (double)m_nDraws;
+    m_nDraws += p_nRejected;
+
+    double delta = -m_Mean;                                                                     // batch mean (0) - running mean
+    m_Mean += delta * (double)p_nRejected / (double)m_nDraws;
+    m_M2   += delta * delta * nPrevious * (double)p_nRejected / (double)m_nDraws;
+}
+
+
+/*
+ * Calculate the relative uncertainty (standard error / estimate) of the rate estimate
+ *
+ *
+ * double RelativeUncertainty() const
+ *
+ * @return                                      Relative uncertainty of the rate estimate (infinity if no binary has had the outcome)
+ */
+double ConvergenceMonitor::RelativeUncertainty() const {
+
+    if (m_nDraws < 2 || m_Mean <= 0.0) return std::numeric_limits<double>::infinity();         // can't estimate yet
+
+    double variance = m_M2 / (double)(m_nDraws - 1);                                            // sample variance of w * x
+
+    return std::sqrt(variance / (double)m_nDraws) / m_Mean;
+}
+
+
+/*
+ * Construct a one-line summary of the rate estimate (for progress reports)
+ *
+ *
+ * std::string Summary() const
+ *
+ * @return                                      Summary string
+ */
+std::string ConvergenceMonitor::Summary() const {
+    double relUnc = RelativeUncertainty();
+    return utils::vFormat("%s rate = %.6e per system drawn (%lu of %lu systems evolved, %lu drawn), relative uncertainty = %s (target %g)",
+                          CONVERGENCE_OUTCOME_LABEL.at(m_Outcome).c_str(),
+                          m_Mean,
+                          (unsigned long)m_nHits,
+                          (unsigned long)m_nSystems,
+                          (unsigned long)m_nDraws,
+                          std::isfinite(relUnc) ? utils::vFormat("%.4f", relUnc).c_str() : "undefined",
+                          OPTIONS->ConvergenceTolerance());
+}
@@ -0,0 +1,71 @@
+#ifndef __ConvergenceMonitor_h__
+#define __ConvergenceMonitor_h__
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+class BinaryStar;
+
+
+/*
+ * ConvergenceMonitor - online estimate of the rate of an outcome, for convergence-driven stopping
+ *
+ * The outcome (see program options --convergence-outcome and --convergence-hubble) is evaluated for
+ * each binary when its evolution is complete.  The rate of the outcome per system drawn from the
+ * prior is estimated by
+ *
+ *     R = sum(w_i * x_i) / N
+ *
+ * where x_i is 1 if binary i has the outcome (else 0), w_i is the importance sampling weight of
+ * binary i (1 unless adaptive importance sampling is being used, or if --convergence-weighted is
+ * FALSE), and N is the number of initial conditions drawn: the binaries evolved, plus the draws
+ * rejected (by the adaptive importance sampler, or by the BaseBinaryStar constructor) because they
+ * could not make a valid binary.  Rejected draws have x_i = 0, so N is the same denominator as that
+ * of the star-forming mass and of the adaptive importance sampling estimator.  The standard error of
+ * R is estimated from the sample variance of w_i * x_i, accumulated with Welford's method.
+ *
+ * The run is converged once at least CONVERGENCE_MINIMUM_HITS binaries have had the outcome and the
+ * relative uncertainty (standard error / R) is at most --convergence-tolerance.  Program option
+ * --number-of-systems is then the maximum number of binaries evolved.
+ */
+
+class ConvergenceMonitor {
+
+public:
+
+    ConvergenceMonitor();
+
+
+    // getters
+    bool        Enabled() const                                                     { return m_Outcome != CONVERGENCE_OUTCOME::NONE; }
+    size_t      nDraws() const                                                      { return m_nDraws; }
+    size_t      nHits() const                                                       { return m_nHits; }
+    size_t      nSystems() const                                                    { return m_nSystems; }
+    double      Rate() const                                                        { return m_Mean; }
+
+
+    // member functions
+    bool        Converged() const;
+    void        Record(BinaryStar* p_Binary);
+    void        RecordRejected(const size_t p_nRejected);
+    double      RelativeUncertainty() const;
+    std::string Summary() const;
+
+
+private:
+
+    bool        IsOutcome(BinaryStar* p_Binary) const;
+
+
+    CONVERGENCE_OUTCOME m_Outcome;                                                              // Outcome whose rate is estimated
+
+    size_t              m_nDraws;                                                               // Number of draws recorded (binaries recorded, and rejected draws)
+    size_t              m_nSystems;                                                             // Number of binaries recorded
+    size_t              m_nHits;                                                                // Number of binaries recorded that had the outcome
+
+    double              m_Mean;                                                                 // Running mean of w * x (the rate estimate)
+    double              m_M2;                                                                   // Running sum of squared deviations of w * x from the mean (Welford)
+};
+
+#endif // __ConvergenceMonitor_h__
@@ -36,6 +36,8 @@ public:
 
 protected:
 
+    friend class Star;                                                                      // so Star can call member functions directly (see STAR_DISPATCH in Star.h)
+
     void Initialise() {
         m_StellarType = STELLAR_TYPE::EARLY_ASYMPTOTIC_GIANT_BRANCH;                                                                                                    // Set stellar type
         CalculateTimescales();                                                                                                                                          // Initialise timescales
@@ -291,6 +291,9 @@ bool Errors::ShowIt(const std::string  p_Prefix,
  * Removes all objectId entries (and associated funcNames) from the Error Catalog
  * This is so entries for deleted objects don't bloat the error catalog
  *
+ * Records the peak number of entries in the catalog (see CatalogEntries()) - the catalog is
+ * largest just before it is cleaned.
+ *
  *
  * void Clean()
  */
@@ -298,7 +301,9 @@ void Errors::Clean() {
 
     if (m_ErrorCatalog.size() == 0) return;                                                                                                                             // nothing to do
 
-    for (auto catalogIter : m_ErrorCatalog) {                                                                                                                           // for each entry in the error catalog
+    m_CatalogEntriesPeak = std::max(m_CatalogEntriesPeak, CatalogEntries());                                                                                            // record peak
+
+    for (auto &catalogIter : m_ErrorCatalog) {                                                                                                                          // for each entry in the error catalog (by reference - the entry is updated)
         std::vector<OBJECT_ID> stellarObjectIds = std::get<5>(catalogIter.second);                                                                                      // stellar object ids
         if (stellarObjectIds.size() == 0) continue;                                                                                                                     // no stellar objectIds for this error
 
@@ -316,3 +321,29 @@ void Errors::Clean() {
         catalogIter.second = std::make_tuple(scope, already, objectTypes, stellarTypes, nonStellarObjectIds, stellarObjectIds, nonStellarFuncs, stellarFuncs, text);    // update catalog
     }
 }
+
+
+/*
+ * Count the entries in the dynamic error catalog
+ *
+ * Each error in the catalog holds the object types, stellar types, and object ids (with function names) from
+ * which it has been printed - this counts them all (the object ids of stellar objects are removed by Clean(),
+ * so this number should not grow without bound).
+ *
+ *
+ * size_t CatalogEntries() const
+ *
+ * @return                                      Number of entries in the dynamic error catalog
+ */
+size_t Errors::CatalogEntries() const {
+
+    size_t entries = 0;
+    for (auto &catalogIter : m_ErrorCatalog) {                                                                                                                          // for each error in the error catalog
+        entries += std::get<2>(catalogIter.second).size() +                                                                                                             // object types
+                   std::get<3>(catalogIter.second).size() +                                                                                                             // stellar types
+                   std::get<4>(catalogIter.second).size() +                                                                                                             // non-stellar object ids
+                   std::get<5>(catalogIter.second).size();                                                                                                              // stellar object ids
+    }
+
+    return entries;
+}
@@ -58,6 +58,8 @@ private:
         >
     > m_ErrorCatalog = {};
 
+    size_t m_CatalogEntriesPeak = 0;                                                // peak number of entries in the dynamic error catalog (see CatalogEntries())
+
 
 public:
 
@@ -77,6 +79,8 @@ public:
     void Clean();
 
     size_t CatalogSize() { return m_ErrorCatalog.size(); }
+    size_t CatalogEntries() const;
+    size_t CatalogEntriesPeak() const { return std::max(m_CatalogEntriesPeak, CatalogEntries()); }
 };
 
 #endif // __Errors_h_
@@ -0,0 +1,166 @@
+#include "EvolutionOutcomes.h"
+#include "Options.h"
+#include "Log.h"
+
+
+/*
+ * Calculate the total number of systems recorded
+ *
+ *
+ * size_t nSystems() const
+ *
+ * @return                                      Number of stars (SSE) or binaries (BSE) recorded
+ */
+size_t EvolutionOutcomes::nSystems() const {
+    size_t n = 0;
+    for (auto& outcome: m_Outcomes) n += outcome.second.count;
+    return n;
+}
+
+
+/*
+ * Record the outcome of evolving a star or binary
+ *
+ *
+ * void Record(const EVOLUTION_STATUS p_Status,
+ *             const STELLAR_TYPE     p_StellarType1,
+ *             const STELLAR_TYPE     p_StellarType2,
+ *             const ERROR            p_Error,
+ *             const double           p_WallSeconds)
+ *
+ * @param   [IN]    p_Status                    Evolution status returned by Evolve()
+ * @param   [IN]    p_StellarType1              Final stellar type of the star (SSE), or of the primary (BSE)
+ * @param   [IN]    p_StellarType2              Final stellar type of the secondary (BSE) - STELLAR_TYPE::NONE for SSE
+ * @param   [IN]    p_Error                     Most recent error recorded for the star or binary
+ * @param   [IN]    p_WallSeconds               Wall time spent evolving the star or binary (seconds)
+ */
+void EvolutionOutcomes::Record(const EVOLUTION_STATUS p_Status,
+                               const STELLAR_TYPE     p_StellarType1,
+                               const STELLAR_TYPE     p_StellarType2,
+                               const ERROR            p_Error,
+                               const double           p_WallSeconds) {
+
+    OutcomeT& outcome = m_Outcomes.emplace(OutcomeKeyT(p_Status, p_StellarType1, p_StellarType2, p_Error), OutcomeT{0, 0.0, 0.0}).first->second;  // get outcome (create if necessary)
+
+    outcome.count++;
+    outcome.wallSeconds   += p_WallSeconds;
+    outcome.wallSecondsMax = std::max(outcome.wallSecondsMax, p_WallSeconds);
+}
+
+
+/*
+ * Write an evolution outcomes summary table to the output container
+ *
+ * Appends the Count, Wall_Time, Wall_Time_Mean and Wall_Time_Max columns for the outcomes
+ * passed to the key columns passed (one row per outcome, in the order of the key columns),
+ * and writes the table.
+ *
+ *
+ * bool WriteTable(const std::string p_TableName, std::vector<SummaryTableColumnT> p_KeyColumns, const std::vector<OutcomeT>& p_Outcomes) const
+ *
+ * @param   [IN]    p_TableName                 Name of the summary table
+ * @param   [IN]    p_KeyColumns                Key columns (values already populated)
+ * @param   [IN]    p_Outcomes                  Outcome for each row of the key columns
+ * @return                                      Boolean status - true = table written ok; false = write failed
+ */
+bool EvolutionOutcomes::WriteTable(const std::string p_TableName, std::vector<SummaryTableColumnT> p_KeyColumns, const std::vector<OutcomeT>& p_Outcomes) const {
+
+    SummaryTableColumnT count        = { "Count",          "-", TYPENAME::ULONGINT, {} };
+    SummaryTableColumnT wallTime     = { "Wall_Time",      "s", TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT wallTimeMean = { "Wall_Time_Mean", "s", TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT wallTimeMax  = { "Wall_Time_Max",  "s", TYPENAME::DOUBLE,   {} };
+
+    for (auto& outcome: p_Outcomes) {
+        count.values.push_back(outcome.count);
+        wallTime.values.push_back(outcome.wallSeconds);
+        wallTimeMean.values.push_back(outcome.wallSeconds / (double)outcome.count);
+        wallTimeMax.values.push_back(outcome.wallSecondsMax);
+    }
+
+    p_KeyColumns.insert(p_KeyColumns.end(), { count, wallTime, wallTimeMean, wallTimeMax });
+
+    return LOGGING->WriteSummaryTable(p_TableName, p_KeyColumns);
+}
+
+
+/*
+ * Write the evolution outcomes summary tables to the output container
+ *
+ * EVOLUTION_OUTCOMES_FILE_NAME has one row per outcome, in order of evolution status, stellar
+ * type(s), and error.  For SSE the table has a single stellar type column; for BSE one for each
+ * constituent star.
+ *
+ * The marginal tables EVOLUTION_OUTCOMES_STATUS_FILE_NAME, EVOLUTION_OUTCOMES_TYPES_FILE_NAME and
+ * EVOLUTION_OUTCOMES_ERROR_FILE_NAME have one row per evolution status, per final stellar type (SSE)
+ * or pair of types (BSE), and per error respectively, with the counts and wall times of all outcomes
+ * with that status, type(s) or error.
+ *
+ *
+ * bool Write() const
+ *
+ * @return                                      Boolean status - true = all tables written ok; false = a write failed
+ */
+bool EvolutionOutcomes::Write() const {
+
+    bool bse = OPTIONS->EvolutionMode() == EVOLUTION_MODE::BSE;
+
+    std::map<EVOLUTION_STATUS, OutcomeT>                        byStatus;                      // marginals - std::map: ordered by key
+    std::map<std::pair<STELLAR_TYPE, STELLAR_TYPE>, OutcomeT>   byTypes;
+    std::map<ERROR, OutcomeT>                                   byError;
+
+    SummaryTableColumnT status       = { "Evolution_Status",                        "-", TYPENAME::INT,          {} };
+    SummaryTableColumnT stellarType1 = { bse ? "Stellar_Type(1)" : "Stellar_Type",  "-", TYPENAME::STELLAR_TYPE, {} };
+    SummaryTableColumnT stellarType2 = { "Stellar_Type(2)",                         "-", TYPENAME::STELLAR_TYPE, {} };
+    SummaryTableColumnT error        = { "Error",                                   "-", TYPENAME::ERROR,        {} };
+
+    std::vector<OutcomeT> outcomes;
+    for (auto& iter: m_Outcomes) {                                                              // std::map - ordered by key
+        const OutcomeT& outcome = iter.second;
+        status.values.push_back(static_cast<int>(std::get<0>(iter.first)));
+        stellarType1.values.push_back(std::get<1>(iter.first));
+        stellarType2.values.push_back(std::get<2>(iter.first));
+        error.values.push_back(std::get<3>(iter.first));
+        outcomes.push_back(outcome);
+
+        Accumulate(byStatus[std::get<0>(iter.first)], outcome);
+        Accumulate(byTypes[std::make_pair(std::get<1>(iter.first), std::get<2>(iter.first))], outcome);
+        Accumulate(byError[std::get<3>(iter.first)], outcome);
+    }
+
+    bool ok = bse
+        ? WriteTable(EVOLUTION_OUTCOMES_FILE_NAME, { status, stellarType1, stellarType2, error }, outcomes)
+        : WriteTable(EVOLUTION_OUTCOMES_FILE_NAME, { status, stellarType1,               error }, outcomes);
+
+    // per evolution status
+    status.values.clear();
+    outcomes.clear();
+    for (auto& iter: byStatus) {
+        status.values.push_back(static_cast<int>(iter.first));
+        outcomes.push_back(iter.second);
+    }
+    ok = WriteTable(EVOLUTION_OUTCOMES_STATUS_FILE_NAME, { status }, outcomes) && ok;
+
+    // per final stellar type (SSE) or pair of types (BSE)
+    stellarType1.values.clear();
+    stellarType2.values.clear();
+    outcomes.clear();
+    for (auto& iter: byTypes) {
+        stellarType1.values.push_back(iter.first.first);
+        stellarType2.values.push_back(iter.first.second);
+        outcomes.push_back(iter.second);
+    }
+    ok = (bse
+        ? WriteTable(EVOLUTION_OUTCOMES_TYPES_FILE_NAME, { stellarType1, stellarType2 }, outcomes)
+        : WriteTable(EVOLUTION_OUTCOMES_TYPES_FILE_NAME, { stellarType1               }, outcomes)) && ok;
+
+    // per error
+    error.values.clear();
+    outcomes.clear();
+    for (auto& iter: byError) {
+        error.values.push_back(iter.first);
+        outcomes.push_back(iter.second);
+    }
+    ok = WriteTable(EVOLUTION_OUTCOMES_ERROR_FILE_NAME, { error }, outcomes) && ok;
+
+    return ok;
+}
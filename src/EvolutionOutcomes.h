@@ -0,0 +1,70 @@
+#ifndef __EvolutionOutcomes_h__
+#define __EvolutionOutcomes_h__
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+/*
+ * EvolutionOutcomes - population-level accounting of the outcomes of evolution
+ *
+ * Counts the stars (SSE) or binaries (BSE) evolved during the run by outcome: the evolution status
+ * returned by Evolve(), the final stellar type of the star (SSE) or of each constituent star (BSE),
+ * and the most recent error recorded for the star or binary (ERROR::NONE if there was none).  The
+ * wall time spent evolving each star or binary is accumulated with its outcome.
+ *
+ * Only outcomes that occur are stored - one entry per distinct (status, stellar type(s), error)
+ * combination, so the memory used does not grow with the number of systems evolved - and they are
+ * written at the end of the run to the EVOLUTION_OUTCOMES_FILE_NAME summary table (a group in the
+ * HDF5 container, or a file in the output container for CSV, TSV, and TXT logfiles), one row per
+ * outcome, so the outcomes of a run can be monitored without post-processing the System Parameters
+ * file.  The counts and times per evolution status, per final stellar type (pair), and per error are
+ * written to the EVOLUTION_OUTCOMES_STATUS_FILE_NAME, EVOLUTION_OUTCOMES_TYPES_FILE_NAME and
+ * EVOLUTION_OUTCOMES_ERROR_FILE_NAME summary tables.
+ */
+
+class EvolutionOutcomes {
+
+public:
+
+    EvolutionOutcomes()                                                             { Clear(); }
+
+
+    // getters
+    bool        Empty() const                                                       { return m_Outcomes.empty(); }
+
+
+    // member functions
+    void        Clear()                                                             { m_Outcomes.clear(); }
+    size_t      nSystems() const;
+    void        Record(const EVOLUTION_STATUS p_Status,
+                       const STELLAR_TYPE     p_StellarType1,
+                       const STELLAR_TYPE     p_StellarType2,
+                       const ERROR            p_Error,
+                       const double           p_WallSeconds);
+    bool        Write() const;
+
+
+private:
+
+    typedef std::tuple<EVOLUTION_STATUS, STELLAR_TYPE, STELLAR_TYPE, ERROR> OutcomeKeyT;      // status, stellar types (type 2 is NONE for SSE), error
+
+    typedef struct Outcome {
+        unsigned long int count;                                                                // number of systems with outcome
+        double            wallSeconds;                                                          // total wall time spent evolving systems with outcome (seconds)
+        double            wallSecondsMax;                                                       // maximum wall time spent evolving a system with outcome (seconds)
+    } OutcomeT;
+
+    std::map<OutcomeKeyT, OutcomeT> m_Outcomes;                                                 // outcomes, ordered by status, stellar type(s), error
+
+
+    static void Accumulate(OutcomeT& p_Total, const OutcomeT& p_Outcome) {
+        p_Total.count         += p_Outcome.count;
+        p_Total.wallSeconds   += p_Outcome.wallSeconds;
+        p_Total.wallSecondsMax = std::max(p_Total.wallSecondsMax, p_Outcome.wallSecondsMax);
+    }
+
+    bool WriteTable(const std::string p_TableName, std::vector<SummaryTableColumnT> p_KeyColumns, const std::vector<OutcomeT>& p_Outcomes) const;
+};
+
+#endif // __EvolutionOutcomes_h__
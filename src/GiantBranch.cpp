@@ -3,6 +3,7 @@
 #include "WhiteDwarfs.h"
 #include "NS.h"
 #include "BH.h"
+#include "RemnantTable.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -1051,31 +1052,7 @@ STELLAR_TYPE GiantBranch::CalculateRemnantTypeByMuller2016(const double p_COCore
 double GiantBranch::CalculateRemnantMassBySchneider2020(const double p_COCoreMass, const bool p_useSchneiderAlt) {
 
     double logRemnantMass;
-    STYPE_VECTOR mtHist = MassTransferDonorHistory();
-    MT_CASE schneiderMassTransferCase = MT_CASE::OTHER;
-
-    // Determine which Schneider case prescription should be used. 
-    if (mtHist.size() == 0) {                                                                                           // No history of MT - effectively single star
-        schneiderMassTransferCase = MT_CASE::NONE;
-    }
-    else { // (mtHist.size() > 0)                                                                                       // Star was MT donor at least once
-
-        STELLAR_TYPE mostRecentDonorType = mtHist[mtHist.size()-1];
-
-        if (utils::IsOneOf(mostRecentDonorType, { STELLAR_TYPE::MS_LTE_07, 
-                                                  STELLAR_TYPE::MS_GT_07 })) {                                          // CASE A Mass Transfer - from MS
-            schneiderMassTransferCase = MT_CASE::A;
-        }
-        else if (utils::IsOneOf(mostRecentDonorType, { STELLAR_TYPE::HERTZSPRUNG_GAP, 
-                                                       STELLAR_TYPE::FIRST_GIANT_BRANCH, 
-                                                       STELLAR_TYPE::CORE_HELIUM_BURNING })) {                          // CASE B Mass Transfer - from HG, FGB, or CHeB 
-            schneiderMassTransferCase = MT_CASE::B;
-        }
-        else if (utils::IsOneOf(mostRecentDonorType, { STELLAR_TYPE::EARLY_ASYMPTOTIC_GIANT_BRANCH,            
-                                                       STELLAR_TYPE::THERMALLY_PULSING_ASYMPTOTIC_GIANT_BRANCH, })) {   // CASE C Mass Transfer - from EAGB or TPAGB 
-            schneiderMassTransferCase = MT_CASE::C;
-        }
-    }
+    MT_CASE schneiderMassTransferCase = MassTransferCase();                                                            // Determine which Schneider case prescription should be used
 
     // Apply the appropriate remnant mass prescription for the chosen MT case
     switch (schneiderMassTransferCase) {                                                                                // Which MT Case prescription to use
@@ -1144,6 +1121,10 @@ double GiantBranch::CalculateRemnantMassBySchneider2020(const double p_COCoreMas
  *
  * Mandel & Mueller, 2020
  *
+ * The remnant mass is drawn from a truncated Gaussian, sampled by inverse transform (see
+ * Rand::TruncatedGaussianInverseCDF()) rather than by rejection, so the number of random numbers
+ * drawn is fixed.
+ *
  *
  * double CalculateRemnantMassByMullerMandel (const double p_COCoreMass, const double p_HeCoreMass)
  *
@@ -1176,27 +1157,23 @@ double GiantBranch::CalculateRemnantMassByMullerMandel(const double p_COCoreMass
 	    if (utils::Compare(RAND->Random(0, 1), pCompleteCollapse) < 0) {
 		    remnantMass = p_HeCoreMass;
         }
-	    else {
-		    while (remnantMass<MULLERMANDEL_MAXNS || remnantMass > (p_COCoreMass + p_HeCoreMass)) { 
-			    remnantMass = MULLERMANDEL_MUBH * p_COCoreMass + RAND->RandomGaussian(MULLERMANDEL_SIGMABH);
-		    }
+	    else {                                          // Gaussian truncated to [maximum NS mass, CO core mass + He core mass]
+		    remnantMass = RAND->RandomTruncatedGaussian(MULLERMANDEL_MUBH * p_COCoreMass, MULLERMANDEL_SIGMABH, MULLERMANDEL_MAXNS, p_COCoreMass + p_HeCoreMass);
 	    }
     }
-    else {                                              // this is an NS
+    else {                                              // this is an NS - Gaussian truncated to [minimum NS mass, min(maximum NS mass, CO core mass + He core mass)]
+        double maxNSMass = std::min(MULLERMANDEL_MAXNS, p_COCoreMass + p_HeCoreMass);
+
 	    if (utils::Compare(p_COCoreMass, MULLERMANDEL_M1) < 0) {
-		    while (remnantMass < MULLERMANDEL_MINNS || remnantMass > MULLERMANDEL_MAXNS || remnantMass > (p_COCoreMass + p_HeCoreMass)) {
-			    remnantMass = MULLERMANDEL_MU1 + RAND->RandomGaussian(MULLERMANDEL_SIGMA1);
-		    }
+            remnantMass = RAND->RandomTruncatedGaussian(MULLERMANDEL_MU1, MULLERMANDEL_SIGMA1, MULLERMANDEL_MINNS, maxNSMass);
 	    }
 	    else if (utils::Compare(p_COCoreMass, MULLERMANDEL_M2) < 0) {
-            while (remnantMass < MULLERMANDEL_MINNS || remnantMass > MULLERMANDEL_MAXNS || remnantMass > (p_COCoreMass + p_HeCoreMass)) {
-                remnantMass = MULLERMANDEL_MU2A + MULLERMANDEL_MU2B / (MULLERMANDEL_M2 - MULLERMANDEL_M1) * (p_COCoreMass - MULLERMANDEL_M1) + RAND->RandomGaussian(MULLERMANDEL_SIGMA2);
-            }
+            double mu = MULLERMANDEL_MU2A + MULLERMANDEL_MU2B / (MULLERMANDEL_M2 - MULLERMANDEL_M1) * (p_COCoreMass - MULLERMANDEL_M1);
+            remnantMass = RAND->RandomTruncatedGaussian(mu, MULLERMANDEL_SIGMA2, MULLERMANDEL_MINNS, maxNSMass);
         }
         else {
-            while (remnantMass < MULLERMANDEL_MINNS || remnantMass > MULLERMANDEL_MAXNS || remnantMass > (p_COCoreMass+p_HeCoreMass)) {
-                remnantMass = MULLERMANDEL_MU3A + MULLERMANDEL_MU3B / (MULLERMANDEL_M3 - MULLERMANDEL_M2) * (p_COCoreMass - MULLERMANDEL_M2) + RAND->RandomGaussian(MULLERMANDEL_SIGMA3);
-            }
+            double mu = MULLERMANDEL_MU3A + MULLERMANDEL_MU3B / (MULLERMANDEL_M3 - MULLERMANDEL_M2) * (p_COCoreMass - MULLERMANDEL_M2);
+            remnantMass = RAND->RandomTruncatedGaussian(mu, MULLERMANDEL_SIGMA3, MULLERMANDEL_MINNS, maxNSMass);
         }
     }
 
@@ -1540,6 +1517,8 @@ STELLAR_TYPE GiantBranch::ResolveCoreCollapseSN() {
     STELLAR_TYPE stellarType = m_StellarType;
     double mass = m_Mass;                                                                                   // initial mass
 
+    STELLAR_TYPE tabulatedStellarType = STELLAR_TYPE::NEUTRON_STAR;                                         // remnant type drawn from the remnant table (TABULATED prescription)
+
     switch (OPTIONS->RemnantMassPrescription()) {                                                           // which prescription?
 
         case REMNANT_MASS_PRESCRIPTION::HURLEY2000:                                                         // Hurley 2000
@@ -1583,6 +1562,20 @@ STELLAR_TYPE GiantBranch::ResolveCoreCollapseSN() {
             m_SupernovaDetails.fallbackFraction = 0.0;                                                      // TODO: sort out fallback - I think it should be 0
             break;
 
+        case REMNANT_MASS_PRESCRIPTION::TABULATED:                                                          // drawn from the remnant table
+
+            if (REMNANT_TABLE->HasMasses()) {
+                std::tie(tabulatedStellarType, m_Mass) = REMNANT_TABLE->DrawRemnant(m_COCoreMass, m_HeCoreMass, m_Metallicity, MassTransferCase(), RAND->Random(), RAND->Random());
+                m_Mass = std::min(m_Mass, mass);                                                            // remnant can't be more massive than the star
+            }
+            else {                                                                                          // no table, or no masses tabulated
+                m_Mass = 0.0;
+                m_Error = ERROR::INVALID_REMNANT_TABLE;                                                     // set error number
+                SHOW_ERROR(ERROR::INVALID_REMNANT_TABLE, "No remnant masses tabulated (see --remnant-table)"); // show error
+            }
+            m_SupernovaDetails.fallbackFraction = 0.0;                                                      // No subsequent kick adjustment by fallback fraction needed
+            break;
+
         default:                                                                                            // unknown prescription
 
             m_Mass                              = 0.0;
@@ -1602,6 +1595,12 @@ STELLAR_TYPE GiantBranch::ResolveCoreCollapseSN() {
         else
             stellarType = STELLAR_TYPE::NEUTRON_STAR;
     }
+    else if (OPTIONS->RemnantMassPrescription() == REMNANT_MASS_PRESCRIPTION::TABULATED) {
+        stellarType = tabulatedStellarType;
+        std::tie(m_Luminosity, m_Radius, m_Temperature) = stellarType == STELLAR_TYPE::BLACK_HOLE
+                                                            ? BH::CalculateCoreCollapseSNParams_Static(m_Mass)
+                                                            : NS::CalculateCoreCollapseSNParams_Static(m_Mass);
+    }
     else if (OPTIONS->RemnantMassPrescription() == REMNANT_MASS_PRESCRIPTION::HURLEY2000) {
         stellarType = (utils::Compare(m_Mass, 1.8 ) > 0) ? STELLAR_TYPE::BLACK_HOLE : STELLAR_TYPE::NEUTRON_STAR; //Hurley+ 2000, Eq. (92)
     }
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <zlib.h>
+
+#include "GzipStream.h"
+
+
+/*
+ * Constructor
+ *
+ *
+ * GzipStream()
+ */
+GzipStream::GzipStream() {
+    m_File      = nullptr;
+    m_BlockSize = 0;
+    m_Block     = "";
+    m_Queue.clear();
+    m_Stop      = false;
+    m_Good      = true;
+}
+
+
+/*
+ * Open the stream
+ *
+ * Creates the file (or opens it for appending - a gzip file with members appended is still a valid
+ * gzip file), and starts the background thread.
+ *
+ *
+ * bool Open(const std::string p_Filename, const bool p_Append, const size_t p_BlockSize)
+ *
+ * @param   [IN]    p_Filename                  Name of the file (including path and extension)
+ * @param   [IN]    p_Append                    Boolean indicating whether an existing file should be appended to
+ * @param   [IN]    p_BlockSize                 Uncompressed block size (bytes)
+ * @return                                      Boolean status - true = stream open; false = file not opened
+ */
+bool GzipStream::Open(const std::string p_Filename, const bool p_Append, const size_t p_BlockSize) {
+
+    if (IsOpen()) return false;                                                     // already open
+
+    m_File = std::fopen(p_Filename.c_str(), p_Append ? "ab" : "wb");
+    if (m_File == nullptr) return false;                                            // couldn't open file
+
+    m_BlockSize = std::max(p_BlockSize, (size_t)1);
+    m_Block.clear();
+    m_Block.reserve(m_BlockSize + 1024);                                            // room for the record that fills the block
+    m_Queue.clear();
+    m_Stop      = false;
+    m_Good      = true;
+
+    m_Thread = std::thread(&GzipStream::CompressBlocks, this);                      // start background thread
+
+    return true;
+}
+
+
+/*
+ * Close the stream
+ *
+ * Writes the partial block and any blocks waiting to be compressed, waits for the background
+ * thread to finish, and closes the file.
+ *
+ *
+ * bool Close()
+ *
+ * @return                                      Boolean status - true = all data written ok; false = write failed
+ */
+bool GzipStream::Close() {
+
+    if (!IsOpen()) return true;                                                     // nothing to do
+
+    (void)QueueBlock();                                                             // queue partial block
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;                                                              // stop background thread once queue is empty
+    }
+    m_QueueChanged.notify_all();
+
+    if (m_Thread.joinable()) m_Thread.join();                                       // wait for background thread
+
+    bool ok = m_Good;
+    if (std::fclose(m_File) != 0) ok = false;
+    m_File = nullptr;
+
+    return ok;
+}
+
+
+/*
+ * Flush the stream
+ *
+ * Hands the partial block to the background thread.  Does not wait for it to be written.
+ *
+ *
+ * bool Flush()
+ *
+ * @return                                      Boolean status - true = ok; false = write failed (earlier)
+ */
+bool GzipStream::Flush() {
+    return IsOpen() && QueueBlock();
+}
+
+
+/*
+ * Check stream status
+ *
+ *
+ * bool Good()
+ *
+ * @return                                      Boolean status - true = all writes to the file so far ok; false = a write failed
+ */
+bool GzipStream::Good() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Good;
+}
+
+
+/*
+ * Write a record to the stream
+ *
+ * Appends the record, and a newline, to the block being accumulated, and hands the block to the
+ * background thread if it is full.
+ *
+ *
+ * bool Write(const std::string& p_Record)
+ *
+ * @param   [IN]    p_Record                    The record to be written (without newline)
+ * @return                                      Boolean status - true = ok; false = write failed
+ */
+bool GzipStream::Write(const std::string& p_Record) {
+
+    if (!IsOpen()) return false;
+
+    m_Block += p_Record;
+    m_Block += '\n';
+
+    return m_Block.size() < m_BlockSize ? Good() : QueueBlock();
+}
+
+
+/*
+ * Hand the block being accumulated to the background thread
+ *
+ * Waits if GZIP_STREAM_MAX_QUEUED_BLOCKS blocks are already waiting.
+ *
+ *
+ * bool QueueBlock()
+ *
+ * @return                                      Boolean status - true = ok; false = write failed
+ */
+bool GzipStream::QueueBlock() {
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    if (!m_Good) {                                                                  // earlier write failed?
+        m_Block.clear();                                                            // yes - discard block
+        return false;
+    }
+    if (m_Block.empty()) return true;                                               // nothing to queue
+
+    m_QueueChanged.wait(lock, [this] { return m_Queue.size() < GZIP_STREAM_MAX_QUEUED_BLOCKS; });
+
+    m_Queue.push_back(std::move(m_Block));
+    m_Block = std::string();
+    m_Block.reserve(m_BlockSize + 1024);
+
+    lock.unlock();
+    m_QueueChanged.notify_all();
+
+    return true;
+}
+
+
+/*
+ * Background thread: compress and write the queued blocks
+ *
+ * Each block is compressed as a complete gzip member and appended to the file, which is then
+ * flushed.  Runs until m_Stop is set and the queue is empty.
+ *
+ *
+ * void CompressBlocks()
+ */
+void GzipStream::CompressBlocks() {
+
+    std::string compressed;
+
+    while (true) {
+
+        std::string block;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_QueueChanged.wait(lock, [this] { return m_Stop || !m_Queue.empty(); });
+            if (m_Queue.empty()) break;                                             // stopping, and nothing left to write
+
+            block = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        m_QueueChanged.notify_all();                                                // room in queue
+
+        bool ok = true;
+
+        z_stream zs;
+        zs.zalloc = Z_NULL;
+        zs.zfree  = Z_NULL;
+        zs.opaque = Z_NULL;
+        if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {     // windowBits 15 + 16: gzip wrapper
+            ok = false;
+        }
+        else {
+            compressed.resize(deflateBound(&zs, block.size()));
+
+            zs.next_in   = reinterpret_cast<Bytef*>(&block[0]);
+            zs.avail_in  = static_cast<uInt>(block.size());
+            zs.next_out  = reinterpret_cast<Bytef*>(&compressed[0]);
+            zs.avail_out = static_cast<uInt>(compressed.size());
+
+            ok = deflate(&zs, Z_FINISH) == Z_STREAM_END;                            // output buffer is deflateBound() - one call is enough
+            size_t nBytes = compressed.size() - zs.avail_out;
+            (void)deflateEnd(&zs);
+
+            if (ok) ok = std::fwrite(compressed.data(), 1, nBytes, m_File) == nBytes && std::fflush(m_File) == 0;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (!ok) m_Good = false;
+        }
+    }
+}
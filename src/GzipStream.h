@@ -0,0 +1,75 @@
+#ifndef __GzipStream_h__
+#define __GzipStream_h__
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+
+/*
+ * GzipStream - streaming gzip compressed output file
+ *
+ * Used by the logging service for CSV, TSV, and TXT standard logfiles when program option
+ * --logfile-compression is GZIP.
+ *
+ * Records written to the stream are accumulated in a block in memory.  When the block reaches
+ * p_BlockSize bytes it is handed to a background thread, which compresses it as a complete gzip
+ * member, appends it to the file, and flushes the file - so the main thread does not wait for the
+ * compression, and the file is readable (by gunzip, zcat, python's gzip module, pandas etc., all
+ * of which read multi-member gzip files) up to the last block written, even if the run crashes.
+ * Flush() hands a partial block to the background thread; Close() writes any outstanding blocks and
+ * waits for the background thread to finish.
+ *
+ * The number of blocks waiting to be compressed is limited (GZIP_STREAM_MAX_QUEUED_BLOCKS) - if the
+ * background thread falls behind, Write() waits for it.
+ *
+ * Errors are sticky: once a write to the file fails, Good() returns false and all subsequent writes
+ * fail.
+ */
+
+class GzipStream {
+
+public:
+
+    GzipStream();
+    ~GzipStream()                                                                   { (void)Close(); }
+
+    GzipStream(const GzipStream&) = delete;                                         // not copyable (owns a thread)
+    GzipStream& operator = (const GzipStream&) = delete;
+
+
+    // member functions
+    bool        Close();
+    bool        Flush();
+    bool        Good();
+    bool        IsOpen() const                                                      { return m_File != nullptr; }
+    bool        Open(const std::string p_Filename, const bool p_Append, const size_t p_BlockSize);
+    bool        Write(const std::string& p_Record);
+
+
+private:
+
+    static const size_t GZIP_STREAM_MAX_QUEUED_BLOCKS = 4;                          // maximum number of blocks waiting to be compressed
+
+    void        CompressBlocks();
+    bool        QueueBlock();
+
+
+    std::FILE*              m_File;                                                 // the output file
+    size_t                  m_BlockSize;                                            // uncompressed block size (bytes)
+    std::string             m_Block;                                                // block being accumulated
+
+    std::deque<std::string> m_Queue;                                                // blocks waiting to be compressed
+    bool                    m_Stop;                                                 // true when the background thread should stop (once the queue is empty)
+    bool                    m_Good;                                                 // false once a write to the file has failed
+
+    std::mutex              m_Mutex;                                                // protects m_Queue, m_Stop, and m_Good
+    std::condition_variable m_QueueChanged;                                         // signalled when a block is added to or removed from the queue
+
+    std::thread             m_Thread;                                               // background (compression) thread
+};
+
+#endif // __GzipStream_h__
@@ -0,0 +1,203 @@
+#include "Histogram.h"
+#include "Log.h"
+
+
+/*
+ * Constructor
+ *
+ * The properties retrieved for each record are the histogram property, the metallicity, the importance
+ * sampling weight (binary logfiles only), and the filter properties, in that order.
+ *
+ *
+ * Histogram(const std::string                  p_Name,
+ *           const LOGFILE                      p_Logfile,
+ *           const T_ANY_PROPERTY               p_Property,
+ *           const std::string                  p_Header,
+ *           const std::string                  p_Units,
+ *           const HISTOGRAM_BINNING            p_Binning,
+ *           const double                       p_Min,
+ *           const double                       p_Max,
+ *           const int                          p_nBins,
+ *           const std::vector<PropertyFilterT> p_Filters)
+ *
+ * @param   [IN]    p_Name                      Histogram name (summary table name without prefix)
+ * @param   [IN]    p_Logfile                   Logfile whose records are counted
+ * @param   [IN]    p_Property                  Histogram property
+ * @param   [IN]    p_Header                    Header string of the histogram property
+ * @param   [IN]    p_Units                     Units string of the histogram property
+ * @param   [IN]    p_Binning                   Binning of the histogram property
+ * @param   [IN]    p_Min                       Lower edge of the first bin (ignored for INTEGER binning)
+ * @param   [IN]    p_Max                       Upper edge of the last bin (ignored for INTEGER binning)
+ * @param   [IN]    p_nBins                     Number of bins between p_Min and p_Max (ignored for INTEGER binning)
+ * @param   [IN]    p_Filters                   Filter terms
+ */
+Histogram::Histogram(const std::string                  p_Name,
+                     const LOGFILE                      p_Logfile,
+                     const T_ANY_PROPERTY               p_Property,
+                     const std::string                  p_Header,
+                     const std::string                  p_Units,
+                     const HISTOGRAM_BINNING            p_Binning,
+                     const double                       p_Min,
+                     const double                       p_Max,
+                     const int                          p_nBins,
+                     const std::vector<PropertyFilterT> p_Filters) {
+
+    m_Name     = p_Name;
+    m_Logfile  = p_Logfile;
+    m_Header   = p_Header;
+    m_Units    = p_Units;
+    m_Binning  = p_Binning;
+    m_Min      = p_Min;
+    m_Max      = p_Max;
+    m_nBins    = p_nBins;
+    m_Filters  = p_Filters;
+
+    m_Weighted = std::get<4>(LOGFILE_DESCRIPTOR.at(p_Logfile)) == LOGFILE_TYPE::BINARY;        // only binaries carry an importance sampling weight
+
+    m_Properties = { p_Property };
+    if (m_Weighted) {
+        m_Properties.push_back(STAR_1_PROPERTY::METALLICITY);
+        m_Properties.push_back(BINARY_PROPERTY::IMPORTANCE_WEIGHT);
+    }
+    else {
+        m_Properties.push_back(STAR_PROPERTY::METALLICITY);
+    }
+    for (auto& filter: m_Filters) m_Properties.push_back(filter.property);
+
+    m_nCounted = 0;
+    m_Bins.clear();
+}
+
+
+/*
+ * Determine the bin of a property value
+ *
+ * Bin -1 is the underflow bin, and bin m_nBins the overflow bin (LINEAR and LOG binning).
+ * For INTEGER binning the bin is the value rounded to the nearest integer.
+ *
+ *
+ * long int ValueBin(const double p_Value) const
+ *
+ * @param   [IN]    p_Value                     Property value (not NaN)
+ * @return                                      Bin number
+ */
+long int Histogram::ValueBin(const double p_Value) const {
+
+    if (m_Binning == HISTOGRAM_BINNING::INTEGER) return std::lround(p_Value);
+
+    double x, xMin, xMax;
+    if (m_Binning == HISTOGRAM_BINNING::LOG) {
+        if (p_Value <= 0.0) return -1L;                                                         // underflow
+        x    = std::log10(p_Value);
+        xMin = std::log10(m_Min);
+        xMax = std::log10(m_Max);
+    }
+    else {
+        x    = p_Value;
+        xMin = m_Min;
+        xMax = m_Max;
+    }
+
+    if (x <  xMin) return -1L;                                                                  // underflow
+    if (x >= xMax) return (long int)m_nBins;                                                    // overflow
+
+    return std::min((long int)std::floor((x - xMin) / (xMax - xMin) * (double)m_nBins), (long int)m_nBins - 1L);
+}
+
+
+/*
+ * Add a record to the histogram
+ *
+ *
+ * void Add(const DBL_VECTOR& p_Values)
+ *
+ * @param   [IN]    p_Values                    Values of the properties returned by Properties(), in the same order
+ */
+void Histogram::Add(const DBL_VECTOR& p_Values) {
+
+    if (p_Values.size() != m_Properties.size()) return;                                         // shouldn't happen
+
+    size_t filterIdx = m_Weighted ? 3 : 2;                                                      // index of first filter value
+    for (size_t idx = 0; idx < m_Filters.size(); idx++) {
+        if (!utils::FilterPasses(m_Filters[idx], p_Values[filterIdx + idx])) return;            // record filtered out
+    }
+
+    double value       = p_Values[0];
+    double metallicity = p_Values[1];
+    double weight      = m_Weighted ? p_Values[2] : 1.0;
+
+    if (std::isnan(value) || std::isnan(metallicity) || metallicity <= 0.0) return;             // can't bin
+
+    long int zBin = (long int)std::floor(std::log10(metallicity) / STAR_FORMING_MASS_LOG_Z_BIN_WIDTH);
+
+    BinT& bin = m_Bins.emplace(std::make_pair(zBin, ValueBin(value)), BinT{0, 0.0}).first->second; // get bin (create if necessary)
+    bin.count++;
+    bin.weight += weight;
+
+    m_nCounted++;
+}
+
+
+/*
+ * Write the histogram summary table to the output container
+ *
+ * One row per non-empty bin, in order of increasing metallicity, then increasing property value.
+ * The underflow and overflow bins have lower and upper edges of -inf (0 for LOG binning) and +inf
+ * respectively.
+ *
+ *
+ * bool Write() const
+ *
+ * @return                                      Boolean status - true = table written ok; false = write failed
+ */
+bool Histogram::Write() const {
+
+    SummaryTableColumnT zBinMin   = { "Metallicity_Bin_Min",  "-",     TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT zBinMax   = { "Metallicity_Bin_Max",  "-",     TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT valBinMin = { m_Header + "_Bin_Min",  m_Units, TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT valBinMax = { m_Header + "_Bin_Max",  m_Units, TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT value     = { m_Header,               m_Units, TYPENAME::INT,      {} };
+    SummaryTableColumnT count     = { "Count",                "-",     TYPENAME::ULONGINT, {} };
+    SummaryTableColumnT weighted  = { "Weighted_Count",       "-",     TYPENAME::DOUBLE,   {} };
+
+    double xMin = m_Binning == HISTOGRAM_BINNING::LOG ? std::log10(m_Min) : m_Min;
+    double xMax = m_Binning == HISTOGRAM_BINNING::LOG ? std::log10(m_Max) : m_Max;
+    double dx   = (xMax - xMin) / (double)m_nBins;
+
+    for (auto& iter: m_Bins) {                                                                  // std::map - ordered by key (so metallicity, then value)
+
+        long int zBin   = iter.first.first;
+        long int valBin = iter.first.second;
+
+        zBinMin.values.push_back(PPOW(10.0, (double)zBin * STAR_FORMING_MASS_LOG_Z_BIN_WIDTH));
+        zBinMax.values.push_back(PPOW(10.0, (double)(zBin + 1) * STAR_FORMING_MASS_LOG_Z_BIN_WIDTH));
+
+        if (m_Binning == HISTOGRAM_BINNING::INTEGER) {
+            value.values.push_back((int)valBin);
+        }
+        else {
+            double lo, hi;
+            if      (valBin < 0)                   { lo = -std::numeric_limits<double>::infinity(); hi = xMin; }
+            else if (valBin >= (long int)m_nBins)  { lo = xMax; hi = std::numeric_limits<double>::infinity(); }
+            else                                   { lo = xMin + (double)valBin * dx; hi = lo + dx; }
+
+            if (m_Binning == HISTOGRAM_BINNING::LOG) {                                          // convert edges back from log10
+                lo = PPOW(10.0, lo);                                                            // 10^-inf = 0
+                hi = PPOW(10.0, hi);
+            }
+            valBinMin.values.push_back(lo);
+            valBinMax.values.push_back(hi);
+        }
+
+        count.values.push_back(iter.second.count);
+        weighted.values.push_back(iter.second.weight);
+    }
+
+    std::vector<SummaryTableColumnT> columns = { zBinMin, zBinMax };
+    if (m_Binning == HISTOGRAM_BINNING::INTEGER) columns.push_back(value);
+    else                                         { columns.push_back(valBinMin); columns.push_back(valBinMax); }
+    columns.push_back(count);
+    columns.push_back(weighted);
+
+    return LOGGING->WriteSummaryTable(HISTOGRAM_FILE_NAME_PREFIX + m_Name, columns);
+}
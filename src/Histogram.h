@@ -0,0 +1,91 @@
+#ifndef __Histogram_h__
+#define __Histogram_h__
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+/*
+ * Histogram - online aggregation sink for a standard logfile
+ *
+ * A histogram is attached to one of the standard logfiles (see program option --histogram).  Each time
+ * a record is produced for that logfile (e.g. by PrintDoubleCompactObjects()), the values of the
+ * histogram property, the metallicity, the importance sampling weight (binary logfiles only - 1 for
+ * stellar logfiles), and any filter properties are retrieved from the object being logged and passed
+ * to Add().  If the record satisfies all filter terms it is counted in the bin of its property value,
+ * in the log10(Z) bin (of width STAR_FORMING_MASS_LOG_Z_BIN_WIDTH dex, the same bins as the star-forming
+ * mass summary) of its metallicity.
+ *
+ * Property values are binned:
+ *
+ *     LINEAR : nBins bins of equal width between min and max
+ *     LOG    : nBins bins of equal width in log10(value) between min and max (min > 0)
+ *     INTEGER: one bin per integer value (e.g. stellar types) - min, max, and nBins are not used
+ *
+ * Values below min (or <= 0 for LOG binning) are counted in an underflow bin, and values at or above
+ * max in an overflow bin.  Records for which the property value is not a number are not counted.
+ *
+ * Only bins with at least one entry are stored, and written (at the end of the run) to a summary table
+ * named HISTOGRAM_FILE_NAME_PREFIX + name: one row per (metallicity bin, value bin), with the count and
+ * the sum of the weights of the records in the bin.
+ */
+
+class Histogram {
+
+public:
+
+    Histogram(const std::string                  p_Name,
+              const LOGFILE                      p_Logfile,
+              const T_ANY_PROPERTY               p_Property,
+              const std::string                  p_Header,
+              const std::string                  p_Units,
+              const HISTOGRAM_BINNING            p_Binning,
+              const double                       p_Min,
+              const double                       p_Max,
+              const int                          p_nBins,
+              const std::vector<PropertyFilterT> p_Filters);
+
+
+    // getters
+    LOGFILE                     Logfile() const                                     { return m_Logfile; }
+    const ANY_PROPERTY_VECTOR&  Properties() const                                  { return m_Properties; }
+    size_t                      nCounted() const                                    { return m_nCounted; }
+
+
+    // member functions
+    void        Add(const DBL_VECTOR& p_Values);
+    bool        Write() const;
+
+
+private:
+
+    typedef struct Bin {
+        unsigned long int count;                                                                // number of records in bin
+        double            weight;                                                               // sum of weights of records in bin
+    } BinT;
+
+    long int    ValueBin(const double p_Value) const;
+
+
+    std::string                  m_Name;                                                        // histogram name (summary table name without prefix)
+    LOGFILE                      m_Logfile;                                                     // logfile whose records are counted
+
+    std::string                  m_Header;                                                      // header string of the histogram property
+    std::string                  m_Units;                                                       // units string of the histogram property
+
+    HISTOGRAM_BINNING            m_Binning;                                                     // binning of the histogram property
+    double                       m_Min;                                                         // lower edge of the first bin (LINEAR and LOG binning)
+    double                       m_Max;                                                         // upper edge of the last bin (LINEAR and LOG binning)
+    int                          m_nBins;                                                       // number of bins between m_Min and m_Max (LINEAR and LOG binning)
+
+    std::vector<PropertyFilterT> m_Filters;                                                     // filter terms - all must be satisfied for a record to be counted
+
+    ANY_PROPERTY_VECTOR          m_Properties;                                                  // properties retrieved for each record: value, metallicity, [weight,] filter properties
+    bool                         m_Weighted;                                                    // true if m_Properties includes the weight
+
+    size_t                       m_nCounted;                                                    // number of records counted
+
+    std::map<std::pair<long int, long int>, BinT> m_Bins;                                       // bins, keyed by (metallicity bin, value bin)
+};
+
+#endif // __Histogram_h__
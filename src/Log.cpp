@@ -6,7 +6,16 @@
 // JR: todo: move error/warning strings to error catalogue in constants.h
 // JR: todo: clean up use of Squawk() vs SAY() etc
 
+#if defined(__linux__)
+#include <fcntl.h>                                                                      // reflinks (see Log::ReflinkFile())
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/fs.h>
+#endif
+
 #include "Log.h"
+#include "Errors.h"
+#include "BaseStar.h"
 
 Log* Log::m_Instance = nullptr;
 
@@ -273,6 +282,8 @@ void Log::Start(const string              p_LogBasePath,
         m_LogClasses    = p_LogClasses;                                                                                     // set enabled log classes
         m_DbgLevel      = p_DbgLevel;                                                                                       // set debug level
         m_DbgClasses    = p_DbgClasses;                                                                                     // set enagled debug classes
+        m_LogClassMask  = ClassMask(m_LogClasses);                                                                          // enabled log classes bitmask
+        m_DbgClassMask  = ClassMask(m_DbgClasses);                                                                          // enabled debug classes bitmask
         m_DbgToLogfile  = p_DbgToLogfile;                                                                                   // write debug records to logfile?
         m_ErrToLogfile  = p_ErrorsToLogfile;                                                                                // write error records to logfile?
         m_LogfileType   = p_LogfileType;                                                                                    // set log file type
@@ -282,6 +293,9 @@ void Log::Start(const string              p_LogBasePath,
         m_OptionDetails = OPTIONS->CmdLineOptionsDetails();                                                                 // get commandline option details
 
         m_Enabled = UpdateAllLogfileRecordSpecs();                                                                          // update all logfile record specifications - disable logging upon failure
+        if (m_Enabled) m_Enabled = ConfigureHistograms();                                                                  // configure histograms - disable logging upon failure
+        if (m_Enabled) m_Enabled = ConfigureLogfileFilters();                                                              // configure logfile filters - disable logging upon failure
+        if (m_Enabled) m_Enabled = ConfigureHDF5Precision();                                                               // configure HDF5 column precision - disable logging upon failure
 
         if (m_Enabled) {                                                                                                    // still ok?
                                                                                                                             // yes
@@ -391,32 +405,23 @@ void Log::Start(const string              p_LogBasePath,
             }
 
             // store input files if required
-            // use Boost to do the copy - copy_file() is available in standard c++17
-            if (OPTIONS->StoreInputFiles()) {                                                                               // user wants input files stored in output container?
+            if (m_Enabled && OPTIONS->StoreInputFiles()) {                                                                  // user wants input files stored in output container?
                                                                                                                             // yes
                 string dstPath = m_LogBasePath + "/" + m_LogContainerName + "/";                                            // destination path (output container)
                 if (!OPTIONS->GridFilename().empty()) {                                                                     // user specified a grid file?
-                    try {                                                                                                   // yes - copy it
-                        boost::filesystem::path srcPath(OPTIONS->GridFilename());                                           // grid file fully-qualified name
-                        string dstFn = dstPath + srcPath.filename().string();                                               // fully-qualified grid filename (inside container)
-                        boost::filesystem::copy_file(OPTIONS->GridFilename(), dstFn, boost::filesystem::copy_option::overwrite_if_exists); // copy grid file - overwrite any existing file (shouldn't be one, but just in case we want this one)
-                    } catch(const boost::filesystem::filesystem_error& e) {
-                        Squawk("ERROR: Unable to copy grid file " + OPTIONS->GridFilename() + " to output container " + dstPath); // announce error
-                        m_Enabled = false;                                                                                  // fail
-                    }
+                    m_Enabled = StoreInputFile(OPTIONS->GridFilename(), "grid file", dstPath);                              // yes - store it
                 }
 
-                // if the user specified a logfile-definitions file, copy it to the output container
+                // if the user specified a logfile-definitions file, store it in the output container
 
                 if (m_Enabled && !OPTIONS->LogfileDefinitionsFilename().empty()) {                                          // user specified a logfile-definitions file?
-                    try {                                                                                                   // yes - copy it
-                        boost::filesystem::path srcPath(OPTIONS->LogfileDefinitionsFilename());                             // logfile-definitions file fully-qualified name
-                        string dstFn = dstPath + srcPath.filename().string();                                               // fully-qualified logfile-definitions filename (inside container)
-                        boost::filesystem::copy_file(OPTIONS->LogfileDefinitionsFilename(), dstFn, boost::filesystem::copy_option::overwrite_if_exists); // copy logfile-definitions file - overwrite any existing file (shouldn't be one, but just in case we want this one)
-                    } catch(const boost::filesystem::filesystem_error& e) {
-                        Squawk("ERROR: Unable to copy logfile-definitions file " + OPTIONS->LogfileDefinitionsFilename() + " to output container " + dstPath); // announce error
-                        m_Enabled = false;                                                                                  // fail
-                    }
+                    m_Enabled = StoreInputFile(OPTIONS->LogfileDefinitionsFilename(), "logfile-definitions file", dstPath); // yes - store it
+                }
+
+                // if the user specified a remnant table, store it in the output container
+
+                if (m_Enabled && !OPTIONS->RemnantTableFilename().empty()) {                                                // user specified a remnant table?
+                    m_Enabled = StoreInputFile(OPTIONS->RemnantTableFilename(), "remnant table", dstPath);                  // yes - store it
                 }
             }
         }
@@ -424,6 +429,137 @@ void Log::Start(const string              p_LogBasePath,
 }
 
 
+/*
+ * Store an input file in the output container
+ *
+ * How the file is stored is determined by program option --store-input-files-mode:
+ *
+ *    COPY      : the file is copied into the output container
+ *    REFLINK   : the file is cloned into the output container (a copy-on-write copy that shares the
+ *                data blocks of the original, so takes no time or space) - where the filesystem supports
+ *                it (e.g. Btrfs, XFS; Linux only), otherwise the file is copied
+ *    HARDLINK  : a hard link to the file is created in the output container - where possible (the output
+ *                container must be on the same filesystem as the file), otherwise the file is copied
+ *    REFERENCE : the file is not stored - a reference to the file is written to the output container instead:
+ *                a file named for the input file with '.sha256' appended, containing the SHA-256 digest of
+ *                the file and its absolute path (in the format written by sha256sum, so the input file can be
+ *                checked against the reference with 'sha256sum -c')
+ *    AUTO      : REFLINK if possible, else HARDLINK if possible, else COPY
+ *
+ * Note that a hard link is the same file as the original, so if the original is later modified in place the
+ * file in the output container is modified too (a reflink is an independent copy).
+ *
+ * Any existing file of the same name in the output container is overwritten (there shouldn't be one, but just
+ * in case we want this one).
+ *
+ *
+ * bool StoreInputFile(const string p_Filename, const string p_Description, const string p_DstPath)
+ *
+ * @param   [IN]    p_Filename                  Filename of the input file
+ * @param   [IN]    p_Description               Description of the input file (for error messages)
+ * @param   [IN]    p_DstPath                   Destination path (the output container, with trailing '/')
+ * @return                                      Boolean status - true = stored ok; false = failed (error announced)
+ */
+bool Log::StoreInputFile(const string p_Filename, const string p_Description, const string p_DstPath) {
+
+    boost::filesystem::path srcPath(p_Filename);                                                                            // input file fully-qualified name
+    string dstFn = p_DstPath + srcPath.filename().string();                                                                 // fully-qualified filename (inside container)
+
+    STORE_INPUT_FILES_MODE mode = OPTIONS->StoreInputFilesMode();
+
+    if (mode == STORE_INPUT_FILES_MODE::REFERENCE) {                                                                        // store reference only?
+                                                                                                                            // yes
+        ERROR  error;
+        string digest;
+        std::tie(error, digest) = utils::FileSHA256(p_Filename);                                                            // digest the file
+        if (error != ERROR::NONE) {                                                                                         // ok?
+            Squawk("ERROR: Unable to calculate SHA-256 digest of " + p_Description + " " + p_Filename + ": " + ERR_MSG(error)); // no - announce error
+            return false;                                                                                                   // fail
+        }
+
+        boost::system::error_code err;
+        boost::filesystem::path absPath = boost::filesystem::canonical(srcPath, err);                                       // absolute path of the file, symlinks resolved
+        if (err) absPath = boost::filesystem::absolute(srcPath);                                                            // shouldn't happen (we just read it) - but just in case
+
+        std::ofstream refFile(dstFn + ".sha256", std::ios::out | std::ios::trunc);                                          // create reference file
+        refFile << digest << "  " << absPath.string() << "\n";                                                              // sha256sum format
+        refFile.close();
+        if (refFile.fail()) {                                                                                               // ok?
+            Squawk("ERROR: Unable to write reference to " + p_Description + " " + p_Filename + " to output container " + p_DstPath); // no - announce error
+            return false;                                                                                                   // fail
+        }
+        return true;
+    }
+
+    boost::system::error_code err;
+    boost::filesystem::remove(dstFn, err);                                                                                  // remove any existing file (links and clones need a new file) - ignore errors
+
+    if (mode == STORE_INPUT_FILES_MODE::REFLINK || mode == STORE_INPUT_FILES_MODE::AUTO) {                                  // clone?
+        if (ReflinkFile(p_Filename, dstFn)) return true;                                                                    // yes - done if cloned
+    }
+
+    if (mode == STORE_INPUT_FILES_MODE::HARDLINK || mode == STORE_INPUT_FILES_MODE::AUTO) {                                 // hard link?
+        boost::filesystem::create_hard_link(srcPath, dstFn, err);                                                           // yes - create it
+        if (!err) return true;                                                                                              // done if linked
+    }
+
+    if (mode == STORE_INPUT_FILES_MODE::REFLINK || mode == STORE_INPUT_FILES_MODE::HARDLINK) {                              // fallback to copy?
+        Squawk("WARNING: Unable to " + string(mode == STORE_INPUT_FILES_MODE::REFLINK ? "clone" : "hard link") + " " + p_Description + " " + p_Filename + " in output container " + p_DstPath + " - copying instead"); // yes - announce warning
+    }
+
+    // use Boost to do the copy - copy_file() is available in standard c++17
+    try {
+        boost::filesystem::copy_file(p_Filename, dstFn, boost::filesystem::copy_option::overwrite_if_exists);              // copy file - overwrite any existing file
+    } catch(const boost::filesystem::filesystem_error& e) {
+        Squawk("ERROR: Unable to copy " + p_Description + " " + p_Filename + " to output container " + p_DstPath);          // announce error
+        return false;                                                                                                       // fail
+    }
+
+    return true;
+}
+
+
+/*
+ * Clone a file (create a reflink)
+ *
+ * Creates p_DstFilename as a copy-on-write clone of p_SrcFilename (ioctl FICLONE): the clone
+ * shares the data blocks of the source file until either is modified, so no data is copied.
+ * Only some filesystems support clones (e.g. Btrfs, XFS), and the source and destination must
+ * be on the same filesystem.  Always fails on systems other than Linux.
+ *
+ * If the clone cannot be created p_DstFilename is removed.
+ *
+ *
+ * bool ReflinkFile(const string p_SrcFilename, const string p_DstFilename)
+ *
+ * @param   [IN]    p_SrcFilename               Filename of the file to be cloned
+ * @param   [IN]    p_DstFilename               Filename of the clone - must not exist
+ * @return                                      Boolean status - true = cloned ok; false = not cloned
+ */
+bool Log::ReflinkFile(const string p_SrcFilename, const string p_DstFilename) {
+
+    bool ok = false;
+
+#if defined(__linux__) && defined(FICLONE)
+    int srcFd = open(p_SrcFilename.c_str(), O_RDONLY);
+    if (srcFd >= 0) {
+        int dstFd = open(p_DstFilename.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (dstFd >= 0) {
+            ok = ioctl(dstFd, FICLONE, srcFd) == 0;
+            ok = (close(dstFd) == 0) && ok;
+            if (!ok) (void)unlink(p_DstFilename.c_str());                                                                   // remove the empty file
+        }
+        (void)close(srcFd);
+    }
+#else
+    (void)p_SrcFilename;
+    (void)p_DstFilename;
+#endif
+
+    return ok;
+}
+
+
 /*
  * Stop logging
  *
@@ -443,6 +579,10 @@ void Log::Stop(std::tuple<int, int> p_ObjectStats) {
 
     if (m_Enabled) {                                                                                                                    // only need to do most of this if logging is enabled 
 
+        (void)WriteHistograms();                                                                                                        // write any histograms not yet written - errors are announced
+        (void)WriteEvolutionOutcomes();                                                                                                 // write the evolution outcomes if not yet written - errors are announced
+        m_StagedRecords.clear();                                                                                                        // discard any staged records not yet released
+
         // get some run stats
      
         double cpuSeconds = (clock() - m_ClockStart) / (double) CLOCKS_PER_SEC;                                                         // stop CPU timer and calculate seconds
@@ -469,6 +609,17 @@ void Log::Stop(std::tuple<int, int> p_ObjectStats) {
 
         unsigned long int actualRandomSeed = OPTIONS->FixedRandomSeedCmdLine() ? OPTIONS->RandomSeedCmdLine() : RAND->DefaultSeed();    // actual random seed used
 
+        // memory footprint - peak values (bytes where applicable)
+
+        std::size_t rss;
+        std::size_t peakRSS;
+        std::tie(rss, peakRSS) = utils::ResidentSetSize();                                                                              // resident set size (bytes)
+
+        unsigned long int peakHDF5Buffered        = m_HDF5BufferedBytesPeak;                                                            // peak bytes held in HDF5 write buffers
+        unsigned long int peakHDF5DatasetBuffered = m_HDF5DatasetBufferedBytesPeak;                                                     // peak bytes held in the write buffer of a single dataset
+        unsigned long int peakErrorCatalog        = ERRORS->CatalogEntriesPeak();                                                       // peak number of error catalog entries
+        unsigned long int peakLiveStars           = BaseStar::LiveStarsPeak();                                                          // peak number of live star objects
+
         // update run details file
 
         if (m_LogfileType == LOGFILETYPE::HDF5) {                                                                                       // logging to HDF5 files?
@@ -536,6 +687,30 @@ void Log::Stop(std::tuple<int, int> p_ObjectStats) {
                             m_Run_Details_H5_File.dataSets[dSetIdx].buf.push_back(actualRandomSeed);                                    // add write data to buffer
                             break;
 
+                        case RUN_DETAILS_COLUMNS::PEAK_RSS:                                                                             // Peak_RSS (bytes)
+                            m_Run_Details_H5_File.dataSets[dSetIdx].buf.push_back((unsigned long int)peakRSS);                          // add write data to buffer
+                            break;
+
+                        case RUN_DETAILS_COLUMNS::PEAK_HDF5_BUFFERED:                                                                   // Peak_HDF5_Buffered (bytes)
+                            m_Run_Details_H5_File.dataSets[dSetIdx].buf.push_back(peakHDF5Buffered);                                    // add write data to buffer
+                            break;
+
+                        case RUN_DETAILS_COLUMNS::PEAK_HDF5_DATASET_BUFFERED:                                                           // Peak_HDF5_Dataset_Buffered (bytes)
+                            m_Run_Details_H5_File.dataSets[dSetIdx].buf.push_back(peakHDF5DatasetBuffered);                             // add write data to buffer
+                            break;
+
+                        case RUN_DETAILS_COLUMNS::PEAK_ERROR_CATALOG_ENTRIES:                                                           // Peak_Error_Catalog_Entries
+                            m_Run_Details_H5_File.dataSets[dSetIdx].buf.push_back(peakErrorCatalog);                                    // add write data to buffer
+                            break;
+
+                        case RUN_DETAILS_COLUMNS::PEAK_LIVE_STARS:                                                                      // Peak_Live_Stars
+                            m_Run_Details_H5_File.dataSets[dSetIdx].buf.push_back(peakLiveStars);                                       // add write data to buffer
+                            break;
+
+                        case RUN_DETAILS_COLUMNS::MEMORY_BUDGET_FLUSHES:                                                                // Memory_Budget_Flushes
+                            m_Run_Details_H5_File.dataSets[dSetIdx].buf.push_back(m_MemoryBudgetFlushes);                               // add write data to buffer
+                            break;
+
                         default:                                                                                                        // unknown dataset - how did that happen?
                             Squawk("ERROR: Invalid HDF5 dataset with name " + h5DatasetName);                                           // announce error
                             ok = false;                                                                                                 // fail
@@ -646,6 +821,13 @@ void Log::Stop(std::tuple<int, int> p_ObjectStats) {
 
             m_RunDetailsFile << "Wall time  = " << wallTime << " (hhhh:mm:ss)" << std::endl;                                            // wall time 
 
+            m_RunDetailsFile << "\nPeak RSS                   = " << peakRSS << " bytes" << std::endl;                                  // memory footprint
+            m_RunDetailsFile << "Peak HDF5 buffered         = " << peakHDF5Buffered << " bytes" << std::endl;
+            m_RunDetailsFile << "Peak HDF5 dataset buffered = " << peakHDF5DatasetBuffered << " bytes" << std::endl;
+            m_RunDetailsFile << "Peak error catalog entries = " << peakErrorCatalog << std::endl;
+            m_RunDetailsFile << "Peak live stars            = " << peakLiveStars << std::endl;
+            m_RunDetailsFile << "Memory budget flushes      = " << m_MemoryBudgetFlushes << std::endl;
+
             // add commandline options
             // moved this code here from Options.cpp
             // have to add a small kludge here to get it to look the same (someone might be relying on format)
@@ -708,7 +890,12 @@ void Log::Stop(std::tuple<int, int> p_ObjectStats) {
         CloseAllStandardFiles();                                                                                                        // close all standard log files
         for(unsigned int index = 0; index < m_Logfiles.size(); index++) {                                                               // check for open logfiles (even if not active)
             if (IsActiveId(index)) {                                                                                                    // logfile active?
-                if (m_Logfiles[index].file.is_open()) {                                                                                 // open file?
+                if (m_Logfiles[index].gzFile) {                                                                                         // compressed stream?
+                    if (!m_Logfiles[index].gzFile->Close()) {                                                                           // yes - write outstanding blocks and close - ok?
+                        Squawk("ERROR: Unable to close log file with file name " + m_Logfiles[index].name);                             // no - announce error
+                    }
+                }
+                else if (m_Logfiles[index].file.is_open()) {                                                                            // open file?
                     try {                                                                                                               // yes
                         m_Logfiles[index].file.flush();                                                                                 // flush output and
                         m_Logfiles[index].file.close();                                                                                 // close it
@@ -727,6 +914,134 @@ void Log::Stop(std::tuple<int, int> p_ObjectStats) {
 }
 
 
+/*
+ * Write a summary table to the output container
+ *
+ * Summary tables are small tables (typically a few hundred rows at most) constructed in memory
+ * during the run and written in one go at the end of the run - they are not standard logfiles
+ * and do not use the logfile record specifications.
+ *
+ * If the logfile type is HDF5 the table is written as a group in the HDF5 container file, with
+ * one dataset per column (each with a "units" attribute).  Otherwise the table is written as a
+ * file in the output container, with the same file extension, delimiter, and header lines (types,
+ * units, and column headers) as the standard logfiles.
+ *
+ *
+ * bool WriteSummaryTable(const string p_TableName, const std::vector<SummaryTableColumnT> p_Columns)
+ *
+ * @param   [IN]    p_TableName                 The name of the table (HDF5 group name, or filename without prefix and extension)
+ * @param   [IN]    p_Columns                   The columns of the table (all columns should have the same number of values)
+ * @return                                      Boolean status - true = table written ok; false = write failed
+ */
+bool Log::WriteSummaryTable(const string p_TableName, const std::vector<SummaryTableColumnT> p_Columns) {
+
+    if (!m_Enabled) return false;                                                                                   // logging not enabled - no business being here
+
+    bool ok = true;                                                                                                 // return value
+
+    size_t nRows = p_Columns.empty() ? 0 : p_Columns[0].values.size();                                              // number of rows in table
+
+    if (m_LogfileType == LOGFILETYPE::HDF5) {                                                                       // HDF5 logfiles?
+                                                                                                                    // yes - write group to HDF5 container
+        string h5GroupName = p_TableName;                                                                           // HDF5 group name for table
+        h5GroupName        = utils::trim(h5GroupName);                                                              // remove leading and trailing blanks
+
+        hid_t h5GroupId = m_HDF5ContainerId < 0 ? -1 : H5Gcreate(m_HDF5ContainerId, h5GroupName.c_str(), 0, H5P_DEFAULT, H5P_DEFAULT); // create the group
+        if (h5GroupId < 0) {                                                                                        // group created ok?
+            Squawk("ERROR: Error creating HDF5 group with name " + h5GroupName);                                    // no - announce error
+            ok = false;                                                                                             // fail
+        }
+        else {                                                                                                      // group created ok
+            h5AttrT h5File;                                                                                         // attributes for the writes
+            h5File.fileId    = m_HDF5ContainerId;
+            h5File.groupId   = h5GroupId;
+            h5File.chunkSize = std::max(nRows, (size_t)1);                                                          // one chunk holds the table
+            h5File.IOBufSize = nRows;
+            h5File.dataSets  = {};
+
+            for (auto& column: p_Columns) {                                                                         // for each column
+
+                int fieldWidth = 0;                                                                                 // string field width
+                if (column.dataType == TYPENAME::STRING) {
+                    for (auto& value: column.values) fieldWidth = std::max(fieldWidth, (int)boost::get<string>(value).length());
+                }
+
+                hid_t h5DataType = GetHDF5DataType(column.dataType, fieldWidth);                                    // HDF5 datatype for column
+                hid_t h5Dset     = CreateHDF5Dataset(h5GroupName, h5GroupId, column.header, h5DataType, column.units, h5File.chunkSize);
+                if (h5Dset < 0) {                                                                                   // dataset created ok?
+                    Squawk("ERROR: Error creating HDF5 dataset with name " + column.header);                        // no - announce error
+                    ok = false;                                                                                     // fail
+                    break;
+                }
+
+                h5File.dataSets.push_back({h5Dset, h5DataType, column.dataType, column.values});                    // record dataset details and values to be written
+
+                if (nRows > 0 && !WriteHDF5_(h5File, h5GroupName, h5File.dataSets.size() - 1)) {                    // write to file ok?
+                    Squawk("ERROR: Error writing to HDF5 dataset with name " + column.header);                      // no - announce error
+                    ok = false;                                                                                     // fail
+                }
+
+                (void)H5Dclose(h5Dset);                                                                             // close the dataset
+                if (!ok) break;                                                                                     // something went wrong
+            }
+
+            (void)H5Gclose(h5GroupId);                                                                              // close the group
+        }
+    }
+    else {                                                                                                          // no - CSV, TSV, or TXT file
+        string delimiter = "";
+        switch (m_LogfileType) {
+            case LOGFILETYPE::CSV: delimiter = DELIMITERValue.at(DELIMITER::COMMA); break;                          // CSV
+            case LOGFILETYPE::TSV: delimiter = DELIMITERValue.at(DELIMITER::TAB); break;                            // TSV
+            case LOGFILETYPE::TXT: delimiter = DELIMITERValue.at(DELIMITER::SPACE); break;                          // TXT
+            default: break;
+        }
+
+        // format the values first - column widths are the width of the widest entry in the column
+
+        std::vector<std::vector<string>> fields;                                                                    // formatted fields: types, units, headers, values
+        std::vector<size_t>              widths;                                                                    // column widths
+        for (auto& column: p_Columns) {
+            std::vector<string> columnFields = { std::get<1>(TYPENAME_LABEL.at(column.dataType)), column.units, column.header };
+            for (auto& value: column.values) {
+                string valueStr = boost::apply_visitor(FormatVariantValueDefault(), value);                         // format value
+                columnFields.push_back(utils::trim(valueStr));                                                      // without padding
+            }
+
+            size_t width = 0;
+            for (auto& field: columnFields) width = std::max(width, field.length());
+
+            fields.push_back(columnFields);
+            widths.push_back(width);
+        }
+
+        string filename = m_LogBasePath + "/" + m_LogContainerName + "/" + m_LogNamePrefix + p_TableName + "." + LOGFILETYPEFileExt.at(m_LogfileType);
+        try {
+            std::ofstream file(filename, std::ios::out);
+            if (!file.is_open()) throw std::ofstream::failure("unable to open file");
+
+            for (size_t row = 0; row < nRows + 3; row++) {                                                          // types, units, headers, then values
+                string record = "";
+                for (size_t col = 0; col < fields.size(); col++) {
+                    if (col > 0) record += delimiter;
+                    record += row < 3 ? utils::CentreJustify(fields[col][row], widths[col])                         // header lines are centred
+                                      : utils::vFormat("%*s", (int)widths[col], fields[col][row].c_str());          // values are right-justified
+                }
+                file << record << std::endl;
+            }
+            file.close();
+        }
+        catch (const std::ofstream::failure &e) {                                                                   // problem...
+            Squawk("ERROR: Unable to write summary table file with name " + filename);                              // announce error
+            Squawk(e.what());                                                                                       // plus details
+            ok = false;                                                                                             // fail
+        }
+    }
+
+    return ok;
+}
+
+
 /*
  * Create and open new log file
  *
@@ -758,6 +1073,10 @@ int Log::Open(const string p_LogFileName, const bool p_Append, const bool p_Time
 
         string basename = m_LogBasePath + "/" + m_LogContainerName + "/" + m_LogNamePrefix + p_LogFileName;         // base filename with path and container ("/" works on Uni*x and Windows)
         string fileext  = LOGFILETYPEFileExt.at(OPTIONS->LogfileType());                                            // file extension
+
+        bool compressed = m_LogfileType != LOGFILETYPE::HDF5 && OPTIONS->LogfileCompression() != LOGFILE_COMPRESSION::NONE;    // compressed CSV, TSV, or TXT file?
+        if (compressed) fileext += "." + LOGFILE_COMPRESSION_FILE_EXT.at(OPTIONS->LogfileCompression());           // yes - add compression extension
+
         string filename = basename + "." + fileext;                                                                 // full filename
 
         int version = 0;                                                                                            // logfile version number if required - start at 1
@@ -869,8 +1188,16 @@ int Log::Open(const string p_LogFileName, const bool p_Append, const bool p_Time
             }
                
             try {
-                m_Logfiles[id].file.open(filename, std::ios::out | std::ios::app);                                  // create fs log file
-                m_Logfiles[id].file.exceptions(std::ofstream::failbit | std::ofstream::badbit);                     // enable exceptions on log file
+                if (compressed) {                                                                                   // compressed log file?
+                    m_Logfiles[id].gzFile.reset(new GzipStream());                                                  // yes - create compressed stream
+                    if (!m_Logfiles[id].gzFile->Open(filename, true, OPTIONS->LogfileCompressionBlockSize() * 1024)) {  // open compressed stream
+                        throw std::ofstream::failure("unable to open compressed stream");                           // failed - handle as fs problem
+                    }
+                }
+                else {                                                                                              // no - uncompressed
+                    m_Logfiles[id].file.open(filename, std::ios::out | std::ios::app);                              // create fs log file
+                    m_Logfiles[id].file.exceptions(std::ofstream::failbit | std::ofstream::badbit);                 // enable exceptions on log file
+                }
 
                 m_Logfiles[id].active         = true;                                                               // this entry now active
                 m_Logfiles[id].logfiletype    = p_StandardLogfile;                                                  // standard logfile type
@@ -882,7 +1209,7 @@ int Log::Open(const string p_LogFileName, const bool p_Append, const bool p_Time
                 m_Logfiles[id].h5File.groupId = -1;                                                                 // not HDF5 file
             }
             catch (const std::ofstream::failure &e) {                                                               // fs problem...
-                Squawk("ERROR: Unable to create fs log file with file name " + m_Logfiles[id].name);                // announce error
+                Squawk("ERROR: Unable to create fs log file with file name " + filename);                           // announce error
                 Squawk(e.what());                                                                                   // plus details
 
                 // it's possible this m_Logfiles entry was just appended - it can be used next time
@@ -983,6 +1310,12 @@ bool Log::Close_(const int p_LogfileId) {
                 m_HDF5DetailedId = -1;                                                                              // (should have) no open detailed output file
             }
         }
+        else if (m_Logfiles[p_LogfileId].gzFile) {                                                                  // no, compressed FS logfile?
+            if (!m_Logfiles[p_LogfileId].gzFile->Close()) {                                                         // yes - write outstanding blocks and close - ok?
+                Squawk("ERROR: Unable to close log file with file name " + m_Logfiles[p_LogfileId].name);           // no - announce error
+                result = false;                                                                                     // fail
+            }
+        }
         else {                                                                                                      // no, FS logfile
             if (m_Logfiles[p_LogfileId].file.is_open()) {                                                           // log file open?
                 try {                                                                                               // yes
@@ -1016,11 +1349,69 @@ void Log::Squawk(const string p_SquawkStr) {
 }
 
 
+/*
+ * Intern a log/debug class
+ *
+ * Returns the integer id of the class (case-insensitive), assigning the next id if the class has not been
+ * seen before.  Enabled classes are recorded as bitmasks of their ids (see ClassMask()), so checking whether
+ * a class is enabled (see DebugEnabled() and LogEnabled()) is a bit test rather than a comparison of the
+ * class with each of the enabled classes.  The LOG_CLASS_ID macro (LogMacros.h) interns the class of a
+ * DBG/SAY/LOG statement once, the first time the statement is executed.
+ *
+ *
+ * int ClassId(const string& p_Class)
+ *
+ * @param   [IN]    p_Class                     The class (logging or debug)
+ * @return                                      Class id - LOG_CLASS_NONE if p_Class is empty
+ */
+int Log::ClassId(const string& p_Class) {
+
+    if (p_Class.empty()) return LOG_CLASS_NONE;                                                                 // no class
+
+    string key = p_Class;
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);                                             // classes are case-insensitive
+
+    auto iter = m_ClassIds.find(key);
+    if (iter != m_ClassIds.end()) return iter->second;                                                          // already interned
+
+    int id = static_cast<int>(m_ClassNames.size());                                                             // next id
+    m_ClassIds.emplace(key, id);
+    m_ClassNames.push_back(p_Class);
+
+    return id;
+}
+
+
+/*
+ * Construct the bitmask of a list of enabled log/debug classes
+ *
+ * Sets the bit for the id of each class (interning the classes - see ClassId()).  Classes with ids
+ * of LOG_CLASS_MASK_BITS or more are not in the bitmask - they are checked by name (see DoIt()).
+ *
+ *
+ * std::uint64_t ClassMask(const std::vector<string>& p_Classes)
+ *
+ * @param   [IN]    p_Classes                   List of enabled classes
+ * @return                                      Bitmask of the enabled classes
+ */
+std::uint64_t Log::ClassMask(const std::vector<string>& p_Classes) {
+
+    std::uint64_t mask = 0;
+
+    for (auto &logClass : p_Classes) {
+        int id = ClassId(logClass);
+        if (id >= 0 && id < LOG_CLASS_MASK_BITS) mask |= std::uint64_t(1) << id;
+    }
+
+    return mask;
+}
+
+
 /*
  * Determine whether record should be logged/debug string should be written based on log/debug classes and log/debug level.
  *
  *
- * bool DoIt(const string p_Class, const int p_Level, const std::vector<string> p_EnabledClasses, const int p_EnabledLevel)
+ * bool DoIt(const string& p_Class, const int p_Level, const std::vector<string>& p_EnabledClasses, const int p_EnabledLevel) const
  *
  * @param   [IN]    p_Class                     The class (logging or debug) of the record being evaluated
  * @param   [IN]    p_LogLevel                  The level (logging or debug) of the record being evaluated
@@ -1028,7 +1419,7 @@ void Log::Squawk(const string p_SquawkStr) {
  * @param   [IN]    p_EnabledLevel              The application logging or debug level
  * @return                                      Boolean indicating whether record should be logged/debug string should be written
  */
-bool Log::DoIt(const string p_Class, const int p_Level, const std::vector<string> p_EnabledClasses, const int p_EnabledLevel) {
+bool Log::DoIt(const string& p_Class, const int p_Level, const std::vector<string>& p_EnabledClasses, const int p_EnabledLevel) const {
 
     bool doIt = (p_Level <= p_EnabledLevel);                                                                    // first check level
 
@@ -1069,6 +1460,23 @@ void Log::Say(const string p_SayClass, const int p_SayLevel, const string p_SayS
 }
 
 
+/*
+ * As Say(), for an interned class (see ClassId())
+ *
+ *
+ * void Say(const int p_SayClassId, const int p_SayLevel, const string p_SayStr)
+ *
+ * @param   [IN]    p_SayClassId                Class id to determine if string should be written
+ * @param   [IN]    p_SayLevel                  Level to determine if string should be written
+ * @param   [IN]    p_SayStr                    The string to be written
+ */
+void Log::Say(const int p_SayClassId, const int p_SayLevel, const string p_SayStr) {
+    if (LogEnabled(p_SayClassId, p_SayLevel)) {                                                                     // logging service enabled, and logging this class and level?
+        Say_(p_SayStr);                                                                                             // yes - say it
+    }
+}
+
+
 /*
  * Say() with no class or level check - internal use only
  *
@@ -1132,8 +1540,15 @@ bool Log::Write_(const int p_LogfileId, const string p_LogStr) {
 
     if (m_Enabled && IsActiveId(p_LogfileId)) {                                                                     // logging service enabled and specified log file active?
         try {
-            m_Logfiles[p_LogfileId].file << p_LogStr << std::endl;                                                  // write string to log file
-            m_Logfiles[p_LogfileId].file.flush();                                                                   // flush data to log file
+            if (m_Logfiles[p_LogfileId].gzFile) {                                                                   // compressed stream?
+                if (!m_Logfiles[p_LogfileId].gzFile->Write(p_LogStr)) {                                             // yes - write string to stream (flushed per block)
+                    throw std::ofstream::failure("unable to write compressed block");                               // failed - handle as fs problem
+                }
+            }
+            else {                                                                                                  // no - uncompressed
+                m_Logfiles[p_LogfileId].file << p_LogStr << std::endl;                                              // write string to log file
+                m_Logfiles[p_LogfileId].file.flush();                                                               // flush data to log file
+            }
 
             result = true;                                                                                          // set result
         }
@@ -1182,7 +1597,12 @@ bool Log::WriteHDF5_(h5AttrT& p_H5file, const string p_H5filename, const size_t
 
     hid_t   dSet            = p_H5file.dataSets[p_DataSetIdx].dataSetId;                                                    // dataset id
     hid_t   dType           = p_H5file.dataSets[p_DataSetIdx].h5DataType;                                                   // HDF5 datatye
-    hsize_t dSetCurrentSize = H5Dget_storage_size(dSet) / H5Tget_size(dType);                                               // current size (entries) of HDF5 dataset
+    hsize_t dSetCurrentSize = 0;                                                                                            // current size (entries) of HDF5 dataset
+    hid_t   dSetSpace       = H5Dget_space(dSet);                                                                           // from the extent of the dataset - the storage size is that of the
+    if (dSetSpace >= 0) {                                                                                                   // allocated chunks, in the file datatype, so is not the number of
+        (void)H5Sget_simple_extent_dims(dSetSpace, &dSetCurrentSize, NULL);                                                 // entries if the file datatype is smaller than the memory datatype,
+        (void)H5Sclose(dSetSpace);                                                                                          // or if the dataset is compressed (see --hdf5-precision)
+    }
     hsize_t h5Dims[1]       = {bufSize};                                                                                    // size of buffer to be written
     hid_t   h5Dspace        = H5Screate_simple(1, h5Dims, NULL);                                                            // create memory dataspace for write
     hid_t   h5FSpace;                                                                                                       // filespace for write - allocated later
@@ -1409,12 +1829,24 @@ bool Log::Write_(const int p_LogfileId, const std::vector<COMPAS_VARIABLE_TYPE>
 
                     if (dSet >= 0) {                                                                                        // dataset open?
                                                                                                                             // yes
+                        std::vector<COMPAS_VARIABLE_TYPE> &buf = m_Logfiles[p_LogfileId].h5File.dataSets[idx].buf;          // write buffer
+                        size_t capacity = buf.capacity();                                                                   // for memory footprint reporting
+
                         if (!p_Flush) {                                                                                     // flush only?
-                            m_Logfiles[p_LogfileId].h5File.dataSets[idx].buf.push_back(p_LogRecordValues[idx]);             // no - add write data to buffer
+                            buf.push_back(p_LogRecordValues[idx]);                                                          // no - add write data to buffer
+
+                            if (buf.capacity() != capacity) {                                                               // buffer grown?
+                                size_t bufBytes = buf.capacity() * sizeof(COMPAS_VARIABLE_TYPE);                            // yes - account for it
+                                m_HDF5BufferedBytes           += bufBytes - capacity * sizeof(COMPAS_VARIABLE_TYPE);
+                                m_HDF5DatasetBufferedBytesPeak = std::max(m_HDF5DatasetBufferedBytesPeak, bufBytes);
+                                m_HDF5BufferedBytesPeak        = std::max(m_HDF5BufferedBytesPeak, m_HDF5BufferedBytes);
+                                capacity                       = buf.capacity();
+                            }
                         }
 
-                        if ((m_Logfiles[p_LogfileId].h5File.dataSets[idx].buf.size() >= m_Logfiles[p_LogfileId].h5File.IOBufSize) || p_Flush) { // need to write?
+                        if ((buf.size() >= m_Logfiles[p_LogfileId].h5File.IOBufSize) || p_Flush) {                         // need to write?
                             ok = WriteHDF5_(m_Logfiles[p_LogfileId].h5File, m_Logfiles[p_LogfileId].name, idx);             // do the write 
+                            m_HDF5BufferedBytes -= (capacity - buf.capacity()) * sizeof(COMPAS_VARIABLE_TYPE);              // buffer released
                         }
                     }
                 }
@@ -1476,6 +1908,30 @@ bool Log::Put(const int p_LogfileId, const string p_LogClass, const int p_LogLev
 }
 
 
+/*
+ * As Put(), for an interned class (see ClassId())
+ *
+ *
+ * bool Put(const int p_LogfileId, const int p_LogClassId, const int p_LogLevel, const string p_LogStr)
+ *
+ * @param   [IN]    p_LogfileId                 The id of the log file to which the log string should be written
+ * @param   [IN]    p_LogClassId                Class id to determine if string sould be written
+ * @param   [IN]    p_LogLevel                  Level to determine if string should be written
+ * @param   [IN]    p_LogStr                    The string to be written
+ * @return                                      Boolean indicating whether record was written successfully
+ */
+bool Log::Put(const int p_LogfileId, const int p_LogClassId, const int p_LogLevel, const string p_LogStr) {
+
+    bool result = false;
+
+    if (LogEnabled(p_LogClassId, p_LogLevel) && IsActiveId(p_LogfileId)) {                                         // logging this class and level, and specified log file active?
+        result = Put_(p_LogfileId, p_LogStr, p_LogClassId == LOG_CLASS_NONE ? "" : m_ClassNames[p_LogClassId]);     // yes - log it
+    }
+
+    return result;
+}
+
+
 /*
  * Put() a string record to specified log file with no class or level check - internal use only
  * Used for CSV, TSV, and TXT files
@@ -1586,6 +2042,22 @@ bool Log::Debug(const string p_DbgClass, const int p_DbgLevel, const string p_Db
 }
 
 
+/*
+ * As Debug(), for an interned class (see ClassId())
+ *
+ *
+ * bool Debug(const int p_DbgClassId, const int p_DbgLevel, const string p_DbgStr)
+ *
+ * @param   [IN]    p_DbgClassId                Class id to determine if string should be written
+ * @param   [IN]    p_DbgLevel                  Level to determine if string should be written
+ * @param   [IN]    p_DbgStr                    The string to be written
+ * @return                                      Boolean indicating whether record was written successfully
+ */
+bool Log::Debug(const int p_DbgClassId, const int p_DbgLevel, const string p_DbgStr) {
+    return DebugEnabled(p_DbgClassId, p_DbgLevel) ? Debug_(p_DbgStr) : false;                                       // debug it if debugging this class and level
+}
+
+
 /*
  * Debug() with no class or level check - internal use only
  *
@@ -1641,6 +2113,31 @@ bool Log::DebugWait(const string p_DbgClass, const int p_DbgLevel, const string
 }
 
 
+/*
+ * As DebugWait(), for an interned class (see ClassId())
+ *
+ *
+ * bool DebugWait(const int p_DbgClassId, const int p_DbgLevel, const string p_DbgStr)
+ *
+ * @param   [IN]    p_DbgClassId                Class id to determine if string should be written
+ * @param   [IN]    p_DbgLevel                  Level to determine if string should be written
+ * @param   [IN]    p_DbgStr                    The string to be written
+ * @return                                      Boolean indicating whether record was written successfully
+ */
+bool Log::DebugWait(const int p_DbgClassId, const int p_DbgLevel, const string p_DbgStr) {
+
+    bool result = false;
+
+    if (DebugEnabled(p_DbgClassId, p_DbgLevel)) {                                                                   // debugging this class and level?
+        result = Debug_(p_DbgStr);                                                                                  // debug it
+        std::cout << "DEBUG: Press any key to continue...";                                                         // announce
+        string tmp; std::cin >> tmp;                                                                                // and wait for input
+    }
+
+    return result;
+}
+
+
 /*
  * Writes error string to stderr
  * Also writes error string to log file if logging is active and so configured (m_ErrToFile via Program Options)
@@ -1848,6 +2345,570 @@ std::tuple<bool, LOGFILE> Log::GetLogfileDescriptorKey(const string p_Value) {
 }
 
 
+/*
+ * Find a short name in the LOGFILE_DESCRIPTOR map and return the key if found, otherwise defaut value
+ *
+ * This function looks for the passed string value in the short file names of the LOGFILE_DESCRIPTOR
+ * map (e.g. "BSE_DCO" - the names used in the logfile-definitions file), and if the string is found
+ * returns the key correspoding to the value found.  If the value is not found the default value
+ * LOGFILE::NONE is returned.
+ *
+ * The string comparison is case-insensitive.
+ *
+ *
+ * std::tuple<bool, LOGFILE> GetLogfileShortNameKey(const string p_Value)
+ *
+ * @param   [IN]    p_Value                     The value to be located in the LOGFILE_DESCRIPTOR map
+ * @return                                      Tuple containing a boolean result (true if value found, else false), and the key
+ *                                              corresponding to the value found, or LOGFILE::NONE if the value was not found
+ */
+std::tuple<bool, LOGFILE> Log::GetLogfileShortNameKey(const string p_Value) {
+    for (auto& it: LOGFILE_DESCRIPTOR)
+        if (!std::get<2>(it.second).empty() && utils::Equals(std::get<2>(it.second), p_Value)) return std::make_tuple(true, it.first);
+    return std::make_tuple(false, LOGFILE::NONE);
+}
+
+
+/*
+ * Parse a property specifier
+ *
+ * Property specifiers have the same form as in the logfile-definitions file: PROPERTY_TYPE::PROPERTY_NAME,
+ * e.g. BINARY_PROPERTY::CHIRP_MASS or STAR_1_PROPERTY::STELLAR_TYPE.  STAR_PROPERTY properties are valid
+ * only for stellar logfiles, and STAR_1_PROPERTY, STAR_2_PROPERTY, SUPERNOVA_PROPERTY, COMPANION_PROPERTY
+ * and BINARY_PROPERTY properties only for binary logfiles.  Program options are not valid here.
+ *
+ *
+ * std::tuple<ERROR, T_ANY_PROPERTY> ParsePropertySpecifier(const string p_Specifier, const LOGFILE_TYPE p_LogfileType)
+ *
+ * @param   [IN]    p_Specifier                 The property specifier
+ * @param   [IN]    p_LogfileType               The type of the logfile for which the property will be retrieved
+ * @return                                      Tuple containing an error (ERROR::NONE if the specifier is valid), and the property
+ */
+std::tuple<ERROR, T_ANY_PROPERTY> Log::ParsePropertySpecifier(const string p_Specifier, const LOGFILE_TYPE p_LogfileType) {
+
+    T_ANY_PROPERTY property = BINARY_PROPERTY::ID;                                                                  // default
+
+    std::size_t sepPos = p_Specifier.find("::");                                                                    // find :: separator
+    if (sepPos == string::npos || sepPos == 0 || sepPos + 2 >= p_Specifier.size()) {                                // have property type and name?
+        return std::make_tuple(ERROR::UNKNOWN_PROPERTY_TYPE, property);                                             // no
+    }
+    string propTypeStr = p_Specifier.substr(0, sepPos);                                                             // property type
+    string propNameStr = p_Specifier.substr(sepPos + 2);                                                            // property name
+
+    bool found;
+    PROPERTY_TYPE propertyType;
+    std::tie(found, propertyType) = utils::GetMapKey(propTypeStr, PROPERTY_TYPE_LABEL, PROPERTY_TYPE::NONE);
+    if (!found) return std::make_tuple(ERROR::UNKNOWN_PROPERTY_TYPE, property);
+
+    ERROR error = ERROR::NONE;
+    switch (propertyType) {                                                                                         // which (known) property type?
+
+        case PROPERTY_TYPE::STAR_PROPERTY: {                                                                        // STAR_PROPERTY
+            STAR_PROPERTY starProp;
+            std::tie(found, starProp) = utils::GetMapKey(propNameStr, STAR_PROPERTY_LABEL, STAR_PROPERTY::ID);
+            if      (!found)                                    error = ERROR::UNKNOWN_STELLAR_PROPERTY;
+            else if (p_LogfileType != LOGFILE_TYPE::STELLAR)    error = ERROR::EXPECTED_BINARY_PROPERTY;
+            else                                                property = starProp;
+            } break;
+
+        case PROPERTY_TYPE::STAR_1_PROPERTY   :                                                                     // STAR_1_PROPERTY, or
+        case PROPERTY_TYPE::STAR_2_PROPERTY   :                                                                     // STAR_2_PROPERTY, or
+        case PROPERTY_TYPE::SUPERNOVA_PROPERTY:                                                                     // SUPERNOVA_PROPERTY, or
+        case PROPERTY_TYPE::COMPANION_PROPERTY: {                                                                   // COMPANION_PROPERTY
+            STAR_PROPERTY starProp;
+            std::tie(found, starProp) = utils::GetMapKey(propNameStr, STAR_PROPERTY_LABEL, STAR_PROPERTY::ID);
+            if      (!found)                                    error = ERROR::UNKNOWN_BINARY_PROPERTY;
+            else if (p_LogfileType != LOGFILE_TYPE::BINARY)     error = ERROR::EXPECTED_STELLAR_PROPERTY;
+            else {
+                switch (propertyType) {
+                    case PROPERTY_TYPE::STAR_1_PROPERTY   : property = static_cast<STAR_1_PROPERTY>(starProp);    break;
+                    case PROPERTY_TYPE::STAR_2_PROPERTY   : property = static_cast<STAR_2_PROPERTY>(starProp);    break;
+                    case PROPERTY_TYPE::SUPERNOVA_PROPERTY: property = static_cast<SUPERNOVA_PROPERTY>(starProp); break;
+                    case PROPERTY_TYPE::COMPANION_PROPERTY: property = static_cast<COMPANION_PROPERTY>(starProp); break;
+                    default: break;                                                                                 // avoids compiler warning
+                }
+            }
+            } break;
+
+        case PROPERTY_TYPE::BINARY_PROPERTY: {                                                                      // BINARY_PROPERTY
+            BINARY_PROPERTY binaryProp;
+            std::tie(found, binaryProp) = utils::GetMapKey(propNameStr, BINARY_PROPERTY_LABEL, BINARY_PROPERTY::ID);
+            if      (!found)                                    error = ERROR::UNKNOWN_BINARY_PROPERTY;
+            else if (p_LogfileType != LOGFILE_TYPE::BINARY)     error = ERROR::EXPECTED_STELLAR_PROPERTY;
+            else                                                property = binaryProp;
+            } break;
+
+        default:                                                                                                    // program options (or unknown)
+            error = ERROR::UNKNOWN_PROPERTY_TYPE;
+    }
+
+    return std::make_tuple(error, property);
+}
+
+
+/*
+ * Parse a record filter term
+ *
+ * Filter terms are of the form PROPERTY<operator>VALUE, where PROPERTY is a property specifier (see
+ * ParsePropertySpecifier()), <operator> is one of ==, !=, <=, >=, <, >, and VALUE is a number, or
+ * TRUE or FALSE (for boolean properties).  Enum-valued properties (e.g. stellar types) are compared
+ * by their ordinal values.  For example:
+ *
+ *     BINARY_PROPERTY::MERGES_IN_HUBBLE_TIME==TRUE
+ *     STAR_1_PROPERTY::STELLAR_TYPE==14
+ *
+ *
+ * std::tuple<ERROR, PropertyFilterT> ParseRecordFilter(const string p_Filter, const LOGFILE_TYPE p_LogfileType)
+ *
+ * @param   [IN]    p_Filter                    The filter term
+ * @param   [IN]    p_LogfileType               The type of the logfile for which the filter property will be retrieved
+ * @return                                      Tuple containing an error (ERROR::NONE if the filter term is valid), and the filter term
+ */
+std::tuple<ERROR, PropertyFilterT> Log::ParseRecordFilter(const string p_Filter, const LOGFILE_TYPE p_LogfileType) {
+
+    PropertyFilterT filter = { BINARY_PROPERTY::ID, FILTER_OPERATOR::EQ, 0.0 };                                     // default
+
+    std::size_t opPos = string::npos;
+    std::size_t opLen = 0;
+    for (auto& op: FILTER_OPERATOR_LABEL) {                                                                         // two-character operators first
+        if ((opPos = p_Filter.find(op.second)) != string::npos) {
+            filter.op = op.first;
+            opLen     = op.second.size();
+            break;
+        }
+    }
+    if (opPos == string::npos) return std::make_tuple(ERROR::INVALID_RECORD_FILTER, filter);                        // no operator
+
+    string propStr  = p_Filter.substr(0, opPos);
+    string valueStr = p_Filter.substr(opPos + opLen);
+    propStr  = utils::trim(propStr);
+    valueStr = utils::trim(valueStr);
+
+    ERROR error;
+    std::tie(error, filter.property) = ParsePropertySpecifier(propStr, p_LogfileType);
+    if (error != ERROR::NONE) return std::make_tuple(error, filter);
+
+    if      (utils::Equals(valueStr, "TRUE"))  filter.value = 1.0;
+    else if (utils::Equals(valueStr, "FALSE")) filter.value = 0.0;
+    else {
+        try {
+            size_t lastChar;
+            filter.value = std::stod(valueStr, &lastChar);
+            if (lastChar != valueStr.size()) error = ERROR::INVALID_RECORD_FILTER;                                  // trailing characters
+        }
+        catch (...) { error = ERROR::INVALID_RECORD_FILTER; }                                                       // not a number
+    }
+
+    return std::make_tuple(error, filter);
+}
+
+
+/*
+ * Configure the histograms (aggregation sinks) specified by program option --histogram
+ *
+ * Each histogram is specified by a single string of comma-separated fields:
+ *
+ *     LOGFILE,PROPERTY,BINNING[,MIN,MAX,NBINS][,FILTER ...]
+ *
+ * where
+ *
+ *     LOGFILE  is the short name of a standard logfile, as used in the logfile-definitions file (e.g. BSE_DCO)
+ *     PROPERTY is a property specifier (see ParsePropertySpecifier())
+ *     BINNING  is one of LINEAR, LOG, INTEGER - LINEAR and LOG must be followed by MIN, MAX and NBINS
+ *     FILTER   is a record filter term (see ParseRecordFilter()) - a record is counted only if it satisfies
+ *              all filter terms
+ *
+ * Errors are announced, and cause logging to be disabled (as for the logfile-definitions file).
+ *
+ *
+ * bool ConfigureHistograms()
+ *
+ * @return                                      Boolean status - true = all histograms configured ok; false = error
+ */
+bool Log::ConfigureHistograms() {
+
+    m_Histograms.clear();
+
+    std::vector<string> specs = OPTIONS->Histograms();
+    for (size_t idx = 0; idx < specs.size(); idx++) {
+
+        string spec = specs[idx];
+
+        std::vector<string> fields;                                                                                 // comma-separated fields
+        std::stringstream   ss(spec);
+        string              field;
+        while (std::getline(ss, field, ',')) fields.push_back(utils::trim(field));
+
+        ERROR  error     = ERROR::NONE;
+        string errorInfo = "";
+
+        LOGFILE           logfile  = LOGFILE::NONE;
+        LOGFILE_TYPE      fileType = LOGFILE_TYPE::NONE;
+        T_ANY_PROPERTY    property = BINARY_PROPERTY::ID;
+        HISTOGRAM_BINNING binning  = HISTOGRAM_BINNING::LINEAR;
+        double            binMin   = 0.0;
+        double            binMax   = 0.0;
+        int               nBins    = 0;
+        size_t            nextIdx  = 3;                                                                             // index of first field after binning spec
+
+        std::vector<PropertyFilterT> filters = {};
+
+        if (fields.size() < 3) {
+            error     = ERROR::INVALID_HISTOGRAM_SPECIFICATION;
+            errorInfo = "expected LOGFILE,PROPERTY,BINNING";
+        }
+
+        if (error == ERROR::NONE) {                                                                                 // logfile
+            bool found;
+            std::tie(found, logfile) = GetLogfileShortNameKey(fields[0]);
+            if (!found || (fileType = std::get<4>(LOGFILE_DESCRIPTOR.at(logfile))) == LOGFILE_TYPE::NONE) {
+                error     = ERROR::UNKNOWN_LOGFILE;
+                errorInfo = fields[0];
+            }
+        }
+
+        if (error == ERROR::NONE) {                                                                                 // property
+            std::tie(error, property) = ParsePropertySpecifier(fields[1], fileType);
+            if (error != ERROR::NONE) errorInfo = fields[1];
+        }
+
+        if (error == ERROR::NONE) {                                                                                 // binning
+            bool found;
+            std::tie(found, binning) = utils::GetMapKey(fields[2], HISTOGRAM_BINNING_LABEL, HISTOGRAM_BINNING::LINEAR);
+            if (!found) {
+                error     = ERROR::INVALID_HISTOGRAM_SPECIFICATION;
+                errorInfo = "unknown binning " + fields[2];
+            }
+            else if (binning != HISTOGRAM_BINNING::INTEGER) {                                                       // need MIN,MAX,NBINS
+                try {
+                    if (fields.size() < 6) throw std::invalid_argument("missing MIN,MAX,NBINS");
+                    binMin  = std::stod(fields[3]);
+                    binMax  = std::stod(fields[4]);
+                    nBins   = std::stoi(fields[5]);
+                    nextIdx = 6;
+                    if (binMax <= binMin || nBins < 1 || (binning == HISTOGRAM_BINNING::LOG && binMin <= 0.0)) throw std::invalid_argument("invalid MIN,MAX,NBINS");
+                }
+                catch (...) {
+                    error     = ERROR::INVALID_HISTOGRAM_SPECIFICATION;
+                    errorInfo = "expected MIN,MAX,NBINS for " + fields[2] + " binning (MAX > MIN, NBINS >= 1, and MIN > 0 for LOG binning)";
+                }
+            }
+        }
+
+        for (size_t fIdx = nextIdx; error == ERROR::NONE && fIdx < fields.size(); fIdx++) {                         // filters
+            PropertyFilterT filter;
+            std::tie(error, filter) = ParseRecordFilter(fields[fIdx], fileType);
+            if (error != ERROR::NONE) errorInfo = fields[fIdx];
+            else                      filters.push_back(filter);
+        }
+
+        if (error != ERROR::NONE) {
+            Squawk("ERROR: " + ERR_MSG(error) + (errorInfo.empty() ? "" : ": " + errorInfo) + " in histogram specification '" + spec + "'");
+            Squawk("Logging disabled");
+            m_Histograms.clear();
+            return false;
+        }
+
+        // header and units strings for the property
+        PROPERTY_DETAILS details;
+        string           suffix = "";
+        switch (boost::apply_visitor(VariantPropertyType(), property)) {
+            case ANY_PROPERTY_TYPE::T_STAR_PROPERTY     : details = StellarPropertyDetails(static_cast<ANY_STAR_PROPERTY>(boost::get<STAR_PROPERTY>(property)));                      break;
+            case ANY_PROPERTY_TYPE::T_STAR_1_PROPERTY   : details = StellarPropertyDetails(static_cast<ANY_STAR_PROPERTY>(boost::get<STAR_1_PROPERTY>(property)));    suffix = "(1)";  break;
+            case ANY_PROPERTY_TYPE::T_STAR_2_PROPERTY   : details = StellarPropertyDetails(static_cast<ANY_STAR_PROPERTY>(boost::get<STAR_2_PROPERTY>(property)));    suffix = "(2)";  break;
+            case ANY_PROPERTY_TYPE::T_SUPERNOVA_PROPERTY: details = StellarPropertyDetails(static_cast<ANY_STAR_PROPERTY>(boost::get<SUPERNOVA_PROPERTY>(property))); suffix = "(SN)"; break;
+            case ANY_PROPERTY_TYPE::T_COMPANION_PROPERTY: details = StellarPropertyDetails(static_cast<ANY_STAR_PROPERTY>(boost::get<COMPANION_PROPERTY>(property))); suffix = "(CP)"; break;
+            default                                     : details = BinaryPropertyDetails(boost::get<BINARY_PROPERTY>(property));                                                     break;
+        }
+        string header = std::get<1>(details) + suffix;
+
+        m_Histograms.push_back(Histogram(std::to_string(idx + 1) + "_" + header,                                    // name: index (for uniqueness) and property header
+                                         logfile, property, header, std::get<2>(details),
+                                         binning, binMin, binMax, nBins, filters));
+    }
+
+    return true;
+}
+
+
+/*
+ * Configure the standard logfile record filters specified by program option --logfile-filter
+ *
+ * Each filter is specified by a single string of comma-separated fields:
+ *
+ *     LOGFILE,FILTER[,FILTER ...]
+ *
+ * where
+ *
+ *     LOGFILE  is the short name of a standard logfile, as used in the logfile-definitions file (e.g. BSE_SNE)
+ *     FILTER   is a record filter term (see ParseRecordFilter())
+ *
+ * The filter terms are evaluated on the final state of the star or binary (see ReleaseStagedRecords()), and
+ * the records produced for the logfile during its evolution are written only if all terms are satisfied.
+ * Filters specified for the same logfile in more than one token are combined (all terms must be satisfied).
+ *
+ * The detailed output logfiles can't be filtered (they are written per star or binary anyway).
+ *
+ * Errors are announced, and cause logging to be disabled (as for the logfile-definitions file).
+ *
+ *
+ * bool ConfigureLogfileFilters()
+ *
+ * @return                                      Boolean status - true = all filters configured ok; false = error
+ */
+bool Log::ConfigureLogfileFilters() {
+
+    m_LogfileFilters.clear();
+    m_StagedRecords.clear();
+
+    for (auto& spec: OPTIONS->LogfileFilters()) {
+
+        std::vector<string> fields;                                                                                 // comma-separated fields
+        std::stringstream   ss(spec);
+        string              field;
+        while (std::getline(ss, field, ',')) fields.push_back(utils::trim(field));
+
+        ERROR  error     = ERROR::NONE;
+        string errorInfo = "";
+
+        LOGFILE      logfile  = LOGFILE::NONE;
+        LOGFILE_TYPE fileType = LOGFILE_TYPE::NONE;
+
+        std::vector<PropertyFilterT> filters = {};
+
+        if (fields.size() < 2) {
+            error     = ERROR::INVALID_RECORD_FILTER;
+            errorInfo = "expected LOGFILE,FILTER";
+        }
+
+        if (error == ERROR::NONE) {                                                                                 // logfile
+            bool found;
+            std::tie(found, logfile) = GetLogfileShortNameKey(fields[0]);
+            if (!found || (fileType = std::get<4>(LOGFILE_DESCRIPTOR.at(logfile))) == LOGFILE_TYPE::NONE) {
+                error     = ERROR::UNKNOWN_LOGFILE;
+                errorInfo = fields[0];
+            }
+            else if (logfile == LOGFILE::BSE_DETAILED_OUTPUT || logfile == LOGFILE::SSE_DETAILED_OUTPUT) {
+                error     = ERROR::INVALID_RECORD_FILTER;
+                errorInfo = "detailed output logfiles can't be filtered";
+            }
+        }
+
+        for (size_t fIdx = 1; error == ERROR::NONE && fIdx < fields.size(); fIdx++) {                               // filters
+            PropertyFilterT filter;
+            std::tie(error, filter) = ParseRecordFilter(fields[fIdx], fileType);
+            if (error != ERROR::NONE) errorInfo = fields[fIdx];
+            else                      filters.push_back(filter);
+        }
+
+        if (error != ERROR::NONE) {
+            Squawk("ERROR: " + ERR_MSG(error) + (errorInfo.empty() ? "" : ": " + errorInfo) + " in logfile filter specification '" + spec + "'");
+            Squawk("Logging disabled");
+            m_LogfileFilters.clear();
+            return false;
+        }
+
+        std::vector<PropertyFilterT>& logfileFilters = m_LogfileFilters[logfile];                                   // filters for logfile (created if necessary)
+        logfileFilters.insert(logfileFilters.end(), filters.begin(), filters.end());                                // combine with any already specified
+    }
+
+    return true;
+}
+
+
+/*
+ * Configure the HDF5 floating-point column precision specified by program option --hdf5-precision
+ *
+ * Each specification is a single string of comma-separated fields:
+ *
+ *     LOGFILE,PRECISION[,COLUMN ...]
+ *
+ * where
+ *
+ *     LOGFILE      is the short name of a standard logfile, as used in the logfile-definitions file (e.g. BSE_SYSPARMS),
+ *                  or ALL (the specification applies to all logfiles)
+ *     PRECISION    is one of
+ *                      DOUBLE      columns are stored as 64-bit floating-point (the default)
+ *                      FLOAT       columns are stored as 32-bit floating-point (about 7 significant digits)
+ *                      DIGITS=n    columns are stored as 64-bit floating-point, compressed with the HDF5 scale-offset filter
+ *                                  retaining n decimal digits after the decimal point (lossy - values are rounded)
+ *     COLUMN       is the name of a column (HDF5 dataset, e.g. Radius(1)) - if no columns are specified the specification
+ *                  applies to all floating-point columns of the logfile
+ *
+ * Specifications are applied in the order given, so later specifications take precedence over earlier ones -
+ * e.g. "ALL,FLOAT" followed by "BSE_DCO,DOUBLE,SemiMajorAxis@DCO" stores all floating-point columns as FLOAT
+ * except the DCO semi-major axis.  Only floating-point columns are affected.
+ *
+ * Errors are announced, and cause logging to be disabled (as for the logfile-definitions file).
+ *
+ *
+ * bool ConfigureHDF5Precision()
+ *
+ * @return                                      Boolean status - true = all specifications configured ok; false = error
+ */
+bool Log::ConfigureHDF5Precision() {
+
+    m_HDF5Precision.clear();
+
+    for (auto& spec: OPTIONS->HDF5Precision()) {
+
+        std::vector<string> fields;                                                                                 // comma-separated fields
+        std::stringstream   ss(spec);
+        string              field;
+        while (std::getline(ss, field, ',')) fields.push_back(utils::trim(field));
+
+        ERROR  error     = ERROR::NONE;
+        string errorInfo = "";
+
+        HDF5PrecisionSpecT precisionSpec = {LOGFILE::NONE, HDF5_PRECISION::DOUBLE, 0, {}};
+
+        if (fields.size() < 2) {
+            error     = ERROR::INVALID_HDF5_PRECISION_SPECIFICATION;
+            errorInfo = "expected LOGFILE,PRECISION";
+        }
+
+        if (error == ERROR::NONE && utils::ToUpper(fields[0]) != "ALL") {                                           // logfile
+            bool found;
+            std::tie(found, precisionSpec.logfile) = GetLogfileShortNameKey(fields[0]);
+            if (!found) {
+                error     = ERROR::UNKNOWN_LOGFILE;
+                errorInfo = fields[0];
+            }
+        }
+
+        if (error == ERROR::NONE) {                                                                                 // precision
+            string precisionStr = utils::ToUpper(fields[1]);
+            string digitsStr    = "";
+            size_t pos          = precisionStr.find('=');
+            if (pos != string::npos) {                                                                              // DIGITS=n?
+                digitsStr    = precisionStr.substr(pos + 1);
+                precisionStr = precisionStr.substr(0, pos);
+            }
+
+            bool found;
+            std::tie(found, precisionSpec.precision) = utils::GetMapKey(precisionStr, HDF5_PRECISION_LABEL, precisionSpec.precision);
+            if (!found || (precisionSpec.precision == HDF5_PRECISION::DIGITS) == digitsStr.empty()) {              // DIGITS requires (and only DIGITS allows) a value
+                error     = ERROR::INVALID_HDF5_PRECISION_SPECIFICATION;
+                errorInfo = fields[1];
+            }
+            else if (precisionSpec.precision == HDF5_PRECISION::DIGITS) {
+                try {
+                    size_t lastChar;
+                    precisionSpec.digits = std::stoi(digitsStr, &lastChar);
+                    if (lastChar != digitsStr.length() || precisionSpec.digits < 0) throw std::invalid_argument("");
+                }
+                catch (const std::exception& e) {
+                    error     = ERROR::INVALID_HDF5_PRECISION_SPECIFICATION;
+                    errorInfo = fields[1] + " (DIGITS must be a non-negative integer)";
+                }
+                if (error == ERROR::NONE && H5Zfilter_avail(H5Z_FILTER_SCALEOFFSET) <= 0) {                          // filter available in this HDF5 library?
+                    error     = ERROR::INVALID_HDF5_PRECISION_SPECIFICATION;
+                    errorInfo = fields[1] + " (HDF5 scale-offset filter not available)";
+                }
+            }
+        }
+
+        for (size_t fIdx = 2; error == ERROR::NONE && fIdx < fields.size(); fIdx++) {                               // columns
+            precisionSpec.columns.push_back(fields[fIdx]);
+        }
+
+        if (error != ERROR::NONE) {
+            Squawk("ERROR: " + ERR_MSG(error) + (errorInfo.empty() ? "" : ": " + errorInfo) + " in HDF5 precision specification '" + spec + "'");
+            Squawk("Logging disabled");
+            m_HDF5Precision.clear();
+            return false;
+        }
+
+        m_HDF5Precision.push_back(precisionSpec);
+    }
+
+    return true;
+}
+
+
+/*
+ * Determine the precision policy for an HDF5 floating-point column
+ *
+ * Applies the specifications configured by ConfigureHDF5Precision(), in order - the last
+ * specification that matches the logfile and column determines the precision.
+ *
+ *
+ * std::tuple<HDF5_PRECISION, int> HDF5ColumnPrecision(const LOGFILE p_Logfile, const string p_Column)
+ *
+ * @param   [IN]    p_Logfile                   The logfile
+ * @param   [IN]    p_Column                    The column (HDF5 dataset) name
+ * @return                                      Tuple containing the precision policy and (for HDF5_PRECISION::DIGITS) the
+ *                                              number of decimal digits retained
+ */
+std::tuple<HDF5_PRECISION, int> Log::HDF5ColumnPrecision(const LOGFILE p_Logfile, const string p_Column) {
+
+    HDF5_PRECISION precision = HDF5_PRECISION::DOUBLE;
+    int            digits    = 0;
+
+    for (auto& spec: m_HDF5Precision) {
+        if (spec.logfile != LOGFILE::NONE && spec.logfile != p_Logfile) continue;                                   // not this logfile
+        if (!spec.columns.empty() && std::find(spec.columns.begin(), spec.columns.end(), p_Column) == spec.columns.end()) continue; // not this column
+
+        precision = spec.precision;
+        digits    = spec.digits;
+    }
+
+    return std::make_tuple(precision, digits);
+}
+
+
+/*
+ * Write the histograms to the output container
+ *
+ * Must be called before the standard logfiles are closed (the HDF5 container is closed with them).
+ * The histograms are discarded once written, so calling this function again is a no-op.
+ *
+ *
+ * bool WriteHistograms()
+ *
+ * @return                                      Boolean status - true = all histograms written ok; false = write failed
+ */
+bool Log::WriteHistograms() {
+
+    bool ok = true;
+
+    for (auto& histogram: m_Histograms) {
+        if (!histogram.Write()) {
+            Squawk("ERROR: Unable to write histogram for logfile " + std::get<2>(LOGFILE_DESCRIPTOR.at(histogram.Logfile())));
+            ok = false;
+        }
+    }
+    m_Histograms.clear();                                                                                           // done with histograms
+
+    return ok;
+}
+
+
+/*
+ * Write the evolution outcomes summary table to the output container
+ *
+ * Must be called before the standard logfiles are closed (the HDF5 container is closed with them).
+ * The outcomes are discarded once written, so calling this function again is a no-op.  Nothing is
+ * written if no outcomes were recorded.
+ *
+ *
+ * bool WriteEvolutionOutcomes()
+ *
+ * @return                                      Boolean status - true = outcomes written ok (or none recorded); false = write failed
+ */
+bool Log::WriteEvolutionOutcomes() {
+
+    if (m_EvolutionOutcomes.Empty()) return true;                                                                   // nothing to write
+
+    bool ok = m_EvolutionOutcomes.Write();
+    if (!ok) Squawk("ERROR: Unable to write evolution outcomes");
+
+    m_EvolutionOutcomes.Clear();                                                                                    // done with outcomes
+
+    return ok;
+}
+
+
 /*
  * Find a value in the m_OpenStandardLogFileIds map and return the key if found, otherwise defaut value
  *
@@ -2145,17 +3206,44 @@ hid_t Log::GetHDF5DataType(const TYPENAME p_COMPASdatatype, const int p_FieldWid
  * 
  * 
  * 
- * hid_t Log::CreateHDF5Dataset(const string p_Filename, const hid_t p_GroupId, const string p_DatasetName, const hid_t p_H5DataType, const string p_UnitsStr, const size_t p_HDF5ChunkSize)
+ * For floating-point datasets p_Precision may specify reduced precision storage (see program option --hdf5-precision):
+ *
+ *     HDF5_PRECISION::FLOAT    the dataset is created with a 32-bit floating-point datatype - values are written
+ *                              from memory with datatype p_H5DataType, and converted by the HDF5 library
+ *     HDF5_PRECISION::DIGITS   the dataset is created with datatype p_H5DataType, and the HDF5 scale-offset filter
+ *                              retaining p_Digits decimal digits after the decimal point
+ *
+ * and the precision policy is recorded in the dataset attribute "precision" (e.g. "FLOAT" or "DIGITS=3").  The
+ * attribute is not written for full precision datasets.
+ * 
+ * 
+ * hid_t Log::CreateHDF5Dataset(const string         p_Filename,
+ *                              const hid_t          p_GroupId,
+ *                              const string         p_DatasetName,
+ *                              const hid_t          p_H5DataType,
+ *                              const string         p_UnitsStr,
+ *                              const size_t         p_HDF5ChunkSize,
+ *                              const HDF5_PRECISION p_Precision,
+ *                              const int            p_Digits)
  *
  * @param   [IN]    p_Filename                  The filename of the HDF5 file (for error logging)
  * @param   [IN]    p_GroupId                   The group id under which the dataset should be created
  * @param   [IN]    p_DatasetName               The dataset name (this (generally) corresponds to the COMPAS column header)
- * @param   [IN]    p_H5DataType                The HDF5 datatype for the dataset
+ * @param   [IN]    p_H5DataType                The HDF5 (memory) datatype for the dataset
  * @param   [IN]    p_UnitsStr                  The units string to be associated with the dataset (generally corresponds to COMPAS units string)
  * @param   [IN]    p_HDF5ChunkSize             Chunk size for this dataset
+ * @param   [IN]    p_Precision                 Precision policy for floating-point datasets (optional, default = HDF5_PRECISION::DOUBLE)
+ * @param   [IN]    p_Digits                    Decimal digits retained for HDF5_PRECISION::DIGITS (optional, default = 0)
  * @return                                      HDF5 dataset id (-1 indicates failure)
  */
-hid_t Log::CreateHDF5Dataset(const string p_Filename, const hid_t p_GroupId, const string p_DatasetName, const hid_t p_H5DataType, const string p_UnitsStr, const size_t p_HDF5ChunkSize) {
+hid_t Log::CreateHDF5Dataset(const string         p_Filename,
+                             const hid_t          p_GroupId,
+                             const string         p_DatasetName,
+                             const hid_t          p_H5DataType,
+                             const string         p_UnitsStr,
+                             const size_t         p_HDF5ChunkSize,
+                             const HDF5_PRECISION p_Precision,
+                             const int            p_Digits) {
 
     hid_t h5Dset = -1;                                                                                              // datset id - return value
 
@@ -2172,13 +3260,18 @@ hid_t Log::CreateHDF5Dataset(const string p_Filename, const hid_t p_GroupId, con
     if (h5Result < 0) {                                                                                             // ok?
         Squawk("ERROR: Unable to set chunk size for HDF5 container file " + p_Filename);                            // no - announce error
     }
-    else {                                                                                                          // yes - chunk size set ok
+    else if (p_Precision == HDF5_PRECISION::DIGITS && H5Pset_scaleoffset(h5CPlist, H5Z_SO_FLOAT_DSCALE, p_Digits) < 0) { // scale-offset filter required - set ok?
+        Squawk("ERROR: Unable to set scale-offset filter for HDF5 dataSet " + p_DatasetName + " for file " + p_Filename); // no - announce error
+    }
+    else {                                                                                                          // yes - chunk size (and filter) set ok
+        hid_t h5FileDataType = p_Precision == HDF5_PRECISION::FLOAT ? H5T_NATIVE_FLOAT : p_H5DataType;              // datatype in file
+
         // create HDF5 dataset
         string h5DsetName = p_DatasetName;                                                                          // dataset name 
         h5DsetName        = utils::trim(h5DsetName);                                                                // remove leading and trailing blanks
         h5Dset            = H5Dcreate(p_GroupId,                                                                    // create the dataset in group p_GroupId
                                       h5DsetName.c_str(),                                                           // dataset name
-                                      p_H5DataType,                                                                 // datatype
+                                      h5FileDataType,                                                               // datatype
                                       h5Dspace,                                                                     // dataspace
                                       H5P_DEFAULT,                                                                  // dataset link property list                                                                     
                                       h5CPlist,                                                                     // dataset creation property list
@@ -2205,6 +3298,23 @@ hid_t Log::CreateHDF5Dataset(const string p_Filename, const hid_t p_GroupId, con
                 }
             }
             (void)H5Aclose(h5Attr);                                                                                 // close attribute 
+
+            if (h5Dset >= 0 && p_Precision != HDF5_PRECISION::DOUBLE) {                                             // reduced precision?
+                                                                                                                    // yes - create attribute for precision policy
+                string precisionStr = HDF5_PRECISION_LABEL.at(p_Precision);                                         // precision policy
+                if (p_Precision == HDF5_PRECISION::DIGITS) precisionStr += "=" + std::to_string(p_Digits);          // add digits retained
+
+                hid_t h5PDType = H5Tcopy(H5T_C_S1);                                                                 // HDF5 c-string datatype
+                (void)H5Tset_size(h5PDType, precisionStr.length() + 1);                                             // size is strlen + 1 (for NULL terminator)
+                (void)H5Tset_cset(h5PDType, H5T_CSET_ASCII);                                                        // ASCII (rather than UTF-8)
+                hid_t h5PAttr = H5Acreate(h5Dset, "precision", h5PDType, h5Dspace, H5P_DEFAULT, H5P_DEFAULT);       // create attribute for precision
+                if (h5PAttr < 0 || H5Awrite(h5PAttr, h5PDType, (const void *)precisionStr.c_str()) < 0) {           // attribute created and written ok?
+                    Squawk("ERROR: Unable to write HDF5 attribute precision for dataSet " + h5DsetName);            // no - announce error
+                    h5Dset = -1;                                                                                    // fail
+                }
+                if (h5PAttr >= 0) (void)H5Aclose(h5PAttr);                                                          // close attribute
+                (void)H5Tclose(h5PDType);                                                                           // close datatype
+            }
         }
     }
     (void)H5Sclose(h5CPlist);                                                                                       // close creation property list
@@ -2601,13 +3711,24 @@ LogfileDetailsT Log::StandardLogFileDetails(const LOGFILE p_Logfile, const strin
                                 m_Logfiles[fileDetails.id].h5File.dataSets[idx].dataType   = fileDetails.propertyTypes[idx];                    // record COMPAS data type
                                 m_Logfiles[fileDetails.id].h5File.dataSets[idx].h5DataType = h5DataType;                                        // record HDF5 data type
 
+                                // precision for floating-point columns
+                                HDF5_PRECISION precision = HDF5_PRECISION::DOUBLE;
+                                int            digits    = 0;
+                                if (fileDetails.propertyTypes[idx] == TYPENAME::FLOAT  ||
+                                    fileDetails.propertyTypes[idx] == TYPENAME::DOUBLE ||
+                                    fileDetails.propertyTypes[idx] == TYPENAME::LONGDOUBLE) {
+                                    std::tie(precision, digits) = HDF5ColumnPrecision(p_Logfile, utils::trim(fileDetails.hdrStrings[idx]));
+                                }
+
                                 // create HDF5 dataset
                                 hid_t h5Dset = CreateHDF5Dataset(fileDetails.filename, 
                                                                  m_Logfiles[fileDetails.id].h5File.groupId, 
                                                                  utils::trim(fileDetails.hdrStrings[idx]), 
                                                                  h5DataType, 
                                                                  utils::trim(fileDetails.unitsStrings[idx]),
-                                                                 chunkSize);
+                                                                 chunkSize,
+                                                                 precision,
+                                                                 digits);
                                 if (h5Dset < 0) {                                                                                               // created ok?
                                     ok = false;                                                                                                 // no - fail
                                 }
@@ -2729,6 +3850,116 @@ bool Log::CloseAllStandardFiles() {
 }
 
 
+/*
+ * Flush the write buffers of all open HDF5 logfiles
+ *
+ * Writes the records buffered for each open HDF5 logfile to the file, and releases the buffers.
+ * Called when the memory budget is exceeded (see CheckMemory()) - the buffers are otherwise
+ * written when they hold IOBufSize records (see program options --hdf5-chunk-size and
+ * --hdf5-buffer-size), or when the logfile is closed.
+ *
+ *
+ * bool FlushHDF5Buffers()
+ *
+ * @return                                      True if all buffers were written successfully, false if not
+ */
+bool Log::FlushHDF5Buffers() {
+
+    bool result = true;                                                                                             // default = success
+
+    for (size_t id = 0; id < m_Logfiles.size(); id++) {                                                             // for each logfile
+        if (!IsActiveId(id) || m_Logfiles[id].filetype != LOGFILETYPE::HDF5) continue;                              // active HDF5 logfiles only
+
+        bool buffered = false;                                                                                      // any records buffered?
+        for (auto &dataSet : m_Logfiles[id].h5File.dataSets) {
+            if (dataSet.dataSetId >= 0 && !dataSet.buf.empty()) { buffered = true; break; }
+        }
+
+        if (buffered && !Flush_(id)) result = false;                                                                // flush - flag if fail
+    }
+
+    return result;
+}
+
+
+/*
+ * Check the memory footprint of the run
+ *
+ * Called once for each system (star or binary) evolved.  Every --memory-report-interval systems
+ * a progress line with the memory footprint is written to stdout (see MemorySummary()), and if
+ * --memory-budget is non-zero, the resident set size of the process exceeds the budget, and the
+ * HDF5 write buffers hold at least MEMORY_BUDGET_HDF5_FRACTION of the budget, the HDF5 write
+ * buffers are flushed early (see FlushHDF5Buffers()).
+ *
+ * The resident set size rarely falls once the buffers are released, so once the budget is exceeded
+ * it stays exceeded - the buffered bytes threshold means the buffers are flushed again only when
+ * they have regrown to a significant share of the budget, rather than after every system (which
+ * would write every HDF5 chunk a record or two at a time).
+ *
+ * The resident set size is only queried when a report is due or the buffered bytes threshold is
+ * reached, so this is a counter increment otherwise.
+ *
+ *
+ * void CheckMemory()
+ */
+void Log::CheckMemory() {
+
+    m_MemorySystems++;                                                                                              // one more system evolved
+
+    int  interval   = OPTIONS->MemoryReportInterval();
+    bool report     = interval > 0 && (m_MemorySystems % interval) == 0;                                           // report due?
+    double budget   = OPTIONS->MemoryBudget();                                                                      // MiB
+
+    if (!report && budget <= 0.0) return;                                                                           // nothing to do
+
+    if (budget > 0.0 && (double)m_HDF5BufferedBytes >= budget * 1024.0 * 1024.0 * MEMORY_BUDGET_HDF5_FRACTION) {   // budget set and significant share of it buffered?
+        std::size_t rss;                                                                                            // yes
+        std::tie(rss, std::ignore) = utils::ResidentSetSize();                                                      // current resident set size (bytes)
+
+        if ((double)rss > budget * 1024.0 * 1024.0) {                                                               // budget exceeded?
+            if (!FlushHDF5Buffers()) Squawk("ERROR: Unable to flush HDF5 write buffers");                           // yes - flush
+            m_MemoryBudgetFlushes++;
+        }
+    }
+
+    if (report && !OPTIONS->Quiet()) Say_("Memory after " + std::to_string(m_MemorySystems) + " systems: " + MemorySummary());
+}
+
+
+/*
+ * Summarise the memory footprint of the run
+ *
+ * Returns a one-line summary of the memory footprint: the resident set size of the process (current
+ * and peak), the bytes held in HDF5 write buffers (current and peak, and the peak for a single dataset),
+ * the number of entries in the error catalog, the number of live star objects, and the number of times
+ * the HDF5 write buffers were flushed because the memory budget was exceeded.
+ *
+ *
+ * string MemorySummary()
+ *
+ * @return                                      Memory footprint summary
+ */
+string Log::MemorySummary() {
+
+    constexpr double MiB = 1024.0 * 1024.0;
+
+    std::size_t rss;
+    std::size_t peakRSS;
+    std::tie(rss, peakRSS) = utils::ResidentSetSize();
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1)
+       << "RSS " << (rss / MiB) << " MiB (peak " << (peakRSS / MiB) << " MiB)"
+       << ", HDF5 buffered " << (m_HDF5BufferedBytes / MiB) << " MiB (peak " << (m_HDF5BufferedBytesPeak / MiB) << " MiB"
+       << ", dataset peak " << (m_HDF5DatasetBufferedBytesPeak / MiB) << " MiB)"
+       << ", error catalog " << ERRORS->CatalogEntries() << " entries"
+       << ", live stars " << BaseStar::LiveStars() << " (peak " << BaseStar::LiveStarsPeak() << ")"
+       << ", budget flushes " << m_MemoryBudgetFlushes;
+
+    return ss.str();
+}
+
+
 /*
  * Prints text representation of the specification of a logfile record
  *
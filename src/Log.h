@@ -8,6 +8,8 @@
 #include <chrono>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <cstdint>
 
 #include <boost/filesystem.hpp>
 #include <boost/variant.hpp>
@@ -22,9 +24,17 @@
 
 #include "Options.h"
 #include "LogMacros.h"
+#include "EvolutionOutcomes.h"
+#include "Histogram.h"
+#include "GzipStream.h"
 
 using std::string;
 
+
+// log/debug class ids (see Log::ClassId())
+const int LOG_CLASS_NONE      = -1;                                                 // no class - enabled whichever classes are enabled
+const int LOG_CLASS_MASK_BITS = 64;                                                 // classes with ids below this are checked against the class bitmasks
+
 /*
  * Log Singleton
  *
@@ -313,6 +323,40 @@ public:
 };
 
 
+/*
+ * Convert a boost::variant value to a double
+ *
+ * This is defined as a class for use with boost::apply_visitor().
+ * It is only ever used by the Log class (for histograms and record filters), hence the reason it is defined here.
+ *
+ * Booleans convert to 0.0 or 1.0, and enum values (e.g. stellar types) to their ordinal values.
+ * Strings can't be converted - they return NaN.
+ *
+ */
+class VariantValueAsDouble: public boost::static_visitor<double> {
+public:
+    double operator()(const bool                    v) const { return v ? 1.0 : 0.0; }
+    double operator()(const int                     v) const { return (double)v; }
+    double operator()(const short int               v) const { return (double)v; }
+    double operator()(const long int                v) const { return (double)v; }
+    double operator()(const long long int           v) const { return (double)v; }
+    double operator()(const unsigned int            v) const { return (double)v; }
+    double operator()(const unsigned short int      v) const { return (double)v; }
+    double operator()(const unsigned long int       v) const { return (double)v; }  // also handles OBJECT_ID (typedef)
+    double operator()(const unsigned long long int  v) const { return (double)v; }
+    double operator()(const float                   v) const { return (double)v; }
+    double operator()(const double                  v) const { return v; }
+    double operator()(const long double             v) const { return (double)v; }
+    double operator()(const string                  v) const { return std::numeric_limits<double>::quiet_NaN(); }
+    double operator()(const ERROR                   v) const { return (double)static_cast<int>(v); }
+    double operator()(const STELLAR_TYPE            v) const { return (double)static_cast<int>(v); }
+    double operator()(const MT_CASE                 v) const { return (double)static_cast<int>(v); }
+    double operator()(const MT_TRACKING             v) const { return (double)static_cast<int>(v); }
+    double operator()(const SN_EVENT                v) const { return (double)static_cast<int>(v); }
+    double operator()(const SN_STATE                v) const { return (double)static_cast<int>(v); }
+};
+
+
 class Log {
 
 private:
@@ -331,6 +375,8 @@ private:
         m_LogClasses = {};                                                          // no default log classes
         m_DbgLevel = 0;                                                             // default debug level - debug everything
         m_DbgClasses = {};                                                          // no default debug classes
+        m_LogClassMask = 0;                                                         // no log classes enabled
+        m_DbgClassMask = 0;                                                         // no debug classes enabled
         m_DbgToLogfile = false;                                                     // default is not to log debug records to the log file
         m_DbgLogfileId = -1;                                                        // default is not valid
         m_Logfiles.empty();                                                         // default is no log files
@@ -346,6 +392,12 @@ private:
         m_SSESupernova_LogRecordFmtVector  = {};                                    // SSE Supernova logfile format vector - initially empty
 
         m_OptionDetails = {};                                                       // option details retrieved from commandline - initially empty
+
+        m_HDF5BufferedBytes            = 0;                                         // no HDF5 write buffers initially
+        m_HDF5BufferedBytesPeak        = 0;
+        m_HDF5DatasetBufferedBytesPeak = 0;
+        m_MemorySystems                = 0;                                         // no systems evolved initially
+        m_MemoryBudgetFlushes          = 0;                                         // no memory budget flushes initially
     };
     Log(Log const&) = delete;                                                       // copy constructor does nothing, and not exposed publicly
     Log& operator = (Log const&) = delete;                                          // operator = does nothing, and not exposed publicly
@@ -372,6 +424,11 @@ private:
     int                  m_DbgLevel;                                                // debug level
     std::vector <string> m_DbgClasses;                                              // debug classes
 
+    std::unordered_map<string, int> m_ClassIds;                                     // interned log/debug classes: class name (lowercase) -> class id (see ClassId())
+    std::vector <string> m_ClassNames;                                              // interned log/debug classes, indexed by class id
+    std::uint64_t        m_LogClassMask;                                            // enabled log classes - bit per class id
+    std::uint64_t        m_DbgClassMask;                                            // enabled debug classes - bit per class id
+
     bool                 m_DbgToLogfile;                                            // log debug records to log file?
     int                  m_DbgLogfileId;                                            // log file id of file to which debug statements should be written
 
@@ -408,6 +465,7 @@ private:
         bool        label;                                                          // record labels enabled?
 
         std::ofstream file;                                                         // file pointer for CSV, TSV, TXT files
+        std::unique_ptr<GzipStream> gzFile;                                         // compressed stream for CSV, TSV, TXT files (see program option --logfile-compression)
 
         h5AttrT h5File;                                                             // file details for HDF5 files
     };
@@ -434,6 +492,40 @@ private:
     ANY_PROPERTY_VECTOR m_SSE_SysParms_Rec    = SSE_SYSTEM_PARAMETERS_REC;          // default specification
 
 
+    std::vector<Histogram> m_Histograms;                                            // histograms (aggregation sinks) - see program option --histogram
+
+    EvolutionOutcomes      m_EvolutionOutcomes;                                     // evolution outcomes (population summary)
+
+
+    // the following block of variables support reduced-precision floating-point columns in HDF5 logfiles (see program option --hdf5-precision)
+
+    typedef struct HDF5PrecisionSpec {
+        LOGFILE             logfile;                                                // the logfile to which the specification applies (LOGFILE::NONE = all logfiles)
+        HDF5_PRECISION      precision;                                              // the precision policy
+        int                 digits;                                                 // decimal digits retained (HDF5_PRECISION::DIGITS only)
+        std::vector<string> columns;                                                // the columns (dataset names) to which the specification applies (empty = all floating-point columns)
+    } HDF5PrecisionSpecT;
+
+    std::vector<HDF5PrecisionSpecT> m_HDF5Precision;                                // precision specifications - later specifications take precedence
+
+
+    // the following block of variables support record filters for the standard logfiles (see program option --logfile-filter)
+    //
+    // The records produced for a filtered logfile during the evolution of a star or binary are staged in memory, and
+    // written (or discarded) by ReleaseStagedRecords() when evolution ends - depending upon whether the final state of
+    // the star or binary satisfies the filter.
+
+    typedef struct StagedRecord {
+        int                               fileId;                                   // id of the (open) logfile to which the record is to be written
+        LOGFILE                           logfile;                                  // the logfile to which the record is to be written
+        string                            record;                                   // the record - CSV, TSV, and TXT files
+        std::vector<COMPAS_VARIABLE_TYPE> values;                                   // the record - HDF5 files
+    } StagedRecordT;
+
+    std::map<LOGFILE, std::vector<PropertyFilterT>> m_LogfileFilters;              // filter terms, per logfile - all must be satisfied for records to be written
+    std::vector<StagedRecordT>                      m_StagedRecords;               // records staged for filtered logfiles
+
+
     // the following block of variables support the BSE Switch Log file
     
     OBJECT_ID    m_ObjectIdSwitching;                                               // the object id of the Star object switching stellar type
@@ -455,6 +547,18 @@ private:
     std::vector<string> m_SSESupernova_LogRecordFmtVector;                          // SSE Supernova logfile format vector
     
   
+    // the following block of variables support memory footprint reporting (see program options --memory-report-interval
+    // and --memory-budget).  The bytes held in HDF5 write buffers are the capacity of the buffers (the buffers hold
+    // COMPAS_VARIABLE_TYPE values - strings held in the buffers may hold more memory, but the columns of the standard
+    // logfiles are mostly numeric).
+
+    size_t m_HDF5BufferedBytes;                                                     // bytes held in the HDF5 write buffers of the open logfiles
+    size_t m_HDF5BufferedBytesPeak;                                                 // peak of m_HDF5BufferedBytes
+    size_t m_HDF5DatasetBufferedBytesPeak;                                          // peak bytes held in the write buffer of a single dataset
+    size_t m_MemorySystems;                                                         // number of systems (stars/binaries) evolved - counted by CheckMemory()
+    int    m_MemoryBudgetFlushes;                                                   // number of times the HDF5 write buffers were flushed because the memory budget was exceeded
+
+
     // the following block of variables support the run details file
 
     std::ofstream                                      m_RunDetailsFile;            // run details file
@@ -477,11 +581,26 @@ private:
             m_Logfiles[p_LogfileId].label           = false;
             m_Logfiles[p_LogfileId].h5File.fileId   = -1;
             m_Logfiles[p_LogfileId].h5File.groupId  = -1;
+            for (auto &dataSet : m_Logfiles[p_LogfileId].h5File.dataSets) {         // write buffers released (should be empty - flushed when the file was closed)
+                m_HDF5BufferedBytes -= dataSet.buf.capacity() * sizeof(COMPAS_VARIABLE_TYPE);
+            }
             m_Logfiles[p_LogfileId].h5File.dataSets = {};
+            m_Logfiles[p_LogfileId].gzFile.reset();                                 // closes the compressed stream if open
         }
     }
 
-    bool DoIt(const string p_Class, const int p_Level, const std::vector<string> p_EnabledClasses, const int p_EnabledLevel);
+    std::uint64_t ClassMask(const std::vector<string>& p_Classes);
+
+    bool DoIt(const string& p_Class, const int p_Level, const std::vector<string>& p_EnabledClasses, const int p_EnabledLevel) const;
+
+    // as DoIt(), for an interned class - the class is checked against the class bitmask
+    bool DoIt(const int p_ClassId, const int p_Level, const std::uint64_t p_EnabledMask, const std::vector<string>& p_EnabledClasses, const int p_EnabledLevel) const {
+        if (p_Level > p_EnabledLevel) return false;                                 // level not enabled
+        if (p_ClassId == LOG_CLASS_NONE || p_EnabledClasses.empty()) return true;   // class not restricted
+        if (p_ClassId < LOG_CLASS_MASK_BITS) return (p_EnabledMask >> p_ClassId) & 1;
+        return DoIt(m_ClassNames[p_ClassId], p_Level, p_EnabledClasses, p_EnabledLevel); // too many classes for the bitmask - compare names
+    }
+
     void Say_(const string p_SayStr);
     bool Write_(const int p_LogfileId, const string p_LogStr);
     bool Write_(const int p_LogfileId, const std::vector<COMPAS_VARIABLE_TYPE> p_LogRecordValues, const bool p_Flush = false);
@@ -498,11 +617,22 @@ private:
     STR_STR_STR_STR  FormatFieldHeaders(PROPERTY_DETAILS p_Details, string p_HeaderSuffix = "");
     LogfileDetailsT  StandardLogFileDetails(const LOGFILE p_Logfile, const string p_FileSuffix);
 
+    std::tuple<ERROR, T_ANY_PROPERTY> ParsePropertySpecifier(const string p_Specifier, const LOGFILE_TYPE p_LogfileType);
+    std::tuple<ERROR, PropertyFilterT> ParseRecordFilter(const string p_Filter, const LOGFILE_TYPE p_LogfileType);
+    bool ConfigureHistograms();
+    bool ConfigureLogfileFilters();
+    bool ConfigureHDF5Precision();
+    std::tuple<HDF5_PRECISION, int> HDF5ColumnPrecision(const LOGFILE p_Logfile, const string p_Column);
+
     std::tuple<bool, LOGFILE> GetLogfileDescriptorKey(const string p_Value);
+    std::tuple<bool, LOGFILE> GetLogfileShortNameKey(const string p_Value);
     std::tuple<bool, LOGFILE> GetStandardLogfileKey(const int p_FileId);
 
     bool  OpenHDF5RunDetailsFile(const string p_Filename = RUN_DETAILS_FILE_NAME);
-    hid_t CreateHDF5Dataset(const string p_Filename, const hid_t p_GroupId, const string p_DatasetName, const hid_t p_H5DataType, const string p_UnitsStr, const size_t p_HDF5ChunkSize);
+
+    bool StoreInputFile(const string p_Filename, const string p_Description, const string p_DstPath);
+    bool ReflinkFile(const string p_SrcFilename, const string p_DstFilename);
+    hid_t CreateHDF5Dataset(const string p_Filename, const hid_t p_GroupId, const string p_DatasetName, const hid_t p_H5DataType, const string p_UnitsStr, const size_t p_HDF5ChunkSize, const HDF5_PRECISION p_Precision = HDF5_PRECISION::DOUBLE, const int p_Digits = 0);
     hid_t GetHDF5DataType(const TYPENAME p_COMPASdatatype, const int p_FieldWidth = 0);
 
 
@@ -685,6 +815,39 @@ private:
     }
 
 
+    /*
+     * Update the histograms attached to a standard logfile
+     *
+     * This function is called for each record produced for a standard logfile, whether or not the
+     * record is written to the logfile.  The values of the properties required by each histogram
+     * attached to the logfile are retrieved from the object being logged (as numbers - see
+     * VariantValueAsDouble) and passed to the histogram.
+     *
+     *
+     * template <class T>
+     * void UpdateHistograms(const LOGFILE p_LogFile, const T* const p_Star)
+     *
+     * @param   [IN]    p_LogFile                   The logfile for which the record was produced
+     * @param   [IN]    p_Star                      The object from which the property values should be retrieved
+     */
+    template <class T>
+    void UpdateHistograms(const LOGFILE p_LogFile, const T* const p_Star) {
+
+        for (auto& histogram: m_Histograms) {                                                                                           // for each histogram
+            if (histogram.Logfile() != p_LogFile) continue;                                                                             // not attached to this logfile
+
+            DBL_VECTOR values = {};
+            for (auto& property: histogram.Properties()) {                                                                              // for each property required
+                bool                 ok;
+                COMPAS_VARIABLE_TYPE value;
+                std::tie(ok, value) = p_Star->PropertyValue(property);                                                                  // get property flag and value
+                values.push_back(ok ? boost::apply_visitor(VariantValueAsDouble(), value) : std::numeric_limits<double>::quiet_NaN());
+            }
+            histogram.Add(values);
+        }
+    }
+
+
     /*
      * Write a record to a standard logfile
      *
@@ -702,6 +865,12 @@ private:
      * file status (open, closed) and contents, will be unchanged by this function.  Similarly, if the
      * log level for this record indicates that the record should not be logged, no changes will be made
      * by this function.
+     *
+     * Any histograms attached to the logfile are updated with the record.  If program option
+     * --histograms-only is specified the record is not written to the logfile (and the logfile is not opened).
+     *
+     * If the logfile is filtered (see program option --logfile-filter) the record is staged, rather than
+     * written, and is written (or discarded) by ReleaseStagedRecords() when evolution ends.
      * 
      *
      * template <class T>
@@ -738,6 +907,9 @@ private:
                            const string   p_LogRecord,
                            const string   p_FileSuffix = "") {
 
+        if (!m_Histograms.empty()) UpdateHistograms(p_LogFile, p_Star);                                                                 // update histograms attached to this logfile
+        if (OPTIONS->HistogramsOnly()) return true;                                                                                     // per-record output not required
+
         bool ok = true;
 
         LogfileDetailsT fileDetails;                                                                                                    // file details
@@ -842,7 +1014,10 @@ private:
             }
 
             if (ok) {                                                                                                                   // if all ok, write the record
-                if (m_Logfiles[fileDetails.id].filetype == LOGFILETYPE::HDF5) {                                                         // HDF5 file?
+                if (!m_LogfileFilters.empty() && m_LogfileFilters.find(p_LogFile) != m_LogfileFilters.end()) {                          // filtered logfile?
+                    m_StagedRecords.push_back({fileDetails.id, p_LogFile, logRecord, logRecordValues});                                 // yes - stage the record until evolution ends
+                }
+                else if (m_Logfiles[fileDetails.id].filetype == LOGFILETYPE::HDF5) {                                                    // HDF5 file?
                     ok = Put_(fileDetails.id, logRecordValues);                                                                         // yes - write the record
                 }
                 else {                                                                                                                  // no - CSV, TSV, or TXT file
@@ -892,20 +1067,42 @@ public:
 
     bool   Enabled() const { return m_Enabled; }
 
+    void   CheckMemory();
+    bool   FlushHDF5Buffers();
+    string MemorySummary();
+
+    bool   WriteSummaryTable(const string p_TableName, const std::vector<SummaryTableColumnT> p_Columns);
+    bool   WriteHistograms();
+
+    void   RecordEvolutionOutcome(const EVOLUTION_STATUS p_Status,
+                                  const STELLAR_TYPE     p_StellarType1,
+                                  const STELLAR_TYPE     p_StellarType2,
+                                  const ERROR            p_Error,
+                                  const double           p_WallSeconds)    { m_EvolutionOutcomes.Record(p_Status, p_StellarType1, p_StellarType2, p_Error, p_WallSeconds); }
+    bool   WriteEvolutionOutcomes();
+
     int    Open(const string p_LogFileName, const bool p_Append, const bool p_TimeStamp, const bool p_Label, const LOGFILE p_StandardLogfile = LOGFILE::NONE);
     bool   Close(const int p_LogfileId);
 
+    int    ClassId(const string& p_Class);
+    bool   DebugEnabled(const int p_ClassId, const int p_DbgLevel) const { return m_Enabled && DoIt(p_ClassId, p_DbgLevel, m_DbgClassMask, m_DbgClasses, m_DbgLevel); }
+    bool   LogEnabled(const int p_ClassId, const int p_LogLevel) const   { return m_Enabled && DoIt(p_ClassId, p_LogLevel, m_LogClassMask, m_LogClasses, m_LogLevel); }
+
     bool   Write(const int p_LogfileId, const string p_LogClass, const int p_LogLevel, const string p_LogStr);
     bool   Put(const int p_LogfileId, const string p_LogClass, const int p_LogLevel, const string p_LogStr);
+    bool   Put(const int p_LogfileId, const int p_LogClassId, const int p_LogLevel, const string p_LogStr);
 
     bool   Debug(const string p_DbgClass, const int p_DbgLevel, const string p_DbgStr);
+    bool   Debug(const int p_DbgClassId, const int p_DbgLevel, const string p_DbgStr);
     bool   DebugWait(const string p_DbgClass, const int p_DbgLevel, const string p_DbgStr);
+    bool   DebugWait(const int p_DbgClassId, const int p_DbgLevel, const string p_DbgStr);
 
     bool   Error(const string p_ErrStr);
 
     void   Squawk(const string squawkStr);
 
     void   Say(const string p_SayClass, const int p_SayLevel, const string p_SayStr);
+    void   Say(const int p_SayClassId, const int p_SayLevel, const string p_SayStr);
 
 
     // SetSwitchParameters is called by Star::SwitchTo to set the parameters 
@@ -1004,6 +1201,63 @@ public:
 
         return result;
     }
+
+
+    /*
+     * Write (or discard) the records staged for the filtered standard logfiles
+     *
+     * This function should be called when the evolution of a star (SSE) or binary (BSE) ends, after
+     * its last record has been logged.  The filter terms of each filtered logfile (see program option
+     * --logfile-filter) are evaluated on the final state of the star or binary: if all are satisfied
+     * the records staged for the logfile are written to it, in the order they were produced, otherwise
+     * they are discarded.  A filter term is not satisfied if the property value is not a number.
+     *
+     *
+     * template <class T>
+     * bool ReleaseStagedRecords(const T* const p_Star)
+     *
+     * @param   [IN]    p_Star                      The star or binary (final state) on which the filters are evaluated
+     * @return                                      Boolean status (true = success, false = failure)
+     */
+    template <class T>
+    bool ReleaseStagedRecords(const T* const p_Star) {
+
+        if (m_StagedRecords.empty()) return true;                                                                                       // nothing to do
+
+        std::map<LOGFILE, bool> passes;                                                                                                 // filter result per logfile
+        for (auto& iter: m_LogfileFilters) {                                                                                            // for each filtered logfile
+            bool pass = true;
+            for (auto& filter: iter.second) {                                                                                           // for each filter term
+                bool                 ok;
+                COMPAS_VARIABLE_TYPE value;
+                std::tie(ok, value) = p_Star->PropertyValue(filter.property);                                                           // get property flag and value
+                if (!ok || !utils::FilterPasses(filter, boost::apply_visitor(VariantValueAsDouble(), value))) {
+                    pass = false;                                                                                                       // filter term not satisfied
+                    break;
+                }
+            }
+            passes[iter.first] = pass;
+        }
+
+        bool result = true;
+        for (auto& staged: m_StagedRecords) {                                                                                           // for each staged record
+            if (!passes[staged.logfile]) continue;                                                                                      // filtered out - discard
+
+            bool ok = false;
+            if (IsActiveId(staged.fileId) && m_Logfiles[staged.fileId].logfiletype == staged.logfile) {                                 // logfile still open?
+                ok = m_Logfiles[staged.fileId].filetype == LOGFILETYPE::HDF5                                                            // yes - write the record
+                        ? Put_(staged.fileId, staged.values)
+                        : Put_(staged.fileId, staged.record);
+            }
+            if (!ok) {
+                Squawk(ERR_MSG(ERROR::FILE_WRITE_ERROR) + " while writing staged record to logfile " + std::get<0>(LOGFILE_DESCRIPTOR.at(staged.logfile)));
+                result = false;
+            }
+        }
+        m_StagedRecords.clear();                                                                                                        // done with staged records
+
+        return result;
+    }
 };
 
 #endif // __Log_h__
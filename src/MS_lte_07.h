@@ -29,6 +29,8 @@ public:
 
 protected:
 
+    friend class Star;                                                                      // so Star can call member functions directly (see STAR_DISPATCH in Star.h)
+
     void Initialise() {
         m_StellarType = STELLAR_TYPE::MS_LTE_07;                                                    // Set stellar type
         CalculateTimescales();                                                                      // Initialise timescales
@@ -139,7 +139,7 @@ double NS::CalculatePulsarBirthSpinPeriod_Static() {
             double mean  = 300.0;
             double sigma = 150.0;
 
-            do { pSpin = RAND->RandomGaussian(sigma) + mean;} while (utils::Compare(pSpin, 0.0) < 0);
+            pSpin = RAND->RandomTruncatedGaussian(mean, sigma, 0.0, std::numeric_limits<double>::infinity());         // spin period can't be negative
 
             } break;
 
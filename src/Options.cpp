@@ -47,7 +47,8 @@
 /*    in Options.cpp.  It is also here you can set any final values that, perhaps due to  */
 /*    dependencies on options that had not yet been parsed, could not be set directly by  */
 /*    Boost when the options were parsed (also see SetCalculatedOptionDefaults(); viz.    */
-/*    m_KickPhi1 etc.).                                                                   */
+/*    m_Drawn.kickPhi1 etc. - per-system drawn values are held in m_Drawn, not in the     */
+/*    Boost variables map).                                                               */
 /*                                                                                        */
 /* 9. Add the new option to one or more of the following vectors in Options.h, as         */
 /*    required:                                                                           */
@@ -139,10 +140,18 @@ void Options::OptionValues::Initialise() {
     m_EnableWarnings                                                = false;
 
 	m_BeBinaries                                                    = false;
+    m_BeBinarySampling.type                                         = LOGFILE_SAMPLING::ALL;
+    m_BeBinarySampling.typeString                                   = LOGFILE_SAMPLING_LABEL.at(m_BeBinarySampling.type);
     m_EvolvePulsars                                                 = false;
+    m_PulsarEvolutionSampling.type                                  = LOGFILE_SAMPLING::ALL;
+    m_PulsarEvolutionSampling.typeString                            = LOGFILE_SAMPLING_LABEL.at(m_PulsarEvolutionSampling.type);
 	m_EvolveUnboundSystems                                          = false;
 
     m_DetailedOutput                                                = false;
+    m_DetailedOutputInterval                                        = 0.0;
+    m_DetailedOutputTolerance                                       = 0.0;
+    m_LogfileSamplingLogTimeStep                                    = 0.05;
+    m_LogfileSamplingTolerance                                      = 0.01;
     m_PopulationDataPrinting                                        = false;
     m_PrintBoolAsString                                             = false;
     m_Quiet                                                         = false;
@@ -151,10 +160,35 @@ void Options::OptionValues::Initialise() {
     m_ShortHelp                                                     = true;
 
     m_StoreInputFiles                                               = true;
+    m_StoreInputFilesMode.type                                      = STORE_INPUT_FILES_MODE::COPY;
+    m_StoreInputFilesMode.typeString                                = STORE_INPUT_FILES_MODE_LABEL.at(m_StoreInputFilesMode.type);
 
     m_SwitchLog                                                     = false;
 
 
+    // Adaptive Importance Sampling (AIS) options
+    m_AdaptiveImportanceSampling                                    = false;
+    m_AISDCOType.type                                               = AIS_DCO_TYPE::ALL;
+    m_AISDCOType.typeString                                         = AIS_DCO_TYPE_LABEL.at(m_AISDCOType.type);
+    m_AISExploratoryFraction                                        = 0.25;
+    m_AISHubble                                                     = true;
+    m_AISKappa                                                      = 1.0;
+    m_AISPessimistic                                                = false;
+    m_AISRLOF                                                       = false;
+
+    // Convergence-driven stopping options
+    m_ConvergenceHubble                                             = true;
+    m_ConvergenceOutcome.type                                       = CONVERGENCE_OUTCOME::NONE;
+    m_ConvergenceOutcome.typeString                                 = CONVERGENCE_OUTCOME_LABEL.at(m_ConvergenceOutcome.type);
+    m_ConvergenceReportInterval                                     = 1000;
+    m_ConvergenceTolerance                                          = 0.1;
+    m_ConvergenceWeighted                                           = true;
+
+    // Quasi-random sampling options
+    m_QuasiRandomScrambleSeed                                       = 0;
+    m_QuasiRandomSequence.type                                      = QUASI_RANDOM_SEQUENCE::NONE;
+    m_QuasiRandomSequence.typeString                                = QUASI_RANDOM_SEQUENCE_LABEL.at(m_QuasiRandomSequence.type);
+
     // Evolution mode: SSE or BSE
     m_EvolutionMode.type                                            = EVOLUTION_MODE::BSE;
     m_EvolutionMode.typeString                                      = EVOLUTION_MODE_LABEL.at(m_EvolutionMode.type);
@@ -170,6 +204,9 @@ void Options::OptionValues::Initialise() {
     m_MaxNumberOfTimestepIterations                                 = 99999;
     m_TimestepMultiplier                                            = 1.0;
 
+    m_MemoryBudget                                                  = 0.0;
+    m_MemoryReportInterval                                          = 0;
+
     // Initial mass options
     m_InitialMass                                                   = 5.0;
     m_InitialMass1                                                  = 5.0;
@@ -272,6 +309,9 @@ void Options::OptionValues::Initialise() {
     m_KickTheta1                                                    = 0.0;                                                  // actual value set later 
     m_KickTheta2                                                    = 0.0;                                                  // actual value set later
 
+    // Per-system drawn values (see SetCalculatedOptionDefaults())
+    m_Drawn                                                         = {};
+
     // Black hole kicks
     m_BlackHoleKicks.type                                           = BLACK_HOLE_KICKS::FALLBACK;
     m_BlackHoleKicks.typeString                                     = BLACK_HOLE_KICKS_LABEL.at(m_BlackHoleKicks.type);
@@ -488,6 +528,11 @@ void Options::OptionValues::Initialise() {
     m_GridStartLine                                                 = 0;
     m_GridLinesToProcess                                            = std::numeric_limits<std::streamsize>::max();                  // effectively no limit - process to EOF
 
+
+    // remnant table
+
+    m_RemnantTableFilename                                          = "";
+
     // debug and logging options
 
     m_DebugLevel                                                    = 0;
@@ -496,11 +541,19 @@ void Options::OptionValues::Initialise() {
     m_LogLevel                                                      = 0;
     m_LogClasses.clear();
 
+    m_Histograms.clear();
+    m_HistogramsOnly                                                = false;
+
+    m_LogfileFilters.clear();
+
     // Logfiles    
     m_LogfileDefinitionsFilename                                    = "";
     m_LogfileNamePrefix                                             = "";
     m_LogfileType.type                                              = LOGFILETYPE::HDF5;
     m_LogfileType.typeString                                        = LOGFILETYPELabel.at(m_LogfileType.type);
+    m_LogfileCompression.type                                       = LOGFILE_COMPRESSION::NONE;
+    m_LogfileCompression.typeString                                 = LOGFILE_COMPRESSION_LABEL.at(m_LogfileCompression.type);
+    m_LogfileCompressionBlockSize                                   = DEFAULT_LOGFILE_COMPRESSION_BLOCK_SIZE;
 
     m_LogfileBeBinaries                                             = get<0>(LOGFILE_DESCRIPTOR.at(LOGFILE::BSE_BE_BINARIES));
     m_LogfileCommonEnvelopes                                        = get<0>(LOGFILE_DESCRIPTOR.at(LOGFILE::BSE_COMMON_ENVELOPES));
@@ -517,6 +570,7 @@ void Options::OptionValues::Initialise() {
     
     m_HDF5BufferSize                                                = HDF5_DEFAULT_IO_BUFFER_SIZE;
     m_HDF5ChunkSize                                                 = HDF5_DEFAULT_CHUNK_SIZE;
+    m_HDF5Precision.clear();
 
     po::variables_map vm;
     m_VM = vm;
@@ -595,6 +649,26 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
 
         // boolean options - alphabetically
 
+        (
+            "adaptive-importance-sampling",                                         
+            po::value<bool>(&p_Options->m_AdaptiveImportanceSampling)->default_value(p_Options->m_AdaptiveImportanceSampling)->implicit_value(true),                                              
+            ("Sample initial masses and semi-major axes using Adaptive Importance Sampling (STROOPWAFEL) (default = " + std::string(p_Options->m_AdaptiveImportanceSampling ? "TRUE" : "FALSE") + ")").c_str()
+        )
+        (
+            "ais-hubble",                                         
+            po::value<bool>(&p_Options->m_AISHubble)->default_value(p_Options->m_AISHubble)->implicit_value(true),                                                                                
+            ("AIS: only count DCOs that merge within a Hubble time as hits (default = " + std::string(p_Options->m_AISHubble ? "TRUE" : "FALSE") + ")").c_str()
+        )
+        (
+            "ais-pessimistic",                                         
+            po::value<bool>(&p_Options->m_AISPessimistic)->default_value(p_Options->m_AISPessimistic)->implicit_value(true),                                                                      
+            ("AIS: exclude DCOs that survived an optimistic common envelope from hits (default = " + std::string(p_Options->m_AISPessimistic ? "TRUE" : "FALSE") + ")").c_str()
+        )
+        (
+            "ais-rlof",                                         
+            po::value<bool>(&p_Options->m_AISRLOF)->default_value(p_Options->m_AISRLOF)->implicit_value(true),                                                                                    
+            ("AIS: exclude DCOs that experienced immediate RLOF post common envelope from hits (default = " + std::string(p_Options->m_AISRLOF ? "TRUE" : "FALSE") + ")").c_str()
+        )
         (
             "allow-rlof-at-birth",                                         
             po::value<bool>(&p_Options->m_AllowRLOFAtBirth)->default_value(p_Options->m_AllowRLOFAtBirth)->implicit_value(true),                                                                  
@@ -634,6 +708,16 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<bool>(&p_Options->m_AllowMainSequenceStarToSurviveCommonEnvelope)->default_value(p_Options->m_AllowMainSequenceStarToSurviveCommonEnvelope)->implicit_value(true),          
             ("Allow main sequence stars to survive common envelope evolution (default = " + std::string(p_Options->m_AllowMainSequenceStarToSurviveCommonEnvelope ? "TRUE" : "FALSE") + ")").c_str()
         )
+        (
+            "convergence-hubble",                 
+            po::value<bool>(&p_Options->m_ConvergenceHubble)->default_value(p_Options->m_ConvergenceHubble)->implicit_value(true),                                                                
+            ("Convergence: only count DCOs that merge within a Hubble time towards the outcome rate (default = " + std::string(p_Options->m_ConvergenceHubble ? "TRUE" : "FALSE") + ")").c_str()
+        )
+        (
+            "convergence-weighted",                 
+            po::value<bool>(&p_Options->m_ConvergenceWeighted)->default_value(p_Options->m_ConvergenceWeighted)->implicit_value(true),                                                            
+            ("Convergence: weight systems by their importance sampling weight when estimating the outcome rate (default = " + std::string(p_Options->m_ConvergenceWeighted ? "TRUE" : "FALSE") + ")").c_str()
+        )
         (
             "cool-wind-mass-loss-multiplier",                           
             po::value<double>(&p_Options->m_CoolWindMassLossMultiplier)->default_value(p_Options->m_CoolWindMassLossMultiplier),                                                                  
@@ -669,6 +753,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<bool>(&p_Options->m_EvolveUnboundSystems)->default_value(p_Options->m_EvolveUnboundSystems)->implicit_value(true),                                                          
             ("Continue evolving stars even if the binary is disrupted (default = " + std::string(p_Options->m_EvolveUnboundSystems ? "TRUE" : "FALSE") + ")").c_str()
         )
+        (
+            "histograms-only",                                      
+            po::value<bool>(&p_Options->m_HistogramsOnly)->default_value(p_Options->m_HistogramsOnly)->implicit_value(true),                                                                      
+            ("Only write histograms (see --histogram) - don't write records to the standard logfiles (default = " + std::string(p_Options->m_HistogramsOnly ? "TRUE" : "FALSE") + ")").c_str()
+        )
         (
             "mass-transfer",                                                
             po::value<bool>(&p_Options->m_UseMassTransfer)->default_value(p_Options->m_UseMassTransfer)->implicit_value(true),                                                                    
@@ -731,6 +820,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
 
         // unsigned long
 
+        (
+            "quasi-random-scramble-seed",                                                 
+            po::value<unsigned long>(&p_Options->m_QuasiRandomScrambleSeed)->default_value(p_Options->m_QuasiRandomScrambleSeed),                                                                 
+            ("Seed for the scrambling of the quasi-random sequence - use the same value for all runs of a population (default = " + std::to_string(p_Options->m_QuasiRandomScrambleSeed) + ")").c_str()
+        )
         (
             "random-seed",                                                 
             po::value<unsigned long>(&p_Options->m_RandomSeed)->default_value(p_Options->m_RandomSeed),                                                                                           
@@ -740,6 +834,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
 
         // int / unsigned int
 
+        (
+            "convergence-report-interval",                                                 
+            po::value<int>(&p_Options->m_ConvergenceReportInterval)->default_value(p_Options->m_ConvergenceReportInterval),                                                                       
+            ("Convergence: number of systems between progress reports of the outcome rate estimate (0 = no progress reports) (default = " + std::to_string(p_Options->m_ConvergenceReportInterval) + ")").c_str()
+        )
         (
             "debug-level",                                                 
             po::value<int>(&p_Options->m_DebugLevel)->default_value(p_Options->m_DebugLevel),                                                                                                     
@@ -765,6 +864,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<int>(&p_Options->m_HDF5BufferSize)->default_value(p_Options->m_HDF5BufferSize),                                                                                                     
             ("HDF5 file dataset IO buffer size (number of chunks, default = " + std::to_string(p_Options->m_HDF5BufferSize) + ")").c_str()
         )
+        (
+            "logfile-compression-block-size",                                                 
+            po::value<int>(&p_Options->m_LogfileCompressionBlockSize)->default_value(p_Options->m_LogfileCompressionBlockSize),                                                                             
+            ("Uncompressed block size for compressed logfiles (KiB, default = " + std::to_string(p_Options->m_LogfileCompressionBlockSize) + ")").c_str()
+        )
         (
             "log-level",                                                   
             po::value<int>(&p_Options->m_LogLevel)->default_value(p_Options->m_LogLevel),                                                                                                         
@@ -775,6 +879,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<int>(&p_Options->m_MaxNumberOfTimestepIterations)->default_value(p_Options->m_MaxNumberOfTimestepIterations),                                                               
             ("Maximum number of timesteps to evolve binary before giving up (default = " + std::to_string(p_Options->m_MaxNumberOfTimestepIterations) + ")").c_str()
         )
+        (
+            "memory-report-interval",                                      
+            po::value<int>(&p_Options->m_MemoryReportInterval)->default_value(p_Options->m_MemoryReportInterval),                                                                                 
+            ("Number of systems between memory footprint reports (0 = no reports) (default = " + std::to_string(p_Options->m_MemoryReportInterval) + ")").c_str()
+        )
         (
             "number-of-systems,n",                                        
             po::value<int>(&p_Options->m_ObjectsToEvolve)->default_value(p_Options->m_ObjectsToEvolve),                                                                                                       
@@ -784,6 +893,16 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
 
         // double
 
+        (
+            "ais-exploratory-fraction",                                       
+            po::value<double>(&p_Options->m_AISExploratoryFraction)->default_value(p_Options->m_AISExploratoryFraction),                                                                          
+            ("AIS: fraction of systems evolved in the exploratory phase, and prior weight of the refinement mixture (default = " + std::to_string(p_Options->m_AISExploratoryFraction) + ")").c_str()
+        )
+        (
+            "ais-kappa",                                       
+            po::value<double>(&p_Options->m_AISKappa)->default_value(p_Options->m_AISKappa),                                                                                                      
+            ("AIS: scale factor for the width of the refinement Gaussians (default = " + std::to_string(p_Options->m_AISKappa) + ")").c_str()
+        )
         (
             "common-envelope-alpha",                                       
             po::value<double>(&p_Options->m_CommonEnvelopeAlpha)->default_value(p_Options->m_CommonEnvelopeAlpha),                                                                                
@@ -829,6 +948,31 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<double>(&p_Options->m_CommonEnvelopeSlopeKruckow)->default_value(p_Options->m_CommonEnvelopeSlopeKruckow),                                                                  
             ("Common Envelope slope for Kruckow lambda (default = " + std::to_string(p_Options->m_CommonEnvelopeSlopeKruckow) + ")").c_str()
         )
+        (
+            "convergence-tolerance",                               
+            po::value<double>(&p_Options->m_ConvergenceTolerance)->default_value(p_Options->m_ConvergenceTolerance),                                                                              
+            ("Convergence: stop evolving systems once the relative uncertainty of the outcome rate estimate is below this value (default = " + std::to_string(p_Options->m_ConvergenceTolerance) + ")").c_str()
+        )
+        (
+            "detailed-output-interval",                               
+            po::value<double>(&p_Options->m_DetailedOutputInterval)->default_value(p_Options->m_DetailedOutputInterval),                                                                          
+            ("Detailed output decimation: maximum time between BSE detailed output records in Myr, 0 = no maximum (default = " + std::to_string(p_Options->m_DetailedOutputInterval) + ")").c_str()
+        )
+        (
+            "detailed-output-tolerance",                               
+            po::value<double>(&p_Options->m_DetailedOutputTolerance)->default_value(p_Options->m_DetailedOutputTolerance),                                                                        
+            ("Detailed output decimation: relative change in monitored properties that triggers a BSE detailed output record, 0 = every timestep (default = " + std::to_string(p_Options->m_DetailedOutputTolerance) + ")").c_str()
+        )
+        (
+            "logfile-sampling-log-time-step",                               
+            po::value<double>(&p_Options->m_LogfileSamplingLogTimeStep)->default_value(p_Options->m_LogfileSamplingLogTimeStep),                                                                  
+            ("Logfile sampling: step in log10(time) between BSE pulsar evolution and Be binary records for sampling LOG_TIME (default = " + std::to_string(p_Options->m_LogfileSamplingLogTimeStep) + ")").c_str()
+        )
+        (
+            "logfile-sampling-tolerance",                               
+            po::value<double>(&p_Options->m_LogfileSamplingTolerance)->default_value(p_Options->m_LogfileSamplingTolerance),                                                                      
+            ("Logfile sampling: relative change in monitored properties that triggers a BSE pulsar evolution or Be binary record for sampling CHANGE (default = " + std::to_string(p_Options->m_LogfileSamplingTolerance) + ")").c_str()
+        )
 
         // AVG - 17/03/2020 - Uncomment mass-ratio options when fully implemented
         /*
@@ -1124,6 +1268,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<double>(&p_Options->m_mCBUR1)->default_value(p_Options->m_mCBUR1),                                                                                                          
             ("MCBUR1: Min core mass at BAGB to avoid fully degenerate CO core  (default = " + std::to_string(p_Options->m_mCBUR1) + ")").c_str()
         )
+        (
+            "memory-budget",                                               
+            po::value<double>(&p_Options->m_MemoryBudget)->default_value(p_Options->m_MemoryBudget),                                                                                              
+            ("Memory budget in MiB: HDF5 write buffers are flushed early while the resident set size exceeds it and the buffers hold at least a tenth of it (0 = no budget) (default = " + std::to_string(p_Options->m_MemoryBudget) + ")").c_str()
+        )
         (
             "metallicity,z",                                               
             po::value<double>(&p_Options->m_Metallicity)->default_value(p_Options->m_Metallicity),                                                                                                
@@ -1309,6 +1458,17 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_AddOptionsToSysParms.typeString)->default_value(p_Options->m_AddOptionsToSysParms.typeString),                                                                              
             ("Add program options columns to BSE/SSE SysParms file (options: [ALWAYS, GRID, NEVER], default = " + p_Options->m_AddOptionsToSysParms.typeString + ")").c_str()
         )
+        (
+            "ais-dco-type",                                            
+            po::value<std::string>(&p_Options->m_AISDCOType.typeString)->default_value(p_Options->m_AISDCOType.typeString),                                                                      
+            ("AIS: type of double compact object counted as a hit (options: [ALL, BBH, BNS, BHNS], default = " + p_Options->m_AISDCOType.typeString + ")").c_str()
+        )
+
+        (
+            "be-binary-sampling",                                            
+            po::value<std::string>(&p_Options->m_BeBinarySampling.typeString)->default_value(p_Options->m_BeBinarySampling.typeString),                                                                          
+            ("Sampling of BSE Be binary records (options: [ALL, CHANGE, EVENTS, LOG_TIME], default = " + p_Options->m_BeBinarySampling.typeString + ")").c_str()
+        )
 
         (
             "black-hole-kicks",                                            
@@ -1336,6 +1496,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_CommonEnvelopeMassAccretionPrescription.typeString)->default_value(p_Options->m_CommonEnvelopeMassAccretionPrescription.typeString),                            
             ("Assumption about whether NS/BHs can accrete mass during common envelope evolution (options: [ZERO, CONSTANT, UNIFORM, MACLEOD], default = " + p_Options->m_CommonEnvelopeMassAccretionPrescription.typeString + ")").c_str()
         )
+        (
+            "convergence-outcome",                 
+            po::value<std::string>(&p_Options->m_ConvergenceOutcome.typeString)->default_value(p_Options->m_ConvergenceOutcome.typeString),                                                      
+            ("Convergence: outcome whose rate is estimated to decide when to stop evolving systems - NONE evolves number-of-systems systems (options: [NONE, DCO, BBH, BNS, BHNS], default = " + p_Options->m_ConvergenceOutcome.typeString + ")").c_str()
+        )
         
         (
             "eccentricity-distribution",                                 
@@ -1374,7 +1539,7 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
         (
             "kick-magnitude-distribution",                                 
             po::value<std::string>(&p_Options->m_KickMagnitudeDistribution.typeString)->default_value(p_Options->m_KickMagnitudeDistribution.typeString),                                                        
-            ("Natal kick magnitude distribution (options: [ZERO, FIXED, FLAT, MAXWELLIAN, BRAYELDRIDGE, MULLER2016, MULLER2016MAXWELLIAN, MULLERMANDEL], default = " + p_Options->m_KickMagnitudeDistribution.typeString + ")").c_str()
+            ("Natal kick magnitude distribution (options: [ZERO, FIXED, FLAT, MAXWELLIAN, BRAYELDRIDGE, MULLER2016, MULLER2016MAXWELLIAN, MULLERMANDEL, TABULATED], default = " + p_Options->m_KickMagnitudeDistribution.typeString + ")").c_str()
         )
 
         // Serena
@@ -1396,6 +1561,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_LogfileCommonEnvelopes)->default_value(p_Options->m_LogfileCommonEnvelopes),                                                                    
             ("Filename for BSE Common Envelopes logfile (default = " + p_Options->m_LogfileCommonEnvelopes + ")").c_str()
         )
+        (
+            "logfile-compression",                                           
+            po::value<std::string>(&p_Options->m_LogfileCompression.typeString)->default_value(p_Options->m_LogfileCompression.typeString),                                                            
+            ("Compression for CSV, TSV, and TXT logfiles (options: [NONE, GZIP], default = " + p_Options->m_LogfileCompression.typeString + ")").c_str()
+        )
         (
             "logfile-detailed-output",                                 
             po::value<std::string>(&p_Options->m_LogfileDetailedOutput)->default_value(p_Options->m_LogfileDetailedOutput),                                                                      
@@ -1525,16 +1695,32 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_PulsarBirthSpinPeriodDistribution.typeString)->default_value(p_Options->m_PulsarBirthSpinPeriodDistribution.typeString),                                        
             ("Pulsar Birth Spin Period distribution (options: [ZERO, FIXED, UNIFORM, NORMAL], default = " + p_Options->m_PulsarBirthSpinPeriodDistribution.typeString + ")").c_str()
         )
+        (
+            "pulsar-evolution-sampling",                       
+            po::value<std::string>(&p_Options->m_PulsarEvolutionSampling.typeString)->default_value(p_Options->m_PulsarEvolutionSampling.typeString),                                                            
+            ("Sampling of BSE pulsar evolution records (options: [ALL, CHANGE, EVENTS, LOG_TIME], default = " + p_Options->m_PulsarEvolutionSampling.typeString + ")").c_str()
+        )
         (
             "pulsational-pair-instability-prescription",                   
             po::value<std::string>(&p_Options->m_PulsationalPairInstabilityPrescription.typeString)->default_value(p_Options->m_PulsationalPairInstabilityPrescription.typeString),                              
             ("Pulsational Pair Instability prescription (options: [COMPAS, STARTRACK, MARCHANT, FARMER], default = " + p_Options->m_PulsationalPairInstabilityPrescription.typeString + ")").c_str()
         )
 
+        (
+            "quasi-random-sequence",                                   
+            po::value<std::string>(&p_Options->m_QuasiRandomSequence.typeString)->default_value(p_Options->m_QuasiRandomSequence.typeString),                                                    
+            ("Low-discrepancy sequence used to sample initial conditions (options: [NONE, HALTON, SOBOL], default = " + p_Options->m_QuasiRandomSequence.typeString + ")").c_str()
+        )
+
         (
             "remnant-mass-prescription",                                   
             po::value<std::string>(&p_Options->m_RemnantMassPrescription.typeString)->default_value(p_Options->m_RemnantMassPrescription.typeString),                                                            
-            ("Choose remnant mass prescription (options: [HURLEY2000, BELCZYNSKI2002, FRYER2012, MULLER2016, MULLERMANDEL, SCHNEIDER2020, SCHNEIDER2020ALT], default = " + p_Options->m_RemnantMassPrescription.typeString + ")").c_str()
+            ("Choose remnant mass prescription (options: [HURLEY2000, BELCZYNSKI2002, FRYER2012, MULLER2016, MULLERMANDEL, SCHNEIDER2020, SCHNEIDER2020ALT, TABULATED], default = " + p_Options->m_RemnantMassPrescription.typeString + ")").c_str()
+        )
+        (
+            "remnant-table",                                               
+            po::value<std::string>(&p_Options->m_RemnantTableFilename)->default_value(p_Options->m_RemnantTableFilename)->implicit_value(""),
+            ("Remnant table filename, for the TABULATED remnant mass prescription and kick magnitude distribution (default = " + p_Options->m_RemnantTableFilename + ")").c_str()
         )
         (
             "rotational-velocity-distribution",                            
@@ -1552,6 +1738,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_StellarZetaPrescription.typeString)->default_value(p_Options->m_StellarZetaPrescription.typeString),                                                            
             ("Prescription for stellar zeta (default = " + p_Options->m_StellarZetaPrescription.typeString + ")").c_str()
         )
+        (
+            "store-input-files-mode",                                   
+            po::value<std::string>(&p_Options->m_StoreInputFilesMode.typeString)->default_value(p_Options->m_StoreInputFilesMode.typeString),                                                                    
+            ("How input files are stored in output container (options: [AUTO, COPY, HARDLINK, REFERENCE, REFLINK], default = " + p_Options->m_StoreInputFilesMode.typeString + ")").c_str()
+        )
 
 
         // vector (list) options - alphabetically
@@ -1561,11 +1752,26 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<vector<std::string>>(&p_Options->m_DebugClasses)->multitoken()->default_value(p_Options->m_DebugClasses),                                                                        
             ("Debug classes enabled (default = " + defaultDebugClasses + ")").c_str()
         )
+        (
+            "histogram",                                                 
+            po::value<vector<std::string>>(&p_Options->m_Histograms)->multitoken()->default_value(p_Options->m_Histograms),                                                                            
+            ("Histogram (aggregation sink) specifications, one per token: LOGFILE,PROPERTY,BINNING[,MIN,MAX,NBINS][,FILTER...] (default = none)")
+        )
         (
             "log-classes",                                                 
             po::value<vector<std::string>>(&p_Options->m_LogClasses)->multitoken()->default_value(p_Options->m_LogClasses),                                                                            
             ("Logging classes enabled (default = " + defaultLogClasses + ")").c_str()
         )
+        (
+            "hdf5-precision",                                                 
+            po::value<vector<std::string>>(&p_Options->m_HDF5Precision)->multitoken()->default_value(p_Options->m_HDF5Precision),                                                                      
+            ("HDF5 floating-point column precision, one per token: LOGFILE,PRECISION[,COLUMN...] (default = none - all columns DOUBLE)")
+        )
+        (
+            "logfile-filter",                                                 
+            po::value<vector<std::string>>(&p_Options->m_LogfileFilters)->multitoken()->default_value(p_Options->m_LogfileFilters),                                                                    
+            ("Standard logfile record filters, one per token: LOGFILE,FILTER[,FILTER...] (default = none)")
+        )
     
         ;   // end the list of options to be added
 
@@ -1586,118 +1792,64 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
  * This is broken out into this function so that that it can be called each time
  * an options "variation" is advanced
  * 
+ * The values are drawn directly into the per-system drawn parameters struct (m_Drawn) -
+ * the Boost variables map is not modified, so no notifiers are run.  Values the user
+ * specified are copied into the struct so the accessor functions need only look there.
+ * The order in which random numbers are drawn is unchanged.
+ * 
  * Note this is a class OptionValues function.
  * 
  * 
- * std::string SetCalculatedOptionDefaults(const BOOST_MAP p_ModifyMap)
+ * std::string SetCalculatedOptionDefaults()
  * 
- * @param   [IN]    p_UpdateMap                 Flag indicating whether the Boost variables map should be updated
  * @return                                      String containing an error string
  *                                              If no error occurred the return string will be the empty string 
  */
-std::string Options::OptionValues::SetCalculatedOptionDefaults(const BOOST_MAP p_UpdateMap) {
-#define DEFAULTED(opt) m_VM[opt].defaulted()    // for convenience and readability - undefined at end of function
+std::string Options::OptionValues::SetCalculatedOptionDefaults() {
 
     std::string errStr = "";                                        // error string
 
     try {
 
         // set "default" values for magnitude random number
-        // only set if the user did not specify a value
+        // only drawn if the user did not specify a value
 
-        if (DEFAULTED("kick-magnitude-random")) {
-            m_KickMagnitudeRandom = RAND->Random();
-            if (p_UpdateMap == BOOST_MAP::UPDATE) {
-                ModifyVariableMap(m_VM, "kick-magnitude-random", m_KickMagnitudeRandom);
-                po::notify(m_VM);
-            }
-        }
-    
-        if (DEFAULTED("kick-magnitude-random-1")) {
-            m_KickMagnitudeRandom1 = RAND->Random();
-            if (p_UpdateMap == BOOST_MAP::UPDATE) {
-                ModifyVariableMap(m_VM, "kick-magnitude-random-1", m_KickMagnitudeRandom1);
-                po::notify(m_VM);
-            }
-        }
-    
-        if (DEFAULTED("kick-magnitude-random-2")) {
-            m_KickMagnitudeRandom2 = RAND->Random();
-            if (p_UpdateMap == BOOST_MAP::UPDATE) {
-                ModifyVariableMap(m_VM, "kick-magnitude-random-2", m_KickMagnitudeRandom2);
-                po::notify(m_VM);
-            }
-        }
+        m_Drawn.kickMagnitudeRandom.value  = m_Drawn.kickMagnitudeRandom.drawn  ? RAND->Random() : m_KickMagnitudeRandom;
+        m_Drawn.kickMagnitudeRandom1.value = m_Drawn.kickMagnitudeRandom1.drawn ? RAND->Random() : m_KickMagnitudeRandom1;
+        m_Drawn.kickMagnitudeRandom2.value = m_Drawn.kickMagnitudeRandom2.drawn ? RAND->Random() : m_KickMagnitudeRandom2;
 
         // set "default" values for mean anomaly
-        // only set if the user did not specify a value
+        // only drawn if the user did not specify a value
     
-        if (DEFAULTED("kick-mean-anomaly-1")) {
-            m_KickMeanAnomaly1 = RAND->Random(0.0, _2_PI);
-            if (p_UpdateMap == BOOST_MAP::UPDATE) {
-                ModifyVariableMap(m_VM, "kick-mean-anomaly-1", m_KickMeanAnomaly1);
-                po::notify(m_VM);
-            }
-        }
-
-        if (DEFAULTED("kick-mean-anomaly-2")) {
-            m_KickMeanAnomaly2 = RAND->Random(0.0, _2_PI);
-            if (p_UpdateMap == BOOST_MAP::UPDATE) {
-                ModifyVariableMap(m_VM, "kick-mean-anomaly-2", m_KickMeanAnomaly2);
-                po::notify(m_VM);
-            }
-        }
+        m_Drawn.kickMeanAnomaly1.value = m_Drawn.kickMeanAnomaly1.drawn ? RAND->Random(0.0, _2_PI) : m_KickMeanAnomaly1;
+        m_Drawn.kickMeanAnomaly2.value = m_Drawn.kickMeanAnomaly2.drawn ? RAND->Random(0.0, _2_PI) : m_KickMeanAnomaly2;
 
-        // set "default" values for m_KickPhi[1/2] and m_KickTheta[1/2]
+        // set "default" values for phi[1/2] and theta[1/2]
         // we now have the kick direction distribution and kick direction 
         // power (exponent) required by the user (either default or specified)
-        // only set if the user did not specify a value
-
-        bool phi1Defaulted   = DEFAULTED("kick-phi-1");
-        bool theta1Defaulted = DEFAULTED("kick-theta-1");
-
-        if (phi1Defaulted || theta1Defaulted) {
-            double phi1, theta1;
-            std::tie(phi1, theta1) = utils::DrawKickDirection(m_KickDirectionDistribution.type, m_KickDirectionPower);
-            if (phi1Defaulted) {
-                m_KickPhi1 = phi1;
-                if (p_UpdateMap == BOOST_MAP::UPDATE) {
-                    ModifyVariableMap(m_VM, "kick-phi-1", m_KickPhi1);
-                    po::notify(m_VM);
-                }
-            }
-
-            if (theta1Defaulted) {
-                m_KickTheta1 = theta1;
-                if (p_UpdateMap == BOOST_MAP::UPDATE) {
-                    ModifyVariableMap(m_VM, "kick-theta-1", m_KickTheta1);
-                    po::notify(m_VM);
-                }
-            }
+        // only drawn if the user did not specify a value
+
+        double phi1   = m_KickPhi1;
+        double theta1 = m_KickTheta1;
+        if (m_Drawn.kickPhi1.drawn || m_Drawn.kickTheta1.drawn) {
+            double drawnPhi, drawnTheta;
+            std::tie(drawnPhi, drawnTheta) = utils::DrawKickDirection(m_KickDirectionDistribution.type, m_KickDirectionPower);
+            if (m_Drawn.kickPhi1.drawn)   phi1   = drawnPhi;
+            if (m_Drawn.kickTheta1.drawn) theta1 = drawnTheta;
         }
-
-        bool phi2Defaulted   = DEFAULTED("kick-phi-2");
-        bool theta2Defaulted = DEFAULTED("kick-theta-2");
-
-        if (phi2Defaulted || theta2Defaulted) {
-            double phi2, theta2;
-            std::tie(phi2, theta2) = utils::DrawKickDirection(m_KickDirectionDistribution.type, m_KickDirectionPower);
-            if (phi2Defaulted) {
-                m_KickPhi2 = phi2;
-                if (p_UpdateMap == BOOST_MAP::UPDATE) {
-                    ModifyVariableMap(m_VM, "kick-phi-2", m_KickPhi2);
-                    po::notify(m_VM);
-                }
-            }
-
-            if (theta2Defaulted) {
-                m_KickTheta2 = theta2;
-                if (p_UpdateMap == BOOST_MAP::UPDATE) {
-                    ModifyVariableMap(m_VM, "kick-theta-2", m_KickTheta2);
-                    po::notify(m_VM);
-                }
-            }
+        m_Drawn.kickPhi1.value   = phi1;
+        m_Drawn.kickTheta1.value = theta1;
+
+        double phi2   = m_KickPhi2;
+        double theta2 = m_KickTheta2;
+        if (m_Drawn.kickPhi2.drawn || m_Drawn.kickTheta2.drawn) {
+            double drawnPhi, drawnTheta;
+            std::tie(drawnPhi, drawnTheta) = utils::DrawKickDirection(m_KickDirectionDistribution.type, m_KickDirectionPower);
+            if (m_Drawn.kickPhi2.drawn)   phi2   = drawnPhi;
+            if (m_Drawn.kickTheta2.drawn) theta2 = drawnTheta;
         }
+        m_Drawn.kickPhi2.value   = phi2;
+        m_Drawn.kickTheta2.value = theta2;
     }
     catch (po::error& e) {                                          // program options exception
         errStr = e.what();                                          // set the error string
@@ -1710,7 +1862,6 @@ std::string Options::OptionValues::SetCalculatedOptionDefaults(const BOOST_MAP p
     }
 
     return errStr;
-#undef DEFAULTED
 }
 
 
@@ -1758,6 +1909,16 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             COMPLAIN_IF(!found, "Unknown Add Options to SysParms Option");
         }
 
+        if (!DEFAULTED("ais-dco-type")) {                                                                                           // AIS target DCO type
+            std::tie(found, m_AISDCOType.type) = utils::GetMapKey(m_AISDCOType.typeString, AIS_DCO_TYPE_LABEL, m_AISDCOType.type);
+            COMPLAIN_IF(!found, "Unknown AIS DCO Type");
+        }
+
+        if (!DEFAULTED("be-binary-sampling")) {                                                                                     // Be binary logfile sampling
+            std::tie(found, m_BeBinarySampling.type) = utils::GetMapKey(m_BeBinarySampling.typeString, LOGFILE_SAMPLING_LABEL, m_BeBinarySampling.type);
+            COMPLAIN_IF(!found, "Unknown Be Binary Sampling");
+        }
+
         if (!DEFAULTED("black-hole-kicks")) {                                                                                       // black hole kicks
             std::tie(found, m_BlackHoleKicks.type) = utils::GetMapKey(m_BlackHoleKicks.typeString, BLACK_HOLE_KICKS_LABEL, m_BlackHoleKicks.type);
             COMPLAIN_IF(!found, "Unknown Black Hole Kicks Option");
@@ -1782,6 +1943,11 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             std::tie(found, m_CommonEnvelopeMassAccretionPrescription.type) = utils::GetMapKey(m_CommonEnvelopeMassAccretionPrescription.typeString, CE_ACCRETION_PRESCRIPTION_LABEL, m_CommonEnvelopeMassAccretionPrescription.type);
             COMPLAIN_IF(!found, "Unknown CE Mass Accretion Prescription");
         }
+
+        if (!DEFAULTED("convergence-outcome")) {                                                                                    // convergence outcome
+            std::tie(found, m_ConvergenceOutcome.type) = utils::GetMapKey(m_ConvergenceOutcome.typeString, CONVERGENCE_OUTCOME_LABEL, m_ConvergenceOutcome.type);
+            COMPLAIN_IF(!found, "Unknown Convergence Outcome");
+        }
             
         if (!DEFAULTED("envelope-state-prescription")) {                                                                            // envelope state prescription
             std::tie(found, m_EnvelopeStatePrescription.type) = utils::GetMapKey(m_EnvelopeStatePrescription.typeString, ENVELOPE_STATE_PRESCRIPTION_LABEL, m_EnvelopeStatePrescription.type);
@@ -1818,6 +1984,11 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             COMPLAIN_IF(!found, "Unknown Logfile Type");
         }
 
+        if (!DEFAULTED("logfile-compression")) {                                                                                    // logfile compression
+            std::tie(found, m_LogfileCompression.type) = utils::GetMapKey(m_LogfileCompression.typeString, LOGFILE_COMPRESSION_LABEL, m_LogfileCompression.type);
+            COMPLAIN_IF(!found, "Unknown Logfile Compression");
+        }
+
         if (!DEFAULTED("luminous-blue-variable-prescription")) {                                                                    // LBV mass loss prescription
             std::tie(found, m_LuminousBlueVariablePrescription.type) = utils::GetMapKey(m_LuminousBlueVariablePrescription.typeString, LBV_PRESCRIPTION_LABEL, m_LuminousBlueVariablePrescription.type);
             COMPLAIN_IF(!found, "Unknown LBV Mass Loss Prescription");
@@ -1891,11 +2062,21 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             COMPLAIN_IF(!found, "Unknown Pulsar Birth Spin Period Distribution");
         }
 
+        if (!DEFAULTED("pulsar-evolution-sampling")) {                                                                              // pulsar evolution logfile sampling
+            std::tie(found, m_PulsarEvolutionSampling.type) = utils::GetMapKey(m_PulsarEvolutionSampling.typeString, LOGFILE_SAMPLING_LABEL, m_PulsarEvolutionSampling.type);
+            COMPLAIN_IF(!found, "Unknown Pulsar Evolution Sampling");
+        }
+
         if (!DEFAULTED("pulsational-pair-instability-prescription")) {                                                              // pulsational pair instability prescription
             std::tie(found, m_PulsationalPairInstabilityPrescription.type) = utils::GetMapKey(m_PulsationalPairInstabilityPrescription.typeString, PPI_PRESCRIPTION_LABEL, m_PulsationalPairInstabilityPrescription.type);
             COMPLAIN_IF(!found, "Unknown Pulsational Pair Instability Prescription");
         }
 
+        if (!DEFAULTED("quasi-random-sequence")) {                                                                                  // quasi-random sequence
+            std::tie(found, m_QuasiRandomSequence.type) = utils::GetMapKey(m_QuasiRandomSequence.typeString, QUASI_RANDOM_SEQUENCE_LABEL, m_QuasiRandomSequence.type);
+            COMPLAIN_IF(!found, "Unknown Quasi-Random Sequence");
+        }
+
         if (!DEFAULTED("remnant-mass-prescription")) {                                                                              // remnant mass prescription
             std::tie(found, m_RemnantMassPrescription.type) = utils::GetMapKey(m_RemnantMassPrescription.typeString, REMNANT_MASS_PRESCRIPTION_LABEL, m_RemnantMassPrescription.type);
             COMPLAIN_IF(!found, "Unknown Remnant Mass Prescription");
@@ -1916,6 +2097,11 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             COMPLAIN_IF(!found, "Unknown stellar Zeta Prescription");
         }
 
+        if (!DEFAULTED("store-input-files-mode")) {                                                                                 // input files storage mode
+            std::tie(found, m_StoreInputFilesMode.type) = utils::GetMapKey(m_StoreInputFilesMode.typeString, STORE_INPUT_FILES_MODE_LABEL, m_StoreInputFilesMode.type);
+            COMPLAIN_IF(!found, "Unknown Store Input Files Mode");
+        }
+
         // constraint/value/range checks - alphabetically (where possible)
 
         COMPLAIN_IF(m_CommonEnvelopeAlpha < 0.0, "CE alpha (--common-envelope-alpha) < 0");
@@ -1937,6 +2123,9 @@ std::string Options::OptionValues::CheckAndSetOptions() {
         COMPLAIN_IF(m_GridStartLine < 0, "Grid file start line (--grid-start-line) < 0");
         COMPLAIN_IF(!DEFAULTED("grid-lines-to-process") && m_GridLinesToProcess < 1, "Grid file lines to process (--grid-lines-to-process) < 1");
 
+        COMPLAIN_IF(m_LogfileCompressionBlockSize < 1, "Logfile compression block size (--logfile-compression-block-size) must be >= 1");
+
+        COMPLAIN_IF(!m_HDF5Precision.empty() && m_LogfileType.type != LOGFILETYPE::HDF5, "HDF5 column precision (--hdf5-precision) can only be specified for HDF5 logfiles");
         COMPLAIN_IF(m_HDF5BufferSize < 1, "HDF5 IO buffer size (--hdf5-buffer-size) must be >= 1");
         COMPLAIN_IF(m_HDF5ChunkSize < HDF5_MINIMUM_CHUNK_SIZE, "HDF5 file dataset chunk size (--hdf5-chunk-size) must be >= minimum chunk size of " + std::to_string(HDF5_MINIMUM_CHUNK_SIZE));
 
@@ -1964,6 +2153,9 @@ std::string Options::OptionValues::CheckAndSetOptions() {
 
         COMPLAIN_IF(m_MaxEvolutionTime <= 0.0, "Maximum evolution time in Myr (--maxEvolutionTime) must be > 0");
 
+        COMPLAIN_IF(m_MemoryBudget < 0.0, "Memory budget (--memory-budget) < 0");
+        COMPLAIN_IF(m_MemoryReportInterval < 0, "Memory report interval (--memory-report-interval) < 0");
+
         COMPLAIN_IF(m_Metallicity < MINIMUM_METALLICITY || m_Metallicity > MAXIMUM_METALLICITY, "Metallicity (--metallicity) should be absolute metallicity and must be between " + std::to_string(MINIMUM_METALLICITY) + " and " + std::to_string(MAXIMUM_METALLICITY));
         COMPLAIN_IF(m_MetallicityDistributionMin < MINIMUM_METALLICITY || m_MetallicityDistributionMin > MAXIMUM_METALLICITY, "Minimum metallicity (--metallicity-min) must be between " + std::to_string(MINIMUM_METALLICITY) + " and " + std::to_string(MAXIMUM_METALLICITY));
         COMPLAIN_IF(m_MetallicityDistributionMax < MINIMUM_METALLICITY || m_MetallicityDistributionMax > MAXIMUM_METALLICITY, "Maximum metallicity (--metallicity-max) must be between " + std::to_string(MINIMUM_METALLICITY) + " and " + std::to_string(MAXIMUM_METALLICITY));
@@ -2028,7 +2220,42 @@ std::string Options::OptionValues::CheckAndSetOptions() {
         COMPLAIN_IF(m_KickMagnitudeRandom1 < 0.0 || m_KickMagnitudeRandom1 >= 1.0, "Kick magnitude random (--kick-magnitude-random-1) must be >= 0 and < 1");
         COMPLAIN_IF(m_KickMagnitudeRandom2 < 0.0 || m_KickMagnitudeRandom2 >= 1.0, "Kick magnitude random (--kick-magnitude-random-2) must be >= 0 and < 1");
 
-        errStr = SetCalculatedOptionDefaults(BOOST_MAP::NO_UPDATE);                                                                 // set calculated option values
+        COMPLAIN_IF(m_AISExploratoryFraction <= 0.0 || m_AISExploratoryFraction > 1.0, "AIS exploratory fraction (--ais-exploratory-fraction) must be > 0 and <= 1");
+        COMPLAIN_IF(m_AISKappa <= 0.0, "AIS Gaussian width scale factor (--ais-kappa) <= 0");
+
+        COMPLAIN_IF(m_DetailedOutputInterval < 0.0, "Detailed output interval (--detailed-output-interval) < 0");
+        COMPLAIN_IF(m_DetailedOutputTolerance < 0.0, "Detailed output tolerance (--detailed-output-tolerance) < 0");
+
+        COMPLAIN_IF(m_LogfileSamplingLogTimeStep <= 0.0, "Logfile sampling log time step (--logfile-sampling-log-time-step) <= 0");
+        COMPLAIN_IF(m_LogfileSamplingTolerance < 0.0, "Logfile sampling tolerance (--logfile-sampling-tolerance) < 0");
+
+        COMPLAIN_IF(m_ConvergenceReportInterval < 0, "Convergence report interval (--convergence-report-interval) < 0");
+        COMPLAIN_IF(m_ConvergenceTolerance <= 0.0, "Convergence tolerance (--convergence-tolerance) <= 0");
+        COMPLAIN_IF(m_ConvergenceOutcome.type != CONVERGENCE_OUTCOME::NONE && m_EvolutionMode.type != EVOLUTION_MODE::BSE, "Convergence-driven stopping (--convergence-outcome) is only supported in BSE mode");
+
+        if (m_AdaptiveImportanceSampling) {                                                                                         // AIS draws primary mass, mass ratio and semi-major axis by inverse transform
+            COMPLAIN_IF(m_EvolutionMode.type != EVOLUTION_MODE::BSE, "Adaptive importance sampling (--adaptive-importance-sampling) is only supported in BSE mode");
+            COMPLAIN_IF(!m_GridFilename.empty(), "Adaptive importance sampling (--adaptive-importance-sampling) cannot be used with a grid file");
+            COMPLAIN_IF(!DEFAULTED("initial-mass-1") || !DEFAULTED("initial-mass-2") || !DEFAULTED("mass-ratio"), "Adaptive importance sampling (--adaptive-importance-sampling) samples the masses - do not specify --initial-mass-1, --initial-mass-2 or --mass-ratio");
+            COMPLAIN_IF(!DEFAULTED("semi-major-axis") || !DEFAULTED("orbital-period"), "Adaptive importance sampling (--adaptive-importance-sampling) samples the semi-major axis - do not specify --semi-major-axis or --orbital-period");
+            COMPLAIN_IF(DEFAULTED("semi-major-axis-distribution") && !DEFAULTED("orbital-period-distribution"), "Adaptive importance sampling (--adaptive-importance-sampling) requires a semi-major axis distribution, not an orbital period distribution");
+            COMPLAIN_IF(m_QuasiRandomSequence.type != QUASI_RANDOM_SEQUENCE::NONE, "Adaptive importance sampling (--adaptive-importance-sampling) cannot be used with a quasi-random sequence (--quasi-random-sequence)");
+        }
+
+        // record which of the per-system values are to be drawn (i.e. the user did not specify a value)
+        // the Boost variables map is not modified after this, so the defaulted state cannot change
+
+        m_Drawn.kickMagnitudeRandom.drawn  = DEFAULTED("kick-magnitude-random");
+        m_Drawn.kickMagnitudeRandom1.drawn = DEFAULTED("kick-magnitude-random-1");
+        m_Drawn.kickMagnitudeRandom2.drawn = DEFAULTED("kick-magnitude-random-2");
+        m_Drawn.kickMeanAnomaly1.drawn     = DEFAULTED("kick-mean-anomaly-1");
+        m_Drawn.kickMeanAnomaly2.drawn     = DEFAULTED("kick-mean-anomaly-2");
+        m_Drawn.kickPhi1.drawn             = DEFAULTED("kick-phi-1");
+        m_Drawn.kickPhi2.drawn             = DEFAULTED("kick-phi-2");
+        m_Drawn.kickTheta1.drawn           = DEFAULTED("kick-theta-1");
+        m_Drawn.kickTheta2.drawn           = DEFAULTED("kick-theta-2");
+
+        errStr = SetCalculatedOptionDefaults();                                                                                     // set calculated option values
     }
     catch (po::error& e) {                                                                                                          // program options exception
         errStr = e.what();                                                                                                          // set the error string
@@ -3050,7 +3277,7 @@ int Options::AdvanceOptionVariation(OptionsDescriptorT &p_OptionsDescriptor) {
 
     if (p_OptionsDescriptor.complexOptionValues.size() == 0) {          // more variations?
         // no - set calculated option defaults and return
-        return p_OptionsDescriptor.optionValues.SetCalculatedOptionDefaults(BOOST_MAP::NO_UPDATE) == "" ? 0 : -1;
+        return p_OptionsDescriptor.optionValues.SetCalculatedOptionDefaults() == "" ? 0 : -1;
     }
 
     // Upon entry iterators for ranges and sets need to be advanced in order
@@ -3857,8 +4084,8 @@ int Options::SetRandomSeed(const unsigned long int p_RandomSeed, const OPTIONS_O
 
     // recalculate "calculated" option values for the relevant set of option values
     std::string err = p_OptionsSet == OPTIONS_ORIGIN::CMDLINE
-                        ? m_CmdLine.optionValues.SetCalculatedOptionDefaults(BOOST_MAP::NO_UPDATE)
-                        : m_GridLine.optionValues.SetCalculatedOptionDefaults(BOOST_MAP::NO_UPDATE);
+                        ? m_CmdLine.optionValues.SetCalculatedOptionDefaults()
+                        : m_GridLine.optionValues.SetCalculatedOptionDefaults();
 
     return err == "" ? 0 : -1;
 }
@@ -100,6 +100,12 @@ namespace po = boost::program_options;
                                                     ? m_GridLine.optionValues.optValue \
                                                     : m_CmdLine.optionValues.optValue
 
+// DRAWN_VALUE returns the per-system drawn value (or the user-specified value if not drawn) of the
+// active set of options (grid line if populated, else commandline) - no boost variables map lookup
+#define DRAWN_VALUE(param)                      (m_GridLine.optionValues.m_Populated \
+                                                    ? m_GridLine.optionValues.m_Drawn.param.value \
+                                                    : m_CmdLine.optionValues.m_Drawn.param.value)
+
 /*
  * Options Singleton
  *
@@ -145,12 +151,30 @@ private:
 
         // trying to keep entries alphabetical so easier to find specific entries
 
+        "adaptive-importance-sampling",
         "add-options-to-sysparms",
 
+        "ais-dco-type",
+        "ais-exploratory-fraction",
+        "ais-hubble",
+        "ais-kappa",
+        "ais-pessimistic",
+        "ais-rlof",
+
+        "be-binary-sampling",
+
+        "convergence-hubble",
+        "convergence-outcome",
+        "convergence-report-interval",
+        "convergence-tolerance",
+        "convergence-weighted",
+
         "debug-level",
         "debug_classes",
         "debug-to-file",
         "detailed-output",
+        "detailed-output-interval",
+        "detailed-output-tolerance",
 
         "enable-warnings",
         "errors-to-file",
@@ -161,8 +185,13 @@ private:
 
         "hdf5-buffer-size",
         "hdf5-chunk-size",
+        "hdf5-precision",
         "help", "h",
 
+        "histogram",
+        "histograms-only",
+        "logfile-filter",
+
         "log-level", 
         "log-classes",
 
@@ -170,12 +199,16 @@ private:
         //"logfile-be-binaries",
 
         "logfile-common-envelopes",
+        "logfile-compression",
+        "logfile-compression-block-size",
         "logfile-definitions",
         "logfile-detailed-output",
         "logfile-double-compact-objects",
         "logfile-name-prefix",
         "logfile-pulsar-evolution",
         "logfile-rlof-parameters",
+        "logfile-sampling-log-time-step",
+        "logfile-sampling-tolerance",
         "logfile-supernovae",
         "logfile-switch-log",
         "logfile-system-parameters",
@@ -183,6 +216,8 @@ private:
 
         "maximum-evolution-time",
         "maximum-number-timestep-iterations",
+        "memory-budget",
+        "memory-report-interval",
         "mode",
 
         "number-of-systems",
@@ -192,12 +227,17 @@ private:
 
         "population-data-printing",
         "print-bool-as-string",
+        "pulsar-evolution-sampling",
 
+        "quasi-random-scramble-seed",
+        "quasi-random-sequence",
         "quiet", 
 
+        "remnant-table",
         "rlof-printing",
 
         "store-input-files",
+        "store-input-files-mode",
         "switch-log",
 
         "timestep-multiplier",
@@ -254,12 +294,21 @@ private:
 
         // trying to keep entries alphabetical so easier to find specific entries
 
+        "adaptive-importance-sampling",
+        "ais-dco-type",
+        "ais-exploratory-fraction",
+        "ais-hubble",
+        "ais-kappa",
+        "ais-pessimistic",
+        "ais-rlof",
+
         "allow-rlof-at-birth",
         "allow-touching-at-birth",
         "angular-momentum-conservation-during-circularisation", 
 
         // Serena
         //"be-binaries",
+        "be-binary-sampling",
 
         "case-BB-stability-prescription",
         "circularise-binary-during-mass-transfer",
@@ -276,6 +325,15 @@ private:
         "common-envelope-recombination-energy-density",
         "common-envelope-slope-kruckow",
 
+        "convergence-hubble",
+        "convergence-outcome",
+        "convergence-report-interval",
+        "convergence-tolerance",
+        "convergence-weighted",
+
+        "detailed-output-interval",
+        "detailed-output-tolerance",
+
         // AVG
         /*
         "critical-mass-ratio-giant-degenerate-accretor",
@@ -321,6 +379,8 @@ private:
         "logfile-double-compact-objects",
         "logfile-pulsar-evolution",
         "logfile-rlof-parameters",
+        "logfile-sampling-log-time-step",
+        "logfile-sampling-tolerance",
         "logfile-system-parameters",
 
         "mass-ratio", "q",
@@ -343,6 +403,8 @@ private:
         "orbital-period-max",
         "orbital-period-min",
 
+        "pulsar-evolution-sampling",
+
         "rlof-printing",
         "rotational-frequency-1",
         "rotational-frequency-2",
@@ -369,14 +431,23 @@ private:
 
         // trying to keep entries alphabetical so easier to find specific entries
 
+        "adaptive-importance-sampling",
         "add-options-to-sysparms",
 
+        "ais-dco-type",
+        "ais-exploratory-fraction",
+        "ais-hubble",
+        "ais-kappa",
+        "ais-pessimistic",
+        "ais-rlof",
+
         "allow-rlof-at-birth",
         "allow-touching-at-birth",
         "angular-momentum-conservation-during-circularisation",
 
         // Serena
         //"be-binaries",
+        "be-binary-sampling",
 
         "black-hole-kicks",
 
@@ -388,10 +459,18 @@ private:
         "common-envelope-lambda-prescription",
         "common-envelope-mass-accretion-prescription",
 
+        "convergence-hubble",
+        "convergence-outcome",
+        "convergence-report-interval",
+        "convergence-tolerance",
+        "convergence-weighted",
+
         "debug_classes",
         "debug-level",
         "debug-to-file",
         "detailed-output",
+        "detailed-output-interval",
+        "detailed-output-tolerance",
 
         "eccentricity-distribution",
         "enable-warnings",
@@ -408,6 +487,7 @@ private:
 
         "hdf5-buffer-size",
         "hdf5-chunk-size",
+        "hdf5-precision",
         "help", "h",
 
         "initial-mass-function", "i",
@@ -415,6 +495,10 @@ private:
         "kick-direction",
         "kick-magnitude-distribution", 
 
+        "histogram",
+        "histograms-only",
+        "logfile-filter",
+
         "log-level", 
         "log-classes",
 
@@ -422,12 +506,16 @@ private:
         //"logfile-be-binaries",
 
         "logfile-common-envelopes",
+        "logfile-compression",
+        "logfile-compression-block-size",
         "logfile-definitions",
         "logfile-detailed-output",
         "logfile-double-compact-objects",
         "logfile-name-prefix",
         "logfile-pulsar-evolution",
         "logfile-rlof-parameters",
+        "logfile-sampling-log-time-step",
+        "logfile-sampling-tolerance",
         "logfile-supernovae",
         "logfile-switch-log",
         "logfile-system-parameters",
@@ -441,6 +529,8 @@ private:
         "mass-transfer-angular-momentum-loss-prescription",
         "mass-transfer-rejuvenation-prescription",
         "mass-transfer-thermal-limit-accretor",
+        "memory-budget",
+        "memory-report-interval",
         "metallicity-distribution",
         "mode",
 
@@ -456,13 +546,17 @@ private:
         "print-bool-as-string",
         "pulsar-birth-magnetic-field-distribution",
         "pulsar-birth-spin-period-distribution",
+        "pulsar-evolution-sampling",
         "pulsational-pair-instability",
         "pulsational-pair-instability-prescription",
 
+        "quasi-random-scramble-seed",
+        "quasi-random-sequence",
         "quiet", 
 
         "random-seed",
         "remnant-mass-prescription",
+        "remnant-table",
         "revised-energy-formalism-nandez-ivanova",
         "rlof-printing",
         "rotational-velocity-distribution",
@@ -470,6 +564,7 @@ private:
         "semi-major-axis-distribution",
         "stellar-zeta-prescription",
         "store-input-files",
+        "store-input-files-mode",
         "switch-log",
 
         "use-mass-loss",
@@ -481,12 +576,30 @@ private:
 
         // trying to keep entries alphabetical so easier to find specific entries
 
+        "adaptive-importance-sampling",
         "add-options-to-sysparms",
 
+        "ais-dco-type",
+        "ais-exploratory-fraction",
+        "ais-hubble",
+        "ais-kappa",
+        "ais-pessimistic",
+        "ais-rlof",
+
+        "be-binary-sampling",
+
+        "convergence-hubble",
+        "convergence-outcome",
+        "convergence-report-interval",
+        "convergence-tolerance",
+        "convergence-weighted",
+
         "debug_classes",
         "debug-level",
         "debug-to-file",
         "detailed-output",
+        "detailed-output-interval",
+        "detailed-output-tolerance",
 
         "enable-warnings",
         "errors-to-file",
@@ -497,8 +610,13 @@ private:
 
         "hdf5-buffer-size",
         "hdf5-chunk-size",
+        "hdf5-precision",
         "help", "h",
 
+        "histogram",
+        "histograms-only",
+        "logfile-filter",
+
         "log-classes",
         "log-level", 
 
@@ -506,17 +624,23 @@ private:
         //"logfile-be-binaries",
 
         "logfile-common-envelopes",
+        "logfile-compression",
+        "logfile-compression-block-size",
         "logfile-definitions",
         "logfile-detailed-output",
         "logfile-double-compact-objects",
         "logfile-name-prefix",
         "logfile-pulsar-evolution",
         "logfile-rlof-parameters",
+        "logfile-sampling-log-time-step",
+        "logfile-sampling-tolerance",
         "logfile-supernovae",
         "logfile-switch-log",
         "logfile-system-parameters",
         "logfile-type",
 
+        "memory-budget",
+        "memory-report-interval",
         "mode",
 
         "output-container", "c",
@@ -524,13 +648,18 @@ private:
 
         "population-data-printing",
         "print-bool-as-string",
+        "pulsar-evolution-sampling",
 
+        "quasi-random-scramble-seed",
+        "quasi-random-sequence",
         "quiet",
 
         "random-seed",
+        "remnant-table",
         "rlof-printing",
 
         "store-input-files",
+        "store-input-files-mode",
         "switch-log",
 
         "version", "v"
@@ -575,6 +704,12 @@ public:
 	        bool                                                m_EvolveUnboundSystems;							                // Option to chose if unbound systems are evolved until death or the evolution stops after the system is unbound during a SN.
 
             bool                                                m_DetailedOutput;                                               // Print detailed output details to file (default = false)
+            double                                              m_DetailedOutputInterval;                                       // Detailed output decimation: maximum time between records (Myr, 0 = no maximum)
+            double                                              m_DetailedOutputTolerance;                                      // Detailed output decimation: relative change in monitored properties that triggers a record (0 = every timestep)
+            ENUM_OPT<LOGFILE_SAMPLING>                          m_BeBinarySampling;                                             // Sampling of BSE Be binary records (default = ALL - every timestep)
+            double                                              m_LogfileSamplingLogTimeStep;                                   // Logfile sampling LOG_TIME: step in log10(time) between records
+            double                                              m_LogfileSamplingTolerance;                                     // Logfile sampling CHANGE: relative change in monitored properties that triggers a record
+            ENUM_OPT<LOGFILE_SAMPLING>                          m_PulsarEvolutionSampling;                                      // Sampling of BSE pulsar evolution records (default = ALL - every timestep)
             bool                                                m_PopulationDataPrinting;                                       // Print certain data for small populations, but not for larger one
             bool                                                m_PrintBoolAsString;                                            // flag used to indicate that boolean properties should be printed as "TRUE" or "FALSE" (default is 1 or 0)
             bool                                                m_Quiet;                                                        // suppress some output
@@ -583,10 +718,33 @@ public:
             bool                                                m_ShortHelp;                                                    // Flag to indicate whether user wants short help ('-h', just option names) or long help ('--help', plus descriptions)
 
             bool                                                m_StoreInputFiles;                                              // Store input files in output container (default = true)
+            ENUM_OPT<STORE_INPUT_FILES_MODE>                    m_StoreInputFilesMode;                                          // How input files are stored in output container (default = COPY)
 
             bool                                                m_SwitchLog;                                                    // Print switch log details to file (default = false)
 
 
+            // Adaptive Importance Sampling (AIS) variables
+            bool                                                m_AdaptiveImportanceSampling;                                   // Sample initial conditions using Adaptive Importance Sampling (STROOPWAFEL)
+            ENUM_OPT<AIS_DCO_TYPE>                              m_AISDCOType;                                                   // Type of double compact object counted as a hit by AIS
+            double                                              m_AISExploratoryFraction;                                       // Fraction of systems evolved in the AIS exploratory phase (also the prior weight of the refinement mixture)
+            bool                                                m_AISHubble;                                                    // Only count DCOs that merge within a Hubble time as AIS hits
+            double                                              m_AISKappa;                                                     // Scale factor for the width of the AIS Gaussians
+            bool                                                m_AISPessimistic;                                               // Exclude DCOs that survived an optimistic common envelope from AIS hits
+            bool                                                m_AISRLOF;                                                      // Exclude DCOs that experienced immediate RLOF post common envelope from AIS hits
+
+
+            // Convergence-driven stopping variables
+            bool                                                m_ConvergenceHubble;                                            // Only count DCOs that merge within a Hubble time towards the outcome rate
+            ENUM_OPT<CONVERGENCE_OUTCOME>                       m_ConvergenceOutcome;                                           // Outcome whose rate is estimated to decide when to stop (NONE = evolve number-of-systems systems)
+            int                                                 m_ConvergenceReportInterval;                                    // Number of systems between progress reports of the outcome rate estimate (0 = no reports)
+            double                                              m_ConvergenceTolerance;                                         // Target relative uncertainty of the outcome rate estimate
+            bool                                                m_ConvergenceWeighted;                                          // Weight systems by their importance sampling weight
+
+            // Quasi-random sampling variables
+            unsigned long int                                   m_QuasiRandomScrambleSeed;                                      // Seed for the scrambling of the quasi-random sequence (common to all systems in a population)
+            ENUM_OPT<QUASI_RANDOM_SEQUENCE>                     m_QuasiRandomSequence;                                          // Low-discrepancy sequence used to sample initial conditions (NONE = pseudo-random)
+
+
             // Miscellaneous evolution variables
 
             ENUM_OPT<EVOLUTION_MODE>                            m_EvolutionMode;                                                // Mode of evolution: SSE or BSE
@@ -599,6 +757,9 @@ public:
             int                                                 m_MaxNumberOfTimestepIterations;                                // Maximum number of timesteps to evolve binary for before giving up
             double                                              m_TimestepMultiplier;                                           // Multiplier for time step size (<1 -- shorter timesteps, >1 -- longer timesteps)
 
+            double                                              m_MemoryBudget;                                                 // Memory budget (MiB) - HDF5 write buffers are flushed while the resident set size exceeds it (see Log::CheckMemory()) (0 = no budget)
+            int                                                 m_MemoryReportInterval;                                         // Number of systems between memory footprint reports (0 = no reports)
+
             std::streamsize                                     m_GridStartLine;                                                // The grid file line to start processing (0-based)
             std::streamsize                                     m_GridLinesToProcess;                                           // The number of grid file lines to process (starting at m_GridStartLine)
 
@@ -854,6 +1015,11 @@ public:
             string                                              m_GridFilename;                                                 // Grid filename
 
 
+            // remnant table
+
+            string                                              m_RemnantTableFilename;                                         // Remnant table filename (TABULATED remnant mass prescription and kick magnitude distribution)
+
+
             // debug and logging options
 
             int                                                 m_DebugLevel;                                                   // Debug level - used to determine which debug statements are actually written
@@ -862,11 +1028,18 @@ public:
             int                                                 m_LogLevel;                                                     // Logging level - used to determine which logging statements are actually written
             vector<string>                                      m_LogClasses;                                                   // Logging classes - used to determine which logging statements are actually written
 
+            vector<string>                                      m_Histograms;                                                   // Histogram (aggregation sink) specifications
+            bool                                                m_HistogramsOnly;                                               // Only write histograms - don't write records to the standard logfiles
+
+            vector<string>                                      m_LogfileFilters;                                               // Standard logfile record filter specifications
+
 
             // Logfiles
             string                                              m_LogfileDefinitionsFilename;                                   // Filename for the logfile record definitions
             string                                              m_LogfileNamePrefix;                                            // Prefix for log file names
             ENUM_OPT<LOGFILETYPE>                               m_LogfileType;                                                  // File type log files
+            ENUM_OPT<LOGFILE_COMPRESSION>                       m_LogfileCompression;                                           // Compression for CSV, TSV, and TXT log files
+            int                                                 m_LogfileCompressionBlockSize;                                  // Uncompressed block size for compressed log files (KiB)
 
             string                                              m_LogfileSystemParameters;                                      // output file name: system parameters
             string                                              m_LogfileDetailedOutput;                                        // output file name: detailed output
@@ -882,6 +1055,7 @@ public:
 
             int                                                 m_HDF5BufferSize;                                               // HDF5 file IO buffer size (number of chunks)
             int                                                 m_HDF5ChunkSize;                                                // HDF5 file chunk size (number of dataset entries)
+            vector<string>                                      m_HDF5Precision;                                                // HDF5 floating-point column precision specifications
 
 
             // the boost variables map
@@ -889,6 +1063,12 @@ public:
 
             po::variables_map m_VM;
 
+            // per-system drawn option values
+            // these are set by SetCalculatedOptionDefaults() for each system, and are held here rather than in the
+            // boost variables map so that the map is not modified (and notified) after the options are parsed
+
+            DrawnParametersT m_Drawn;
+
             bool m_Populated;                                                                                                   // flag to indicate whether we're using a grid line
 
 
@@ -905,7 +1085,7 @@ public:
 
             int         OptionSpecified(std::string p_OptionString);
 
-            std::string SetCalculatedOptionDefaults(const BOOST_MAP p_BoostMap);
+            std::string SetCalculatedOptionDefaults();
 
         public:
 
@@ -1044,8 +1224,16 @@ public:
 
     // getters
 
+    bool                                        AdaptiveImportanceSampling() const                                      { return m_CmdLine.optionValues.m_AdaptiveImportanceSampling; }
     ADD_OPTIONS_TO_SYSPARMS                     AddOptionsToSysParms() const                                            { return m_CmdLine.optionValues.m_AddOptionsToSysParms.type; }
 
+    AIS_DCO_TYPE                                AISDCOType() const                                                      { return m_CmdLine.optionValues.m_AISDCOType.type; }
+    double                                      AISExploratoryFraction() const                                          { return m_CmdLine.optionValues.m_AISExploratoryFraction; }
+    bool                                        AISHubble() const                                                       { return m_CmdLine.optionValues.m_AISHubble; }
+    double                                      AISKappa() const                                                        { return m_CmdLine.optionValues.m_AISKappa; }
+    bool                                        AISPessimistic() const                                                  { return m_CmdLine.optionValues.m_AISPessimistic; }
+    bool                                        AISRLOF() const                                                         { return m_CmdLine.optionValues.m_AISRLOF; }
+
     bool                                        AllowMainSequenceStarToSurviveCommonEnvelope() const                    { return OPT_VALUE("common-envelope-allow-main-sequence-survive", m_AllowMainSequenceStarToSurviveCommonEnvelope, true); }
     bool                                        AllowRLOFAtBirth() const                                                { return OPT_VALUE("allow-rlof-at-birth", m_AllowRLOFAtBirth, true); }
     bool                                        AllowTouchingAtBirth() const                                            { return OPT_VALUE("allow-touching-at-birth", m_AllowTouchingAtBirth, true); }
@@ -1053,6 +1241,7 @@ public:
 
 // Serena
     bool                                        BeBinaries() const                                                      { return OPT_VALUE("be-binaries", m_BeBinaries, true); }
+    LOGFILE_SAMPLING                            BeBinarySampling() const                                                { return m_CmdLine.optionValues.m_BeBinarySampling.type; }
 
     BLACK_HOLE_KICKS                            BlackHoleKicks() const                                                  { return OPT_VALUE("black-hole-kicks", m_BlackHoleKicks.type, true); }
     
@@ -1080,12 +1269,20 @@ public:
     double                                      CommonEnvelopeRecombinationEnergyDensity() const                        { return OPT_VALUE("common-envelope-recombination-energy-density", m_CommonEnvelopeRecombinationEnergyDensity, true); }
     double                                      CommonEnvelopeSlopeKruckow() const                                      { return OPT_VALUE("common-envelope-slope-kruckow", m_CommonEnvelopeSlopeKruckow, true); }
 
+    bool                                        ConvergenceHubble() const                                               { return m_CmdLine.optionValues.m_ConvergenceHubble; }
+    CONVERGENCE_OUTCOME                         ConvergenceOutcome() const                                              { return m_CmdLine.optionValues.m_ConvergenceOutcome.type; }
+    int                                         ConvergenceReportInterval() const                                       { return m_CmdLine.optionValues.m_ConvergenceReportInterval; }
+    double                                      ConvergenceTolerance() const                                            { return m_CmdLine.optionValues.m_ConvergenceTolerance; }
+    bool                                        ConvergenceWeighted() const                                             { return m_CmdLine.optionValues.m_ConvergenceWeighted; }
+
     double                                      CoolWindMassLossMultiplier() const                                      { return OPT_VALUE("cool-wind-mass-loss-multiplier", m_CoolWindMassLossMultiplier, true); }
 
     vector<string>                              DebugClasses() const                                                    { return m_CmdLine.optionValues.m_DebugClasses; }
     int                                         DebugLevel() const                                                      { return m_CmdLine.optionValues.m_DebugLevel; }
     bool                                        DebugToFile() const                                                     { return m_CmdLine.optionValues.m_DebugToFile; }
     bool                                        DetailedOutput() const                                                  { return m_CmdLine.optionValues.m_DetailedOutput; }
+    double                                      DetailedOutputInterval() const                                          { return m_CmdLine.optionValues.m_DetailedOutputInterval; }
+    double                                      DetailedOutputTolerance() const                                         { return m_CmdLine.optionValues.m_DetailedOutputTolerance; }
 
     bool                                        EnableWarnings() const                                                  { return m_CmdLine.optionValues.m_EnableWarnings; }
     bool                                        ErrorsToFile() const                                                    { return m_CmdLine.optionValues.m_ErrorsToFile; }
@@ -1110,6 +1307,12 @@ public:
 
     size_t                                      HDF5ChunkSize() const                                                   { return m_CmdLine.optionValues.m_HDF5ChunkSize; }
     size_t                                      HDF5BufferSize() const                                                  { return m_CmdLine.optionValues.m_HDF5BufferSize; }
+    vector<string>                              HDF5Precision() const                                                   { return m_CmdLine.optionValues.m_HDF5Precision; }
+
+    vector<string>                              Histograms() const                                                      { return m_CmdLine.optionValues.m_Histograms; }
+    bool                                        HistogramsOnly() const                                                  { return m_CmdLine.optionValues.m_HistogramsOnly; }
+
+    vector<string>                              LogfileFilters() const                                                  { return m_CmdLine.optionValues.m_LogfileFilters; }
 
     double                                      InitialMass() const                                                     { return OPT_VALUE("initial-mass", m_InitialMass, true); }
     double                                      InitialMass1() const                                                    { return OPT_VALUE("initial-mass-1", m_InitialMass1, true); }
@@ -1136,9 +1339,9 @@ public:
     double                                      KickMagnitude1() const                                                  { return OPT_VALUE("kick-magnitude-1", m_KickMagnitude1, true); }
     double                                      KickMagnitude2() const                                                  { return OPT_VALUE("kick-magnitude-2", m_KickMagnitude2, true); }
 
-    double                                      KickMagnitudeRandom() const                                             { return OPT_VALUE("kick-magnitude-random", m_KickMagnitudeRandom, false); }
-    double                                      KickMagnitudeRandom1() const                                            { return OPT_VALUE("kick-magnitude-random-1", m_KickMagnitudeRandom1, false); }
-    double                                      KickMagnitudeRandom2() const                                            { return OPT_VALUE("kick-magnitude-random-2", m_KickMagnitudeRandom2, false); }
+    double                                      KickMagnitudeRandom() const                                             { return DRAWN_VALUE(kickMagnitudeRandom); }
+    double                                      KickMagnitudeRandom1() const                                            { return DRAWN_VALUE(kickMagnitudeRandom1); }
+    double                                      KickMagnitudeRandom2() const                                            { return DRAWN_VALUE(kickMagnitudeRandom2); }
 
     vector<string>                              LogClasses() const                                                      { return m_CmdLine.optionValues.m_LogClasses; }
     string                                      LogfileBeBinaries() const                                               { return m_CmdLine.optionValues.m_LogfileBeBinaries; }
@@ -1176,6 +1379,10 @@ public:
                                                                                                                                         : get<0>(LOGFILE_DESCRIPTOR.at(LOGFILE::BSE_SYSTEM_PARAMETERS))
                                                                                                                                       );
                                                                                                                         }
+    LOGFILE_COMPRESSION                         LogfileCompression() const                                              { return m_CmdLine.optionValues.m_LogfileCompression.type; }
+    size_t                                      LogfileCompressionBlockSize() const                                     { return m_CmdLine.optionValues.m_LogfileCompressionBlockSize; }
+    double                                      LogfileSamplingLogTimeStep() const                                      { return m_CmdLine.optionValues.m_LogfileSamplingLogTimeStep; }
+    double                                      LogfileSamplingTolerance() const                                        { return m_CmdLine.optionValues.m_LogfileSamplingTolerance; }
     LOGFILETYPE                                 LogfileType() const                                                     { return m_CmdLine.optionValues.m_LogfileType.type; }
     string                                      LogfileTypeString() const                                               { return m_CmdLine.optionValues.m_LogfileType.typeString; }
     int                                         LogLevel() const                                                        { return m_CmdLine.optionValues.m_LogLevel; }
@@ -1227,6 +1434,8 @@ public:
     double                                      MaxEvolutionTime() const                                                { return m_CmdLine.optionValues.m_MaxEvolutionTime; }
     double                                      MaximumNeutronStarMass() const                                          { return OPT_VALUE("maximum-neutron-star-mass", m_MaximumNeutronStarMass, true); }
     int                                         MaxNumberOfTimestepIterations() const                                   { return m_CmdLine.optionValues.m_MaxNumberOfTimestepIterations; }
+    double                                      MemoryBudget() const                                                    { return m_CmdLine.optionValues.m_MemoryBudget; }
+    int                                         MemoryReportInterval() const                                            { return m_CmdLine.optionValues.m_MemoryReportInterval; }
     double                                      MaximumDonorMass() const                                                { return OPT_VALUE("maximum-mass-donor-nandez-ivanova", m_MaximumMassDonorNandezIvanova, true); }
     double                                      MCBUR1() const                                                          { return OPT_VALUE("mcbur1", m_mCBUR1, true); }
 
@@ -1271,6 +1480,7 @@ public:
     PULSAR_BIRTH_SPIN_PERIOD_DISTRIBUTION       PulsarBirthSpinPeriodDistribution() const                               { return OPT_VALUE("pulsar-birth-spin-period-distribution", m_PulsarBirthSpinPeriodDistribution.type, true); }
     double                                      PulsarBirthSpinPeriodDistributionMax() const                            { return OPT_VALUE("pulsar-birth-spin-period-distribution-max", m_PulsarBirthSpinPeriodDistributionMax, true); }
     double                                      PulsarBirthSpinPeriodDistributionMin() const                            { return OPT_VALUE("pulsar-birth-spin-period-distribution-min", m_PulsarBirthSpinPeriodDistributionMin, true); }
+    LOGFILE_SAMPLING                            PulsarEvolutionSampling() const                                         { return m_CmdLine.optionValues.m_PulsarEvolutionSampling.type; }
 
     double                                      PulsarLog10MinimumMagneticField() const                                 { return OPT_VALUE("pulsar-minimum-magnetic-field", m_PulsarLog10MinimumMagneticField, true); }
 
@@ -1281,6 +1491,8 @@ public:
     double                                      PulsationalPairInstabilityLowerLimit() const                            { return OPT_VALUE("PPI-lower-limit", m_PulsationalPairInstabilityLowerLimit, true); }
     double                                      PulsationalPairInstabilityUpperLimit() const                            { return OPT_VALUE("PPI-upper-limit", m_PulsationalPairInstabilityUpperLimit, true); }
 
+    unsigned long int                           QuasiRandomScrambleSeed() const                                         { return m_CmdLine.optionValues.m_QuasiRandomScrambleSeed; }
+    QUASI_RANDOM_SEQUENCE                       QuasiRandomSequence() const                                             { return m_CmdLine.optionValues.m_QuasiRandomSequence.type; }
     bool                                        Quiet() const                                                           { return m_CmdLine.optionValues.m_Quiet; }
 
     unsigned long int                           RandomSeed() const                                                      { return OPT_VALUE("random-seed", m_RandomSeed, true); }
@@ -1288,6 +1500,7 @@ public:
     unsigned long int                           RandomSeedGridLine() const                                              { return m_GridLine.optionValues.m_RandomSeed; }
 
     REMNANT_MASS_PRESCRIPTION                   RemnantMassPrescription() const                                         { return OPT_VALUE("remnant-mass-prescription", m_RemnantMassPrescription.type, true); }
+    string                                      RemnantTableFilename() const                                            { return m_CmdLine.optionValues.m_RemnantTableFilename; }
     bool                                        RLOFPrinting() const                                                    { return m_CmdLine.optionValues.m_RlofPrinting; }
 
     ROTATIONAL_VELOCITY_DISTRIBUTION            RotationalVelocityDistribution() const                                  { return OPT_VALUE("rotational-velocity-distribution", m_RotationalVelocityDistribution.type, true); }
@@ -1303,17 +1516,18 @@ public:
 
     void                                        ShowHelp()                                                              { PrintOptionHelp(!m_CmdLine.optionValues.m_ShortHelp); }
 
-    double                                      SN_MeanAnomaly1() const                                                 { return OPT_VALUE("kick-mean-anomaly-1", m_KickMeanAnomaly1, false); }
-    double                                      SN_MeanAnomaly2() const                                                 { return OPT_VALUE("kick-mean-anomaly-2", m_KickMeanAnomaly2, false); }
-    double                                      SN_Phi1() const                                                         { return OPT_VALUE("kick-phi-1", m_KickPhi1, false); }
-    double                                      SN_Phi2() const                                                         { return OPT_VALUE("kick-phi-2", m_KickPhi2, false); }
-    double                                      SN_Theta1() const                                                       { return OPT_VALUE("kick-theta-1", m_KickTheta1, false); }
-    double                                      SN_Theta2() const                                                       { return OPT_VALUE("kick-theta-2", m_KickTheta2, false); }
+    double                                      SN_MeanAnomaly1() const                                                 { return DRAWN_VALUE(kickMeanAnomaly1); }
+    double                                      SN_MeanAnomaly2() const                                                 { return DRAWN_VALUE(kickMeanAnomaly2); }
+    double                                      SN_Phi1() const                                                         { return DRAWN_VALUE(kickPhi1); }
+    double                                      SN_Phi2() const                                                         { return DRAWN_VALUE(kickPhi2); }
+    double                                      SN_Theta1() const                                                       { return DRAWN_VALUE(kickTheta1); }
+    double                                      SN_Theta2() const                                                       { return DRAWN_VALUE(kickTheta2); }
 
     bool                                        RequestedHelp() const                                                   { return m_CmdLine.optionValues.m_VM["help"].as<bool>(); }
     bool                                        RequestedVersion() const                                                { return m_CmdLine.optionValues.m_VM["version"].as<bool>(); }
 
     bool                                        StoreInputFiles() const                                                 { return m_CmdLine.optionValues.m_StoreInputFiles; }
+    STORE_INPUT_FILES_MODE                      StoreInputFilesMode() const                                             { return m_CmdLine.optionValues.m_StoreInputFilesMode.type; }
     bool                                        SwitchLog() const                                                       { return m_CmdLine.optionValues.m_SwitchLog; }
 
     ZETA_PRESCRIPTION                           StellarZetaPrescription() const                                         { return OPT_VALUE("stellar-zeta-prescription", m_StellarZetaPrescription.type, true); }
@@ -1,8 +1,12 @@
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <time.h>
 
 #include <iostream>
 
+#include <gsl/gsl_cdf.h>
+
 #include "Rand.h"
 
 Rand* Rand::m_Instance = nullptr;
@@ -118,3 +122,97 @@ int Rand::RandomInt(const int p_Lower, const int p_Upper) {
 double Rand::RandomGaussian(const double p_Sigma) {
     return gsl_ran_gaussian(m_Rng, p_Sigma);
 }
+
+
+/*
+ * Transform a uniform deviate to a sample from a Gaussian distribution, with mean p_Mu and standard
+ * deviation p_Sigma, truncated to [p_Lower, p_Upper]
+ *
+ * The sample is the exact inverse of the truncated CDF at p_Rand, so each sample takes one uniform
+ * deviate however far into the tails the bounds are (sampling by rejection takes an unbounded number
+ * of draws, and the expected number grows without limit as the probability in the bounds falls), and
+ * the sample increases with p_Rand.
+ *
+ * If the interval is in a tail, the inverse is calculated from the complementary CDF of that tail, so
+ * that it is accurate there.  Beyond the range of the complementary CDF (more than about 37 standard
+ * deviations from the mean) the tail is approximated by an exponential (Robert 1995, Stat. Comput. 5, 121).
+ *
+ * Either bound may be infinite.  If the interval is empty (p_Upper <= p_Lower) p_Lower is returned.
+ *
+ *
+ * double TruncatedGaussianInverseCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_Rand)
+ *
+ * @param   [IN]    p_Mu                        Mean of the (untruncated) distribution
+ * @param   [IN]    p_Sigma                     Standard deviation of the (untruncated) distribution
+ * @param   [IN]    p_Lower                     Lower bound
+ * @param   [IN]    p_Upper                     Upper bound
+ * @param   [IN]    p_Rand                      Uniform deviate in [0, 1) - the value of the truncated CDF at the sample
+ * @return                                      Sample, in [p_Lower, p_Upper]
+ */
+double Rand::TruncatedGaussianInverseCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_Rand) {
+
+    if (p_Upper <= p_Lower) return p_Lower;                                                             // empty interval
+    if (p_Sigma <= 0.0)     return std::min(std::max(p_Mu, p_Lower), p_Upper);                          // degenerate distribution
+
+    double a = (p_Lower - p_Mu) / p_Sigma;                                                              // standardised bounds
+    double b = (p_Upper - p_Mu) / p_Sigma;
+    double u = std::min(std::max(p_Rand, 0.0), 1.0);
+
+    double sign = 1.0;
+    if (a + b < 0.0) {                                                                                  // interval mostly below the mean - reflect it above the mean
+        double tmp = a;
+        a    = -b;
+        b    = -tmp;
+        u    = 1.0 - u;                                                                                 // reflection reverses the order of the samples
+        sign = -1.0;
+    }
+
+    double x;
+    if (a <= 0.0) {                                                                                     // interval contains the mean - use the CDF
+        double pA = gsl_cdf_ugaussian_P(a);
+        double pB = gsl_cdf_ugaussian_P(b);
+        x = gsl_cdf_ugaussian_Pinv(pA + u * (pB - pA));
+    }
+    else {                                                                                              // interval in the upper tail - use the complementary CDF
+        double qA = gsl_cdf_ugaussian_Q(a);
+        double qB = gsl_cdf_ugaussian_Q(b);
+        if (qA > std::numeric_limits<double>::min() && qA > qB) {
+            x = gsl_cdf_ugaussian_Qinv(qA - u * (qA - qB));
+        }
+        else {                                                                                          // beyond the range of the complementary CDF - exponential tail
+            x = a - std::log1p(-u * -std::expm1(-a * (b - a))) / a;
+        }
+    }
+
+    x = std::min(std::max(x, a), b);                                                                    // rounding may put the sample just outside the bounds
+
+    return std::min(std::max(p_Mu + sign * p_Sigma * x, p_Lower), p_Upper);
+}
+
+
+/*
+ * Transform a uniform deviate to a sample from a log-normal distribution, truncated to [p_Lower, p_Upper]
+ *
+ * log10 of the sample is Gaussian, with mean p_Mu and standard deviation p_Sigma (so the sample is
+ * 10^TruncatedGaussianInverseCDF() for the bounds log10(p_Lower) and log10(p_Upper)).  p_Lower may be 0,
+ * and p_Upper may be infinite.
+ *
+ *
+ * double TruncatedLogNormalInverseCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_Rand)
+ *
+ * @param   [IN]    p_Mu                        Mean of log10 of the (untruncated) distribution
+ * @param   [IN]    p_Sigma                     Standard deviation of log10 of the (untruncated) distribution
+ * @param   [IN]    p_Lower                     Lower bound (>= 0)
+ * @param   [IN]    p_Upper                     Upper bound
+ * @param   [IN]    p_Rand                      Uniform deviate in [0, 1) - the value of the truncated CDF at the sample
+ * @return                                      Sample, in [p_Lower, p_Upper]
+ */
+double Rand::TruncatedLogNormalInverseCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_Rand) {
+
+    double logLower = p_Lower > 0.0 ? std::log10(p_Lower) : -std::numeric_limits<double>::infinity();
+    double logUpper = p_Upper > 0.0 ? std::log10(p_Upper) : -std::numeric_limits<double>::infinity();
+
+    double sample = std::pow(10.0, TruncatedGaussianInverseCDF(p_Mu, p_Sigma, logLower, logUpper, p_Rand));
+
+    return std::min(std::max(sample, p_Lower), p_Upper);
+}
@@ -46,6 +46,13 @@ public:
     int           RandomInt(const int p_Lower, const int p_Upper);
     int           RandomInt(const int p_Upper) { return p_Upper < 0 ? 0 : RandomInt(0, p_Upper); }
     double        RandomGaussian(const double p_Sigma);
+
+    // truncated distributions - sampled by inverse transform, one uniform deviate per sample (no rejection)
+    double        RandomTruncatedGaussian(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper) { return TruncatedGaussianInverseCDF(p_Mu, p_Sigma, p_Lower, p_Upper, Random()); }
+    double        RandomTruncatedLogNormal(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper) { return TruncatedLogNormalInverseCDF(p_Mu, p_Sigma, p_Lower, p_Upper, Random()); }
+
+    static double TruncatedGaussianInverseCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_Rand);
+    static double TruncatedLogNormalInverseCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_Rand);
 };
 
 
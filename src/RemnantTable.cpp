@@ -0,0 +1,491 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "RemnantTable.h"
+#include "utils.h"
+
+
+RemnantTable* RemnantTable::m_Instance = nullptr;
+
+
+RemnantTable* RemnantTable::Instance() {
+
+    if (!m_Instance) {
+        m_Instance = new RemnantTable();
+    }
+    return m_Instance;
+}
+
+
+/*
+ * Clear the table
+ *
+ *
+ * void Clear()
+ */
+void RemnantTable::Clear() {
+
+    m_Filename = "";
+
+    m_COCoreMass = { {}, false, 0.0 };
+    m_HeCoreMass = { {}, false, 0.0 };
+    m_LogZ       = { {}, false, 0.0 };
+
+    m_MTCases.clear();
+    for (auto &idx : m_MTCaseIndex) idx = 0;
+
+    m_PBH.clear();
+    for (size_t q = 0; q < static_cast<size_t>(QUANTITY::COUNT); q++) {
+        m_nQuantiles[q] = 0;
+        m_Quantiles[q].clear();
+    }
+}
+
+
+/*
+ * Read the table from a file
+ *
+ * See RemnantTable.h for the format of the file.  If the file cannot be read, or is not a valid
+ * table, the table is left empty and the error is returned, with a description of the problem.
+ *
+ *
+ * std::tuple<ERROR, std::string> Load(const std::string p_Filename)
+ *
+ * @param   [IN]    p_Filename                  Name of the table file
+ * @return                                      Tuple containing the error (ERROR::NONE if the table was read),
+ *                                              and a description of the problem (empty if none)
+ */
+std::tuple<ERROR, std::string> RemnantTable::Load(const std::string p_Filename) {
+
+    static const std::vector<std::string> quantilePrefix = { "NS_MASS_Q", "BH_MASS_Q", "NS_KICK_Q", "BH_KICK_Q" };   // indexed by QUANTITY
+
+    Clear();
+
+    if (p_Filename.empty()) return std::make_tuple(ERROR::EMPTY_FILENAME, "");
+
+    std::ifstream file(p_Filename);
+    if (file.fail()) return std::make_tuple(ERROR::FILE_OPEN_ERROR, "");
+
+    // read the header and the rows
+
+    std::vector<std::string>              header = {};
+    std::vector<std::vector<std::string>> rows   = {};
+    std::vector<size_t>                   lines  = {};                                                  // line number of each row (for error messages)
+
+    std::string record;
+    size_t      lineNumber = 0;
+    while (std::getline(file, record)) {
+        lineNumber++;
+
+        size_t hashPos = record.find("#");                                                              // strip comment
+        if (hashPos != std::string::npos) record.erase(hashPos);
+        std::replace(record.begin(), record.end(), ',', ' ');                                           // commas are whitespace
+
+        std::vector<std::string> fields = {};
+        std::stringstream        ss(record);
+        std::string              field;
+        while (ss >> field) fields.push_back(field);
+
+        if (fields.empty()) continue;                                                                   // blank line
+
+        if (header.empty()) header = fields;
+        else {
+            rows.push_back(fields);
+            lines.push_back(lineNumber);
+        }
+    }
+    if (file.bad()) return std::make_tuple(ERROR::FILE_READ_ERROR, "");
+
+    auto fail = [this](const std::string p_Info) { Clear(); return std::make_tuple(ERROR::INVALID_REMNANT_TABLE, p_Info); };
+
+    if (header.empty()) return fail("no header");
+    if (rows.empty())   return fail("no nodes");
+
+    // identify the columns
+
+    int coCol  = -1;
+    int heCol  = -1;
+    int zCol   = -1;
+    int mtCol  = -1;
+    int pBHCol = -1;
+    std::vector<int> quantileCols[static_cast<int>(QUANTITY::COUNT)];
+
+    for (size_t col = 0; col < header.size(); col++) {
+
+        std::string name = utils::ToUpper(header[col]);
+        int *axisCol     = nullptr;
+
+             if (name == "CO_CORE_MASS") axisCol = &coCol;
+        else if (name == "HE_CORE_MASS") axisCol = &heCol;
+        else if (name == "METALLICITY")  axisCol = &zCol;
+        else if (name == "MT_CASE")      axisCol = &mtCol;
+        else if (name == "P_BH")         axisCol = &pBHCol;
+
+        if (axisCol) {
+            if (*axisCol >= 0) return fail("duplicate column " + header[col]);
+            *axisCol = static_cast<int>(col);
+            continue;
+        }
+
+        bool found = false;
+        for (size_t q = 0; !found && q < quantilePrefix.size(); q++) {
+            if (name.compare(0, quantilePrefix[q].size(), quantilePrefix[q]) != 0) continue;
+            std::string idxStr = name.substr(quantilePrefix[q].size());
+            if (idxStr.empty() || idxStr.find_first_not_of("0123456789") != std::string::npos) continue;
+
+            size_t idx = std::stoul(idxStr);
+            if (idx >= quantileCols[q].size()) quantileCols[q].resize(idx + 1, -1);
+            if (quantileCols[q][idx] >= 0) return fail("duplicate column " + header[col]);
+            quantileCols[q][idx] = static_cast<int>(col);
+            found = true;
+        }
+        if (!found) return fail("unknown column " + header[col]);
+    }
+
+    if (coCol < 0)  return fail("missing column CO_Core_Mass");
+    if (pBHCol < 0) return fail("missing column P_BH");
+
+    for (size_t q = 0; q < quantilePrefix.size(); q++) {
+        if (quantileCols[q].empty()) continue;
+        if (quantileCols[q].size() < 2) return fail("at least 2 quantile columns required for " + quantilePrefix[q] + "...");
+        for (size_t idx = 0; idx < quantileCols[q].size(); idx++) {
+            if (quantileCols[q][idx] < 0) return fail("missing column " + quantilePrefix[q] + std::to_string(idx));
+        }
+        m_nQuantiles[q] = quantileCols[q].size();
+    }
+    if ((m_nQuantiles[static_cast<int>(QUANTITY::NS_MASS)] > 0) != (m_nQuantiles[static_cast<int>(QUANTITY::BH_MASS)] > 0)) return fail("both or neither of NS_Mass_Q... and BH_Mass_Q... required");
+    if ((m_nQuantiles[static_cast<int>(QUANTITY::NS_KICK)] > 0) != (m_nQuantiles[static_cast<int>(QUANTITY::BH_KICK)] > 0)) return fail("both or neither of NS_Kick_Q... and BH_Kick_Q... required");
+
+    // parse the values
+
+    std::vector<std::vector<double>> values(rows.size(), std::vector<double>(header.size(), 0.0));
+    std::vector<MT_CASE>             mtCases(rows.size(), MT_CASE::NONE);
+
+    for (size_t row = 0; row < rows.size(); row++) {
+
+        std::string where = "line " + std::to_string(lines[row]);
+
+        if (rows[row].size() != header.size()) return fail(where + ": expected " + std::to_string(header.size()) + " values");
+
+        for (size_t col = 0; col < header.size(); col++) {
+            if (static_cast<int>(col) == mtCol) {
+                bool found;
+                std::tie(found, mtCases[row]) = utils::GetMapKey(rows[row][col], MT_CASE_SHORT_LABEL, MT_CASE::NONE);
+                if (!found) return fail(where + ": unknown MT case " + rows[row][col]);
+            }
+            else {
+                try {
+                    size_t pos;
+                    values[row][col] = std::stod(rows[row][col], &pos);
+                    if (pos != rows[row][col].size()) throw std::invalid_argument(rows[row][col]);
+                }
+                catch (...) {
+                    return fail(where + ": expected a number for " + header[col] + ", found " + rows[row][col]);
+                }
+            }
+        }
+
+        if (zCol >= 0) {
+            if (values[row][zCol] <= 0.0) return fail(where + ": Metallicity must be > 0");
+            values[row][zCol] = log10(values[row][zCol]);                                               // interpolate in log10(Z)
+        }
+
+        double pBH = values[row][pBHCol];
+        if (pBH < 0.0 || pBH > 1.0) return fail(where + ": P_BH must be in [0, 1]");
+
+        for (size_t q = 0; q < quantilePrefix.size(); q++) {
+            for (size_t idx = 1; idx < m_nQuantiles[q]; idx++) {
+                if (values[row][quantileCols[q][idx]] < values[row][quantileCols[q][idx - 1]]) return fail(where + ": " + quantilePrefix[q] + "... quantiles must not decrease");
+            }
+        }
+    }
+
+    // axes - the distinct values of each axis column (a single value if the column is not present)
+
+    auto makeAxis = [&values](const int p_Col) {
+        AxisT axis = { {}, false, 0.0 };
+        if (p_Col < 0) axis.values.push_back(0.0);
+        else {
+            for (auto &row : values) axis.values.push_back(row[p_Col]);
+            std::sort(axis.values.begin(), axis.values.end());
+            axis.values.erase(std::unique(axis.values.begin(), axis.values.end()), axis.values.end());
+        }
+        if (axis.values.size() > 1) {                                                                   // uniformly spaced?
+            axis.step    = (axis.values.back() - axis.values.front()) / (axis.values.size() - 1);
+            axis.uniform = true;
+            for (size_t idx = 1; axis.uniform && idx < axis.values.size(); idx++) {
+                axis.uniform = std::abs((axis.values[idx] - axis.values[idx - 1]) - axis.step) <= 1.0E-9 * axis.step;
+            }
+        }
+        return axis;
+    };
+
+    m_COCoreMass = makeAxis(coCol);
+    m_HeCoreMass = makeAxis(heCol);
+    m_LogZ       = makeAxis(zCol);
+
+    m_MTCases = mtCases;
+    std::sort(m_MTCases.begin(), m_MTCases.end());
+    m_MTCases.erase(std::unique(m_MTCases.begin(), m_MTCases.end()), m_MTCases.end());
+
+    for (int mtCase = 0; mtCase <= static_cast<int>(MT_CASE::OTHER); mtCase++) {                        // index of each MT case - case NONE if not tabulated
+        auto it = std::find(m_MTCases.begin(), m_MTCases.end(), static_cast<MT_CASE>(mtCase));
+        if (it == m_MTCases.end()) it = std::find(m_MTCases.begin(), m_MTCases.end(), MT_CASE::NONE);
+        if (it == m_MTCases.end()) return fail("MT_Case NONE required if not all MT cases are tabulated");
+        m_MTCaseIndex[mtCase] = static_cast<int>(it - m_MTCases.begin());
+    }
+
+    // nodes - must form a complete grid
+
+    size_t nCO   = m_COCoreMass.values.size();
+    size_t nHe   = m_HeCoreMass.values.size();
+    size_t nZ    = m_LogZ.values.size();
+    size_t nodes = nCO * nHe * nZ * m_MTCases.size();
+
+    if (rows.size() != nodes) return fail("expected " + std::to_string(nodes) + " nodes for a complete grid, found " + std::to_string(rows.size()));
+
+    auto index = [](const AxisT& p_Axis, const std::vector<double>& p_Row, const int p_Col) {
+        return p_Col < 0 ? 0 : static_cast<size_t>(std::lower_bound(p_Axis.values.begin(), p_Axis.values.end(), p_Row[p_Col]) - p_Axis.values.begin());
+    };
+
+    m_PBH.assign(nodes, -1.0);                                                                          // -1 = node not (yet) read
+    for (size_t q = 0; q < quantilePrefix.size(); q++) m_Quantiles[q].assign(nodes * m_nQuantiles[q], 0.0);
+
+    for (size_t row = 0; row < rows.size(); row++) {
+
+        size_t mtIdx = static_cast<size_t>(std::find(m_MTCases.begin(), m_MTCases.end(), mtCases[row]) - m_MTCases.begin());
+        size_t node  = ((mtIdx * nZ + index(m_LogZ, values[row], zCol)) * nHe + index(m_HeCoreMass, values[row], heCol)) * nCO + index(m_COCoreMass, values[row], coCol);
+
+        if (m_PBH[node] >= 0.0) return fail("line " + std::to_string(lines[row]) + ": duplicate node");
+
+        m_PBH[node] = values[row][pBHCol];
+        for (size_t q = 0; q < quantilePrefix.size(); q++) {
+            for (size_t idx = 0; idx < m_nQuantiles[q]; idx++) {
+                m_Quantiles[q][node * m_nQuantiles[q] + idx] = values[row][quantileCols[q][idx]];
+            }
+        }
+    }
+
+    m_Filename = p_Filename;
+
+    return std::make_tuple(ERROR::NONE, "");
+}
+
+
+/*
+ * Locate a value on an axis
+ *
+ * Finds the interval of the axis containing the value (clamped to the axis), and the fractional
+ * position of the value in the interval.  If the axis is uniformly spaced the interval is calculated
+ * directly, otherwise it is found by binary search.
+ *
+ *
+ * std::tuple<size_t, double> Locate(const AxisT& p_Axis, const double p_Value)
+ *
+ * @param   [IN]    p_Axis                      The axis
+ * @param   [IN]    p_Value                     The value
+ * @return                                      Tuple containing the index of the node at the lower end of the interval,
+ *                                              and the fractional position of the value in the interval (0 for an axis
+ *                                              with a single node)
+ */
+std::tuple<size_t, double> RemnantTable::Locate(const AxisT& p_Axis, const double p_Value) {
+
+    const std::vector<double> &values = p_Axis.values;
+    size_t n = values.size();
+
+    if (n < 2) return std::make_tuple(0, 0.0);
+
+    double x = std::min(std::max(p_Value, values.front()), values.back());
+
+    size_t idx = p_Axis.uniform
+                    ? std::min(static_cast<size_t>((x - values.front()) / p_Axis.step), n - 2)
+                    : std::min(static_cast<size_t>(std::upper_bound(values.begin(), values.end(), x) - values.begin()), n - 1) - 1;
+
+    double fraction = std::min(std::max((x - values[idx]) / (values[idx + 1] - values[idx]), 0.0), 1.0);
+
+    return std::make_tuple(idx, fraction);
+}
+
+
+/*
+ * Find the nodes that bracket a star, and their interpolation weights
+ *
+ *
+ * CornersT Bracket(const double p_COCoreMass, const double p_HeCoreMass, const double p_Metallicity, const MT_CASE p_MTCase)
+ *
+ * @param   [IN]    p_COCoreMass                CO core mass of the star (Msol)
+ * @param   [IN]    p_HeCoreMass                He core mass of the star (Msol)
+ * @param   [IN]    p_Metallicity               Metallicity of the star
+ * @param   [IN]    p_MTCase                    Mass transfer case of the star
+ * @return                                      The bracketing nodes (at most 8) and their weights
+ */
+RemnantTable::CornersT RemnantTable::Bracket(const double  p_COCoreMass,
+                                             const double  p_HeCoreMass,
+                                             const double  p_Metallicity,
+                                             const MT_CASE p_MTCase) const {
+    size_t iCO, iHe, iZ;
+    double fCO, fHe, fZ;
+
+    std::tie(iCO, fCO) = Locate(m_COCoreMass, p_COCoreMass);
+    std::tie(iHe, fHe) = Locate(m_HeCoreMass, p_HeCoreMass);
+    std::tie(iZ,  fZ)  = m_LogZ.values.size() < 2 ? std::make_tuple(size_t(0), 0.0) : Locate(m_LogZ, log10(p_Metallicity));
+
+    size_t nCO   = m_COCoreMass.values.size();
+    size_t nHe   = m_HeCoreMass.values.size();
+    size_t nZ    = m_LogZ.values.size();
+    size_t mtIdx = static_cast<size_t>(m_MTCaseIndex[static_cast<int>(p_MTCase)]);
+
+    CornersT corners;
+    corners.n = 0;
+    for (size_t corner = 0; corner < 8; corner++) {
+
+        size_t dCO = corner & 1;
+        size_t dHe = (corner >> 1) & 1;
+        size_t dZ  = (corner >> 2) & 1;
+
+        double weight = (dCO ? fCO : 1.0 - fCO) * (dHe ? fHe : 1.0 - fHe) * (dZ ? fZ : 1.0 - fZ);
+        if (weight <= 0.0) continue;                                                                    // node does not contribute (includes nodes beyond single-node axes)
+
+        corners.node[corners.n]   = ((mtIdx * nZ + iZ + dZ) * nHe + iHe + dHe) * nCO + iCO + dCO;
+        corners.weight[corners.n] = weight;
+        corners.n++;
+    }
+
+    return corners;
+}
+
+
+/*
+ * Evaluate the quantile function of a node
+ *
+ * The quantile function is linear between the tabulated quantiles.
+ *
+ *
+ * double Quantile(const size_t p_Node, const QUANTITY p_Quantity, const double p_Rand)
+ *
+ * @param   [IN]    p_Node                      Node index
+ * @param   [IN]    p_Quantity                  Quantity
+ * @param   [IN]    p_Rand                      Probability, in [0, 1]
+ * @return                                      Value of the quantity at probability p_Rand
+ */
+double RemnantTable::Quantile(const size_t p_Node, const QUANTITY p_Quantity, const double p_Rand) const {
+
+    size_t        n         = m_nQuantiles[static_cast<int>(p_Quantity)];
+    const double *quantiles = &m_Quantiles[static_cast<int>(p_Quantity)][p_Node * n];
+
+    double x   = std::min(std::max(p_Rand, 0.0), 1.0) * (n - 1);
+    size_t idx = std::min(static_cast<size_t>(x), n - 2);
+
+    return quantiles[idx] + (x - idx) * (quantiles[idx + 1] - quantiles[idx]);
+}
+
+
+/*
+ * Draw a value of a quantity, by inverse transform sampling
+ *
+ * The quantile function is interpolated between the bracketing nodes, each node weighted by its
+ * interpolation weight and the probability of the remnant type at the node (so nodes at which the
+ * remnant type cannot occur do not contribute).
+ *
+ *
+ * double Draw(const CornersT& p_Corners, const STELLAR_TYPE p_StellarType, const QUANTITY p_Quantity, const double p_Rand)
+ *
+ * @param   [IN]    p_Corners                   Bracketing nodes
+ * @param   [IN]    p_StellarType               Remnant type (BLACK_HOLE, otherwise neutron star)
+ * @param   [IN]    p_Quantity                  Quantity to draw
+ * @param   [IN]    p_Rand                      Uniform random number in [0, 1)
+ * @return                                      Drawn value
+ */
+double RemnantTable::Draw(const CornersT&    p_Corners,
+                          const STELLAR_TYPE p_StellarType,
+                          const QUANTITY     p_Quantity,
+                          const double       p_Rand) const {
+
+    double typeWeightSum = 0.0, typeWeightedValue = 0.0;
+    double weightedValue = 0.0;
+
+    for (size_t corner = 0; corner < p_Corners.n; corner++) {
+        size_t node     = p_Corners.node[corner];
+        double value    = Quantile(node, p_Quantity, p_Rand);
+        double pType    = p_StellarType == STELLAR_TYPE::BLACK_HOLE ? m_PBH[node] : 1.0 - m_PBH[node];
+        double weight   = p_Corners.weight[corner];
+
+        typeWeightSum     += weight * pType;
+        typeWeightedValue += weight * pType * value;
+        weightedValue     += weight * value;
+    }
+
+    return typeWeightSum > 0.0 ? typeWeightedValue / typeWeightSum : weightedValue;                    // remnant type not possible at any node - use interpolation weights only
+}
+
+
+/*
+ * Draw the type and mass of the remnant of a core-collapse supernova
+ *
+ *
+ * std::tuple<STELLAR_TYPE, double> DrawRemnant(const double  p_COCoreMass,
+ *                                              const double  p_HeCoreMass,
+ *                                              const double  p_Metallicity,
+ *                                              const MT_CASE p_MTCase,
+ *                                              const double  p_RandType,
+ *                                              const double  p_RandMass)
+ *
+ * @param   [IN]    p_COCoreMass                CO core mass of the star (Msol)
+ * @param   [IN]    p_HeCoreMass                He core mass of the star (Msol)
+ * @param   [IN]    p_Metallicity               Metallicity of the star
+ * @param   [IN]    p_MTCase                    Mass transfer case of the star
+ * @param   [IN]    p_RandType                  Uniform random number in [0, 1) used to draw the remnant type
+ * @param   [IN]    p_RandMass                  Uniform random number in [0, 1) used to draw the remnant mass
+ * @return                                      Tuple containing the remnant type (NEUTRON_STAR or BLACK_HOLE) and mass (Msol)
+ */
+std::tuple<STELLAR_TYPE, double> RemnantTable::DrawRemnant(const double  p_COCoreMass,
+                                                           const double  p_HeCoreMass,
+                                                           const double  p_Metallicity,
+                                                           const MT_CASE p_MTCase,
+                                                           const double  p_RandType,
+                                                           const double  p_RandMass) const {
+
+    CornersT corners = Bracket(p_COCoreMass, p_HeCoreMass, p_Metallicity, p_MTCase);
+
+    double pBH = 0.0;
+    for (size_t corner = 0; corner < corners.n; corner++) pBH += corners.weight[corner] * m_PBH[corners.node[corner]];
+
+    STELLAR_TYPE stellarType = p_RandType < pBH ? STELLAR_TYPE::BLACK_HOLE : STELLAR_TYPE::NEUTRON_STAR;
+
+    double mass = Draw(corners, stellarType, stellarType == STELLAR_TYPE::BLACK_HOLE ? QUANTITY::BH_MASS : QUANTITY::NS_MASS, p_RandMass);
+
+    return std::make_tuple(stellarType, mass);
+}
+
+
+/*
+ * Draw the natal kick magnitude of the remnant of a supernova
+ *
+ *
+ * double DrawKick(const double       p_COCoreMass,
+ *                 const double       p_HeCoreMass,
+ *                 const double       p_Metallicity,
+ *                 const MT_CASE      p_MTCase,
+ *                 const STELLAR_TYPE p_StellarType,
+ *                 const double       p_Rand)
+ *
+ * @param   [IN]    p_COCoreMass                CO core mass of the star (Msol)
+ * @param   [IN]    p_HeCoreMass                He core mass of the star (Msol)
+ * @param   [IN]    p_Metallicity               Metallicity of the star
+ * @param   [IN]    p_MTCase                    Mass transfer case of the star
+ * @param   [IN]    p_StellarType               Remnant type (BLACK_HOLE, otherwise neutron star)
+ * @param   [IN]    p_Rand                      Uniform random number in [0, 1) used to draw the kick magnitude
+ * @return                                      Kick magnitude (km s^-1)
+ */
+double RemnantTable::DrawKick(const double       p_COCoreMass,
+                              const double       p_HeCoreMass,
+                              const double       p_Metallicity,
+                              const MT_CASE      p_MTCase,
+                              const STELLAR_TYPE p_StellarType,
+                              const double       p_Rand) const {
+
+    CornersT corners = Bracket(p_COCoreMass, p_HeCoreMass, p_Metallicity, p_MTCase);
+
+    return Draw(corners, p_StellarType, p_StellarType == STELLAR_TYPE::BLACK_HOLE ? QUANTITY::BH_KICK : QUANTITY::NS_KICK, p_Rand);
+}
@@ -0,0 +1,144 @@
+#ifndef __RemnantTable_h__
+#define __RemnantTable_h__
+
+#define REMNANT_TABLE RemnantTable::Instance()
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+/*
+ * RemnantTable Singleton - tabulated remnant types, masses and natal kicks
+ *
+ * The table is read at startup from the file specified by program option --remnant-table, and is
+ * used by the TABULATED remnant mass prescription (--remnant-mass-prescription) and the TABULATED
+ * kick magnitude distribution (--kick-magnitude-distribution), so the outcomes of an explodability
+ * study can be used without changes to the code.
+ *
+ * The table file is a text file.  Blank lines, and text following a '#', are ignored.  The first line
+ * is a header that names the columns; each following line is a node of the table.  Columns are
+ * separated by commas or whitespace, and may be in any order.  The columns are:
+ *
+ *     CO_Core_Mass                 CO core mass (Msol) at the supernova                            - required
+ *     He_Core_Mass                 He core mass (Msol) at the supernova                            - optional
+ *     Metallicity                  Metallicity Z (interpolated in log10(Z))                        - optional
+ *     MT_Case                      Mass transfer case of the star: NONE, A, B, C or OTHER          - optional
+ *                                  (see BaseStar::MassTransferCase())
+ *
+ *     P_BH                         Probability that the remnant is a black hole (otherwise a neutron star)
+ *     NS_Mass_Q0 ... NS_Mass_Qn    Quantiles of the neutron star mass (Msol) at probabilities 0, 1/n, ... 1
+ *     BH_Mass_Q0 ... BH_Mass_Qn    Quantiles of the black hole mass (Msol) at probabilities 0, 1/n, ... 1
+ *     NS_Kick_Q0 ... NS_Kick_Qn    Quantiles of the neutron star kick magnitude (km s^-1)
+ *     BH_Kick_Q0 ... BH_Kick_Qn    Quantiles of the black hole kick magnitude (km s^-1)
+ *
+ * The mass quantiles are required for the TABULATED remnant mass prescription, and the kick quantiles
+ * for the TABULATED kick magnitude distribution.  Each set of quantiles has at least 2 columns (n >= 1),
+ * and may have a different number of columns than the other sets.  Quantiles must not decrease.
+ *
+ * The nodes must form a complete grid: one node for each combination of the distinct values of the
+ * CO_Core_Mass, He_Core_Mass, Metallicity and MT_Case columns present.  The grid need not be uniformly
+ * spaced, but look-up along an axis is a direct index calculation (rather than a search) if it is.
+ *
+ * Draws interpolate linearly between the nodes that bracket the star in CO core mass, He core mass and
+ * log10(Z) (values outside the grid are clamped to its edges), at the MT case of the star (if the table
+ * has no node for that case, the nodes for case NONE are used).  The probability of a black hole is
+ * interpolated, and the remnant type drawn from it; the mass and kick are drawn by inverse transform
+ * sampling, from the quantile function interpolated between the nodes (the quantiles of each node
+ * weighted by the interpolation weight of the node and the probability of the drawn remnant type at the
+ * node).  Each draw takes one uniform random number, and a fixed amount of work - there are no rejection
+ * loops.
+ */
+
+class RemnantTable {
+
+private:
+
+    RemnantTable()                                                                  { Clear(); }
+    RemnantTable(RemnantTable const&) = delete;
+    RemnantTable& operator = (RemnantTable const&) = delete;
+
+    static RemnantTable* m_Instance;
+
+
+    // quantities tabulated as quantiles
+    enum class QUANTITY: int { NS_MASS, BH_MASS, NS_KICK, BH_KICK, COUNT };
+
+    // interpolation axis (CO core mass, He core mass, log10(Z))
+    typedef struct Axis {
+        std::vector<double> values;                                                 // distinct node values, ascending
+        bool                uniform;                                                // true if values are uniformly spaced
+        double              step;                                                   // spacing of values (if uniform)
+    } AxisT;
+
+    // nodes bracketing a star, and their interpolation weights
+    typedef struct Corners {
+        size_t n;                                                                   // number of nodes
+        size_t node[8];                                                             // node indices
+        double weight[8];                                                           // interpolation weights (sum to 1)
+    } CornersT;
+
+
+    void                Clear();
+
+    CornersT            Bracket(const double  p_COCoreMass,
+                                const double  p_HeCoreMass,
+                                const double  p_Metallicity,
+                                const MT_CASE p_MTCase) const;
+
+    double              Draw(const CornersT&    p_Corners,
+                             const STELLAR_TYPE p_StellarType,
+                             const QUANTITY     p_Quantity,
+                             const double       p_Rand) const;
+
+    static std::tuple<size_t, double> Locate(const AxisT& p_Axis, const double p_Value);
+
+    double              Quantile(const size_t p_Node, const QUANTITY p_Quantity, const double p_Rand) const;
+
+
+    std::string         m_Filename;                                                 // table file
+
+    AxisT               m_COCoreMass;                                               // CO core mass axis (Msol)
+    AxisT               m_HeCoreMass;                                               // He core mass axis (Msol)
+    AxisT               m_LogZ;                                                     // log10(metallicity) axis
+
+    std::vector<MT_CASE> m_MTCases;                                                 // MT cases tabulated
+    int                 m_MTCaseIndex[static_cast<int>(MT_CASE::OTHER) + 1];        // index into m_MTCases for each MT case (case NONE if not tabulated)
+
+    std::vector<double> m_PBH;                                                      // probability of a black hole, per node
+    size_t              m_nQuantiles[static_cast<int>(QUANTITY::COUNT)];            // number of quantiles for each quantity (0 = not tabulated)
+    std::vector<double> m_Quantiles[static_cast<int>(QUANTITY::COUNT)];             // quantiles for each quantity - m_nQuantiles per node, node by node
+
+
+public:
+
+    static RemnantTable* Instance();
+
+
+    // getters
+    std::string         Filename() const                                            { return m_Filename; }
+    bool                HasKicks() const                                            { return m_nQuantiles[static_cast<int>(QUANTITY::NS_KICK)] > 0; }
+    bool                HasMasses() const                                           { return m_nQuantiles[static_cast<int>(QUANTITY::NS_MASS)] > 0; }
+    bool                Loaded() const                                              { return !m_PBH.empty(); }
+    size_t              nNodes() const                                              { return m_PBH.size(); }
+
+
+    // member functions
+    double              DrawKick(const double       p_COCoreMass,
+                                 const double       p_HeCoreMass,
+                                 const double       p_Metallicity,
+                                 const MT_CASE      p_MTCase,
+                                 const STELLAR_TYPE p_StellarType,
+                                 const double       p_Rand) const;
+
+    std::tuple<STELLAR_TYPE, double> DrawRemnant(const double  p_COCoreMass,
+                                                 const double  p_HeCoreMass,
+                                                 const double  p_Metallicity,
+                                                 const MT_CASE p_MTCase,
+                                                 const double  p_RandType,
+                                                 const double  p_RandMass) const;
+
+    std::tuple<ERROR, std::string> Load(const std::string p_Filename);
+};
+
+
+#endif // __RemnantTable_h__
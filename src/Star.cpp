@@ -1,14 +1,19 @@
 #include "Star.h"
 #include <algorithm>
 #include <csignal>
+#include <new>
 
 // Default constructor
-Star::Star() : m_Star(new BaseStar()) {
+Star::Star() {
 
     m_ObjectId   = globalObjectId++;                                                                // set object id
     m_ObjectType = OBJECT_TYPE::STAR;                                                               // set object type
 
-    m_SaveStar = nullptr;
+    m_Phase     = &m_Storage[0];
+    m_Star      = new (m_Phase) BaseStar();
+
+    m_SaveStar  = nullptr;
+    m_SavePhase = nullptr;
 }
 
 
@@ -23,7 +28,11 @@ Star::Star(const unsigned long int p_RandomSeed,
     m_ObjectId   = globalObjectId++;                                                                                // set object id
     m_ObjectType = OBJECT_TYPE::STAR;                                                                               // set object type
 
-    m_Star = new BaseStar(p_RandomSeed, p_MZAMS, p_Metallicity, p_KickParameters, p_RotationalVelocity);            // create underlying BaseStar object
+    m_SaveStar  = nullptr;
+    m_SavePhase = nullptr;
+
+    m_Phase = &m_Storage[0];
+    m_Star  = new (m_Phase) BaseStar(p_RandomSeed, p_MZAMS, p_Metallicity, p_KickParameters, p_RotationalVelocity); // create underlying BaseStar object
 
     // star begins life as a main sequence star, unless it is
     // spinning fast enough for it to be chemically homogeneous
@@ -37,56 +46,86 @@ Star::Star(const unsigned long int p_RandomSeed,
     else {
         (void)SwitchTo(STELLAR_TYPE::MS_GT_07, true);                                                               // MS > 0.7 Msol
     }
-
-    m_SaveStar = nullptr;
 }
 
 
 /*
  * Clone underlying BaseStar
  *
- * Instantiates new object of current underlying star class and initialises
- * it with the star object passed as p_Star
+ * Instantiates new object of current underlying star class, in the storage passed
+ * as p_Storage, and initialises it with the star object passed as p_Star
  *
  *
- * BaseStar* Clone()
+ * BaseStar* Clone(const BaseStar& p_Star, void* p_Storage)
+ *
+ * @param   [IN]    p_Star                      Star object to clone
+ * @param   [IN]    p_Storage                   Storage for the new object (one of m_Storage)
+ * @return                                      Pointer to the new object (nullptr if p_Star is not one of the stellar phase classes)
  */
-BaseStar* Star::Clone(const BaseStar& p_Star) {
+BaseStar* Star::Clone(const BaseStar& p_Star, void* p_Storage) {
 
     BaseStar *ptr = nullptr;
 
     switch (p_Star.StellarType()) {
-        case STELLAR_TYPE::MS_LTE_07                                : {ptr = new MS_lte_07(p_Star, false);} break;
-        case STELLAR_TYPE::MS_GT_07                                 : {ptr = new MS_gt_07(p_Star, false);} break;
-        case STELLAR_TYPE::CHEMICALLY_HOMOGENEOUS                   : {ptr = new CH(p_Star, false);} break;
-        case STELLAR_TYPE::HERTZSPRUNG_GAP                          : {ptr = new HG(p_Star, false);} break;
-        case STELLAR_TYPE::FIRST_GIANT_BRANCH                       : {ptr = new FGB(p_Star, false);} break;
-        case STELLAR_TYPE::CORE_HELIUM_BURNING                      : {ptr = new CHeB(p_Star, false);} break;
-        case STELLAR_TYPE::EARLY_ASYMPTOTIC_GIANT_BRANCH            : {ptr = new EAGB(p_Star, false);} break;
-        case STELLAR_TYPE::THERMALLY_PULSING_ASYMPTOTIC_GIANT_BRANCH: {ptr = new TPAGB(p_Star, false);} break;
-        case STELLAR_TYPE::NAKED_HELIUM_STAR_MS                     : {ptr = new HeMS(p_Star, false);} break;
-        case STELLAR_TYPE::NAKED_HELIUM_STAR_HERTZSPRUNG_GAP        : {ptr = new HeHG(p_Star, false);} break;
-        case STELLAR_TYPE::NAKED_HELIUM_STAR_GIANT_BRANCH           : {ptr = new HeGB(p_Star, false);} break;
-        case STELLAR_TYPE::HELIUM_WHITE_DWARF                       : {ptr = new HeWD(p_Star, false);} break;
-        case STELLAR_TYPE::CARBON_OXYGEN_WHITE_DWARF                : {ptr = new COWD(p_Star, false);} break;
-        case STELLAR_TYPE::OXYGEN_NEON_WHITE_DWARF                  : {ptr = new ONeWD(p_Star, false);} break;
-        case STELLAR_TYPE::NEUTRON_STAR                             : {ptr = new NS(p_Star, false);} break;
-        case STELLAR_TYPE::BLACK_HOLE                               : {ptr = new BH(p_Star, false);} break;
-        case STELLAR_TYPE::MASSLESS_REMNANT                         : {ptr = new MR(p_Star, false);} break;
+        case STELLAR_TYPE::MS_LTE_07                                : {ptr = new (p_Storage) MS_lte_07(p_Star, false);} break;
+        case STELLAR_TYPE::MS_GT_07                                 : {ptr = new (p_Storage) MS_gt_07(p_Star, false);} break;
+        case STELLAR_TYPE::CHEMICALLY_HOMOGENEOUS                   : {ptr = new (p_Storage) CH(p_Star, false);} break;
+        case STELLAR_TYPE::HERTZSPRUNG_GAP                          : {ptr = new (p_Storage) HG(p_Star, false);} break;
+        case STELLAR_TYPE::FIRST_GIANT_BRANCH                       : {ptr = new (p_Storage) FGB(p_Star, false);} break;
+        case STELLAR_TYPE::CORE_HELIUM_BURNING                      : {ptr = new (p_Storage) CHeB(p_Star, false);} break;
+        case STELLAR_TYPE::EARLY_ASYMPTOTIC_GIANT_BRANCH            : {ptr = new (p_Storage) EAGB(p_Star, false);} break;
+        case STELLAR_TYPE::THERMALLY_PULSING_ASYMPTOTIC_GIANT_BRANCH: {ptr = new (p_Storage) TPAGB(p_Star, false);} break;
+        case STELLAR_TYPE::NAKED_HELIUM_STAR_MS                     : {ptr = new (p_Storage) HeMS(p_Star, false);} break;
+        case STELLAR_TYPE::NAKED_HELIUM_STAR_HERTZSPRUNG_GAP        : {ptr = new (p_Storage) HeHG(p_Star, false);} break;
+        case STELLAR_TYPE::NAKED_HELIUM_STAR_GIANT_BRANCH           : {ptr = new (p_Storage) HeGB(p_Star, false);} break;
+        case STELLAR_TYPE::HELIUM_WHITE_DWARF                       : {ptr = new (p_Storage) HeWD(p_Star, false);} break;
+        case STELLAR_TYPE::CARBON_OXYGEN_WHITE_DWARF                : {ptr = new (p_Storage) COWD(p_Star, false);} break;
+        case STELLAR_TYPE::OXYGEN_NEON_WHITE_DWARF                  : {ptr = new (p_Storage) ONeWD(p_Star, false);} break;
+        case STELLAR_TYPE::NEUTRON_STAR                             : {ptr = new (p_Storage) NS(p_Star, false);} break;
+        case STELLAR_TYPE::BLACK_HOLE                               : {ptr = new (p_Storage) BH(p_Star, false);} break;
+        case STELLAR_TYPE::MASSLESS_REMNANT                         : {ptr = new (p_Storage) MR(p_Star, false);} break;
         default: break;                                             // avoids compiler warning - this should never happen
     }
 
     return ptr;
 }
 
+
+/*
+ * Find storage (one of m_Storage) not used by the current or saved star objects
+ *
+ *
+ * void* FreeStorage()
+ *
+ * @return                                      Pointer to the free storage
+ */
+void* Star::FreeStorage() {
+
+    void *storage = nullptr;
+
+    for (auto &thisStorage : m_Storage) {
+        if (&thisStorage != m_Phase && &thisStorage != m_SavePhase) {
+            storage = &thisStorage;
+            break;
+        }
+    }
+
+    return storage;                                                                     // there are 3 of m_Storage, so one is always free
+}
+
 // Copy constructor - deep copy so dynamic variables are also copied
 Star::Star(const Star& p_Star) {
 
     m_ObjectId   = globalObjectId++;                                                    // set object id
     m_ObjectType = OBJECT_TYPE::STAR;                                                   // set object type
 
-    m_Star     = p_Star.m_Star ? Clone(*(p_Star.m_Star)) : nullptr;                     // copy underlying BasStar object
-    m_SaveStar = p_Star.m_SaveStar ? Clone(*(p_Star.m_Star)) : nullptr;                 // and the saved copy
+    m_Phase     = &m_Storage[0];
+    m_Star      = p_Star.m_Star ? Clone(*(p_Star.m_Star), m_Phase) : nullptr;           // copy underlying BasStar object
+    if (!m_Star) m_Phase = nullptr;
+
+    m_SavePhase = &m_Storage[1];
+    m_SaveStar  = p_Star.m_SaveStar ? Clone(*(p_Star.m_Star), m_SavePhase) : nullptr;   // and the saved copy
+    if (!m_SaveStar) m_SavePhase = nullptr;
 }
 
 
@@ -98,11 +137,23 @@ Star& Star::operator = (const Star& p_Star) {
         m_ObjectId   = globalObjectId++;                                                // set object id
         m_ObjectType = OBJECT_TYPE::STAR;                                               // set object type
 
-        delete m_Star;
-        m_Star = p_Star.m_Star ? Clone(*(p_Star.m_Star)) : nullptr;                     // copy underlying BasStar object
-
-        delete m_SaveStar;
-        m_SaveStar = p_Star.m_SaveStar ? Clone(*(p_Star.m_SaveStar)) : nullptr;         // and the saved copy
+        // destroy both existing objects before cloning - after SwitchTo() the current and
+        // saved star objects can be in any of m_Storage, so either may be in the storage
+        // the clones are constructed in
+        if (m_Star) m_Star->~BaseStar();
+        if (m_SaveStar) m_SaveStar->~BaseStar();
+        m_Star      = nullptr;
+        m_SaveStar  = nullptr;
+        m_Phase     = nullptr;
+        m_SavePhase = nullptr;
+
+        m_Phase = &m_Storage[0];
+        m_Star  = p_Star.m_Star ? Clone(*(p_Star.m_Star), m_Phase) : nullptr;           // copy underlying BasStar object
+        if (!m_Star) m_Phase = nullptr;
+
+        m_SavePhase = &m_Storage[1];
+        m_SaveStar  = p_Star.m_SaveStar ? Clone(*(p_Star.m_SaveStar), m_SavePhase) : nullptr; // and the saved copy
+        if (!m_SaveStar) m_SavePhase = nullptr;
     }
     return *this;
 }
@@ -111,8 +162,8 @@ Star& Star::operator = (const Star& p_Star) {
 /*
  * Switch to required star type
  *
- * Instantiates new object of required class, deletes existing pointer to star object and
- * replaces it with pointer to newly instantiated object
+ * Instantiates new object of required class (in free storage), destroys existing star object and
+ * replaces it with the newly instantiated object
  *
  *
  * STELLAR_TYPE SwitchTo(const STELLAR_TYPE p_StellarType, bool p_SetInitialState)
@@ -130,32 +181,34 @@ STELLAR_TYPE Star::SwitchTo(const STELLAR_TYPE p_StellarType, bool p_SetInitialT
     // (the call to SwitchTo() in Star::EvolveOneTimestep() doesn't check - it relies on the check here)
 
     if (p_StellarType != m_Star->StellarType()) {
-        BaseStar *ptr = nullptr;
+        BaseStar *ptr     = nullptr;
+        void     *storage = FreeStorage();
 
         switch (p_StellarType) {
-            case STELLAR_TYPE::MS_LTE_07                                : {ptr = new MS_lte_07(*m_Star);} break;
-            case STELLAR_TYPE::MS_GT_07                                 : {ptr = new MS_gt_07(*m_Star);} break;
-            case STELLAR_TYPE::CHEMICALLY_HOMOGENEOUS                   : {ptr = new CH(*m_Star);} break;
-            case STELLAR_TYPE::HERTZSPRUNG_GAP                          : {ptr = new HG(*m_Star);} break;
-            case STELLAR_TYPE::FIRST_GIANT_BRANCH                       : {ptr = new FGB(*m_Star);} break;
-            case STELLAR_TYPE::CORE_HELIUM_BURNING                      : {ptr = new CHeB(*m_Star);} break;
-            case STELLAR_TYPE::EARLY_ASYMPTOTIC_GIANT_BRANCH            : {ptr = new EAGB(*m_Star);} break;
-            case STELLAR_TYPE::THERMALLY_PULSING_ASYMPTOTIC_GIANT_BRANCH: {ptr = new TPAGB(*m_Star);} break;
-            case STELLAR_TYPE::NAKED_HELIUM_STAR_MS                     : {ptr = new HeMS(*m_Star);} break;
-            case STELLAR_TYPE::NAKED_HELIUM_STAR_HERTZSPRUNG_GAP        : {ptr = new HeHG(*m_Star);} break;
-            case STELLAR_TYPE::NAKED_HELIUM_STAR_GIANT_BRANCH           : {ptr = new HeGB(*m_Star);} break;
-            case STELLAR_TYPE::HELIUM_WHITE_DWARF                       : {ptr = new HeWD(*m_Star);} break;
-            case STELLAR_TYPE::CARBON_OXYGEN_WHITE_DWARF                : {ptr = new COWD(*m_Star);} break;
-            case STELLAR_TYPE::OXYGEN_NEON_WHITE_DWARF                  : {ptr = new ONeWD(*m_Star);} break;
-            case STELLAR_TYPE::NEUTRON_STAR                             : {ptr = new NS(*m_Star);} break;
-            case STELLAR_TYPE::BLACK_HOLE                               : {ptr = new BH(*m_Star);} break;
-            case STELLAR_TYPE::MASSLESS_REMNANT                         : {ptr = new MR(*m_Star);} break;
+            case STELLAR_TYPE::MS_LTE_07                                : {ptr = new (storage) MS_lte_07(*m_Star);} break;
+            case STELLAR_TYPE::MS_GT_07                                 : {ptr = new (storage) MS_gt_07(*m_Star);} break;
+            case STELLAR_TYPE::CHEMICALLY_HOMOGENEOUS                   : {ptr = new (storage) CH(*m_Star);} break;
+            case STELLAR_TYPE::HERTZSPRUNG_GAP                          : {ptr = new (storage) HG(*m_Star);} break;
+            case STELLAR_TYPE::FIRST_GIANT_BRANCH                       : {ptr = new (storage) FGB(*m_Star);} break;
+            case STELLAR_TYPE::CORE_HELIUM_BURNING                      : {ptr = new (storage) CHeB(*m_Star);} break;
+            case STELLAR_TYPE::EARLY_ASYMPTOTIC_GIANT_BRANCH            : {ptr = new (storage) EAGB(*m_Star);} break;
+            case STELLAR_TYPE::THERMALLY_PULSING_ASYMPTOTIC_GIANT_BRANCH: {ptr = new (storage) TPAGB(*m_Star);} break;
+            case STELLAR_TYPE::NAKED_HELIUM_STAR_MS                     : {ptr = new (storage) HeMS(*m_Star);} break;
+            case STELLAR_TYPE::NAKED_HELIUM_STAR_HERTZSPRUNG_GAP        : {ptr = new (storage) HeHG(*m_Star);} break;
+            case STELLAR_TYPE::NAKED_HELIUM_STAR_GIANT_BRANCH           : {ptr = new (storage) HeGB(*m_Star);} break;
+            case STELLAR_TYPE::HELIUM_WHITE_DWARF                       : {ptr = new (storage) HeWD(*m_Star);} break;
+            case STELLAR_TYPE::CARBON_OXYGEN_WHITE_DWARF                : {ptr = new (storage) COWD(*m_Star);} break;
+            case STELLAR_TYPE::OXYGEN_NEON_WHITE_DWARF                  : {ptr = new (storage) ONeWD(*m_Star);} break;
+            case STELLAR_TYPE::NEUTRON_STAR                             : {ptr = new (storage) NS(*m_Star);} break;
+            case STELLAR_TYPE::BLACK_HOLE                               : {ptr = new (storage) BH(*m_Star);} break;
+            case STELLAR_TYPE::MASSLESS_REMNANT                         : {ptr = new (storage) MR(*m_Star);} break;
             default: break;                                             // avoids compiler warning - this should never happen
         }
 
         if (ptr) {
-            delete m_Star;
-            m_Star = ptr;
+            m_Star->~BaseStar();
+            m_Star  = ptr;
+            m_Phase = storage;
 
             if (p_SetInitialType) m_Star->SetInitialType(p_StellarType);
         }
@@ -181,16 +234,19 @@ STELLAR_TYPE Star::SwitchTo(const STELLAR_TYPE p_StellarType, bool p_SetInitialT
 /*
  * Save current state of star
  *
- * Instantiates new object of current star class, deletes existing pointer to saved star
- * object (if it exists) and replaces it with pointer to newly instantiated object
+ * Destroys existing saved star object (if it exists) and replaces it with a newly
+ * instantiated copy of the current star object
  *
  *
  * void SaveState()
  */
 void Star::SaveState() {
 
-    delete m_SaveStar;
-    m_SaveStar = Clone(*m_Star);
+    if (m_SaveStar) m_SaveStar->~BaseStar();
+
+    m_SavePhase = FreeStorage();
+    m_SaveStar  = Clone(*m_Star, m_SavePhase);
+    if (!m_SaveStar) m_SavePhase = nullptr;
 }
 
 
@@ -211,10 +267,12 @@ bool Star::RevertState() {
     bool result = false;
 
     if (m_SaveStar) {
-        delete m_Star;
-        m_Star     = m_SaveStar;
-        m_SaveStar = nullptr;
-        result     = true;
+        m_Star->~BaseStar();
+        m_Star      = m_SaveStar;
+        m_Phase     = m_SavePhase;
+        m_SaveStar  = nullptr;
+        m_SavePhase = nullptr;
+        result      = true;
     }
 
     return result;
@@ -511,6 +569,7 @@ EVOLUTION_STATUS Star::Evolve(const long int p_Id) {
     }
 
     (void)m_Star->PrintSystemParameters();                                      // log system parameters
+    (void)LOGGING->ReleaseStagedRecords(m_Star);                                // write (or discard) records staged for filtered logfiles
 
     return status;
 }
@@ -2,6 +2,7 @@
 #define __Star_h__
 
 #include <fstream>
+#include <type_traits>
 
 #include "constants.h"
 #include "typedefs.h"
@@ -47,6 +48,51 @@ class BH;
 class MR;
 
 
+// Storage for the underlying star object - large enough, and aligned, for an object of any of the
+// stellar phase classes.  The class of the underlying star object is determined by its stellar type
+// (see Star::Clone() and Star::SwitchTo()), so the star objects can be held in Star (see m_Storage)
+// rather than on the heap, and calls to them can be dispatched on the stellar type (see STAR_DISPATCH)
+typedef std::aligned_union<0, BaseStar, MS_lte_07, MS_gt_07, CH, HG, FGB, CHeB, EAGB, TPAGB,
+                           HeMS, HeHG, HeGB, HeWD, COWD, ONeWD, NS, BH, MR>::type StarStorageT;
+
+
+// Closed-set dispatch of a call to the underlying star object
+//
+// Switches on the stellar type and calls the function of the class of the underlying star object
+// directly (a qualified call), rather than through the vtable, so the compiler can inline it.  Building
+// with COMPAS_VIRTUAL_DISPATCH defined ('make DISPATCH=virtual') reverts to virtual calls - e.g. to
+// compare the two.
+//
+// Only use for functions declared with the same signature in every class that declares them: the
+// qualified call resolves to the first declaration found in the class hierarchy, which is not the
+// overrider if a class hides the BaseStar declaration with a different signature.
+#ifdef COMPAS_VIRTUAL_DISPATCH
+#define STAR_DISPATCH(call) return m_Star->call
+#else
+#define STAR_DISPATCH(call)                                                                                                     \
+    switch (m_Star->StellarType()) {                                                                                            \
+        case STELLAR_TYPE::MS_LTE_07                                : return Phase<MS_lte_07>()->MS_lte_07::call;               \
+        case STELLAR_TYPE::MS_GT_07                                 : return Phase<MS_gt_07>()->MS_gt_07::call;                 \
+        case STELLAR_TYPE::CHEMICALLY_HOMOGENEOUS                   : return Phase<CH>()->CH::call;                             \
+        case STELLAR_TYPE::HERTZSPRUNG_GAP                          : return Phase<HG>()->HG::call;                             \
+        case STELLAR_TYPE::FIRST_GIANT_BRANCH                       : return Phase<FGB>()->FGB::call;                           \
+        case STELLAR_TYPE::CORE_HELIUM_BURNING                      : return Phase<CHeB>()->CHeB::call;                         \
+        case STELLAR_TYPE::EARLY_ASYMPTOTIC_GIANT_BRANCH            : return Phase<EAGB>()->EAGB::call;                         \
+        case STELLAR_TYPE::THERMALLY_PULSING_ASYMPTOTIC_GIANT_BRANCH: return Phase<TPAGB>()->TPAGB::call;                       \
+        case STELLAR_TYPE::NAKED_HELIUM_STAR_MS                     : return Phase<HeMS>()->HeMS::call;                         \
+        case STELLAR_TYPE::NAKED_HELIUM_STAR_HERTZSPRUNG_GAP        : return Phase<HeHG>()->HeHG::call;                         \
+        case STELLAR_TYPE::NAKED_HELIUM_STAR_GIANT_BRANCH           : return Phase<HeGB>()->HeGB::call;                         \
+        case STELLAR_TYPE::HELIUM_WHITE_DWARF                       : return Phase<HeWD>()->HeWD::call;                         \
+        case STELLAR_TYPE::CARBON_OXYGEN_WHITE_DWARF                : return Phase<COWD>()->COWD::call;                         \
+        case STELLAR_TYPE::OXYGEN_NEON_WHITE_DWARF                  : return Phase<ONeWD>()->ONeWD::call;                       \
+        case STELLAR_TYPE::NEUTRON_STAR                             : return Phase<NS>()->NS::call;                             \
+        case STELLAR_TYPE::BLACK_HOLE                               : return Phase<BH>()->BH::call;                             \
+        case STELLAR_TYPE::MASSLESS_REMNANT                         : return Phase<MR>()->MR::call;                             \
+        default                                                     : return m_Star->call;                                      \
+    }
+#endif
+
+
 class Star {
 
 public:
@@ -63,7 +109,7 @@ public:
 
     Star& operator = (const Star& p_Star);
 
-    virtual ~Star() { delete m_Star; delete m_SaveStar; }
+    virtual ~Star() { if (m_Star) m_Star->~BaseStar(); if (m_SaveStar) m_SaveStar->~BaseStar(); }
 
 
     // object identifiers - all classes have these
@@ -86,6 +132,7 @@ public:
     double              CalculateThermalTimescale() const                                                           { return m_Star->CalculateThermalTimescale(); }
     double              COCoreMass() const                                                                          { return m_Star->COCoreMass(); }
     double              CoreMass() const                                                                            { return m_Star->CoreMass(); }
+    ERROR               Error() const                                                                               { return m_Star->Error(); }
     bool                ExperiencedCCSN() const                                                                     { return m_Star->ExperiencedCCSN(); }
     bool                ExperiencedECSN() const                                                                     { return m_Star->ExperiencedECSN(); }
     bool                ExperiencedPISN() const                                                                     { return m_Star->ExperiencedPISN() ; }
@@ -93,9 +140,9 @@ public:
     bool                ExperiencedUSSN() const                                                                     { return m_Star->ExperiencedUSSN(); }
     double              HeCoreMass() const                                                                          { return m_Star->HeCoreMass(); }
     bool                IsCCSN() const                                                                              { return m_Star->IsCCSN(); }
-    bool                IsDegenerate() const                                                                        { return m_Star->IsDegenerate(); }
+    bool                IsDegenerate() const                                                                        { STAR_DISPATCH(IsDegenerate()); }
     bool                IsECSN() const                                                                              { return m_Star->IsECSN(); }
-    bool                IsMassRatioUnstable(const double p_AccretorMass, const double p_IsAccretorDegenerate) const { return m_Star->IsMassRatioUnstable(p_AccretorMass, p_IsAccretorDegenerate); }
+    bool                IsMassRatioUnstable(const double p_AccretorMass, const double p_IsAccretorDegenerate) const { STAR_DISPATCH(IsMassRatioUnstable(p_AccretorMass, p_IsAccretorDegenerate)); }
     bool                IsOneOf(STELLAR_TYPE_LIST p_List) const                                                     { return m_Star->IsOneOf(p_List); }
     bool                IsPISN() const                                                                              { return m_Star->IsPISN(); }
     bool                IsPPISN() const                                                                             { return m_Star->IsPPISN(); }
@@ -113,6 +160,8 @@ public:
     double              Omega() const                                                                               { return m_Star->Omega(); }
     double              OmegaCHE() const                                                                            { return m_Star->OmegaCHE(); }
     double              OmegaPrev() const                                                                           { return m_Star->OmegaPrev(); }
+    double              Pulsar_MagneticField() const                                                                { return m_Star->Pulsar_MagneticField(); }
+    double              Pulsar_SpinPeriod() const                                                                   { return m_Star->Pulsar_SpinPeriod(); }
     double              Radius() const                                                                              { return m_Star->Radius(); }
     double              RadiusPrev() const                                                                          { return m_Star->RadiusPrev(); }
     double              RZAMS() const                                                                               { return m_Star->RZAMS(); }
@@ -148,17 +197,17 @@ public:
 
     double          CalculateEddyTurnoverTimescale()                                                                { return m_Star->CalculateEddyTurnoverTimescale(); }
 
-    double          CalculateGyrationRadius() const                                                                 { return m_Star->CalculateGyrationRadius(); }
+    double          CalculateGyrationRadius() const                                                                 { STAR_DISPATCH(CalculateGyrationRadius()); }
 
     void            CalculateLambdas()                                                                              { m_Star->CalculateLambdas(); }
     void            CalculateLambdas(const double p_EnvMass)                                                        { m_Star->CalculateLambdas(p_EnvMass); }
 
-    DBL_DBL         CalculateMassAcceptanceRate(const double p_DonorMassRate, const double p_AccretorMassRate)      { return m_Star->CalculateMassAcceptanceRate(p_DonorMassRate, p_AccretorMassRate); }
+    DBL_DBL         CalculateMassAcceptanceRate(const double p_DonorMassRate, const double p_AccretorMassRate)      { STAR_DISPATCH(CalculateMassAcceptanceRate(p_DonorMassRate, p_AccretorMassRate)); }
 
     double          CalculateMassLossValues(const bool p_UpdateMDot = false, const bool p_UpdateMDt = false)        { return m_Star->CalculateMassLossValues(p_UpdateMDot, p_UpdateMDt); }
 
-    double          CalculateMomentOfInertia(const double p_RemnantRadius = 0.0) const                              { return m_Star->CalculateMomentOfInertia(p_RemnantRadius); }
-    double          CalculateMomentOfInertiaAU(const double p_RemnantRadius = 0.0) const                            { return m_Star->CalculateMomentOfInertiaAU(p_RemnantRadius); }
+    double          CalculateMomentOfInertia(const double p_RemnantRadius = 0.0) const                              { STAR_DISPATCH(CalculateMomentOfInertia(p_RemnantRadius)); }
+    double          CalculateMomentOfInertiaAU(const double p_RemnantRadius = 0.0) const                            { STAR_DISPATCH(CalculateMomentOfInertiaAU(p_RemnantRadius)); }
 
     void            CalculateSNAnomalies(const double p_Eccentricity)                                               { m_Star->CalculateSNAnomalies(p_Eccentricity); }
     
@@ -166,7 +215,7 @@ public:
                                              const double p_EjectaMass, 
 								             const STELLAR_TYPE p_StellarType)                                      { return m_Star->CalculateSNKickMagnitude(p_RemnantMass, p_EjectaMass, p_StellarType); }
 
-    double          CalculateThermalMassLossRate() const                                                            { return m_Star->CalculateThermalMassLossRate(); }
+    double          CalculateThermalMassLossRate() const                                                            { STAR_DISPATCH(CalculateThermalMassLossRate()); }
 
     double          CalculateThermalTimescale(const double p_Mass,
                                               const double p_Radius,
@@ -175,13 +224,13 @@ public:
 
     double          CalculateTimestep()                                                                             { return m_Star->CalculateTimestep(); }
 
-    double          CalculateZeta(ZETA_PRESCRIPTION p_ZetaPrescription)                                             { return m_Star->CalculateZeta(p_ZetaPrescription); }
+    double          CalculateZeta(ZETA_PRESCRIPTION p_ZetaPrescription)                                             { STAR_DISPATCH(CalculateZeta(p_ZetaPrescription)); }
 
     void            ClearCurrentSNEvent()                                                                           { m_Star->ClearCurrentSNEvent(); }
 
-    BaseStar*       Clone(const BaseStar& p_Star);
+    BaseStar*       Clone(const BaseStar& p_Star, void* p_Storage);
 
-    ENVELOPE        DetermineEnvelopeType() const                                                                   { return m_Star->DetermineEnvelopeType(); }
+    ENVELOPE        DetermineEnvelopeType() const                                                                   { STAR_DISPATCH(DetermineEnvelopeType()); }
 
     EVOLUTION_STATUS Evolve(const long int p_Id);
 
@@ -208,7 +257,7 @@ public:
 
     STELLAR_TYPE    SwitchTo(const STELLAR_TYPE p_StellarType, bool p_SetInitialType = false);
 
-    void            UpdateAgeAfterMassLoss()                                                                        { m_Star->UpdateAgeAfterMassLoss(); }
+    void            UpdateAgeAfterMassLoss()                                                                        { STAR_DISPATCH(UpdateAgeAfterMassLoss()); }
 
     void            UpdateAttributes()                                                                              { (void)UpdateAttributes(0.0, 0.0, true); }
     STELLAR_TYPE    UpdateAttributes(const double p_DeltaMass,
@@ -223,17 +272,17 @@ public:
 
     void            UpdateComponentVelocity(const Vector3d p_newVelocity)                                           { m_Star->UpdateComponentVelocity(p_newVelocity); }
 
-    void            UpdateInitialMass()                                                                             { m_Star->UpdateInitialMass(); }
+    void            UpdateInitialMass()                                                                             { STAR_DISPATCH(UpdateInitialMass()); }
 
     void            UpdateMagneticFieldAndSpin(const bool   p_CommonEnvelope,
                                                const bool   p_RecycledNS,
                                                const double p_Stepsize,
                                                const double p_MassGainPerTimeStep,
-                                               const double p_Epsilon)                                              { m_Star->UpdateMagneticFieldAndSpin(p_CommonEnvelope,
-                                                                                                                                                         p_RecycledNS,
-                                                                                                                                                         p_Stepsize,
-                                                                                                                                                         p_MassGainPerTimeStep,
-                                                                                                                                                         p_Epsilon);}
+                                               const double p_Epsilon)                                              { STAR_DISPATCH(UpdateMagneticFieldAndSpin(p_CommonEnvelope,
+                                                                                                                                                                  p_RecycledNS,
+                                                                                                                                                                  p_Stepsize,
+                                                                                                                                                                  p_MassGainPerTimeStep,
+                                                                                                                                                                  p_Epsilon)); }
 
 
 private:
@@ -245,6 +294,18 @@ private:
     BaseStar   *m_Star;                                                                                         // pointer to current star
     BaseStar   *m_SaveStar;                                                                                     // pointer to saved star
 
+    void       *m_Phase;                                                                                        // current star object (its storage in m_Storage)
+    void       *m_SavePhase;                                                                                    // saved star object (its storage in m_Storage)
+
+    StarStorageT m_Storage[3];                                                                                  // storage for the current and saved star objects, and the new star object in SwitchTo()
+
+
+    // member functions - alphabetically
+    void       *FreeStorage();
+
+    template <class T>
+    T          *Phase() const                                                                                   { return reinterpret_cast<T*>(m_Phase); }     // current star object as its class (see STAR_DISPATCH)
+
 };
 
 #endif // __Star_h__
@@ -0,0 +1,146 @@
+#include "StarFormingMass.h"
+#include "Options.h"
+#include "Log.h"
+#include "BinaryStar.h"
+
+
+/*
+ * Calculate the total mass of all draws (evolved and rejected)
+ *
+ *
+ * double MassDrawn() const
+ *
+ * @return                                      Total mass drawn (Msol)
+ */
+double StarFormingMass::MassDrawn() const {
+    double mass = 0.0;
+    for (auto& bin: m_Bins) mass += bin.second.massEvolved + bin.second.massRejected;
+    return mass;
+}
+
+
+/*
+ * Calculate the total number of draws evolved
+ *
+ *
+ * size_t nEvolved() const
+ *
+ * @return                                      Number of draws evolved
+ */
+size_t StarFormingMass::nEvolved() const {
+    size_t n = 0;
+    for (auto& bin: m_Bins) n += bin.second.nEvolved;
+    return n;
+}
+
+
+/*
+ * Calculate the total number of draws rejected
+ *
+ *
+ * size_t nRejected() const
+ *
+ * @return                                      Number of draws rejected
+ */
+size_t StarFormingMass::nRejected() const {
+    size_t n = 0;
+    for (auto& bin: m_Bins) n += bin.second.nRejected;
+    return n;
+}
+
+
+/*
+ * Record a single draw
+ *
+ *
+ * void Record(const double p_Mass, const double p_Metallicity, const bool p_Accepted, const double p_Weight)
+ *
+ * @param   [IN]    p_Mass                      Total mass of the draw (Msol)
+ * @param   [IN]    p_Metallicity               Metallicity of the draw
+ * @param   [IN]    p_Accepted                  True if the draw was evolved, false if it was rejected
+ * @param   [IN]    p_Weight                    Importance sampling weight of the draw (1.0 unless drawn by AIS)
+ */
+void StarFormingMass::Record(const double p_Mass, const double p_Metallicity, const bool p_Accepted, const double p_Weight) {
+
+    long int key = (long int)std::floor(std::log10(p_Metallicity) / STAR_FORMING_MASS_LOG_Z_BIN_WIDTH);   // bin for metallicity
+
+    BinT& bin = m_Bins.emplace(key, BinT{0, 0, 0.0, 0.0, 0.0, 0.0, 0.0}).first->second;                  // get bin (create if necessary)
+
+    if (p_Accepted) {
+        bin.nEvolved++;
+        bin.massEvolved         += p_Mass;
+        bin.weightedMassEvolved += p_Weight * p_Mass;
+    }
+    else {
+        bin.nRejected++;
+        bin.massRejected         += p_Mass;
+        bin.weightedMassRejected += p_Weight * p_Mass;
+    }
+    bin.sumMetallicity += p_Metallicity;
+}
+
+
+/*
+ * Record all draws made for a binary
+ *
+ *
+ * void Record(BinaryStar* p_Binary)
+ *
+ * @param   [IN]    p_Binary                    The binary (constructed - need not be evolved)
+ */
+void StarFormingMass::Record(BinaryStar* p_Binary) {
+    for (auto& draw: p_Binary->InitialConditionsDraws()) Record(draw.mass, draw.metallicity, draw.accepted, draw.weight);
+}
+
+
+/*
+ * Write the star-forming mass summary table to the output container
+ *
+ * One row per metallicity bin, in order of increasing metallicity.  The importance weighted
+ * totals are written only if adaptive importance sampling is enabled (otherwise they are
+ * the same as the unweighted totals).
+ *
+ *
+ * bool Write() const
+ *
+ * @return                                      Boolean status - true = table written ok; false = write failed
+ */
+bool StarFormingMass::Write() const {
+
+    SummaryTableColumnT metallicity  = { "Metallicity",         "-",    TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT binMin       = { "Metallicity_Bin_Min", "-",    TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT binMax       = { "Metallicity_Bin_Max", "-",    TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT nEvolved     = { "N_Evolved",           "-",    TYPENAME::ULONGINT, {} };
+    SummaryTableColumnT nRejected    = { "N_Rejected",          "-",    TYPENAME::ULONGINT, {} };
+    SummaryTableColumnT massEvolved  = { "Mass_Evolved",        "Msol", TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT massRejected = { "Mass_Rejected",       "Msol", TYPENAME::DOUBLE,   {} };
+    SummaryTableColumnT massDrawn    = { "Mass_Drawn",          "Msol", TYPENAME::DOUBLE,   {} };
+
+    SummaryTableColumnT weightedMassEvolved  = { "Weighted_Mass_Evolved",  "Msol", TYPENAME::DOUBLE, {} };
+    SummaryTableColumnT weightedMassRejected = { "Weighted_Mass_Rejected", "Msol", TYPENAME::DOUBLE, {} };
+    SummaryTableColumnT weightedMassDrawn    = { "Weighted_Mass_Drawn",    "Msol", TYPENAME::DOUBLE, {} };
+
+    for (auto& iter: m_Bins) {                                                                  // std::map - ordered by key (so metallicity)
+        const BinT& bin = iter.second;
+        metallicity.values.push_back(bin.sumMetallicity / (double)(bin.nEvolved + bin.nRejected));
+        binMin.values.push_back(PPOW(10.0, (double)iter.first * STAR_FORMING_MASS_LOG_Z_BIN_WIDTH));
+        binMax.values.push_back(PPOW(10.0, (double)(iter.first + 1) * STAR_FORMING_MASS_LOG_Z_BIN_WIDTH));
+        nEvolved.values.push_back((unsigned long int)bin.nEvolved);
+        nRejected.values.push_back((unsigned long int)bin.nRejected);
+        massEvolved.values.push_back(bin.massEvolved);
+        massRejected.values.push_back(bin.massRejected);
+        massDrawn.values.push_back(bin.massEvolved + bin.massRejected);
+        weightedMassEvolved.values.push_back(bin.weightedMassEvolved);
+        weightedMassRejected.values.push_back(bin.weightedMassRejected);
+        weightedMassDrawn.values.push_back(bin.weightedMassEvolved + bin.weightedMassRejected);
+    }
+
+    std::vector<SummaryTableColumnT> columns = { metallicity, binMin, binMax, nEvolved, nRejected, massEvolved, massRejected, massDrawn };
+    if (OPTIONS->AdaptiveImportanceSampling()) {                                                // importance sampled?
+        columns.push_back(weightedMassEvolved);                                                 // yes - add weighted totals
+        columns.push_back(weightedMassRejected);
+        columns.push_back(weightedMassDrawn);
+    }
+
+    return LOGGING->WriteSummaryTable(STAR_FORMING_MASS_FILE_NAME, columns);
+}
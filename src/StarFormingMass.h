@@ -0,0 +1,70 @@
+#ifndef __StarFormingMass_h__
+#define __StarFormingMass_h__
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+class BinaryStar;
+
+
+/*
+ * StarFormingMass - star-forming mass accounting, per metallicity bin
+ *
+ * Accumulates the total mass of the initial conditions drawn during the run: for binaries the
+ * total mass (m1 + m2) of every draw made by the BaseBinaryStar constructor - the accepted draw
+ * (from which the binary was evolved) and any draws rejected because the stars were touching,
+ * overflowing their Roche lobes, or the secondary mass was below the minimum - and for single
+ * stars the mass of each star.  Each draw is counted in the log10(Z) bin (of width
+ * STAR_FORMING_MASS_LOG_Z_BIN_WIDTH dex) of its own metallicity.
+ *
+ * The totals are written at the end of the run to the STAR_FORMING_MASS_FILE_NAME summary table
+ * (a group in the HDF5 container, or a file in the output container for CSV, TSV, and TXT logfiles),
+ * one row per bin, so post-processing does not have to reconstruct the mass evolved by re-sampling
+ * the initial conditions.
+ *
+ * If the initial conditions are drawn by adaptive importance sampling (see AIS.h) the draws are not
+ * distributed as the distributions specified by the user, so the mass of each draw is also accumulated
+ * multiplied by its importance weight, and the weighted totals written (Weighted_Mass_* columns).  The
+ * weighted mass drawn is an (unbiased) estimate of the mass that the same number of draws from the
+ * user-specified distributions would have had, so it is the star-forming mass that should be used to
+ * normalise weighted outcome counts (sum of Mixture_Weight).  The unweighted totals are the mass of the
+ * systems actually drawn, and should not be used to normalise rates under AIS.
+ *
+ * Only draws made by COMPAS are counted - the mass in stars outside the sampled ranges (e.g. below
+ * --initial-mass-min), and in single stars that would accompany the binaries of a BSE run, must still
+ * be accounted for in post-processing (analytically, from the distributions sampled).
+ */
+
+class StarFormingMass {
+
+public:
+
+    StarFormingMass()                                                               { m_Bins.clear(); }
+
+
+    // member functions
+    double      MassDrawn() const;
+    size_t      nEvolved() const;
+    size_t      nRejected() const;
+    void        Record(BinaryStar* p_Binary);
+    void        Record(const double p_Mass, const double p_Metallicity, const bool p_Accepted, const double p_Weight);
+    bool        Write() const;
+
+
+private:
+
+    typedef struct Bin {
+        size_t nEvolved;                                                                        // number of draws evolved (accepted)
+        size_t nRejected;                                                                       // number of draws rejected
+        double massEvolved;                                                                     // total mass of draws evolved (Msol)
+        double massRejected;                                                                    // total mass of draws rejected (Msol)
+        double weightedMassEvolved;                                                             // total importance weighted mass of draws evolved (Msol)
+        double weightedMassRejected;                                                            // total importance weighted mass of draws rejected (Msol)
+        double sumMetallicity;                                                                  // sum of metallicities of all draws (for mean)
+    } BinT;
+
+    std::map<long int, BinT> m_Bins;                                                            // bins, keyed by floor(log10(Z) / bin width)
+};
+
+#endif // __StarFormingMass_h__
@@ -0,0 +1,753 @@
+/*
+ * Benchmarks - microbenchmarks for COMPAS hot kernels
+ *
+ * Times the kernels that dominate the cost of a COMPAS run, in isolation, on fixed (seeded) inputs:
+ *
+ *     utils::SampleInitialMass                 initial mass function (as configured by the COMPAS options)
+ *     utils::SampleMassRatio                   mass ratio distribution
+ *     utils::SampleSemiMajorAxis               semi-major axis distribution
+ *     utils::SampleEccentricity                eccentricity distribution
+ *     utils::SampleMetallicity                 metallicity distribution
+ *     Star::CalculateTimestep                  single stars at a mix of evolutionary phases
+ *     Star::EvolveOneTimestep                  copies of the single stars, each evolved one timestep
+ *     Star phase dispatch                      calls dispatched to the stellar phase classes (see STAR_DISPATCH in Star.h)
+ *     BaseBinaryStar::Evolve                   construction and full evolution of binaries (seeds 0, 1, 2, ...)
+ *     BaseBinaryStar::CalculateMassTransferOrbit
+ *     BaseBinaryStar::ResolveSupernova         binaries evolved (from a fixed seed) to their first supernova
+ *     Log::LogStandardRecord                   BSE_System_Parameters records, written to the configured logfile type
+ *     BaseStar::CalculateLoveridgePolynomial_Static
+ *                                              Loveridge et al. 2011 binding energy polynomial, on a grid of masses and radii
+ *     Loveridge direct sum                     the same polynomial summed term by term, as before the nested Horner evaluation
+ *
+ * The two Loveridge evaluations are also compared on the grid (every metallicity and evolutionary stage that
+ * COMPAS uses, masses log-uniform in the range of the stage, radii log-uniform in [0.5, 3000] Rsol).  For each
+ * metallicity and stage the largest difference, and the largest difference relative to the rounding error
+ * expected of the sum (DBL_EPSILON times the sum of the magnitudes of the terms), are written with the results.
+ *
+ * Each kernel is run in batches of operations; inputs that are consumed by an operation (e.g. a binary
+ * that has resolved its supernova) are prepared before each batch, outside the timed region.  Batches are
+ * run until the timed region has accumulated --min-time seconds, and this is repeated --repetitions times.
+ * The result for each kernel is the median (and the minimum and maximum) over the repetitions of the mean
+ * time per operation, and the mean number of heap allocations (calls to operator new) per operation.
+ *
+ * The results are written as JSON (to stdout, or to the file given by --output), with the peak resident
+ * set size of the process.  benchmarks/runBenchmarks.py runs this program along with the COMPAS workloads,
+ * and merges the results into a single JSON file - see docs/benchmarks.md.
+ *
+ * Any COMPAS program options given after '--' are passed to COMPAS, so the kernels can be timed with
+ * non-default options, e.g.
+ *
+ *     COMPAS_BENCH --min-time 1.0 -- --initial-mass-function SALPETER --logfile-type CSV
+ *
+ * Build with 'make bench' (or 'make COMPAS_BENCH') in the src directory.
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <new>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <boost/program_options.hpp>
+
+#include "constants.h"
+#include "typedefs.h"
+#include "profiling.h"
+#include "utils.h"
+#include "Options.h"
+#include "Rand.h"
+#include "Log.h"
+#include "Star.h"
+#include "BinaryConstituentStar.h"
+#include "BaseBinaryStar.h"
+
+namespace bpo = boost::program_options;                                                 // po is taken (Options.h)
+
+
+OBJECT_ID globalObjectId = 1;                                                           // used to uniquely identify objects - used primarily for error printing
+OBJECT_ID m_ObjectId     = 0;                                                           // object id for the benchmark driver - always 0
+
+OBJECT_ID    ObjectId()    { return m_ObjectId; }
+OBJECT_TYPE  ObjectType()  { return OBJECT_TYPE::MAIN; }
+STELLAR_TYPE StellarType() { return STELLAR_TYPE::NONE; }
+
+
+const std::string BENCHMARK_OUTPUT_CONTAINER = "COMPAS_Bench_Output";                  // logfile container (in --work-dir)
+const int         BENCHMARK_STAR_COUNT       = 64;                                      // number of single stars for Star::CalculateTimestep
+const int         BENCHMARK_MAX_SEEDS        = 1000;                                    // maximum number of seeds tried to find a supernova binary
+const int         BENCHMARK_LOVERIDGE_POINTS = 50;                                      // number of masses (and of radii) per Loveridge metallicity and stage
+volatile double   benchmarkSink              = 0.0;                                     // results are accumulated here so the kernels are not optimised away
+
+unsigned long int benchmarkHeapAllocations   = 0;                                       // number of calls to operator new (see below)
+
+
+// replacement global operators new and delete - count the heap allocations
+//
+// Every (non-placement) form is replaced, so each allocation is released by the matching replacement.
+// The allocation and the release are kept out of line: inlined into a caller, the release (free()) of
+// memory allocated by the (replaced) operator new is reported as mismatched by -Wmismatched-new-delete.
+
+__attribute__((noinline)) void* BenchmarkAllocate(std::size_t p_Size) {
+    benchmarkHeapAllocations++;
+    return std::malloc(p_Size == 0 ? 1 : p_Size);
+}
+
+__attribute__((noinline)) void BenchmarkRelease(void* p_Ptr) noexcept { std::free(p_Ptr); }
+
+void* operator new(std::size_t p_Size) {
+    void *ptr = BenchmarkAllocate(p_Size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t p_Size)                                   { return operator new(p_Size); }
+void* operator new(std::size_t p_Size, const std::nothrow_t&) noexcept     { return BenchmarkAllocate(p_Size); }
+void* operator new[](std::size_t p_Size, const std::nothrow_t&) noexcept   { return BenchmarkAllocate(p_Size); }
+
+void operator delete(void* p_Ptr) noexcept                                 { BenchmarkRelease(p_Ptr); }
+void operator delete[](void* p_Ptr) noexcept                               { BenchmarkRelease(p_Ptr); }
+void operator delete(void* p_Ptr, const std::nothrow_t&) noexcept          { BenchmarkRelease(p_Ptr); }
+void operator delete[](void* p_Ptr, const std::nothrow_t&) noexcept        { BenchmarkRelease(p_Ptr); }
+#ifdef __cpp_sized_deallocation
+void operator delete(void* p_Ptr, std::size_t) noexcept                    { BenchmarkRelease(p_Ptr); }
+void operator delete[](void* p_Ptr, std::size_t) noexcept                  { BenchmarkRelease(p_Ptr); }
+#endif
+
+
+typedef struct BenchmarkSettings {
+    std::string              output;
+    std::string              workDir;
+    std::string              filter;
+    double                   minTime;
+    int                      repetitions;
+    std::vector<std::string> compasOptions;
+} BenchmarkSettingsT;
+
+typedef struct LoveridgePoint {
+    int             lMetallicity;                                                       // index of the metallicity (LOVERIDGE_METALLICITY)
+    LOVERIDGE_GROUP lGroup;                                                             // evolutionary stage
+    double          logMass;                                                            // log10(Mass / Msol)
+    double          logRadius;                                                          // log10(Radius / Rsol)
+} LoveridgePointT;
+
+typedef struct LoveridgeComparison {
+    int             lMetallicity;
+    LOVERIDGE_GROUP lGroup;
+    int             points;
+    double          maxAbsDiff;                                                         // largest |Horner - direct sum|
+    double          maxScaledDiff;                                                      // largest |Horner - direct sum| / (DBL_EPSILON * sum of |terms|)
+} LoveridgeComparisonT;
+
+typedef struct BenchmarkResult {
+    std::string name;
+    long int    ops;                                                                    // total number of operations timed (all repetitions)
+    double      nsPerOp;                                                                // median over repetitions
+    double      nsPerOpMin;
+    double      nsPerOpMax;
+    double      allocsPerOp;                                                            // heap allocations per operation (mean over all repetitions)
+} BenchmarkResultT;
+
+
+/*
+ * A benchmarked kernel
+ *
+ * setup(n) prepares the inputs for a batch of n operations (not timed)
+ * run(n)   performs the batch of n operations (timed)
+ */
+typedef struct BenchmarkKernel {
+    std::string                      name;
+    long int                         batchSize;
+    std::function<void(const long)>  setup;
+    std::function<void(const long)>  run;
+} BenchmarkKernelT;
+
+
+/*
+ * Benchmarks class
+ *
+ * Holds the prepared inputs for the kernels.  This is a class (rather than free functions) so that
+ * BaseBinaryStar can grant it access to its private kernels (CalculateMassTransferOrbit(),
+ * ResolveSupernova(), EvolveOneTimestep() etc.) without making them public.
+ */
+class Benchmarks {
+
+public:
+
+    Benchmarks() : m_SupernovaBinary(nullptr) { }
+
+    ~Benchmarks() {
+        for (auto star : m_Stars) delete star;
+        m_StarCopies.clear();
+        m_Copies.clear();
+        delete m_SupernovaBinary;
+    }
+
+    bool Prepare();
+    std::vector<BenchmarkKernelT> Kernels();
+    std::vector<LoveridgeComparisonT> CompareLoveridge() const;
+
+private:
+
+    BaseBinaryStar* EvolveToSupernova(const unsigned long int p_Seed);
+
+    static double LoveridgeDirectSum(const LoveridgePointT& p_Point, double& p_TermSum);
+
+    std::vector<Star*>                           m_Stars;                              // single stars at a mix of phases
+    BaseBinaryStar*                              m_SupernovaBinary;                    // binary at its first supernova (not yet resolved)
+    std::vector<std::unique_ptr<BaseBinaryStar>> m_Copies;                             // per-batch copies of m_SupernovaBinary
+    std::vector<std::unique_ptr<Star>>           m_StarCopies;                         // per-batch copies of m_Stars
+    std::vector<LoveridgePointT>                 m_LoveridgePoints;                    // grid for the Loveridge binding energy polynomials
+};
+
+
+/*
+ * Evaluate the binding energy polynomial of Loveridge et al. 2011, eq 5, term by term
+ *
+ * This is the evaluation BaseStar::CalculateLogBindingEnergyLoveridge() made before the polynomials were
+ * evaluated by nested Horner's method (see BaseStar::CalculateLoveridgePolynomial_Static()) - the reference
+ * for the comparison, and for the timing.
+ *
+ *
+ * double LoveridgeDirectSum(const LoveridgePointT& p_Point, double& p_TermSum)
+ *
+ * @param   [IN]    p_Point                     Metallicity, stage, log10(mass) and log10(radius)
+ * @param   [OUT]   p_TermSum                   Sum of the magnitudes of the terms
+ * @return                                      Value of the polynomial
+ */
+double Benchmarks::LoveridgeDirectSum(const LoveridgePointT& p_Point, double& p_TermSum) {
+
+    double value = 0.0;
+    p_TermSum    = 0.0;
+    for (auto const& lCoefficients: LOVERIDGE_COEFFICIENTS[p_Point.lMetallicity][static_cast<int>(p_Point.lGroup)]) {
+        double term = lCoefficients.alpha_mr * utils::intPow(p_Point.logMass, lCoefficients.m) * utils::intPow(p_Point.logRadius, lCoefficients.r);
+        value      += term;
+        p_TermSum  += std::abs(term);
+    }
+
+    return value;
+}
+
+
+/*
+ * Evolve a binary until one of its stars undergoes a supernova
+ *
+ * The evolution follows BaseBinaryStar::Evolve(), without the logging, and stops immediately before
+ * the supernova would be resolved - after the star evolves, or after the mass changes of the timestep
+ * are resolved.  Binaries that stop evolving for any other reason (merger, error, etc.) are discarded.
+ *
+ *
+ * BaseBinaryStar* EvolveToSupernova(const unsigned long int p_Seed)
+ *
+ * @param   [IN]    p_Seed                      Random seed for the binary
+ * @return                                      Pointer to the binary (caller owns it), or nullptr
+ */
+BaseBinaryStar* Benchmarks::EvolveToSupernova(const unsigned long int p_Seed) {
+
+    if (OPTIONS->SetRandomSeed(p_Seed, OPTIONS_ORIGIN::CMDLINE) < 0) return nullptr;
+
+    BaseBinaryStar* binary = new BaseBinaryStar(p_Seed, static_cast<long int>(p_Seed));
+    if (binary->m_Error != ERROR::NONE || binary->HasStarsTouching()) { delete binary; return nullptr; }
+
+    double dt = std::min(binary->m_Star1->CalculateTimestep(), binary->m_Star2->CalculateTimestep()) / 1000.0;
+
+    for (int step = 1; step < OPTIONS->MaxNumberOfTimestepIterations(); step++) {
+
+        binary->EvolveOneTimestep(dt);
+
+        if (binary->m_Error != ERROR::NONE || binary->HasOneOf({ STELLAR_TYPE::MASSLESS_REMNANT }) ||
+            binary->StellarMerger() || binary->HasStarsTouching() || binary->IsUnbound()) break;
+
+        if (binary->m_Star1->IsSNevent() || binary->m_Star2->IsSNevent()) {                    // supernova this timestep?
+            binary->m_Supernova = binary->m_Star1->IsSNevent() ? binary->m_Star1 : binary->m_Star2;
+            binary->m_Companion = binary->m_Supernova == binary->m_Star1 ? binary->m_Star2 : binary->m_Star1;
+            return binary;
+        }
+
+        // supernovae are usually triggered by the mass changes resolved in EvaluateBinary(), and resolved
+        // there - so resolve the mass changes for this timestep on a copy, and keep the copy if either star
+        // is then at a supernova (as EvaluateBinary() does, unless there is a common envelope or a merger)
+
+        BaseBinaryStar* copy = new BaseBinaryStar(*binary);
+        copy->CalculateMassTransfer(dt);
+        copy->CalculateWindsMassLoss();
+        if (!copy->m_CEDetails.CEEnow && !copy->StellarMerger()) {
+            copy->ResolveMassChanges();
+            if (copy->m_Error == ERROR::NONE && (copy->m_Star1->IsSNevent() || copy->m_Star2->IsSNevent())) {
+                copy->m_Supernova = copy->m_Star1->IsSNevent() ? copy->m_Star1 : copy->m_Star2;
+                copy->m_Companion = copy->m_Supernova == copy->m_Star1 ? copy->m_Star2 : copy->m_Star1;
+                delete binary;
+                return copy;
+            }
+        }
+        delete copy;
+
+        binary->EvaluateBinary(dt);
+
+        if (binary->m_Error != ERROR::NONE || binary->StellarMerger() || binary->HasStarsTouching() ||
+            binary->IsUnbound() || binary->HasTwoOf({ STELLAR_TYPE::NEUTRON_STAR, STELLAR_TYPE::BLACK_HOLE, STELLAR_TYPE::MASSLESS_REMNANT }) ||
+            binary->m_Time > OPTIONS->MaxEvolutionTime()) break;
+
+        dt = std::max(std::min(binary->m_Star1->CalculateTimestep(), binary->m_Star2->CalculateTimestep()) * OPTIONS->TimestepMultiplier(), NUCLEAR_MINIMUM_TIMESTEP);
+    }
+
+    delete binary;
+    return nullptr;
+}
+
+
+/*
+ * Prepare the kernel inputs
+ *
+ * The inputs depend only on the COMPAS options and fixed seeds, so are the same for every run.
+ *
+ *
+ * bool Prepare()
+ *
+ * @return                                      Boolean status (true = ok)
+ */
+bool Benchmarks::Prepare() {
+
+    // single stars, log-uniform in mass in [0.5, 100] Msol, each evolved for a
+    // different number of timesteps so that the stars are at a mix of phases
+
+    KickParameters kickParameters = {};
+    for (int i = 0; i < BENCHMARK_STAR_COUNT; i++) {
+        double mass = 0.5 * std::pow(200.0, static_cast<double>(i) / (BENCHMARK_STAR_COUNT - 1));
+        (void)OPTIONS->SetRandomSeed(static_cast<unsigned long int>(i), OPTIONS_ORIGIN::CMDLINE);
+        Star* star = new Star(static_cast<unsigned long int>(i), mass, OPTIONS->Metallicity(), kickParameters);
+        int steps = (i * 37) % 200;
+        for (int step = 0; step < steps && !star->IsOneOf(COMPACT_OBJECTS) && !star->IsOneOf({ STELLAR_TYPE::MASSLESS_REMNANT }); step++) {
+            (void)star->EvolveOneTimestep(star->CalculateTimestep() * OPTIONS->TimestepMultiplier());
+        }
+        m_Stars.push_back(star);
+    }
+
+    // binary at its first supernova - first seed (from 0) that gets there
+
+    for (unsigned long int seed = 0; seed < BENCHMARK_MAX_SEEDS && !m_SupernovaBinary; seed++) {
+        m_SupernovaBinary = EvolveToSupernova(seed);
+    }
+    if (!m_SupernovaBinary) {
+        std::cerr << "ERROR: no binary reached a supernova - cannot benchmark ResolveSupernova()" << std::endl;
+        return false;
+    }
+
+    // grid for the Loveridge binding energy polynomials - every metallicity, and every stage that
+    // BaseStar::CalculateLogBindingEnergyLoveridge() uses, masses in the range of the stage
+
+    for (int lMetallicity = 0; lMetallicity < static_cast<int>(LOVERIDGE_METALLICITY::COUNT); lMetallicity++) {
+        for (auto lGroup : { LOVERIDGE_GROUP::LMR1, LOVERIDGE_GROUP::LMR2, LOVERIDGE_GROUP::LMA, LOVERIDGE_GROUP::HM }) {
+            double massMin = lGroup == LOVERIDGE_GROUP::HM ? LOVERIDGE_LM_HM_CUTOFFS[lMetallicity] : 0.8;
+            double massMax = lGroup == LOVERIDGE_GROUP::HM ? 100.0 : LOVERIDGE_LM_HM_CUTOFFS[lMetallicity];
+            for (int i = 0; i < BENCHMARK_LOVERIDGE_POINTS; i++) {
+                double logMass = std::log10(massMin) + std::log10(massMax / massMin) * static_cast<double>(i) / (BENCHMARK_LOVERIDGE_POINTS - 1);
+                for (int j = 0; j < BENCHMARK_LOVERIDGE_POINTS; j++) {
+                    double logRadius = std::log10(0.5) + std::log10(3000.0 / 0.5) * static_cast<double>(j) / (BENCHMARK_LOVERIDGE_POINTS - 1);
+                    m_LoveridgePoints.push_back({ lMetallicity, lGroup, logMass, logRadius });
+                }
+            }
+        }
+    }
+
+    (void)OPTIONS->SetRandomSeed(0, OPTIONS_ORIGIN::CMDLINE);                               // fixed state for the samplers
+
+    return true;
+}
+
+
+/*
+ * Compare the Loveridge binding energy polynomials evaluated by nested Horner's method (as COMPAS does)
+ * and term by term (as COMPAS did), on the grid
+ *
+ *
+ * std::vector<LoveridgeComparisonT> CompareLoveridge() const
+ *
+ * @return                                      One comparison per metallicity and stage, in the order of the grid
+ */
+std::vector<LoveridgeComparisonT> Benchmarks::CompareLoveridge() const {
+
+    std::vector<LoveridgeComparisonT> comparisons;
+
+    for (auto& point : m_LoveridgePoints) {
+        if (comparisons.empty() || comparisons.back().lMetallicity != point.lMetallicity || comparisons.back().lGroup != point.lGroup) {
+            comparisons.push_back({ point.lMetallicity, point.lGroup, 0, 0.0, 0.0 });
+        }
+        LoveridgeComparisonT& comparison = comparisons.back();
+
+        double termSum;
+        double direct = LoveridgeDirectSum(point, termSum);
+        double horner = BaseStar::CalculateLoveridgePolynomial_Static(point.lMetallicity, point.lGroup, point.logMass, point.logRadius);
+        double diff   = std::abs(horner - direct);
+
+        comparison.points++;
+        comparison.maxAbsDiff    = std::max(comparison.maxAbsDiff, diff);
+        comparison.maxScaledDiff = std::max(comparison.maxScaledDiff, termSum > 0.0 ? diff / (DBL_EPSILON * termSum) : 0.0);
+    }
+
+    return comparisons;
+}
+
+
+/*
+ * The benchmarked kernels
+ *
+ *
+ * std::vector<BenchmarkKernelT> Kernels()
+ *
+ * @return                                      Vector of kernels
+ */
+std::vector<BenchmarkKernelT> Benchmarks::Kernels() {
+
+    auto noSetup = [](const long p_N) { };
+
+    std::vector<BenchmarkKernelT> kernels;
+
+    kernels.push_back({ "utils::SampleInitialMass", 100000, noSetup, [](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) sum += utils::SampleInitialMass(OPTIONS->InitialMassFunction(), OPTIONS->InitialMassFunctionMax(), OPTIONS->InitialMassFunctionMin(), OPTIONS->InitialMassFunctionPower());
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "utils::SampleMassRatio", 100000, noSetup, [](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) sum += utils::SampleMassRatio(OPTIONS->MassRatioDistribution(), OPTIONS->MassRatioDistributionMax(), OPTIONS->MassRatioDistributionMin());
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "utils::SampleSemiMajorAxis", 100000, noSetup, [](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) sum += utils::SampleSemiMajorAxis(OPTIONS->SemiMajorAxisDistribution(), OPTIONS->SemiMajorAxisDistributionMax(), OPTIONS->SemiMajorAxisDistributionMin(),
+                                                                         OPTIONS->SemiMajorAxisDistributionPower(), OPTIONS->OrbitalPeriodDistributionMax(), OPTIONS->OrbitalPeriodDistributionMin(), 20.0, 10.0);
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "utils::SampleEccentricity", 100000, noSetup, [](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) sum += utils::SampleEccentricity(OPTIONS->EccentricityDistribution(), OPTIONS->EccentricityDistributionMax(), OPTIONS->EccentricityDistributionMin());
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "utils::SampleMetallicity", 100000, noSetup, [](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) sum += utils::SampleMetallicity(OPTIONS->MetallicityDistribution(), OPTIONS->MetallicityDistributionMax(), OPTIONS->MetallicityDistributionMin());
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "Star::CalculateTimestep", 10000, noSetup, [this](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) sum += m_Stars[i % m_Stars.size()]->CalculateTimestep();
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "Star::EvolveOneTimestep", 256, [this](const long p_N) {
+        m_StarCopies.clear();
+        for (long i = 0; i < p_N; i++) m_StarCopies.emplace_back(new Star(*m_Stars[i % m_Stars.size()]));
+    }, [this](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) {
+            Star* star = m_StarCopies[i].get();
+            sum += star->EvolveOneTimestep(star->CalculateTimestep() * OPTIONS->TimestepMultiplier());
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "Star phase dispatch", 10000, noSetup, [this](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) {
+            Star* star = m_Stars[i % m_Stars.size()];
+            sum += star->CalculateMomentOfInertiaAU() * star->CalculateGyrationRadius();
+            sum += static_cast<double>(star->DetermineEnvelopeType()) + (star->IsDegenerate() ? 1.0 : 0.0);
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "BaseBinaryStar::CalculateMassTransferOrbit", 10000, noSetup, [this](const long p_N) {
+        BaseBinaryStar* binary = m_SupernovaBinary;
+        BinaryConstituentStar* donor    = binary->m_Companion;
+        BinaryConstituentStar* accretor = binary->m_Supernova;
+        double thermalRate = donor->CalculateThermalMassLossRate();
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) {
+            double dM = -donor->Mass() * (0.001 + 0.099 * static_cast<double>(i % 100) / 99.0);   // 0.1% to 10% of the donor mass
+            sum += binary->CalculateMassTransferOrbit(donor->Mass(), dM, thermalRate, *accretor, 0.5);
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "BaseBinaryStar::ResolveSupernova", 256, [this](const long p_N) {
+        m_Copies.clear();
+        for (long i = 0; i < p_N; i++) m_Copies.emplace_back(new BaseBinaryStar(*m_SupernovaBinary));
+    }, [this](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) {
+            (void)m_Copies[i]->ResolveSupernova();
+            sum += m_Copies[i]->m_SemiMajorAxis;
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "Log::LogStandardRecord", 1000, noSetup, [this](const long p_N) {
+        for (long i = 0; i < p_N; i++) (void)LOGGING->LogBSESystemParameters(m_SupernovaBinary, "");
+    }});
+
+    kernels.push_back({ "BaseStar::CalculateLoveridgePolynomial_Static", 10000, noSetup, [this](const long p_N) {
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++) {
+            const LoveridgePointT& point = m_LoveridgePoints[i % m_LoveridgePoints.size()];
+            sum += BaseStar::CalculateLoveridgePolynomial_Static(point.lMetallicity, point.lGroup, point.logMass, point.logRadius);
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "Loveridge direct sum", 10000, noSetup, [this](const long p_N) {
+        double sum = 0.0;
+        double termSum;
+        for (long i = 0; i < p_N; i++) sum += LoveridgeDirectSum(m_LoveridgePoints[i % m_LoveridgePoints.size()], termSum);
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    kernels.push_back({ "BaseBinaryStar::Evolve", 16, noSetup, [](const long p_N) {
+        static unsigned long int seed = 0;
+        double sum = 0.0;
+        for (long i = 0; i < p_N; i++, seed++) {
+            BaseBinaryStar binary(seed, static_cast<long int>(seed));
+            (void)binary.Evolve();
+            sum += binary.Time();
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }});
+
+    return kernels;
+}
+
+
+/*
+ * Time a kernel
+ *
+ *
+ * BenchmarkResultT TimeKernel(const BenchmarkKernelT& p_Kernel, const double p_MinTime, const int p_Repetitions)
+ *
+ * @param   [IN]    p_Kernel                    The kernel to time
+ * @param   [IN]    p_MinTime                   Minimum timed duration per repetition (seconds)
+ * @param   [IN]    p_Repetitions               Number of repetitions
+ * @return                                      Timing result
+ */
+BenchmarkResultT TimeKernel(const BenchmarkKernelT& p_Kernel, const double p_MinTime, const int p_Repetitions) {
+
+    BenchmarkResultT result = { p_Kernel.name, 0, 0.0, 0.0, 0.0, 0.0 };
+
+    p_Kernel.setup(p_Kernel.batchSize);                                                 // warm up (caches, lazily initialised tables, logfile creation)
+    p_Kernel.run(p_Kernel.batchSize);
+
+    std::vector<double> nsPerOp;
+    unsigned long int   allocations = 0;
+    for (int rep = 0; rep < p_Repetitions; rep++) {
+        double   elapsed = 0.0;                                                         // seconds
+        long int ops     = 0;
+        while (elapsed < p_MinTime) {
+            p_Kernel.setup(p_Kernel.batchSize);
+            unsigned long int allocationsStart = benchmarkHeapAllocations;
+            auto start = std::chrono::steady_clock::now();
+            p_Kernel.run(p_Kernel.batchSize);
+            elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            allocations += benchmarkHeapAllocations - allocationsStart;
+            ops     += p_Kernel.batchSize;
+        }
+        nsPerOp.push_back(elapsed * 1.0E9 / static_cast<double>(ops));
+        result.ops += ops;
+    }
+    p_Kernel.setup(0);                                                                  // release batch inputs
+
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+    size_t n = nsPerOp.size();
+    result.nsPerOp    = n % 2 ? nsPerOp[n / 2] : 0.5 * (nsPerOp[n / 2 - 1] + nsPerOp[n / 2]);
+    result.nsPerOpMin = nsPerOp.front();
+    result.nsPerOpMax = nsPerOp.back();
+
+    result.allocsPerOp = static_cast<double>(allocations) / static_cast<double>(result.ops);
+
+    return result;
+}
+
+
+/*
+ * Write the results as JSON
+ *
+ *
+ * void WriteJSON(std::ostream& p_Stream, const BenchmarkSettingsT& p_Settings, const std::vector<BenchmarkResultT>& p_Results, const std::vector<LoveridgeComparisonT>& p_Loveridge)
+ *
+ * @param   [IN]    p_Stream                    Stream to write to
+ * @param   [IN]    p_Settings                  Benchmark settings
+ * @param   [IN]    p_Results                   Kernel results
+ * @param   [IN]    p_Loveridge                 Loveridge polynomial comparisons (empty if not made)
+ */
+void WriteJSON(std::ostream& p_Stream, const BenchmarkSettingsT& p_Settings, const std::vector<BenchmarkResultT>& p_Results, const std::vector<LoveridgeComparisonT>& p_Loveridge) {
+
+    struct rusage usage;
+    (void)getrusage(RUSAGE_SELF, &usage);                                               // ru_maxrss is in KiB on Linux
+
+    std::string compasOptions = "";
+    for (auto& opt : p_Settings.compasOptions) compasOptions += (compasOptions.empty() ? "" : " ") + opt;
+
+    p_Stream << "{\n";
+    p_Stream << "    \"suite\": \"microbenchmarks\",\n";
+    p_Stream << "    \"compas_version\": \"" << VERSION_STRING << "\",\n";
+    p_Stream << "    \"compas_options\": \"" << compasOptions << "\",\n";
+    p_Stream << "    \"min_time_s\": " << p_Settings.minTime << ",\n";
+    p_Stream << "    \"repetitions\": " << p_Settings.repetitions << ",\n";
+    p_Stream << "    \"peak_rss_kb\": " << usage.ru_maxrss << ",\n";
+    p_Stream << "    \"results\": [\n";
+    for (size_t i = 0; i < p_Results.size(); i++) {
+        p_Stream << "        { \"name\": \"" << p_Results[i].name << "\", "
+                 << "\"ops\": " << p_Results[i].ops << ", "
+                 << "\"ns_per_op\": " << utils::vFormat("%.3f", p_Results[i].nsPerOp) << ", "
+                 << "\"ns_per_op_min\": " << utils::vFormat("%.3f", p_Results[i].nsPerOpMin) << ", "
+                 << "\"ns_per_op_max\": " << utils::vFormat("%.3f", p_Results[i].nsPerOpMax) << ", "
+                 << "\"allocs_per_op\": " << utils::vFormat("%.3f", p_Results[i].allocsPerOp) << " }"
+                 << (i + 1 < p_Results.size() ? "," : "") << "\n";
+    }
+    p_Stream << "    ],\n";
+    p_Stream << "    \"loveridge_comparison\": [\n";
+    for (size_t i = 0; i < p_Loveridge.size(); i++) {
+        p_Stream << "        { \"metallicity\": " << std::get<1>(LOVERIDGE_METALLICITY_VALUE[p_Loveridge[i].lMetallicity]) << ", "
+                 << "\"group\": " << static_cast<int>(p_Loveridge[i].lGroup) << ", "
+                 << "\"points\": " << p_Loveridge[i].points << ", "
+                 << "\"max_abs_diff\": " << utils::vFormat("%.3e", p_Loveridge[i].maxAbsDiff) << ", "
+                 << "\"max_diff_eps_terms\": " << utils::vFormat("%.3f", p_Loveridge[i].maxScaledDiff) << " }"
+                 << (i + 1 < p_Loveridge.size() ? "," : "") << "\n";
+    }
+    p_Stream << "    ]\n";
+    p_Stream << "}" << std::endl;
+}
+
+
+/*
+ * Parse the command line
+ *
+ * Arguments after '--' are COMPAS program options
+ *
+ *
+ * BenchmarkSettingsT ParseCommandLine(int argc, char* argv[])
+ *
+ * @param   [IN]    argc                        Argument count
+ * @param   [IN]    argv                        Argument values
+ * @return                                      Benchmark settings
+ */
+BenchmarkSettingsT ParseCommandLine(int argc, char* argv[]) {
+
+    BenchmarkSettingsT settings;
+
+    int nArgs = argc;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--") {
+            nArgs = i;
+            for (int j = i + 1; j < argc; j++) settings.compasOptions.push_back(argv[j]);
+            break;
+        }
+    }
+
+    bpo::options_description options("Options");
+    options.add_options()
+        ("help,h",       "Print this help message")
+
+        ("output,o",     bpo::value<std::string>(&settings.output)->default_value(""),          "JSON output file (default: stdout)")
+        ("work-dir",     bpo::value<std::string>(&settings.workDir)->default_value("."),        "Directory for the COMPAS logfiles written by the benchmarks")
+        ("filter",       bpo::value<std::string>(&settings.filter)->default_value(""),          "Only run kernels whose name contains this string")
+        ("min-time",     bpo::value<double>(&settings.minTime)->default_value(0.25),            "Minimum timed duration per repetition (seconds)")
+        ("repetitions",  bpo::value<int>(&settings.repetitions)->default_value(5),              "Number of repetitions per kernel")
+    ;
+
+    bpo::variables_map vm;
+    try {
+        bpo::store(bpo::parse_command_line(nArgs, argv, options), vm);
+        bpo::notify(vm);
+    }
+    catch (bpo::error& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    if (vm.count("help")) {
+        std::cout << "COMPAS kernel microbenchmarks\n\nUsage: COMPAS_BENCH [options] [-- COMPAS options]\n\n" << options << std::endl;
+        std::exit(EXIT_SUCCESS);
+    }
+
+    if (settings.minTime <= 0.0 || settings.repetitions < 1) {
+        std::cerr << "ERROR: --min-time must be positive and --repetitions at least 1" << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    return settings;
+}
+
+
+int main(int argc, char* argv[]) {
+
+    BenchmarkSettingsT settings = ParseCommandLine(argc, argv);
+
+    RAND->Initialise();
+    RAND->Seed(0l);
+
+    // COMPAS options: user-supplied options, then the logfile location (the benchmarks
+    // own the output path and container), quiet, and a fixed random seed
+
+    std::vector<std::string> args = { argv[0] };
+    args.insert(args.end(), settings.compasOptions.begin(), settings.compasOptions.end());
+    args.insert(args.end(), { "--output-path", settings.workDir, "--output-container", BENCHMARK_OUTPUT_CONTAINER, "--quiet", "--random-seed", "0" });
+
+    std::vector<char*> compasArgv;
+    for (auto& arg : args) compasArgv.push_back(const_cast<char*>(arg.c_str()));
+
+    if (!OPTIONS->Initialise(static_cast<int>(compasArgv.size()), compasArgv.data())) return EXIT_FAILURE;
+
+    LOGGING->Start(OPTIONS->OutputPathString(), OPTIONS->OutputContainerName(), OPTIONS->LogfileNamePrefix(),
+                   OPTIONS->LogLevel(), OPTIONS->LogClasses(), OPTIONS->DebugLevel(), OPTIONS->DebugClasses(),
+                   OPTIONS->DebugToFile(), OPTIONS->ErrorsToFile(), OPTIONS->LogfileType());
+    if (!LOGGING->Enabled()) return EXIT_FAILURE;
+
+    int status = EXIT_SUCCESS;
+    {
+        Benchmarks benchmarks;
+        if (!benchmarks.Prepare()) status = EXIT_FAILURE;
+        else {
+            std::vector<BenchmarkResultT> results;
+            for (auto& kernel : benchmarks.Kernels()) {
+                if (!settings.filter.empty() && kernel.name.find(settings.filter) == std::string::npos) continue;
+                std::cerr << "Timing " << kernel.name << "..." << std::endl;
+                results.push_back(TimeKernel(kernel, settings.minTime, settings.repetitions));
+            }
+
+            std::vector<LoveridgeComparisonT> loveridge;
+            if (std::string("Loveridge").find(settings.filter) != std::string::npos) {                    // compare Loveridge polynomials (unless filtered out)
+                std::cerr << "Comparing Loveridge polynomials..." << std::endl;
+                loveridge = benchmarks.CompareLoveridge();
+            }
+
+            if (settings.output.empty()) WriteJSON(std::cout, settings, results, loveridge);
+            else {
+                std::ofstream file(settings.output);
+                if (!file) {
+                    std::cerr << "ERROR: unable to open output file '" << settings.output << "'" << std::endl;
+                    status = EXIT_FAILURE;
+                }
+                else WriteJSON(file, settings, results, loveridge);
+            }
+        }
+    }
+
+    LOGGING->Stop();
+    RAND->Free();
+
+    return status;
+}
@@ -0,0 +1,415 @@
+/*
+ * SamplingChecks - statistical checks of the truncated Gaussian and log-normal samplers
+ *
+ * Rand::TruncatedGaussianInverseCDF() and Rand::TruncatedLogNormalInverseCDF() replaced the rejection
+ * loops that sampled the truncated Gaussian distributions in COMPAS.  This program checks that the
+ * samples drawn at each site that uses them follow the intended distribution, with a one-sample
+ * Kolmogorov-Smirnov (KS) test of --samples samples (drawn from the COMPAS random number generator,
+ * seeded with --random-seed) against the analytic CDF of the truncated distribution:
+ *
+ *     MULLERMANDEL remnant masses              the three NS branches and the BH branch of
+ *                                              GiantBranch::CalculateRemnantMassByMullerMandel(),
+ *                                              including an NS branch truncated near its mean
+ *     MULLERMANDEL kicks                       the truncated Gaussian of BaseStar::DrawRemnantKickMullerMandel()
+ *     DUQUENNOYMAYOR1991 eccentricity          utils::SampleEccentricity()
+ *     GELLER_2013 eccentricity                 utils::SampleEccentricity()
+ *     DUQUENNOYMAYOR1991 mass ratio            utils::SampleMassRatio()
+ *     DUQUENNOYMAYOR1991 period                utils::SampleSemiMajorAxis() (log-normal in period)
+ *     upper and lower tails                    intervals 3 to 5 sigma from the mean (the complementary CDF branch,
+ *                                              and the reflection of intervals below the mean)
+ *     exponential tails                        intervals more than 37 sigma from the mean, beyond the range of
+ *                                              the complementary CDF (the exponential tail branch)
+ *
+ * The analytic CDFs are calculated here independently of GSL: from std::erfc, and, in the tails, from the
+ * ratio of the complementary CDFs, calculated with the continued fraction for the Mills ratio (so they are
+ * accurate where the complementary CDF underflows).
+ *
+ * A check fails if the KS p-value is below --alpha.  The exponential tail is an approximation (with relative
+ * error of order 1/a^2 at a standard deviations from the mean), so it is checked at the resolution of the
+ * KS test for --samples samples.  The exit status is 0 if all checks pass, and 1 if not.
+ *
+ * Build and run with 'make checks' (or build with 'make COMPAS_CHECKS') in the src directory.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "constants.h"
+#include "typedefs.h"
+#include "profiling.h"
+#include "utils.h"
+#include "Options.h"
+#include "Rand.h"
+
+namespace bpo = boost::program_options;                                                 // po is taken (Options.h)
+
+
+OBJECT_ID globalObjectId = 1;                                                           // used to uniquely identify objects - used primarily for error printing
+OBJECT_ID m_ObjectId     = 0;                                                           // object id for the checks driver - always 0
+
+OBJECT_ID    ObjectId()    { return m_ObjectId; }
+OBJECT_TYPE  ObjectType()  { return OBJECT_TYPE::MAIN; }
+STELLAR_TYPE StellarType() { return STELLAR_TYPE::NONE; }
+
+
+const double INF = std::numeric_limits<double>::infinity();
+
+
+typedef struct ChecksSettings {
+    long int          samples;
+    unsigned long int seed;
+    double            alpha;
+} ChecksSettingsT;
+
+
+/*
+ * A sampling check
+ *
+ * sample(u) transforms a uniform deviate to a sample, as the code being checked does
+ * cdf(x)    is the analytic CDF of the distribution the samples should follow
+ */
+typedef struct SamplingCheck {
+    std::string                           name;
+    std::function<double(const double)>   sample;
+    std::function<double(const double)>   cdf;
+} SamplingCheckT;
+
+
+/*
+ * Calculate the Mills ratio Q(z) / phi(z) of the standard normal distribution, for z > 0
+ *
+ * Uses the continued fraction R(z) = 1 / (z + 1 / (z + 2 / (z + 3 / (z + ...)))), evaluated
+ * by the modified Lentz method.  Converges quickly for z greater than about 1.
+ *
+ *
+ * double MillsRatio(const double p_Z)
+ *
+ * @param   [IN]    p_Z                         Standardised value (> 0)
+ * @return                                      Mills ratio at p_Z
+ */
+double MillsRatio(const double p_Z) {
+
+    const double tiny = 1.0E-300;
+
+    double f = p_Z;                                                                     // b0
+    double c = f;
+    double d = 0.0;
+    for (int k = 1; k < 10000; k++) {
+        double a = static_cast<double>(k);                                              // a_k = k, b_k = z
+        d = p_Z + a * d; d = std::abs(d) < tiny ? tiny : d; d = 1.0 / d;
+        c = p_Z + a / c; c = std::abs(c) < tiny ? tiny : c;
+        double delta = c * d;
+        f *= delta;
+        if (std::abs(delta - 1.0) < 1.0E-16) break;
+    }
+
+    return 1.0 / f;
+}
+
+
+/*
+ * Calculate Q(p_X) / Q(p_A) for the standard normal distribution, for p_X >= p_A > 0
+ *
+ * Uses std::erfc where Q(p_A) is well within its range, otherwise the Mills ratio.
+ *
+ *
+ * double TailRatio(const double p_X, const double p_A)
+ *
+ * @param   [IN]    p_X                         Standardised value
+ * @param   [IN]    p_A                         Standardised lower bound of the tail
+ * @return                                      Q(p_X) / Q(p_A)
+ */
+double TailRatio(const double p_X, const double p_A) {
+    if (std::isinf(p_X)) return 0.0;
+    if (p_A < 20.0) return std::erfc(p_X / M_SQRT2) / std::erfc(p_A / M_SQRT2);
+    return std::exp(-0.5 * (p_X - p_A) * (p_X + p_A)) * MillsRatio(p_X) / MillsRatio(p_A);
+}
+
+
+/*
+ * Calculate the CDF of a Gaussian distribution, with mean p_Mu and standard deviation p_Sigma,
+ * truncated to [p_Lower, p_Upper]
+ *
+ *
+ * double TruncatedGaussianCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_X)
+ *
+ * @param   [IN]    p_Mu                        Mean of the (untruncated) distribution
+ * @param   [IN]    p_Sigma                     Standard deviation of the (untruncated) distribution
+ * @param   [IN]    p_Lower                     Lower bound
+ * @param   [IN]    p_Upper                     Upper bound
+ * @param   [IN]    p_X                         Value at which to calculate the CDF
+ * @return                                      CDF at p_X
+ */
+double TruncatedGaussianCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_X) {
+
+    if (p_X <= p_Lower) return 0.0;
+    if (p_X >= p_Upper) return 1.0;
+
+    double a = (p_Lower - p_Mu) / p_Sigma;                                              // standardised bounds and value
+    double b = (p_Upper - p_Mu) / p_Sigma;
+    double x = (p_X - p_Mu) / p_Sigma;
+
+    if (a + b < 0.0) return 1.0 - TruncatedGaussianCDF(0.0, 1.0, -b, -a, -x);           // interval mostly below the mean - reflect it
+
+    if (a <= 1.0) {                                                                     // not far into the tail - use the CDF
+        auto phi = [](const double z) { return 0.5 * std::erfc(-z / M_SQRT2); };
+        return (phi(x) - phi(a)) / (phi(b) - phi(a));
+    }
+
+    return (1.0 - TailRatio(x, a)) / (1.0 - TailRatio(b, a));                           // tail - use the ratio of complementary CDFs
+}
+
+
+/*
+ * Calculate the CDF of a log-normal distribution (log10 of the value is Gaussian, with mean p_Mu
+ * and standard deviation p_Sigma), truncated to [p_Lower, p_Upper]
+ *
+ *
+ * double TruncatedLogNormalCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_X)
+ *
+ * @param   [IN]    p_Mu                        Mean of log10 of the (untruncated) distribution
+ * @param   [IN]    p_Sigma                     Standard deviation of log10 of the (untruncated) distribution
+ * @param   [IN]    p_Lower                     Lower bound (> 0)
+ * @param   [IN]    p_Upper                     Upper bound
+ * @param   [IN]    p_X                         Value at which to calculate the CDF
+ * @return                                      CDF at p_X
+ */
+double TruncatedLogNormalCDF(const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper, const double p_X) {
+    if (p_X <= p_Lower) return 0.0;
+    return TruncatedGaussianCDF(p_Mu, p_Sigma, std::log10(p_Lower), std::log10(p_Upper), std::log10(p_X));
+}
+
+
+/*
+ * Calculate the p-value of the one-sample KS statistic
+ *
+ * Uses the asymptotic Kolmogorov distribution, with the finite sample correction of
+ * Stephens (1970).
+ *
+ *
+ * double KSPValue(const double p_D, const long int p_N)
+ *
+ * @param   [IN]    p_D                         KS statistic
+ * @param   [IN]    p_N                         Number of samples
+ * @return                                      p-value
+ */
+double KSPValue(const double p_D, const long int p_N) {
+
+    double sqrtN  = std::sqrt(static_cast<double>(p_N));
+    double lambda = (sqrtN + 0.12 + 0.11 / sqrtN) * p_D;
+
+    if (lambda < 0.2) return 1.0;                                                       // series converges slowly - p-value is 1 to double precision
+
+    double p    = 0.0;
+    double sign = 1.0;
+    for (int k = 1; k <= 100; k++) {
+        double term = sign * std::exp(-2.0 * k * k * lambda * lambda);
+        p          += term;
+        if (std::abs(term) < 1.0E-16 * std::abs(p)) break;
+        sign = -sign;
+    }
+
+    return std::min(std::max(2.0 * p, 0.0), 1.0);
+}
+
+
+/*
+ * The sampling checks
+ *
+ * The sites are checked with the parameters (and default bounds) they use in COMPAS.
+ *
+ *
+ * std::vector<SamplingCheckT> Checks()
+ *
+ * @return                                      Vector of checks
+ */
+std::vector<SamplingCheckT> Checks() {
+
+    std::vector<SamplingCheckT> checks;
+
+    // adds a check of a truncated Gaussian sampled with RAND->RandomTruncatedGaussian() (as GiantBranch does) -
+    // the uniform deviate is ignored, and the sampler draws its own from the same generator
+    auto randomTruncatedGaussian = [&checks](const std::string p_Name, const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper) {
+        checks.push_back({ p_Name,
+                           [=](const double u) { return RAND->RandomTruncatedGaussian(p_Mu, p_Sigma, p_Lower, p_Upper); },
+                           [=](const double x) { return TruncatedGaussianCDF(p_Mu, p_Sigma, p_Lower, p_Upper, x); } });
+    };
+
+    // adds a check of Rand::TruncatedGaussianInverseCDF()
+    auto truncatedGaussian = [&checks](const std::string p_Name, const double p_Mu, const double p_Sigma, const double p_Lower, const double p_Upper) {
+        checks.push_back({ p_Name,
+                           [=](const double u) { return Rand::TruncatedGaussianInverseCDF(p_Mu, p_Sigma, p_Lower, p_Upper, u); },
+                           [=](const double x) { return TruncatedGaussianCDF(p_Mu, p_Sigma, p_Lower, p_Upper, x); } });
+    };
+
+    // MULLERMANDEL remnant masses (GiantBranch::CalculateRemnantMassByMullerMandel()), at representative CO and He core masses
+
+    randomTruncatedGaussian("MULLERMANDEL NS mass, CO core < M1", MULLERMANDEL_MU1, MULLERMANDEL_SIGMA1, MULLERMANDEL_MINNS, MULLERMANDEL_MAXNS);
+    randomTruncatedGaussian("MULLERMANDEL NS mass, CO core < M1, truncated at mean", MULLERMANDEL_MU1, MULLERMANDEL_SIGMA1, MULLERMANDEL_MINNS, MULLERMANDEL_MU1);  // CO + He core mass = MU1
+
+    double coCoreMass = 2.5;                                                            // M1 <= CO core < M2
+    randomTruncatedGaussian("MULLERMANDEL NS mass, M1 <= CO core < M2",
+                            MULLERMANDEL_MU2A + MULLERMANDEL_MU2B / (MULLERMANDEL_M2 - MULLERMANDEL_M1) * (coCoreMass - MULLERMANDEL_M1), MULLERMANDEL_SIGMA2, MULLERMANDEL_MINNS, MULLERMANDEL_MAXNS);
+
+    coCoreMass = 5.0;                                                                   // CO core >= M2
+    randomTruncatedGaussian("MULLERMANDEL NS mass, CO core >= M2",
+                            MULLERMANDEL_MU3A + MULLERMANDEL_MU3B / (MULLERMANDEL_M3 - MULLERMANDEL_M2) * (coCoreMass - MULLERMANDEL_M2), MULLERMANDEL_SIGMA3, MULLERMANDEL_MINNS, MULLERMANDEL_MAXNS);
+
+    coCoreMass = 10.0;                                                                  // BH, partial fallback
+    double heCoreMass = 5.0;
+    randomTruncatedGaussian("MULLERMANDEL BH mass", MULLERMANDEL_MUBH * coCoreMass, MULLERMANDEL_SIGMABH, MULLERMANDEL_MAXNS, coCoreMass + heCoreMass);
+
+    // MULLERMANDEL kicks (BaseStar::DrawRemnantKickMullerMandel()) - kick / muKick
+
+    truncatedGaussian("MULLERMANDEL kick / mean kick", 1.0, MULLERMANDEL_SIGMAKICK, 0.0, INF);
+
+    // initial conditions (utils.cpp) - default bounds
+
+    checks.push_back({ "DUQUENNOYMAYOR1991 eccentricity",
+                       [](const double u) { return utils::SampleEccentricity(ECCENTRICITY_DISTRIBUTION::DUQUENNOYMAYOR1991, 1.0, 0.0, u); },
+                       [](const double x) { return TruncatedGaussianCDF(0.3, 0.15, 0.0, 1.0, x); } });
+
+    checks.push_back({ "GELLER_2013 eccentricity",
+                       [](const double u) { return utils::SampleEccentricity(ECCENTRICITY_DISTRIBUTION::GELLER_2013, 1.0, 0.0, u); },
+                       [](const double x) { return TruncatedGaussianCDF(0.38, 0.23, 0.0, 1.0, x); } });
+
+    checks.push_back({ "DUQUENNOYMAYOR1991 mass ratio",
+                       [](const double u) { return utils::SampleMassRatio(MASS_RATIO_DISTRIBUTION::DUQUENNOYMAYOR1991, 1.0, 0.01, u); },
+                       [](const double x) { return TruncatedGaussianCDF(0.23, 0.42, 0.01, 1.0, x); } });
+
+    // the period distribution is checked through the semi-major axis: the CDF at a is the CDF of the
+    // truncated log-normal period distribution at the period of a (period increases with a)
+    const double mass1       = 20.0;
+    const double mass2       = 10.0;
+    const double aMin        = 0.01;
+    const double aMax        = 1000.0;
+    const double periodPerAU = PPOW(utils::ConvertPeriodInDaysToSemiMajorAxisInAU(mass1, mass2, 1.0), -1.5);    // period in days at a = 1 AU
+    checks.push_back({ "DUQUENNOYMAYOR1991 period",
+                       [=](const double u) { return utils::SampleSemiMajorAxis(SEMI_MAJOR_AXIS_DISTRIBUTION::DUQUENNOYMAYOR1991, aMax, aMin, 0.0, 0.0, 0.0, mass1, mass2, u); },
+                       [=](const double x) { return TruncatedLogNormalCDF(4.8, 2.3, periodPerAU * PPOW(aMin, 1.5), periodPerAU * PPOW(aMax, 1.5), periodPerAU * PPOW(x, 1.5)); } });
+
+    // tails - the complementary CDF branch, the reflection, and the exponential tail branch
+
+    truncatedGaussian("upper tail [3, 5] sigma",          0.0, 1.0,   3.0,   5.0);
+    truncatedGaussian("lower tail [-5, -3] sigma",        0.0, 1.0,  -5.0,  -3.0);
+    truncatedGaussian("upper tail [8, inf) sigma",        0.0, 1.0,   8.0,   INF);
+    truncatedGaussian("exponential tail [40, inf) sigma", 0.0, 1.0,  40.0,   INF);
+    truncatedGaussian("exponential tail [40, 40.1] sigma", 0.0, 1.0, 40.0,  40.1);
+    truncatedGaussian("exponential tail [-inf, -45] sigma (mu = 10, sigma = 2)", 10.0, 2.0, -INF, 10.0 - 45.0 * 2.0);
+
+    checks.push_back({ "log-normal upper tail [3, 5] sigma",
+                       [](const double u) { return Rand::TruncatedLogNormalInverseCDF(1.0, 0.5, PPOW(10.0, 2.5), PPOW(10.0, 3.5), u); },
+                       [](const double x) { return TruncatedLogNormalCDF(1.0, 0.5, PPOW(10.0, 2.5), PPOW(10.0, 3.5), x); } });
+
+    return checks;
+}
+
+
+/*
+ * Run a check
+ *
+ * Draws the samples, and calculates the KS statistic against the analytic CDF
+ *
+ *
+ * double RunCheck(const SamplingCheckT& p_Check, const long int p_Samples, double& p_D)
+ *
+ * @param   [IN]    p_Check                     The check to run
+ * @param   [IN]    p_Samples                   Number of samples
+ * @param   [OUT]   p_D                         KS statistic
+ * @return                                      p-value
+ */
+double RunCheck(const SamplingCheckT& p_Check, const long int p_Samples, double& p_D) {
+
+    std::vector<double> samples(p_Samples);
+    for (auto& sample : samples) sample = p_Check.sample(RAND->Random());
+
+    std::sort(samples.begin(), samples.end());
+
+    double n = static_cast<double>(p_Samples);
+    p_D = 0.0;
+    for (long int i = 0; i < p_Samples; i++) {
+        double F = p_Check.cdf(samples[i]);
+        p_D = std::max(p_D, std::max(F - static_cast<double>(i) / n, static_cast<double>(i + 1) / n - F));
+    }
+
+    return KSPValue(p_D, p_Samples);
+}
+
+
+/*
+ * Parse the command line
+ *
+ *
+ * ChecksSettingsT ParseCommandLine(int argc, char* argv[])
+ *
+ * @param   [IN]    argc                        Argument count
+ * @param   [IN]    argv                        Argument values
+ * @return                                      Settings
+ */
+ChecksSettingsT ParseCommandLine(int argc, char* argv[]) {
+
+    ChecksSettingsT settings;
+
+    bpo::options_description options("Options");
+    options.add_options()
+        ("help,h",       "Print this help message")
+
+        ("samples,n",    bpo::value<long int>(&settings.samples)->default_value(100000),          "Number of samples per check")
+        ("random-seed",  bpo::value<unsigned long int>(&settings.seed)->default_value(0),        "Random seed")
+        ("alpha",        bpo::value<double>(&settings.alpha)->default_value(1.0E-3),             "A check fails if the KS p-value is below alpha")
+    ;
+
+    bpo::variables_map vm;
+    try {
+        bpo::store(bpo::parse_command_line(argc, argv, options), vm);
+        bpo::notify(vm);
+    }
+    catch (bpo::error& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    if (vm.count("help")) {
+        std::cout << "COMPAS truncated Gaussian sampling checks\n\nUsage: COMPAS_CHECKS [options]\n\n" << options << std::endl;
+        std::exit(EXIT_SUCCESS);
+    }
+
+    if (settings.samples < 2 || settings.alpha <= 0.0 || settings.alpha >= 1.0) {
+        std::cerr << "ERROR: --samples must be at least 2 and --alpha in (0, 1)" << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    return settings;
+}
+
+
+int main(int argc, char* argv[]) {
+
+    ChecksSettingsT settings = ParseCommandLine(argc, argv);
+
+    RAND->Initialise();
+    RAND->Seed(settings.seed);
+
+    int failures = 0;
+    for (auto& check : Checks()) {
+        double D;
+        double p  = RunCheck(check, settings.samples, D);
+        bool   ok = p >= settings.alpha;
+        if (!ok) failures++;
+        std::cout << utils::vFormat("%-4s  D = %.5f  p = %.4f  ", ok ? "ok" : "FAIL", D, p) << check.name << std::endl;
+    }
+
+    std::cout << "\n" << failures << " check(s) failed (" << settings.samples << " samples per check, alpha = " << settings.alpha << ", random seed " << settings.seed << ")" << std::endl;
+
+    RAND->Free();
+
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,322 @@
+#!/usr/bin/env python
+
+#######################################################
+###
+### A/B comparison of two COMPAS builds
+###
+### Runs two COMPAS executables (A: the reference, B: the candidate) with the
+### same options and random seed, and reports
+###
+###   - wall time, CPU time and peak RSS of each, side by side (median over
+###     --repeat runs; the runs of A and B are interleaved)
+###   - whether the outputs are equivalent: every logfile (HDF5 groups, or
+###     CSV/TSV/TXT files, gzip compressed or not, including the Detailed
+###     Output files) is compared column by column.  Numeric values are equal
+###     if |a - b| <= atol + rtol * |a|; other values must match exactly.
+###     Records are grouped by SEED, so a divergence is reported as the list
+###     of diverging seeds, and for each the first divergent record (for the
+###     Detailed Output files, the first divergent row - i.e. timestep).
+###
+### The Run_Details file is not compared (it records run times), nor are the wall time
+### columns (Wall_Time...) of the summary tables (e.g. Evolution_Outcomes).
+###
+### Exit status is 0 if the outputs are equivalent, 1 if they are not.
+###
+### Usage:  python3 compareBuilds.py COMPAS_A COMPAS_B [--options '...'] [-n N]
+###                                  [--atol A] [--rtol R] [--tolerance COLUMN=ATOL,RTOL ...]
+###                                  [--repeat R] [--report FILE] [--keep DIR]
+###
+### e.g.    python3 compareBuilds.py ./COMPAS_ref ./COMPAS -n 1000 --options '--detailed-output' --rtol 1e-12
+###
+### For User Instructions, see 'docs/benchmarks.md'
+###
+#######################################################
+
+import argparse
+import csv
+import gzip
+import json
+import math
+import os
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+RUN_DETAILS = 'Run_Details'
+TIMING_COLUMN_PREFIX = 'Wall_Time'                                                      # summary table columns that record run times
+MAX_REPORTED_SEEDS = 20                                                                 # per logfile, in the text summary
+
+
+def run(command):
+    """
+    Run command, and return (wall time, CPU time (user + system), peak RSS in KiB) of the child process
+    """
+    start = time.perf_counter()
+    process = subprocess.Popen(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    _, status, usage = os.wait4(process.pid, 0)
+    wall = time.perf_counter() - start
+    exitCode = os.waitstatus_to_exitcode(status) if hasattr(os, 'waitstatus_to_exitcode') else status >> 8
+    if exitCode != 0:
+        raise RuntimeError('command failed ({}): {}'.format(exitCode, ' '.join(command)))
+    return wall, usage.ru_utime + usage.ru_stime, usage.ru_maxrss
+
+
+def median(values):
+    values = sorted(values)
+    n = len(values)
+    return values[n // 2] if n % 2 else 0.5 * (values[n // 2 - 1] + values[n // 2])
+
+
+###
+### Reading logfiles: each table is returned as a dict {column name: list of values}
+###
+
+def read_text_table(filename):
+    """
+    Read a COMPAS CSV/TSV/TXT logfile (optionally gzip compressed): three header rows (types, units, names), then the records
+    """
+    base = filename[:-3] if filename.endswith('.gz') else filename
+    delimiter = {'.csv': ',', '.tsv': '\t'}.get(os.path.splitext(base)[1], None)
+    opener = gzip.open if filename.endswith('.gz') else open
+    with opener(filename, 'rt') as f:
+        rows = csv.reader(f, delimiter=delimiter) if delimiter else (line.split() for line in f)
+        rows = [[v.strip() for v in row] for row in rows]
+    if len(rows) < 3: return {}
+    types, names = rows[0], rows[2]
+    table = {name: [] for name in names}
+    for row in rows[3:]:
+        for name, kind, value in zip(names, types, row):
+            table[name].append(convert(value, kind))
+    return table
+
+
+def convert(value, kind):
+    """
+    Convert a text logfile value to a number, per its column type
+    """
+    try:
+        if kind in ('FLOAT', 'DOUBLE'): return float(value)
+        if kind in ('INT', 'UNSIGNED_INT', 'LONG_INT', 'UNSIGNED_LONG_INT', 'SHORT_INT', 'UNSIGNED_SHORT_INT'): return int(value)
+    except ValueError:
+        pass
+    return value
+
+
+def read_hdf5_tables(filename):
+    """
+    Read every group of a COMPAS HDF5 file: {group name: table}
+    """
+    import h5py                                                                         # only needed for HDF5 output
+    tables = {}
+    with h5py.File(filename, 'r') as f:
+        for group in f:
+            if not isinstance(f[group], h5py.Group): continue
+            table = {}
+            for column in f[group]:
+                values = f[group][column][()].tolist()
+                table[column] = [v.decode() if isinstance(v, bytes) else v for v in values]
+            tables[group] = table
+    return tables
+
+
+def read_container(container):
+    """
+    Read all logfiles in a COMPAS output container: {logfile name: table}
+
+    Logfile names are relative paths, without extension, with the HDF5 group name appended for HDF5 files.
+    The Run_Details logfile, and the columns that record run times, are dropped
+    """
+    tables = {}
+    for root, _, files in os.walk(container):
+        for name in sorted(files):
+            path  = os.path.join(root, name)
+            rel   = os.path.relpath(path, container)
+            stem  = rel[:-3] if rel.endswith('.gz') else rel
+            stem, ext = os.path.splitext(stem)
+            if ext == '.h5':
+                for group, table in read_hdf5_tables(path).items():
+                    tables[stem if group == os.path.basename(stem) else stem + ':' + group] = table
+            elif ext in ('.csv', '.tsv', '.txt'):
+                tables[stem] = read_text_table(path)
+    return {name: {column: values for column, values in table.items() if not column.startswith(TIMING_COLUMN_PREFIX)}
+            for name, table in tables.items() if os.path.basename(name).split(':')[-1] != RUN_DETAILS}
+
+
+###
+### Comparison
+###
+
+def equal(a, b, atol, rtol):
+    """
+    Values are equal if identical, both NaN, or (numeric) within tolerance
+    """
+    if a == b: return True
+    if isinstance(a, (int, float)) and isinstance(b, (int, float)) and not isinstance(a, bool) and not isinstance(b, bool):
+        if math.isnan(a) and math.isnan(b): return True
+        return abs(a - b) <= atol + rtol * abs(a)
+    return False
+
+
+def compare_tables(tableA, tableB, atol, rtol, tolerances):
+    """
+    Compare two tables
+
+    Returns a dict: columns only in A, columns only in B, and the diverging seeds, each with its
+    first divergent record (index within the seed's records), column and values
+    """
+    result = {'columns_only_in_a': sorted(set(tableA) - set(tableB)),
+              'columns_only_in_b': sorted(set(tableB) - set(tableA)),
+              'rows_a': len(next(iter(tableA.values()), [])),
+              'rows_b': len(next(iter(tableB.values()), [])),
+              'diverging_seeds': []}
+
+    columns = [c for c in tableA if c in tableB]
+    seedColumn = 'SEED' if 'SEED' in columns else None
+
+    def group_rows(table, n):
+        groups = {}
+        for row in range(n):
+            seed = table[seedColumn][row] if seedColumn else None
+            groups.setdefault(seed, []).append(row)
+        return groups
+
+    groupsA = group_rows(tableA, result['rows_a'])
+    groupsB = group_rows(tableB, result['rows_b'])
+
+    for seed in sorted(set(groupsA) | set(groupsB), key=lambda s: (s is None, s)):
+        rowsA, rowsB = groupsA.get(seed, []), groupsB.get(seed, [])
+        divergence = None
+        for i, (rowA, rowB) in enumerate(zip(rowsA, rowsB)):
+            for column in columns:
+                a, b = tableA[column][rowA], tableB[column][rowB]
+                columnAtol, columnRtol = tolerances.get(column, (atol, rtol))
+                if not equal(a, b, columnAtol, columnRtol):
+                    divergence = {'record': i, 'column': column, 'a': a, 'b': b}
+                    if 'Time' in columns: divergence['time'] = tableA['Time'][rowA]
+                    break
+            if divergence: break
+        if not divergence and len(rowsA) != len(rowsB):
+            divergence = {'record': min(len(rowsA), len(rowsB)), 'column': None, 'a': len(rowsA), 'b': len(rowsB)}
+        if divergence:
+            divergence['seed'] = seed
+            result['diverging_seeds'].append(divergence)
+
+    return result
+
+
+def compare_containers(containerA, containerB, atol, rtol, tolerances):
+    """
+    Compare the logfiles of two COMPAS output containers
+    """
+    tablesA, tablesB = read_container(containerA), read_container(containerB)
+    report = {'logfiles_only_in_a': sorted(set(tablesA) - set(tablesB)),
+              'logfiles_only_in_b': sorted(set(tablesB) - set(tablesA)),
+              'logfiles': {}}
+    for name in sorted(set(tablesA) & set(tablesB)):
+        report['logfiles'][name] = compare_tables(tablesA[name], tablesB[name], atol, rtol, tolerances)
+    report['equivalent'] = not (report['logfiles_only_in_a'] or report['logfiles_only_in_b'] or
+                                any(r['columns_only_in_a'] or r['columns_only_in_b'] or r['diverging_seeds'] for r in report['logfiles'].values()))
+    return report
+
+
+def print_report(performance, report):
+    """
+    Print the side-by-side performance and the output comparison
+    """
+    a, b = performance['a'], performance['b']
+    print('\n{:20s} {:>14s} {:>14s} {:>10s}'.format('', 'A', 'B', 'B/A'))
+    for key, label in (('wall_s', 'wall (s)'), ('cpu_s', 'CPU (s)'), ('peak_rss_kb', 'peak RSS (KiB)')):
+        ratio = b[key] / a[key] if a[key] else float('nan')
+        print('{:20s} {:14.3f} {:14.3f} {:10.3f}'.format(label, a[key], b[key], ratio))
+    print('speedup (wall, A/B): {:.3f}'.format(a['wall_s'] / b['wall_s'] if b['wall_s'] else float('nan')))
+
+    print('\nOutput comparison: {}'.format('EQUIVALENT' if report['equivalent'] else 'DIFFERENT'))
+    for name in report['logfiles_only_in_a']: print('    only in A: ' + name)
+    for name in report['logfiles_only_in_b']: print('    only in B: ' + name)
+    for name, r in report['logfiles'].items():
+        if not (r['columns_only_in_a'] or r['columns_only_in_b'] or r['diverging_seeds']): continue
+        print('    {}: {} diverging seed(s) ({} / {} records)'.format(name, len(r['diverging_seeds']), r['rows_a'], r['rows_b']))
+        if r['columns_only_in_a']: print('        columns only in A: ' + ', '.join(r['columns_only_in_a']))
+        if r['columns_only_in_b']: print('        columns only in B: ' + ', '.join(r['columns_only_in_b']))
+        for d in r['diverging_seeds'][:MAX_REPORTED_SEEDS]:
+            if d['column'] is None:
+                print('        SEED {}: record count {} vs {}'.format(d['seed'], d['a'], d['b']))
+            else:
+                print('        SEED {}: first divergence at record {}{}, column {}: {!r} vs {!r}'.format(
+                      d['seed'], d['record'], ' (Time {})'.format(d['time']) if 'time' in d else '', d['column'], d['a'], d['b']))
+        if len(r['diverging_seeds']) > MAX_REPORTED_SEEDS:
+            print('        ... and {} more'.format(len(r['diverging_seeds']) - MAX_REPORTED_SEEDS))
+
+
+def parse_tolerances(specs):
+    """
+    Parse per-column tolerances: COLUMN=ATOL,RTOL
+    """
+    tolerances = {}
+    for spec in specs:
+        try:
+            column, values = spec.split('=', 1)
+            atol, rtol = (float(v) for v in values.split(','))
+        except ValueError:
+            sys.exit('invalid tolerance specification (expected COLUMN=ATOL,RTOL): ' + spec)
+        tolerances[column] = (atol, rtol)
+    return tolerances
+
+
+def main():
+    parser = argparse.ArgumentParser(description='A/B performance and output comparison of two COMPAS builds')
+    parser.add_argument('compas_a',                                                     help='reference COMPAS executable')
+    parser.add_argument('compas_b',                                                     help='candidate COMPAS executable')
+    parser.add_argument('--options',            default='',                             help='COMPAS options for both runs (one quoted string)')
+    parser.add_argument('-n', '--number-of-systems', type=int, default=100,             help='number of systems to evolve (ignored if --options has a grid file)')
+    parser.add_argument('--random-seed',        type=int,   default=0,                  help='random seed for both runs')
+    parser.add_argument('--atol',               type=float, default=0.0,                help='absolute tolerance')
+    parser.add_argument('--rtol',               type=float, default=0.0,                help='relative tolerance')
+    parser.add_argument('--tolerance',          nargs='*',  default=[],                 help='per-column tolerances, COLUMN=ATOL,RTOL')
+    parser.add_argument('--repeat',             type=int,   default=1,                  help='number of runs of each build for timing (median reported)')
+    parser.add_argument('--report',             default='',                             help='write the full report as JSON to this file')
+    parser.add_argument('--keep',               default='',                             help='keep the outputs in this directory')
+    args = parser.parse_args()
+
+    if args.repeat < 1: sys.exit('--repeat must be at least 1')
+
+    options = shlex.split(args.options)
+    command = ['--random-seed', str(args.random_seed), '--quiet']
+    if '--grid' not in options: command += ['--number-of-systems', str(args.number_of_systems)]
+    command += options
+
+    workdir = args.keep if args.keep else tempfile.mkdtemp(prefix='compas_ab_')
+    os.makedirs(workdir, exist_ok=True)
+    try:
+        samples = {'a': [], 'b': []}
+        for r in range(args.repeat):                                                    # interleave A and B so drift affects both
+            for build, compas in (('a', args.compas_a), ('b', args.compas_b)):
+                container = '{}_{}'.format(build.upper(), r)
+                shutil.rmtree(os.path.join(workdir, container), ignore_errors=True)
+                print('Running {} ({}/{})...'.format(build.upper(), r + 1, args.repeat), flush=True)
+                samples[build].append(run([compas] + command + ['--output-path', workdir, '--output-container', container]))
+
+        performance = {build: {'wall_s':      median([s[0] for s in samples[build]]),
+                               'cpu_s':       median([s[1] for s in samples[build]]),
+                               'peak_rss_kb': max(s[2] for s in samples[build])} for build in samples}
+
+        report = compare_containers(os.path.join(workdir, 'A_0'), os.path.join(workdir, 'B_0'), args.atol, args.rtol, parse_tolerances(args.tolerance))
+        print_report(performance, report)
+
+        if args.report:
+            with open(args.report, 'w') as f:
+                json.dump({'compas_a': args.compas_a, 'compas_b': args.compas_b, 'options': command,
+                           'atol': args.atol, 'rtol': args.rtol, 'tolerances': args.tolerance,
+                           'performance': performance, 'comparison': report}, f, indent=4, default=str)
+    finally:
+        if not args.keep: shutil.rmtree(workdir, ignore_errors=True)
+
+    sys.exit(0 if report['equivalent'] else 1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,217 @@
+#!/usr/bin/env python
+
+#######################################################
+###
+### COMPAS benchmark suite
+###
+### Runs the canonical COMPAS workloads, and the kernel microbenchmarks
+### (COMPAS_BENCH, see Benchmarks.cpp), and writes the results to a single
+### JSON file so that performance can be compared across versions.
+###
+### Workloads (all with a fixed random seed):
+###
+###     sse_grid        single stars from a grid file, log-uniform in mass in [0.5, 150] Msol
+###     bse_default     binary population with the default options
+###     bse_rlof        short-period binaries (a in [0.01, 0.5] AU) - mass transfer dominated
+###     bse_pulsar      massive binaries with pulsar evolution (--evolve-pulsars)
+###     bse_logging     binaries with detailed output to HDF5 - logging dominated
+###
+### For each workload the suite reports the median wall time over --repeat
+### runs, the throughput (systems/s), the peak RSS of the COMPAS process, and
+### the size of the output written.
+###
+### Usage:  python3 runBenchmarks.py [--compas PATH] [--micro PATH] [--output FILE]
+###                                  [--scale S] [--repeat R] [--workloads NAME ...]
+###
+### For User Instructions, see 'docs/benchmarks.md'
+###
+#######################################################
+
+import argparse
+import json
+import os
+import platform
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+SRC_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SSE_GRID_SIZE = 500
+
+# name: (number of systems at scale 1, COMPAS options)
+WORKLOADS = {
+    'sse_grid':    (SSE_GRID_SIZE, ['--mode', 'SSE']),
+    'bse_default': (1000, []),
+    'bse_rlof':    (500,  ['--semi-major-axis-min', '0.01', '--semi-major-axis-max', '0.5']),
+    'bse_pulsar':  (500,  ['--evolve-pulsars', '--initial-mass-min', '8.0', '--initial-mass-max', '20.0', '--mass-ratio-min', '0.5']),
+    'bse_logging': (100,  ['--detailed-output', '--logfile-type', 'HDF5']),
+}
+
+
+def compas_version():
+    """
+    COMPAS version, from changelog.h
+    """
+    with open(os.path.join(SRC_DIR, 'changelog.h')) as f:
+        match = re.search(r'VERSION_STRING\s*=\s*"([^"]+)"', f.read())
+    return match.group(1) if match else 'unknown'
+
+
+def git_revision():
+    """
+    Git revision of the source tree (with '-dirty' if there are uncommitted changes), if available
+    """
+    try:
+        return subprocess.check_output(['git', 'describe', '--always', '--dirty'], cwd=SRC_DIR, stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def cpu_model():
+    """
+    CPU model name (Linux), or the platform processor string
+    """
+    try:
+        with open('/proc/cpuinfo') as f:
+            for line in f:
+                if line.startswith('model name'):
+                    return line.split(':', 1)[1].strip()
+    except OSError:
+        pass
+    return platform.processor()
+
+
+def write_sse_grid(filename, n):
+    """
+    Grid of n single stars, log-uniform in mass in [0.5, 150] Msol
+    """
+    with open(filename, 'w') as f:
+        for i in range(n):
+            f.write('--initial-mass {:.6f}\n'.format(0.5 * 300.0 ** (i / (n - 1.0))))
+
+
+def directory_size(path):
+    """
+    Total size in bytes of the files under path
+    """
+    size = 0
+    for root, _, files in os.walk(path):
+        for name in files:
+            size += os.path.getsize(os.path.join(root, name))
+    return size
+
+
+def run(command):
+    """
+    Run command, and return (wall time in seconds, peak RSS in KiB) of the child process
+    """
+    start = time.perf_counter()
+    process = subprocess.Popen(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    _, status, usage = os.wait4(process.pid, 0)
+    wall = time.perf_counter() - start
+    exitCode = os.waitstatus_to_exitcode(status) if hasattr(os, 'waitstatus_to_exitcode') else status >> 8
+    if exitCode != 0:
+        raise RuntimeError('command failed ({}): {}'.format(exitCode, ' '.join(command)))
+    return wall, usage.ru_maxrss
+
+
+def run_workload(compas, name, scale, repeat, workdir):
+    """
+    Run a workload repeat times, and return its results
+    """
+    n, options = WORKLOADS[name]
+    n = max(1, int(round(n * scale)))
+
+    command = [compas, '--random-seed', '0', '--quiet', '--output-path', workdir]
+    if name == 'sse_grid':
+        grid = os.path.join(workdir, 'SSE_Bench_Grid.txt')
+        write_sse_grid(grid, n)
+        command += ['--grid', grid]
+    else:
+        command += ['--number-of-systems', str(n)]
+    command += options
+
+    walls, rss, outputSize = [], [], 0
+    for r in range(repeat):
+        container = '{}_{}'.format(name, r)
+        wall, peak = run(command + ['--output-container', container])
+        walls.append(wall)
+        rss.append(peak)
+        outputSize = directory_size(os.path.join(workdir, container))
+        shutil.rmtree(os.path.join(workdir, container), ignore_errors=True)
+
+    walls.sort()
+    median = walls[len(walls) // 2] if len(walls) % 2 else 0.5 * (walls[len(walls) // 2 - 1] + walls[len(walls) // 2])
+
+    return {
+        'name':             name,
+        'systems':          n,
+        'options':          ' '.join(options),
+        'wall_s':           round(median, 4),
+        'wall_s_min':       round(walls[0], 4),
+        'wall_s_max':       round(walls[-1], 4),
+        'systems_per_s':    round(n / median, 3),
+        'peak_rss_kb':      max(rss),
+        'output_bytes':     outputSize,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description='COMPAS benchmark suite')
+    parser.add_argument('--compas',    default=os.path.join(SRC_DIR, 'COMPAS'),       help='COMPAS executable')
+    parser.add_argument('--micro',     default=os.path.join(SRC_DIR, 'COMPAS_BENCH'), help='microbenchmark executable (empty to skip the microbenchmarks)')
+    parser.add_argument('--output',    default='COMPAS_Benchmarks.json',              help='JSON output file')
+    parser.add_argument('--scale',     type=float, default=1.0,                       help='scale factor for the number of systems in each workload')
+    parser.add_argument('--repeat',    type=int,   default=3,                         help='number of runs of each workload (the median wall time is reported)')
+    parser.add_argument('--min-time',  type=float, default=0.25,                      help='microbenchmarks: minimum timed duration per repetition (seconds)')
+    parser.add_argument('--workloads', nargs='*',  default=list(WORKLOADS.keys()),    help='workloads to run (default: all)')
+    args = parser.parse_args()
+
+    unknown = [w for w in args.workloads if w not in WORKLOADS]
+    if unknown: sys.exit('unknown workload(s): ' + ', '.join(unknown))
+    if args.scale <= 0.0 or args.repeat < 1: sys.exit('--scale must be positive and --repeat at least 1')
+
+    results = {
+        'compas_version':   compas_version(),
+        'git_revision':     git_revision(),
+        'timestamp':        time.strftime('%Y-%m-%dT%H:%M:%S%z'),
+        'host':             platform.node(),
+        'cpu':              cpu_model(),
+        'cpu_count':        os.cpu_count(),
+        'compiler_flags':   os.environ.get('COMPAS_BENCH_FLAGS', ''),
+        'scale':            args.scale,
+        'repeat':           args.repeat,
+        'workloads':        [],
+    }
+
+    workdir = tempfile.mkdtemp(prefix='compas_bench_')
+    try:
+        for name in args.workloads:
+            print('Running workload {}...'.format(name), flush=True)
+            results['workloads'].append(run_workload(args.compas, name, args.scale, args.repeat, workdir))
+            w = results['workloads'][-1]
+            print('    {:.3f} s, {:.1f} systems/s, peak RSS {} KiB'.format(w['wall_s'], w['systems_per_s'], w['peak_rss_kb']), flush=True)
+
+        if args.micro:
+            print('Running microbenchmarks...', flush=True)
+            microOutput = os.path.join(workdir, 'micro.json')
+            subprocess.run([args.micro, '--output', microOutput, '--work-dir', workdir, '--min-time', str(args.min_time)], stdout=subprocess.DEVNULL, check=True)
+            with open(microOutput) as f:
+                results['microbenchmarks'] = json.load(f)
+            for r in results['microbenchmarks']['results']:
+                print('    {:45s} {:12.1f} ns/op {:10.1f} allocs/op'.format(r['name'], r['ns_per_op'], r.get('allocs_per_op', 0.0)), flush=True)
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=4)
+    print('Results written to ' + args.output)
+
+
+if __name__ == '__main__':
+    main()
@@ -773,7 +773,243 @@
 //                                      - Removed unnecessary IsPrimary() / BecomePrimary() functionality, fixed incorrect MassTransferTrackerHistory (see issue #605)
 // 02.22.03     IM - Oct 4, 2022    - Defect repair:
 //                                      - Corrected Eddington mass accretion limits, issue #612 (very minor change for WDs and NSs, factor of a few increase for BHs)
+// 02.23.00     FSB - Oct 11, 2022  - Enhancement:
+//                                      - Added in-process adaptive importance sampling (STROOPWAFEL) of the primary mass, mass ratio and semi-major axis, so
+//                                        AIS no longer requires launching COMPAS once per batch and re-reading the output files (see AIS.h for details)
+//                                      - Added program options --adaptive-importance-sampling, --ais-dco-type, --ais-exploratory-fraction, --ais-hubble,
+//                                        --ais-kappa, --ais-pessimistic and --ais-rlof
+//                                      - Added BINARY_PROPERTY::IMPORTANCE_WEIGHT (header "Mixture_Weight") to the default BSE System Parameters file record
+//                                      - Added overloads of utils::SampleInitialMass(), utils::SampleMassRatio() and utils::SampleSemiMajorAxis() that take
+//                                        the uniform deviate as a parameter (inverse transform sampling)
+// 02.24.00     FSB - Oct 14, 2022  - Enhancement:
+//                                      - Added quasi-random (low-discrepancy) sampling of initial conditions: new program options --quasi-random-sequence
+//                                        (NONE, HALTON, SOBOL) and --quasi-random-scramble-seed.  The point used for a system is indexed by the system's
+//                                        random seed, so populations evolved in several runs form a single sequence (see utils::QuasiRandomPoint())
+//                                      - Added uniform deviate overloads of utils::SampleEccentricity(), utils::SampleMetallicity() and utils::SampleOrbitalPeriod()
+//                                      - Added preProcessing/quasiRandomConvergence.py - convergence benchmark on the DCO merger rate
+// 02.25.00     FSB - Oct 18, 2022  - Enhancement:
+//                                      - Added convergence-driven stopping of BSE runs: the rate of the outcome specified by new program option
+//                                        --convergence-outcome (NONE, DCO, BBH, BNS, BHNS) is estimated as binaries are evolved, and the run stops once
+//                                        the relative uncertainty of the estimate is at most --convergence-tolerance (--number-of-systems is then the
+//                                        maximum number of binaries evolved).  See ConvergenceMonitor.h for details.
+//                                      - Added program options --convergence-hubble, --convergence-report-interval and --convergence-weighted
+// 02.26.00     FSB - Oct 20, 2022  - Enhancement:
+//                                      - Added star-forming mass accounting: the total mass of every set of initial conditions drawn (the binaries evolved,
+//                                        initial conditions rejected by the BaseBinaryStar constructor, and single stars) is accumulated per log10(Z) bin
+//                                        and written to new summary table Star_Forming_Mass at the end of the run (see StarFormingMass.h)
+//                                      - Added Log::WriteSummaryTable() - writes a small in-memory table as an HDF5 group, or a CSV/TSV/TXT file
 
-const std::string VERSION_STRING = "02.22.03";
+// 02.27.00     FSB - Oct 24, 2022  - Enhancement:
+//                                      - Added native cosmic integration tool tools/CosmicIntegration.cpp (make target cosmic-integration), a multi-threaded
+//                                        C++ port of FastCosmicIntegration.py that streams BSE_Double_Compact_Objects from the COMPAS HDF5 output file and
+//                                        appends the merger and detection rate matrices to it
+// 02.28.00     FSB - Oct 26, 2022  - Enhancement:
+//                                      - Added histograms (aggregation sinks): new program option --histogram attaches a histogram of a property, binned
+//                                        by property value and log10(Z), to a standard logfile.  The histogram is updated as records for the logfile are
+//                                        produced (optionally filtered), and written as a summary table at the end of the run (see Histogram.h)
+//                                      - Added program option --histograms-only - records are not written to the standard logfiles
+//                                      - Added BINARY_PROPERTY::CHIRP_MASS, BINARY_PROPERTY::DELAY_TIME and BINARY_PROPERTY::MASS_RATIO
+//                                      - DCO formation time is now set before the BSE_Double_Compact_Objects record is printed
+// 02.29.00     FSB - Oct 28, 2022  - Enhancement:
+//                                      - Added standard logfile record filters: new program option --logfile-filter specifies filter terms for a standard
+//                                        logfile, evaluated on the final state of each star or binary.  The records produced for a filtered logfile are
+//                                        staged in memory during evolution, and written only if the final state satisfies all filter terms (see
+//                                        Log::ReleaseStagedRecords())
+// 02.30.00     FSB - Oct 30, 2022  - Enhancement:
+//                                      - Added gzip compressed CSV, TSV, and TXT logfiles: new program options --logfile-compression (NONE or GZIP) and
+//                                        --logfile-compression-block-size.  Records are compressed in blocks on a background thread, each block written
+//                                        (and flushed) as a complete gzip member, so the file is readable up to the last block written (see GzipStream.h)
+// 02.31.00     FSB - Nov 01, 2022  - Enhancement:
+//                                      - Added program option --hdf5-precision: floating-point columns in HDF5 logfiles can be stored as FLOAT (32-bit),
+//                                        or rounded to a number of decimal digits and compressed with the HDF5 scale-offset filter (DIGITS=n), per logfile
+//                                        and per column.  The precision policy is recorded in the dataset attribute "precision"
+//                                      - WriteHDF5_() takes the current size of a dataset from its extent rather than its storage size (which is that of
+//                                        the allocated chunks, in the file datatype, so was wrong for FLOAT and DIGITS=n columns)
+// 02.32.00     FSB - Nov 03, 2022  - Enhancement:
+//                                      - Added BSE detailed output decimation: new program options --detailed-output-tolerance and --detailed-output-interval.
+//                                        Per-timestep records are written only on events (stellar type, RLOF, CE, SN, mass transfer history changes), when
+//                                        a monitored property changes by more than the relative tolerance, or when the interval has passed (see
+//                                        BaseBinaryStar::PrintDetailedOutputDecimated()).  Default is full resolution
+// 02.33.00     FSB - Nov 05, 2022  - Code cleanup:
+//                                      - Per-system drawn option values (kick magnitude random numbers, mean anomalies, phi and theta) are now held in
+//                                        a per-options-set struct (OptionValues::m_Drawn, see DrawnParametersT in typedefs.h), filled directly from the
+//                                        random number generator by SetCalculatedOptionDefaults().  The Boost variables map is no longer modified
+//                                        for these values, and the (unused) BOOST_MAP enum class has been removed.  Random number draw order unchanged
+//                                      - Added Options::DrawnParameters() to retrieve the drawn values for the current system
+// 02.34.00     FSB - Nov 07, 2022  - Enhancement:
+//                                      - Added benchmark suite (make target bench, see docs/benchmarks.md): benchmarks/runBenchmarks.py runs canonical
+//                                        SSE, BSE, RLOF, pulsar and logging workloads, and benchmarks/Benchmarks.cpp (COMPAS_BENCH) times hot kernels
+//                                        (utils::Sample*, CalculateTimestep(), CalculateMassTransferOrbit(), ResolveSupernova(), LogStandardRecord()).
+//                                        Results (systems/s, ns/op, peak RSS) are written as JSON
+// 02.35.00     FSB - Nov 08, 2022  - Enhancement:
+//                                      - Added benchmarks/compareBuilds.py: runs two COMPAS builds with the same options and seed, reports wall time, CPU
+//                                        time and peak RSS side by side, and compares the HDF5/CSV/TSV/TXT logfiles column by column with absolute and
+//                                        relative (and per-column) tolerances, reporting the diverging seeds and their first divergent record
+// 02.36.00     FSB - Nov 09, 2022  - Enhancement:
+//                                      - Added 'lto' (link-time optimisation) and 'pgo' (profile-guided optimisation, trained on the benchmark
+//                                        workloads) build targets to the Makefile - see docs/benchmarks.md
+// 02.37.00     FSB - Nov 10, 2022  - Enhancement:
+//                                      - Star holds its underlying star object in storage inside the Star object (no heap allocation in SwitchTo(),
+//                                        SaveState() and RevertState())
+//                                      - Calls from Star to functions overridden by the stellar phase classes are dispatched on the stellar type,
+//                                        directly to the function of the class (STAR_DISPATCH), so they can be inlined - 'make DISPATCH=virtual'
+//                                        reverts to virtual calls
+//                                      - Added Star::EvolveOneTimestep and stellar phase dispatch microbenchmarks
+// 02.38.00     FSB - Nov 11, 2022  - Enhancement:
+//                                      - Added per-binary memory arenas (Arena.h): BinaryConstituentStars, and DBL_VECTORs and STYPE_VECTORs, created
+//                                        while a binary is constructed or evolved are allocated from the binary's arena, which is released when the
+//                                        binary is destroyed - 'make ARENA=off' disables the arenas
+//                                      - Microbenchmarks report heap allocations per operation; added BaseBinaryStar::Evolve microbenchmark
+// 02.39.00     FSB - Nov 12, 2022  - Enhancement:
+//                                      - BaseStar::CalculateLogBindingEnergyLoveridge(): the closest Loveridge et al. 2011 metallicity is found once, when
+//                                        the star is constructed (m_LoveridgeMetallicity), and the polynomials (eq 5, and the LMR1/LMR2 cutoff, eq 4)
+//                                        are evaluated by Horner's method, with log10(M) and log10(R) calculated once, from dense coefficient arrays
+//                                        built from LOVERIDGE_COEFFICIENTS (see struct LoveridgePolynomial)
+// 02.40.00     FSB - Nov 12, 2022  - Enhancement:
+//                                      - Added program option '--store-input-files-mode' {AUTO, COPY, HARDLINK, REFERENCE, REFLINK}: how the grid file and
+//                                        logfile-definitions file are stored in the output container when --store-input-files is TRUE.  HARDLINK and REFLINK
+//                                        (FICLONE, Linux only) fall back to a copy where not possible, REFERENCE writes the SHA-256 digest and absolute path
+//                                        of the file (sha256sum format) instead of a copy, AUTO tries REFLINK, then HARDLINK, then COPY.  Default is COPY.
+//                                      - Added utils::FileSHA256()
+
+// 02.41.00     FSB - Nov 13, 2022  - Enhancement:
+//                                      - Memory footprint reporting: peak RSS, peak bytes held in HDF5 write buffers (total and for a single dataset),
+//                                        peak number of error catalog entries and peak number of live star objects are recorded in Run_Details
+//                                      - Added program option '--memory-report-interval': write a memory footprint progress line every N systems
+//                                      - Added program option '--memory-budget' (MiB): flush the HDF5 write buffers early when the RSS exceeds the budget
+//                                      - Added utils::ResidentSetSize()
+
+// 02.41.01     FSB - Nov 13, 2022  - Defect repair:
+//                                      - Errors::Clean() iterates the error catalog by reference: it iterated by value, so the object ids of deleted
+//                                        stellar objects were removed from a copy of each entry, and the catalog was never cleaned
+
+// 02.42.00     FSB - Nov 14, 2022  - Enhancement:
+//                                      - LOG/SAY/DBG macros check whether the class and level are enabled before formatting the string.  Log/debug
+//                                        classes are interned to integer ids (Log::ClassId(), once per statement) and enabled classes are held as
+//                                        bitmasks, so the check is a level comparison and a bit test
+//                                      - Log::DoIt() and utils::Equals() take their arguments by reference, and utils::Equals() no longer copies and
+//                                        lowercases the strings
+//                                      - 'make DEBUG=on' builds with the DBG macros; DEBUG_MAX_LEVEL compiles out DBG statements above a debug level
+
+// 02.43.00     FSB - Nov 15, 2022  - Enhancement:
+//                                      - Added program options --pulsar-evolution-sampling and --be-binary-sampling to set the sampling of the
+//                                        per-timestep BSE pulsar evolution and Be binary records: ALL (default, every timestep), EVENTS (only at
+//                                        events), CHANGE (also on a relative change in monitored properties > --logfile-sampling-tolerance), and
+//                                        LOG_TIME (also at steps of --logfile-sampling-log-time-step in log10(time)).  The first record is always
+//                                        written, and a record of the final state is written if records were skipped
+//                                      - Detailed output decimation and the new sampling share the event check and binary state snapshot
+//                                        (DetailedOutputSnapshotT generalised to LogfileSnapshotT)
+
+// 02.44.00     FSB - Nov 15, 2022  - Enhancement:
+//                                      - Added TABULATED remnant mass prescription and kick magnitude distribution: remnant type, mass and natal
+//                                        kick drawn from a user-supplied table (new program option --remnant-table) of black hole probability and
+//                                        NS/BH mass and kick quantiles on a grid of CO core mass, He core mass, metallicity and MT case
+//                                      - Table read once at startup (new RemnantTable singleton); draws interpolate between the bracketing nodes
+//                                        (direct index look-up on uniformly spaced axes) and sample by inverse transform - no rejection loops
+//                                      - Added BaseStar::MassTransferCase() (MT case from the MT donor history, previously computed inline in
+//                                        GiantBranch::CalculateRemnantMassBySchneider2020())
+
+// 02.45.00     FSB - Nov 15, 2022  - Enhancement:
+//                                      - Added truncated Gaussian and truncated log-normal sampling to Rand (Rand::TruncatedGaussianInverseCDF(),
+//                                        Rand::TruncatedLogNormalInverseCDF(), RAND->RandomTruncatedGaussian(), RAND->RandomTruncatedLogNormal()):
+//                                        exact inverse transform, one uniform deviate per sample however far into the tails the bounds are
+//                                      - Replaced the rejection loops that sampled truncated Gaussians with the new sampler: the MULLERMANDEL
+//                                        remnant masses and kicks, the GELLER+2013 and DUQUENNOYMAYOR1991 eccentricities, the DUQUENNOYMAYOR1991
+//                                        mass ratios and semi-major axes (log-normal in period), and the NORMAL pulsar birth spin periods.
+//                                        The distributions are unchanged, but the random numbers drawn differ, so individual systems differ
+//                                      - The MULLERMANDEL kick no longer adjusts the random number when the kick would be negative - the
+//                                        kick is drawn from the truncated distribution, and increases with --kick-magnitude-random
+//                                      - All initial-condition distributions are now sampled by inverse transform, so DUQUENNOYMAYOR1991 and
+//                                        GELLER+2013 use the quasi-random sequence (--quasi-random-sequence), and DUQUENNOYMAYOR1991 can be
+//                                        used with --adaptive-importance-sampling
+
+// 02.46.00     FSB - Nov 15, 2022  - Enhancement:
+//                                      - Added evolution outcomes summary table 'Evolution_Outcomes' (HDF5 group, or file for CSV/TSV/TXT logfiles),
+//                                        written at the end of the run: one row per distinct outcome (evolution status, final stellar type(s),
+//                                        most recent error), with the count and the total, mean and maximum wall time spent evolving the systems
+//                                      - New class EvolutionOutcomes (EvolutionOutcomes.h, EvolutionOutcomes.cpp), owned by the logging service;
+//                                        outcomes recorded with LOGGING->RecordEvolutionOutcome(), written with LOGGING->WriteEvolutionOutcomes()
+//                                        (and by Log::Stop() if not already written)
+//                                      - Added Error() getters to Star and BinaryStar
+
+// 02.46.01     FSB - Nov 16, 2022  - Defect repair:
+//                                      - Log::CheckMemory(): with --memory-budget, the HDF5 write buffers are flushed early only when they hold at least
+//                                        MEMORY_BUDGET_HDF5_FRACTION (0.1) of the budget - the resident set size rarely falls once the buffers are
+//                                        released, so once the budget was exceeded the buffers were flushed after every system
+
+// 02.46.02     FSB - Nov 16, 2022  - Defect repair:
+//                                      - Adaptive importance sampling: initial conditions that cannot make a valid binary (secondary below the minimum
+//                                        mass, touching or RLOF at birth when not allowed) are now rejected by the sampler before a binary is
+//                                        constructed, and the whole draw (including eccentricity and metallicity) repeated. Rejected draws are counted in
+//                                        the star-forming mass summary (N_Rejected) so the estimator divides by all draws.
+//                                      - Added BaseBinaryStar::InitialConditionsOk_Static() and BaseStar::CalculateRadiusAtZAMS_Static() for the check.
+
+// 02.46.03     FSB - Nov 16, 2022  - Defect repair:
+//                                      - Star-forming mass summary: under adaptive importance sampling the mass of each draw (evolved, or rejected by the
+//                                        sampler or the BaseBinaryStar constructor) is also accumulated multiplied by its importance weight, and written
+//                                        as Weighted_Mass_Evolved, Weighted_Mass_Rejected and Weighted_Mass_Drawn. The unweighted totals are the mass of
+//                                        the biased draws, and do not normalise weighted outcome counts.
+
+// 02.46.04     FSB - Nov 16, 2022  - Enhancement:
+//                                      - Added COMPAS_CHECKS (src/benchmarks/SamplingChecks.cpp, 'make checks'): one-sample KS tests of
+//                                        Rand::TruncatedGaussianInverseCDF() and Rand::TruncatedLogNormalInverseCDF() at the MULLERMANDEL remnant mass
+//                                        and kick sites, the DUQUENNOYMAYOR1991 and GELLER_2013 eccentricities, the DUQUENNOYMAYOR1991 mass ratios and
+//                                        periods, and the tail, reflection and exponential tail branches.
+
+// 02.46.05     FSB - Nov 16, 2022  - Defect repair:
+//                                      - BaseBinaryStar copy constructor now points each copied constituent star at its copied companion (they pointed at
+//                                        the source binary's stars, which dangle once the source is deleted).
+
+// 02.46.06     FSB - Nov 16, 2022  - Defect repair:
+//                                      - COMPAS_BENCH (benchmarks/Benchmarks.cpp): EvolveToSupernova() now also finds the supernova when it is triggered
+//                                        by the mass changes of a timestep (ResolveMassChanges()), not only by evolving the stars.
+
+// 02.46.07     FSB - Nov 16, 2022  - Enhancement:
+//                                      - BaseStar::CalculateLoveridgePolynomial_Static() - the nested Horner evaluation of the Loveridge et al. 2011
+//                                        polynomials, factored out of CalculateLogBindingEnergyLoveridge() (no change to results).
+//                                      - COMPAS_BENCH: compares the Horner evaluation with the previous term-by-term sum on a grid of every metallicity
+//                                        and stage (loveridge_comparison in the JSON output), and times both.
+
+// 02.46.08     FSB - Nov 16, 2022  - Documentation:
+//                                      - docs/benchmarks.md: baseline results of the benchmark suite (default and fast builds), with the machine,
+//                                        compiler and flags they were measured with.
+
+// 02.46.09     FSB - Nov 16, 2022  - Defect repair:
+//                                      - BSE Pulsar Evolution and BSE Be Binaries logfiles: the record of the final state, written when records were
+//                                        skipped by --pulsar-evolution-sampling or --be-binary-sampling, is now also written when the stars merge.
+
+// 02.46.10     FSB - Nov 16, 2022  - Defect repair:
+//                                      - Convergence-driven stopping: the outcome rate is now estimated per set of initial conditions drawn - draws rejected
+//                                        by the adaptive importance sampler or the BaseBinaryStar constructor count towards the denominator (as for the
+//                                        star-forming mass and the AIS estimator). Added ConvergenceMonitor::RecordRejected().
+//                                      - The "Not converged" message is not shown in quiet mode (as for the "Converged" message).
+
+// 02.46.11     FSB - Nov 16, 2022  - Code cleanup:
+//                                      - Added BaseBinaryStar::CheckInitialConditions_Static(): the checks of initial conditions (secondary mass, RLOF and
+//                                        touching at birth, with mass equilibration if RLOF at birth is allowed), shared by the BaseBinaryStar
+//                                        constructor (which creates the stars for their radii) and InitialConditionsOk_Static() (which calculates the
+//                                        ZAMS radii without constructing stars). No change to results.
+
+// 02.46.12     FSB - Nov 16, 2022  - Enhancement:
+//                                      - CosmicIntegration (src/tools/CosmicIntegration.cpp): the star forming mass is read from the Star_Forming_Mass
+//                                        summary table (Mass_Drawn, or Weighted_Mass_Drawn for weighted DCOs under adaptive importance sampling), and
+//                                        scaled analytically to the star forming mass in the universe - it was calculated analytically from the number
+//                                        of systems, so did not count draws rejected by COMPAS. Added options --qmin and --qmax (the mass ratio range
+//                                        sampled by COMPAS).
+//                                      - CosmicIntegration reads the system parameters, common envelopes and DCOs a chunk of rows at a time, matching
+//                                        them by SEED as they are read, and appends the per-DCO datasets a block at a time - memory use no longer grows
+//                                        with the number of DCOs or systems.
+
+// 02.46.13     FSB - Nov 16, 2022  - Code cleanup:
+//                                      - Removed Options::DrawnParameters() - it was not used (the per-system drawn values are read by the option
+//                                        accessors, with DRAWN_VALUE).
+
+// 02.46.14     FSB - Nov 16, 2022  - Enhancement:
+//                                      - The evolution outcomes are also written per evolution status, per final stellar type (pair), and per error,
+//                                        to the Evolution_Outcomes_By_Status, Evolution_Outcomes_By_Stellar_Type and Evolution_Outcomes_By_Error
+//                                        summary tables.
+//                                      - compareBuilds.py does not compare the wall time columns of the summary tables.
+
+const std::string VERSION_STRING = "02.46.14";
 
 # endif // __changelog_h__
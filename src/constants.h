@@ -8,12 +8,14 @@
 #include <unordered_map>
 #include <fstream>
 
+#include "Arena.h"
+
 #include <boost/variant.hpp>
 
 
 typedef unsigned long int                                               OBJECT_ID;                  // OBJECT_ID type
 
-typedef std::vector<double>                                             DBL_VECTOR;
+typedef std::vector<double, ArenaAllocator<double>>                     DBL_VECTOR;                 // allocates from the current arena, if any (see Arena.h)
 typedef std::tuple <double, double>                                     DBL_DBL;
 typedef std::tuple <double, double, double>                             DBL_DBL_DBL;
 typedef std::tuple<std::string, std::string, std::string, std::string>  STR_STR_STR_STR;
@@ -268,6 +270,8 @@ constexpr double ABSOLUTE_MINIMUM_TIMESTEP              = 100.0 / SECONDS_IN_MYR
 constexpr double NUCLEAR_MINIMUM_TIMESTEP               = 1.0E-4;                                                   // Minimum time step for nuclear evolution = 100 years expressed in Myr
 
 constexpr int    MAX_BSE_INITIAL_CONDITIONS_ITERATIONS  = 100;                                                      // Maximum loop iterations looking for initial conditions for binary systems
+constexpr int    CONVERGENCE_MINIMUM_HITS               = 10;                                                       // Minimum number of systems with the outcome before a convergence-driven run can stop
+constexpr double STAR_FORMING_MASS_LOG_Z_BIN_WIDTH      = 0.01;                                                     // Width (dex) of the log10(Z) bins for star-forming mass accounting
 constexpr int    MAX_TIMESTEP_RETRIES                   = 30;                                                       // Maximum retries to find a good timestep for stellar evolution
 
 constexpr double MAXIMUM_MASS_LOSS_FRACTION             = 0.01;                                                     // Maximum allowable mass loss - 1.0% (of mass) expressed as a fraction
@@ -299,12 +303,22 @@ enum class LOGFILETYPE: int { NONE, HDF5, CSV, TSV, TXT };
 const LOGFILETYPE DEFAULT_LOGFILE_TYPE                  = LOGFILETYPE::HDF5;                                        // Default logfile type
 const std::string DEFAULT_OUTPUT_CONTAINER_NAME         = "COMPAS_Output";                                          // Default name for output container (directory)
 const std::string DETAILED_OUTPUT_DIRECTORY_NAME        = "Detailed_Output";                                        // Name for detailed output directory within output container
+const std::string EVOLUTION_OUTCOMES_FILE_NAME          = "Evolution_Outcomes";                                     // Name for evolution outcomes summary file within output container
+const std::string EVOLUTION_OUTCOMES_ERROR_FILE_NAME    = "Evolution_Outcomes_By_Error";                            // Name for evolution outcomes per error summary file within output container
+const std::string EVOLUTION_OUTCOMES_STATUS_FILE_NAME   = "Evolution_Outcomes_By_Status";                           // Name for evolution outcomes per evolution status summary file within output container
+const std::string EVOLUTION_OUTCOMES_TYPES_FILE_NAME    = "Evolution_Outcomes_By_Stellar_Type";                     // Name for evolution outcomes per final stellar type (or pair of types) summary file within output container
+const std::string HISTOGRAM_FILE_NAME_PREFIX            = "Histogram_";                                             // Prefix for histogram (aggregation sink) summary file names within output container
 const std::string RUN_DETAILS_FILE_NAME                 = "Run_Details";                                            // Name for run details output file within output container
+const std::string STAR_FORMING_MASS_FILE_NAME           = "Star_Forming_Mass";                                      // Name for star-forming mass summary file within output container
+
+const int         DEFAULT_LOGFILE_COMPRESSION_BLOCK_SIZE = 256;                                                     // Default uncompressed block size for compressed logfiles (KiB)
 
 constexpr int    HDF5_DEFAULT_CHUNK_SIZE                = 100000;                                                   // default HDF5 chunk size (number of dataset entries)
 constexpr int    HDF5_DEFAULT_IO_BUFFER_SIZE            = 1;                                                        // number of HDF5 chunks to buffer for IO (per open dataset)
 constexpr int    HDF5_MINIMUM_CHUNK_SIZE                = 1000;                                                     // minimum HDF5 chunk size (number of dataset entries)
 
+constexpr double MEMORY_BUDGET_HDF5_FRACTION            = 0.1;                                                      // HDF5 write buffers are flushed early only when they hold at least this fraction of --memory-budget
+
 // option constraints
 // Use these constant to specify constraints that should be applied to program option values
 // The values specified here should be checked in Options::OptionValues::CheckAndSetOptions()
@@ -392,9 +406,6 @@ const COMPASUnorderedMap<OBJECT_TYPE, std::string> OBJECT_TYPE_LABEL = {
 // Commandline Status constants
 enum class PROGRAM_STATUS: int { SUCCESS, CONTINUE, STOPPED, ERROR_IN_COMMAND_LINE, LOGGING_FAILED, ERROR_UNHANDLED_EXCEPTION };
 
-// Boost map update options for program options
-enum class BOOST_MAP: int { UPDATE, NO_UPDATE };
-
 // Program options origin indicator (command line or gridfile line)
 enum class OPTIONS_ORIGIN: int { CMDLINE, GRIDFILE };
 
@@ -445,9 +456,13 @@ enum class ERROR: int {
     INVALID_DATA_TYPE,                                              // invalid data type
     INVALID_EDDINGTION_FACTOR,                                      // invalid OPTION value: Eddington Accretion Factor eddingtonAccretionFactor < 0.0
     INVALID_ENVELOPE_TYPE,                                          // invalid envelope type
+    INVALID_HDF5_PRECISION_SPECIFICATION,                           // invalid HDF5 column precision specification
+    INVALID_HISTOGRAM_SPECIFICATION,                                // invalid histogram (aggregation sink) specification
     INVALID_INITIAL_ATTRIBUTES,                                     // initial values of stellar or binary attributes are not valid - can't evolve star or binary
     INVALID_MASS_TRANSFER_DONOR,                                    // mass transfer from NS, BH or Massless Remnant
     INVALID_RADIUS_INCREASE_ONCE,                                   // radius increased when it should have decreased (or at least remained static)
+    INVALID_RECORD_FILTER,                                          // invalid record filter
+    INVALID_REMNANT_TABLE,                                          // invalid remnant table file
     INVALID_TYPE_EDDINGTON_RATE,                                    // invalid stellar type for Eddington critical rate calculation
     INVALID_TYPE_MT_MASS_RATIO,                                     // invalid stellar type for mass ratio calculation
     INVALID_TYPE_MT_THERMAL_TIMESCALE,                              // invalid stellar type for thermal timescale calculation
@@ -575,9 +590,13 @@ const COMPASUnorderedMap<ERROR, std::tuple<ERROR_SCOPE, std::string>> ERROR_CATA
     { ERROR::INVALID_DATA_TYPE,                                     { ERROR_SCOPE::ALWAYS,              "Invalid data type" }},
     { ERROR::INVALID_EDDINGTION_FACTOR,                             { ERROR_SCOPE::ALWAYS,              "Invalid OPTION value: Eddington Accretion Factor eddingtonAccretionFactor < 0.0" }},
     { ERROR::INVALID_ENVELOPE_TYPE,                                 { ERROR_SCOPE::ALWAYS,              "Invalid envelope type" }},
+    { ERROR::INVALID_HDF5_PRECISION_SPECIFICATION,                  { ERROR_SCOPE::ALWAYS,              "Invalid HDF5 precision specification" }},
+    { ERROR::INVALID_HISTOGRAM_SPECIFICATION,                       { ERROR_SCOPE::ALWAYS,              "Invalid histogram specification" }},
     { ERROR::INVALID_INITIAL_ATTRIBUTES,                            { ERROR_SCOPE::ALWAYS,              "Initial attributes are not valid - evolution not possible" }},
     { ERROR::INVALID_MASS_TRANSFER_DONOR,                           { ERROR_SCOPE::ALWAYS,              "Mass transfer from NS, BH, or Massless Remnant" }},
     { ERROR::INVALID_RADIUS_INCREASE_ONCE,                          { ERROR_SCOPE::FIRST_IN_FUNCTION,   "Unexpected Radius increase" }},
+    { ERROR::INVALID_RECORD_FILTER,                                 { ERROR_SCOPE::ALWAYS,              "Invalid record filter" }},
+    { ERROR::INVALID_REMNANT_TABLE,                                 { ERROR_SCOPE::ALWAYS,              "Invalid remnant table" }},
     { ERROR::INVALID_TYPE_EDDINGTON_RATE,                           { ERROR_SCOPE::ALWAYS,              "Invalid stellar type for Eddington critical rate calculation" }},
     { ERROR::INVALID_TYPE_MT_MASS_RATIO,                            { ERROR_SCOPE::ALWAYS,              "Invalid stellar type for mass ratio calculation" }},
     { ERROR::INVALID_TYPE_MT_THERMAL_TIMESCALE,                     { ERROR_SCOPE::ALWAYS,              "Invalid stellar type for thermal timescale calculation" }},
@@ -697,6 +716,23 @@ const COMPASUnorderedMap<EVOLUTION_MODE, std::string> EVOLUTION_MODE_LABEL = {
 
 // user specified distributions, assumptions etc.
 
+// Adaptive Importance Sampling (AIS) target DCO types
+enum class AIS_DCO_TYPE: int { ALL, BBH, BNS, BHNS };
+const COMPASUnorderedMap<AIS_DCO_TYPE, std::string> AIS_DCO_TYPE_LABEL = {
+    { AIS_DCO_TYPE::ALL,  "ALL" },              // any double compact object
+    { AIS_DCO_TYPE::BBH,  "BBH" },              // binary black hole
+    { AIS_DCO_TYPE::BNS,  "BNS" },              // binary neutron star
+    { AIS_DCO_TYPE::BHNS, "BHNS" }              // black hole + neutron star
+};
+
+// Adaptive Importance Sampling (AIS) phases
+enum class AIS_PHASE: int { EXPLORATION, REFINEMENT };
+const COMPASUnorderedMap<AIS_PHASE, std::string> AIS_PHASE_LABEL = {
+    { AIS_PHASE::EXPLORATION, "Exploration" },
+    { AIS_PHASE::REFINEMENT,  "Refinement" }
+};
+
+
 // Black Hole Kick Options
 enum class BLACK_HOLE_KICKS: int { FULL, REDUCED, ZERO, FALLBACK };
 const COMPASUnorderedMap<BLACK_HOLE_KICKS, std::string> BLACK_HOLE_KICKS_LABEL = {
@@ -770,6 +806,17 @@ const COMPASUnorderedMap<CHE_MODE, std::string> CHE_MODE_LABEL = {
 };
 
 
+// Convergence-driven stopping: outcome whose rate is estimated
+enum class CONVERGENCE_OUTCOME: int { NONE, DCO, BBH, BNS, BHNS };
+const COMPASUnorderedMap<CONVERGENCE_OUTCOME, std::string> CONVERGENCE_OUTCOME_LABEL = {
+    { CONVERGENCE_OUTCOME::NONE, "NONE" },
+    { CONVERGENCE_OUTCOME::DCO,  "DCO" },
+    { CONVERGENCE_OUTCOME::BBH,  "BBH" },
+    { CONVERGENCE_OUTCOME::BNS,  "BNS" },
+    { CONVERGENCE_OUTCOME::BHNS, "BHNS" }
+};
+
+
 // Logfile file types
 const COMPASUnorderedMap<LOGFILETYPE, std::string> LOGFILETYPELabel = {     // labels
     { LOGFILETYPE::NONE, "NONE" },
@@ -786,6 +833,28 @@ const COMPASUnorderedMap<LOGFILETYPE, std::string> LOGFILETYPEFileExt = {   // f
 };
 
 
+// HDF5 floating-point column precision (see program option --hdf5-precision)
+enum class HDF5_PRECISION: int { DOUBLE, FLOAT, DIGITS };
+const COMPASUnorderedMap<HDF5_PRECISION, std::string> HDF5_PRECISION_LABEL = {
+    { HDF5_PRECISION::DOUBLE, "DOUBLE" },
+    { HDF5_PRECISION::FLOAT,  "FLOAT" },
+    { HDF5_PRECISION::DIGITS, "DIGITS" }
+};
+
+
+// Logfile compression (CSV, TSV, and TXT logfiles)
+enum class LOGFILE_COMPRESSION: int { NONE, GZIP };
+const COMPASUnorderedMap<LOGFILE_COMPRESSION, std::string> LOGFILE_COMPRESSION_LABEL = {
+    { LOGFILE_COMPRESSION::NONE, "NONE" },
+    { LOGFILE_COMPRESSION::GZIP, "GZIP" }
+};
+
+const COMPASUnorderedMap<LOGFILE_COMPRESSION, std::string> LOGFILE_COMPRESSION_FILE_EXT = {  // file extensions (appended to the logfile type extension)
+    { LOGFILE_COMPRESSION::NONE, "" },
+    { LOGFILE_COMPRESSION::GZIP, "gz" }
+};
+
+
 // Logfile delimiters
 enum class DELIMITER: int { TAB, SPACE, COMMA };
 const COMPASUnorderedMap<DELIMITER, std::string> DELIMITERLabel = {         // labels
@@ -810,6 +879,45 @@ const COMPASUnorderedMap<ADD_OPTIONS_TO_SYSPARMS, std::string> ADD_OPTIONS_TO_SY
     { ADD_OPTIONS_TO_SYSPARMS::NEVER,  "NEVER" }
 };
 
+// How input files (grid file, logfile-definitions file) are stored in the output container
+enum class STORE_INPUT_FILES_MODE: int { AUTO, COPY, HARDLINK, REFERENCE, REFLINK };
+const COMPASUnorderedMap<STORE_INPUT_FILES_MODE, std::string> STORE_INPUT_FILES_MODE_LABEL = {
+    { STORE_INPUT_FILES_MODE::AUTO,      "AUTO" },
+    { STORE_INPUT_FILES_MODE::COPY,      "COPY" },
+    { STORE_INPUT_FILES_MODE::HARDLINK,  "HARDLINK" },
+    { STORE_INPUT_FILES_MODE::REFERENCE, "REFERENCE" },
+    { STORE_INPUT_FILES_MODE::REFLINK,   "REFLINK" }
+};
+
+// Sampling of the per-timestep BSE pulsar evolution and Be binary logfile records (see BaseBinaryStar::SampleLogfileRecord())
+enum class LOGFILE_SAMPLING: int { ALL, CHANGE, EVENTS, LOG_TIME };
+const COMPASUnorderedMap<LOGFILE_SAMPLING, std::string> LOGFILE_SAMPLING_LABEL = {
+    { LOGFILE_SAMPLING::ALL,      "ALL" },
+    { LOGFILE_SAMPLING::CHANGE,   "CHANGE" },
+    { LOGFILE_SAMPLING::EVENTS,   "EVENTS" },
+    { LOGFILE_SAMPLING::LOG_TIME, "LOG_TIME" }
+};
+
+// Histogram (aggregation sink) binning
+enum class HISTOGRAM_BINNING: int { LINEAR, LOG, INTEGER };
+const COMPASUnorderedMap<HISTOGRAM_BINNING, std::string> HISTOGRAM_BINNING_LABEL = {
+    { HISTOGRAM_BINNING::LINEAR,  "LINEAR" },
+    { HISTOGRAM_BINNING::LOG,     "LOG" },
+    { HISTOGRAM_BINNING::INTEGER, "INTEGER" }
+};
+
+// Record filter comparison operators
+// (the order of the labels matters for parsing - two-character operators must be matched first)
+enum class FILTER_OPERATOR: int { EQ, NE, LE, GE, LT, GT };
+const std::vector<std::pair<FILTER_OPERATOR, std::string>> FILTER_OPERATOR_LABEL = {
+    { FILTER_OPERATOR::EQ, "==" },
+    { FILTER_OPERATOR::NE, "!=" },
+    { FILTER_OPERATOR::LE, "<=" },
+    { FILTER_OPERATOR::GE, ">=" },
+    { FILTER_OPERATOR::LT, "<" },
+    { FILTER_OPERATOR::GT, ">" }
+};
+
 
 // Eccentricity distribution
 enum class ECCENTRICITY_DISTRIBUTION: int { ZERO, FLAT, THERMAL, GELLER_2013, DUQUENNOYMAYOR1991, SANA2012 };
@@ -833,7 +941,7 @@ const COMPASUnorderedMap<ENVELOPE, std::string> ENVELOPE_LABEL = {
 
 
 // Kick magnitude distribution
-enum class KICK_MAGNITUDE_DISTRIBUTION: int { ZERO, FIXED, FLAT, MAXWELLIAN, BRAYELDRIDGE, MULLER2016, MULLER2016MAXWELLIAN, MULLERMANDEL};
+enum class KICK_MAGNITUDE_DISTRIBUTION: int { ZERO, FIXED, FLAT, MAXWELLIAN, BRAYELDRIDGE, MULLER2016, MULLER2016MAXWELLIAN, MULLERMANDEL, TABULATED };
 const COMPASUnorderedMap<KICK_MAGNITUDE_DISTRIBUTION, std::string> KICK_MAGNITUDE_DISTRIBUTION_LABEL = {
     { KICK_MAGNITUDE_DISTRIBUTION::ZERO,                 "ZERO" },
     { KICK_MAGNITUDE_DISTRIBUTION::FIXED,                "FIXED" },
@@ -842,7 +950,8 @@ const COMPASUnorderedMap<KICK_MAGNITUDE_DISTRIBUTION, std::string> KICK_MAGNITUD
     { KICK_MAGNITUDE_DISTRIBUTION::BRAYELDRIDGE,         "BRAYELDRIDGE" },
     { KICK_MAGNITUDE_DISTRIBUTION::MULLER2016,           "MULLER2016" },
     { KICK_MAGNITUDE_DISTRIBUTION::MULLER2016MAXWELLIAN, "MULLER2016MAXWELLIAN" },
-    { KICK_MAGNITUDE_DISTRIBUTION::MULLERMANDEL,         "MULLERMANDEL" }
+    { KICK_MAGNITUDE_DISTRIBUTION::MULLERMANDEL,         "MULLERMANDEL" },
+    { KICK_MAGNITUDE_DISTRIBUTION::TABULATED,            "TABULATED" }
 };
 
 
@@ -932,6 +1041,13 @@ const COMPASUnorderedMap<MT_CASE, std::string> MT_CASE_LABEL = {
     { MT_CASE::C,    "Mass Transfer CASE C" },                          // SuperGiant phase
     { MT_CASE::OTHER,"Mass Transfer CASE OTHER: Some combination" }     // default value, or multiple MT events
 };
+const COMPASUnorderedMap<MT_CASE, std::string> MT_CASE_SHORT_LABEL = {     // short labels (e.g. MT_Case column of the remnant table file)
+    { MT_CASE::NONE,  "NONE" },
+    { MT_CASE::A,     "A" },
+    { MT_CASE::B,     "B" },
+    { MT_CASE::C,     "C" },
+    { MT_CASE::OTHER, "OTHER" }
+};
 
 
 // Mass transfer prescriptions
@@ -1038,8 +1154,21 @@ const COMPASUnorderedMap<PULSAR_BIRTH_SPIN_PERIOD_DISTRIBUTION, std::string> PUL
 };
 
 
+// Quasi-random (low-discrepancy) sequences for sampling initial conditions
+enum class QUASI_RANDOM_SEQUENCE: int { NONE, HALTON, SOBOL };
+const COMPASUnorderedMap<QUASI_RANDOM_SEQUENCE, std::string> QUASI_RANDOM_SEQUENCE_LABEL = {
+    { QUASI_RANDOM_SEQUENCE::NONE,   "NONE" },
+    { QUASI_RANDOM_SEQUENCE::HALTON, "HALTON" },
+    { QUASI_RANDOM_SEQUENCE::SOBOL,  "SOBOL" }
+};
+
+// Dimensions of the quasi-random initial conditions vector
+enum class QUASI_RANDOM_DIMENSION: int { MASS_1, MASS_RATIO, SEMI_MAJOR_AXIS, ECCENTRICITY, METALLICITY };
+constexpr int QUASI_RANDOM_DIMENSIONS = 5;                                                                                  // number of dimensions in QUASI_RANDOM_DIMENSION
+
+
 // Remnant Mass Prescriptions
-enum class REMNANT_MASS_PRESCRIPTION: int { HURLEY2000, BELCZYNSKI2002, FRYER2012, MULLER2016, MULLERMANDEL, SCHNEIDER2020, SCHNEIDER2020ALT};
+enum class REMNANT_MASS_PRESCRIPTION: int { HURLEY2000, BELCZYNSKI2002, FRYER2012, MULLER2016, MULLERMANDEL, SCHNEIDER2020, SCHNEIDER2020ALT, TABULATED };
 const COMPASUnorderedMap<REMNANT_MASS_PRESCRIPTION, std::string> REMNANT_MASS_PRESCRIPTION_LABEL = {
     { REMNANT_MASS_PRESCRIPTION::HURLEY2000,           "HURLEY2000" },
     { REMNANT_MASS_PRESCRIPTION::BELCZYNSKI2002,       "BELCZYNSKI2002" },
@@ -1047,7 +1176,8 @@ const COMPASUnorderedMap<REMNANT_MASS_PRESCRIPTION, std::string> REMNANT_MASS_PR
     { REMNANT_MASS_PRESCRIPTION::MULLER2016,           "MULLER2016" },
     { REMNANT_MASS_PRESCRIPTION::MULLERMANDEL,         "MULLERMANDEL" },
     { REMNANT_MASS_PRESCRIPTION::SCHNEIDER2020,        "SCHNEIDER2020" },
-    { REMNANT_MASS_PRESCRIPTION::SCHNEIDER2020ALT ,    "SCHNEIDER2020ALT" }
+    { REMNANT_MASS_PRESCRIPTION::SCHNEIDER2020ALT ,    "SCHNEIDER2020ALT" },
+    { REMNANT_MASS_PRESCRIPTION::TABULATED,            "TABULATED" }
 };
 
 
@@ -1793,9 +1923,11 @@ enum class BINARY_PROPERTY: int {
     BE_BINARY_CURRENT_RANDOM_SEED,
     BE_BINARY_CURRENT_SEMI_MAJOR_AXIS,
     BE_BINARY_CURRENT_TOTAL_TIME,
+    CHIRP_MASS,
     CIRCULARIZATION_TIMESCALE,
     COMMON_ENVELOPE_AT_LEAST_ONCE,
     COMMON_ENVELOPE_EVENT_COUNT,
+    DELAY_TIME,
     DIMENSIONLESS_KICK_MAGNITUDE,
     UNBOUND,
     DOUBLE_CORE_COMMON_ENVELOPE,
@@ -1809,6 +1941,7 @@ enum class BINARY_PROPERTY: int {
     ERROR,
     ID,
     IMMEDIATE_RLOF_POST_COMMON_ENVELOPE,
+    IMPORTANCE_WEIGHT,
     MASS_1_FINAL,
     MASS_1_POST_COMMON_ENVELOPE,
     MASS_1_PRE_COMMON_ENVELOPE,
@@ -1817,6 +1950,7 @@ enum class BINARY_PROPERTY: int {
     MASS_2_PRE_COMMON_ENVELOPE,
     MASS_ENV_1,
     MASS_ENV_2,
+    MASS_RATIO,
     MASSES_EQUILIBRATED,
     MASSES_EQUILIBRATED_AT_BIRTH,
     MASS_TRANSFER_TRACKER_HISTORY,
@@ -1918,9 +2052,11 @@ const COMPASUnorderedMap<BINARY_PROPERTY, std::string> BINARY_PROPERTY_LABEL = {
     { BINARY_PROPERTY::BE_BINARY_CURRENT_RANDOM_SEED,                      "BE_BINARY_CURRENT_RANDOM_SEED" },
     { BINARY_PROPERTY::BE_BINARY_CURRENT_SEMI_MAJOR_AXIS,                  "BE_BINARY_CURRENT_SEMI_MAJOR_AXIS" },
     { BINARY_PROPERTY::BE_BINARY_CURRENT_TOTAL_TIME,                       "BE_BINARY_CURRENT_TOTAL_TIME" },
+    { BINARY_PROPERTY::CHIRP_MASS,                                         "CHIRP_MASS" },
     { BINARY_PROPERTY::CIRCULARIZATION_TIMESCALE,                          "CIRCULARIZATION_TIMESCALE" },
     { BINARY_PROPERTY::COMMON_ENVELOPE_AT_LEAST_ONCE,                      "COMMON_ENVELOPE_AT_LEAST_ONCE" },
     { BINARY_PROPERTY::COMMON_ENVELOPE_EVENT_COUNT,                        "COMMON_ENVELOPE_EVENT_COUNT" },
+    { BINARY_PROPERTY::DELAY_TIME,                                         "DELAY_TIME" },
     { BINARY_PROPERTY::DIMENSIONLESS_KICK_MAGNITUDE,                       "DIMENSIONLESS_KICK_MAGNITUDE" },
     { BINARY_PROPERTY::UNBOUND,                                            "UNBOUND" },
     { BINARY_PROPERTY::DOUBLE_CORE_COMMON_ENVELOPE,                        "DOUBLE_CORE_COMMON_ENVELOPE" },
@@ -1934,6 +2070,7 @@ const COMPASUnorderedMap<BINARY_PROPERTY, std::string> BINARY_PROPERTY_LABEL = {
     { BINARY_PROPERTY::ERROR,                                              "ERROR" },
     { BINARY_PROPERTY::ID,                                                 "ID" },
     { BINARY_PROPERTY::IMMEDIATE_RLOF_POST_COMMON_ENVELOPE,                "IMMEDIATE_RLOF_POST_COMMON_ENVELOPE" },
+    { BINARY_PROPERTY::IMPORTANCE_WEIGHT,                                  "IMPORTANCE_WEIGHT" },
     { BINARY_PROPERTY::MASS_1_FINAL,                                       "MASS_1_FINAL" },
     { BINARY_PROPERTY::MASS_1_POST_COMMON_ENVELOPE,                        "MASS_1_POST_COMMON_ENVELOPE" },
     { BINARY_PROPERTY::MASS_1_PRE_COMMON_ENVELOPE,                         "MASS_1_PRE_COMMON_ENVELOPE" },
@@ -1942,6 +2079,7 @@ const COMPASUnorderedMap<BINARY_PROPERTY, std::string> BINARY_PROPERTY_LABEL = {
     { BINARY_PROPERTY::MASS_2_PRE_COMMON_ENVELOPE,                         "MASS_2_PRE_COMMON_ENVELOPE" },
     { BINARY_PROPERTY::MASS_ENV_1,                                         "MASS_ENV_1" },
     { BINARY_PROPERTY::MASS_ENV_2,                                         "MASS_ENV_2" },
+    { BINARY_PROPERTY::MASS_RATIO,                                         "MASS_RATIO" },
     { BINARY_PROPERTY::MASSES_EQUILIBRATED,                                "MASSES_EQUILIBRATED" },
     { BINARY_PROPERTY::MASSES_EQUILIBRATED_AT_BIRTH,                       "MASSES_EQUILIBRATED_AT_BIRTH" },
     { BINARY_PROPERTY::MASS_TRANSFER_TRACKER_HISTORY,                      "MASS_TRANSFER_TRACKER_HISTORY" },
@@ -2619,9 +2757,11 @@ const std::map<BINARY_PROPERTY, PROPERTY_DETAILS> BINARY_PROPERTY_DETAIL = {
     { BINARY_PROPERTY::BE_BINARY_CURRENT_RANDOM_SEED,                       { TYPENAME::ULONGINT,       "SEED",                 "-",                12, 1 }},
     { BINARY_PROPERTY::BE_BINARY_CURRENT_SEMI_MAJOR_AXIS,                   { TYPENAME::DOUBLE,         "SemiMajorAxis",        "Rsol",             14, 6 }},
     { BINARY_PROPERTY::BE_BINARY_CURRENT_TOTAL_TIME,                        { TYPENAME::DOUBLE,         "Total_Time",           "Myr",              16, 8 }},
+    { BINARY_PROPERTY::CHIRP_MASS,                                          { TYPENAME::DOUBLE,         "Chirp_Mass",           "Msol",             14, 6 }},
     { BINARY_PROPERTY::CIRCULARIZATION_TIMESCALE,                           { TYPENAME::DOUBLE,         "Tau_Circ",             "Myr",              16, 8 }},
     { BINARY_PROPERTY::COMMON_ENVELOPE_AT_LEAST_ONCE,                       { TYPENAME::BOOL,           "CEE",                  "Event",             0, 0 }},
     { BINARY_PROPERTY::COMMON_ENVELOPE_EVENT_COUNT,                         { TYPENAME::UINT,           "CE_Event_Count",       "Count",             6, 1 }},
+    { BINARY_PROPERTY::DELAY_TIME,                                          { TYPENAME::DOUBLE,         "Delay_Time",           "Myr",              16, 8 }},
     { BINARY_PROPERTY::DIMENSIONLESS_KICK_MAGNITUDE,                        { TYPENAME::DOUBLE,         "Kick_Magnitude(uK)",   "-",                14, 6 }},
     { BINARY_PROPERTY::DOUBLE_CORE_COMMON_ENVELOPE,                         { TYPENAME::BOOL,           "Double_Core_CE",       "Event",             0, 0 }},
     { BINARY_PROPERTY::DT,                                                  { TYPENAME::DOUBLE,         "dT",                   "Myr",              16, 8 }},
@@ -2634,6 +2774,7 @@ const std::map<BINARY_PROPERTY, PROPERTY_DETAILS> BINARY_PROPERTY_DETAIL = {
     { BINARY_PROPERTY::ERROR,                                               { TYPENAME::ERROR,          "Error",                "-",                 4, 1 }},
     { BINARY_PROPERTY::ID,                                                  { TYPENAME::OBJECT_ID,      "ID",                   "-",                12, 1 }},
     { BINARY_PROPERTY::IMMEDIATE_RLOF_POST_COMMON_ENVELOPE,                 { TYPENAME::BOOL,           "Immediate_RLOF>CE",    "Event",             0, 0 }},
+    { BINARY_PROPERTY::IMPORTANCE_WEIGHT,                                   { TYPENAME::DOUBLE,         "Mixture_Weight",       "-",                14, 6 }},
     { BINARY_PROPERTY::MASS_1_FINAL,                                        { TYPENAME::DOUBLE,         "Core_Mass(1)",         "Msol",             14, 6 }},
     { BINARY_PROPERTY::MASS_1_POST_COMMON_ENVELOPE,                         { TYPENAME::DOUBLE,         "Mass(1)>CE",           "Msol",             14, 6 }},
     { BINARY_PROPERTY::MASS_1_PRE_COMMON_ENVELOPE,                          { TYPENAME::DOUBLE,         "Mass(1)<CE",           "Msol",             14, 6 }},
@@ -2642,6 +2783,7 @@ const std::map<BINARY_PROPERTY, PROPERTY_DETAILS> BINARY_PROPERTY_DETAIL = {
     { BINARY_PROPERTY::MASS_2_PRE_COMMON_ENVELOPE,                          { TYPENAME::DOUBLE,         "Mass(2)<CE",           "Msol",             14, 6 }},
     { BINARY_PROPERTY::MASS_ENV_1,                                          { TYPENAME::DOUBLE,         "Mass_Env(1)",          "Msol",             14, 6 }},
     { BINARY_PROPERTY::MASS_ENV_2,                                          { TYPENAME::DOUBLE,         "Mass_Env(2)",          "Msol",             14, 6 }},
+    { BINARY_PROPERTY::MASS_RATIO,                                          { TYPENAME::DOUBLE,         "q",                    "-",                14, 6 }},
     { BINARY_PROPERTY::MASSES_EQUILIBRATED,                                 { TYPENAME::BOOL,           "Equilibrated",         "Event",             0, 0 }},
     { BINARY_PROPERTY::MASSES_EQUILIBRATED_AT_BIRTH,                        { TYPENAME::BOOL,           "Equilibrated_At_Birth","Event",             0, 0 }},
     { BINARY_PROPERTY::MASS_TRANSFER_TRACKER_HISTORY,                       { TYPENAME::MT_TRACKING,    "MT_History",           "-",                 4, 1 }},
@@ -2945,6 +3087,12 @@ enum class RUN_DETAILS_COLUMNS: int { COMPAS_VERSION,
                                       CLOCK_TIME,
                                       WALL_TIME,
                                       ACTUAL_RANDOM_SEED,
+                                      PEAK_RSS,
+                                      PEAK_HDF5_BUFFERED,
+                                      PEAK_HDF5_DATASET_BUFFERED,
+                                      PEAK_ERROR_CATALOG_ENTRIES,
+                                      PEAK_LIVE_STARS,
+                                      MEMORY_BUDGET_FLUSHES,
                                       SENTINEL };
 
 const COMPASUnorderedMap<RUN_DETAILS_COLUMNS, std::tuple<std::string, TYPENAME, std::size_t>> RUN_DETAILS_DETAIL = {
@@ -2955,7 +3103,13 @@ const COMPASUnorderedMap<RUN_DETAILS_COLUMNS, std::tuple<std::string, TYPENAME,
     { RUN_DETAILS_COLUMNS::OBJECTS_CREATED,     { "Objects-Created",               TYPENAME::INT,       0 }},
     { RUN_DETAILS_COLUMNS::CLOCK_TIME,          { "Clock-Time",                    TYPENAME::DOUBLE,    0 }},
     { RUN_DETAILS_COLUMNS::WALL_TIME,           { "Wall-Time",                     TYPENAME::STRING,   10 }},
-    { RUN_DETAILS_COLUMNS::ACTUAL_RANDOM_SEED,  { "Actual-Random-Seed",            TYPENAME::ULONGINT,  0 }}
+    { RUN_DETAILS_COLUMNS::ACTUAL_RANDOM_SEED,  { "Actual-Random-Seed",            TYPENAME::ULONGINT,  0 }},
+    { RUN_DETAILS_COLUMNS::PEAK_RSS,            { "Peak-RSS",                      TYPENAME::ULONGINT,  0 }},
+    { RUN_DETAILS_COLUMNS::PEAK_HDF5_BUFFERED,  { "Peak-HDF5-Buffered",            TYPENAME::ULONGINT,  0 }},
+    { RUN_DETAILS_COLUMNS::PEAK_HDF5_DATASET_BUFFERED, { "Peak-HDF5-Dataset-Buffered", TYPENAME::ULONGINT, 0 }},
+    { RUN_DETAILS_COLUMNS::PEAK_ERROR_CATALOG_ENTRIES, { "Peak-Error-Catalog-Entries", TYPENAME::ULONGINT, 0 }},
+    { RUN_DETAILS_COLUMNS::PEAK_LIVE_STARS,     { "Peak-Live-Stars",               TYPENAME::ULONGINT,  0 }},
+    { RUN_DETAILS_COLUMNS::MEMORY_BUDGET_FLUSHES, { "Memory-Budget-Flushes",       TYPENAME::INT,       0 }}
 };
 
 
@@ -3287,6 +3441,7 @@ const ANY_PROPERTY_VECTOR BSE_SYSTEM_PARAMETERS_REC = {
     STAR_2_PROPERTY::MZAMS,
     BINARY_PROPERTY::SEMI_MAJOR_AXIS_INITIAL,
     BINARY_PROPERTY::ECCENTRICITY_INITIAL,
+    BINARY_PROPERTY::IMPORTANCE_WEIGHT,
     STAR_1_PROPERTY::SUPERNOVA_KICK_MAGNITUDE_RANDOM_NUMBER,
     STAR_1_PROPERTY::SUPERNOVA_THETA,
     STAR_1_PROPERTY::SUPERNOVA_PHI,
@@ -3797,6 +3952,19 @@ struct LoveridgeCoefficients {
     double alpha_mr;
 };
 
+// struct LoveridgePolynomial
+// The coefficients alpha(m,r) of Loveridge et al. 2011, eq 5 for one metallicity and evolutionary stage, as a dense
+// (mHigh - mLow + 1) x (rHigh - rLow + 1) array - alpha[(m - mLow) * (rHigh - rLow + 1) + (r - rLow)] = alpha(m,r), 0 for
+// terms not in the table - so the polynomial can be evaluated by nested Horner's method (some exponents r are negative,
+// so the lowest powers are factored out).  Built from LOVERIDGE_COEFFICIENTS (see BaseStar::LoveridgePolynomials_Static())
+struct LoveridgePolynomial {
+    int                 mLow;
+    int                 mHigh;
+    int                 rLow;
+    int                 rHigh;
+    std::vector<double> alpha;
+};
+
 
 // enum class LOVERIDGE_METALLICITY
 // Symbolic names for metallicities described in Loveridge et al., 2011
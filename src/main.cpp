@@ -24,6 +24,10 @@
 
 #include "Star.h"
 #include "BinaryStar.h"
+#include "AIS.h"
+#include "ConvergenceMonitor.h"
+#include "StarFormingMass.h"
+#include "RemnantTable.h"
 
 OBJECT_ID globalObjectId = 1;                                   // used to uniquely identify objects - used primarily for error printing
 OBJECT_ID m_ObjectId     = 0;                                   // object id for main - always 0
@@ -119,6 +123,8 @@ std::tuple<int, int> EvolveSingleStars() {
     bool   usingGrid = !OPTIONS->GridFilename().empty();                                                            // using grid file?
     size_t index     = 0;                                                                                           // which star
 
+    StarFormingMass starFormingMass;                                                                                // star-forming mass accounting
+
     // The options specified by the user at the commandline are set to their initial values.
     // OPTIONS->AdvanceCmdLineOptionValues(), called at the end of the loop, advances the
     // options specified by the user at the commandline to their next variation (if necessary,
@@ -226,12 +232,25 @@ std::tuple<int, int> EvolveSingleStars() {
                     // their own mass).  Here we use the mass supplied by the user via the program options or, 
                     // if no mass was supplied by the user, sample the mass from the IMF.
 
+                    // if the user specified a quasi-random sequence, the mass and metallicity are sampled
+                    // using the point of the sequence indexed by the random seed of the star
+
+                    DBL_VECTOR quasiRandom = OPTIONS->QuasiRandomSequence() == QUASI_RANDOM_SEQUENCE::NONE         // quasi-random sequence specified?
+                                                ? DBL_VECTOR()                                                      // no
+                                                : utils::QuasiRandomPoint(OPTIONS->QuasiRandomSequence(), randomSeed, OPTIONS->QuasiRandomScrambleSeed()); // yes - point for this star
+
                     double initialMass = OPTIONS->OptionSpecified("initial-mass") == 1                              // user specified mass?
                                             ? OPTIONS->InitialMass()                                                // yes, use it
-                                            : utils::SampleInitialMass(OPTIONS->InitialMassFunction(),              // no, sample it
-                                                                       OPTIONS->InitialMassFunctionMax(), 
-                                                                       OPTIONS->InitialMassFunctionMin(), 
-                                                                       OPTIONS->InitialMassFunctionPower());
+                                            : quasiRandom.empty()                                                   // no, sample it
+                                                ? utils::SampleInitialMass(OPTIONS->InitialMassFunction(),
+                                                                           OPTIONS->InitialMassFunctionMax(), 
+                                                                           OPTIONS->InitialMassFunctionMin(), 
+                                                                           OPTIONS->InitialMassFunctionPower())
+                                                : utils::SampleInitialMass(OPTIONS->InitialMassFunction(),
+                                                                           OPTIONS->InitialMassFunctionMax(), 
+                                                                           OPTIONS->InitialMassFunctionMin(), 
+                                                                           OPTIONS->InitialMassFunctionPower(),
+                                                                           quasiRandom[static_cast<int>(QUASI_RANDOM_DIMENSION::MASS_1)]);
 
                     // the metallicity of the star is supplied - this is to allow binary stars to initialise
                     // the metallicity of their constituent stars (rather than have the constituent stars sample 
@@ -240,9 +259,14 @@ std::tuple<int, int> EvolveSingleStars() {
 
                     double metallicity = OPTIONS->OptionSpecified("metallicity") == 1                               // user specified metallicity?
                                             ? OPTIONS->Metallicity()                                                // yes, use it
-                                            : utils::SampleMetallicity(OPTIONS->MetallicityDistribution(), 
-                                                                       OPTIONS->MetallicityDistributionMax(), 
-                                                                       OPTIONS->MetallicityDistributionMin());      // no, sample it
+                                            : quasiRandom.empty()                                                   // no, sample it
+                                                ? utils::SampleMetallicity(OPTIONS->MetallicityDistribution(), 
+                                                                           OPTIONS->MetallicityDistributionMax(), 
+                                                                           OPTIONS->MetallicityDistributionMin())
+                                                : utils::SampleMetallicity(OPTIONS->MetallicityDistribution(), 
+                                                                           OPTIONS->MetallicityDistributionMax(), 
+                                                                           OPTIONS->MetallicityDistributionMin(),
+                                                                           quasiRandom[static_cast<int>(QUASI_RANDOM_DIMENSION::METALLICITY)]);
 
 
 
@@ -272,7 +296,13 @@ std::tuple<int, int> EvolveSingleStars() {
                         ? new Star(randomSeed, initialMass, metallicity, kickParameters, OPTIONS->RotationalFrequency() * SECONDS_IN_YEAR) // yes - use it (convert from Hz to cycles per year - see BaseStar::CalculateZAMSAngularFrequency())
                         : new Star(randomSeed, initialMass, metallicity, kickParameters);                           // no - let it be calculated
 
+                    starFormingMass.Record(initialMass, star->Metallicity(), true, 1.0);                               // record star-forming mass
+
+                    auto starWallStart = std::chrono::system_clock::now();                                          // start wall timer for star
                     EVOLUTION_STATUS thisStatus = star->Evolve(index);                                              // evolve the star
+                    std::chrono::duration<double> starWallSeconds = std::chrono::system_clock::now() - starWallStart; // elapsed seconds
+
+                    LOGGING->RecordEvolutionOutcome(thisStatus, star->StellarType(), STELLAR_TYPE::NONE, star->Error(), starWallSeconds.count()); // record outcome for evolution outcomes summary
 
                     if (!OPTIONS->Quiet()) {                                                                        // quiet mode?
                         SAY(index                                   <<                                              // announce result of evolving the star
@@ -295,6 +325,8 @@ std::tuple<int, int> EvolveSingleStars() {
 
                     ERRORS->Clean();                                                                                // clean the dynamic error catalog
 
+                    LOGGING->CheckMemory();                                                                         // memory footprint
+
                     index++;                                                                                        // next...
 
                     if (usingGrid) {                                                                                // using grid file?
@@ -342,6 +374,15 @@ std::tuple<int, int> EvolveSingleStars() {
         }
     }
 
+    // write star-forming mass summary
+    if (!starFormingMass.Write()) SHOW_WARN(ERROR::FILE_WRITE_ERROR, "Star-forming mass summary not written");
+
+    // write histograms
+    if (!LOGGING->WriteHistograms()) SHOW_WARN(ERROR::FILE_WRITE_ERROR, "Histograms not written");
+
+    // write evolution outcomes summary
+    if (!LOGGING->WriteEvolutionOutcomes()) SHOW_WARN(ERROR::FILE_WRITE_ERROR, "Evolution outcomes summary not written");
+
     // close SSE logfiles
     // don't check result here - let log system handle it
     (void)LOGGING->CloseAllStandardFiles();                                                                         // close any standard log files
@@ -393,6 +434,10 @@ std::tuple<int, int> EvolveBinaryStars() {
     bool        usingGrid = !OPTIONS->GridFilename().empty();                                                   // using grid file?
     size_t      index     = 0;                                                                                  // which binary
 
+    AIS                ais;                                                                                     // adaptive importance sampling (only used if requested)
+    ConvergenceMonitor convergence;                                                                             // convergence-driven stopping (only used if requested)
+    StarFormingMass    starFormingMass;                                                                         // star-forming mass accounting
+
     // The options specified by the user at the commandline are set to their initial values.
     // OPTIONS->AdvanceCmdLineOptionValues(), called at the end of the loop, advances the
     // options specified by the user at the commandline to their next variation (if necessary,
@@ -502,6 +547,26 @@ std::tuple<int, int> EvolveBinaryStars() {
                     }
                 }
 
+                // if adaptive importance sampling is being used, the initial conditions drawn for the
+                // binary are applied as though they had been read from a grid file record (AIS cannot
+                // be used with a grid file), and the binary carries the importance weight of the draw.
+                // Draws that cannot make a valid binary are rejected by the sampler, and only counted
+                // towards the star-forming mass
+
+                double importanceWeight = 1.0;                                                                  // importance sampling weight of the binary
+                if (evolutionStatus == EVOLUTION_STATUS::CONTINUE && OPTIONS->AdaptiveImportanceSampling()) {   // ok, and adaptive importance sampling?
+                    std::string aisOptions;                                                                     // yes - draw initial conditions
+                    std::tie(aisOptions, importanceWeight) = ais.DrawSample();
+                    for (auto& draw : ais.RejectedDraws()) {                                                    // record star-forming mass of draws rejected by the sampler
+                        starFormingMass.Record(draw.mass, draw.metallicity, draw.accepted, draw.weight);
+                    }
+                    if (convergence.Enabled()) convergence.RecordRejected(ais.RejectedDraws().size());         // rejected draws count towards the rate denominator
+                    if (!OPTIONS->InitialiseEvolvingObject(aisOptions)) {                                       // apply the initial conditions - ok?
+                        SHOW_ERROR(ERROR::ERROR_PROCESSING_GRIDLINE_OPTIONS, "Applying AIS sample");            // no - show error
+                        evolutionStatus = EVOLUTION_STATUS::STOPPED;                                            // and stop evolution
+                    }
+                }
+
                 if (evolutionStatus == EVOLUTION_STATUS::CONTINUE) {                                            // ok?
                                                                                                                 // yes - continue
                     randomSeed = RAND->CurrentSeed();                                                           // current random seed - to pass to binary object
@@ -510,10 +575,21 @@ std::tuple<int, int> EvolveBinaryStars() {
                     delete binary; binary = nullptr;                                                            // so we don't leak
                     binary = new BinaryStar(randomSeed, thisId);                                                // generate binary according to the user options
 
+                    binary->SetImportanceWeight(importanceWeight);                                              // record importance weight (for BSE System Parameters file and star-forming mass)
+
+                    starFormingMass.Record(binary);                                                             // record star-forming mass (including rejected draws)
+
                     evolvingBinaryStar      = binary;                                                           // set global pointer to evolving binary (for BSE Switch Log)
                     evolvingBinaryStarValid = true;                                                             // indicate that the global pointer is now valid (for BSE Switch Log)
 
+                    auto binaryWallStart = std::chrono::system_clock::now();                                    // start wall timer for binary
                     EVOLUTION_STATUS binaryStatus = binary->Evolve();                                           // evolve the binary
+                    std::chrono::duration<double> binaryWallSeconds = std::chrono::system_clock::now() - binaryWallStart; // elapsed seconds
+
+                    LOGGING->RecordEvolutionOutcome(binaryStatus, binary->Star1Type(), binary->Star2Type(), binary->Error(), binaryWallSeconds.count()); // record outcome for evolution outcomes summary
+
+                    if (OPTIONS->AdaptiveImportanceSampling()) ais.RecordOutcome(ais.IsHit(binary));           // record outcome for adaptive importance sampling
+                    if (convergence.Enabled()) convergence.Record(binary);                                      // record outcome for convergence-driven stopping
 
                     if (binaryStatus == EVOLUTION_STATUS::ERROR || binaryStatus == EVOLUTION_STATUS::SSE_ERROR) { // ok?
                         SHOW_ERROR(ERROR::BINARY_EVOLUTION_STOPPED, EVOLUTION_STATUS_LABEL.at(binaryStatus));   // no - show error
@@ -547,6 +623,8 @@ std::tuple<int, int> EvolveBinaryStars() {
 
                     ERRORS->Clean();                                                                            // clean the dynamic error catalog
 
+                    LOGGING->CheckMemory();                                                                     // memory footprint
+
                     if (usingGrid) {                                                                            // using grid file?
                         gridLineVariation++;                                                                    // yes - increment grid line variation number
                         int optionsStatus = OPTIONS->AdvanceGridLineOptionValues();                             // apply next grid file options (ranges/sets)
@@ -561,6 +639,17 @@ std::tuple<int, int> EvolveBinaryStars() {
                     else doneGridLine = true;                                                                   // not using grid file - done
 
                     if (doneGridLine) index = thisId + 1;                                                       // increment index
+
+                    if (convergence.Enabled() && evolutionStatus == EVOLUTION_STATUS::CONTINUE) {               // convergence-driven stopping?
+                        int reportInterval = OPTIONS->ConvergenceReportInterval();                              // yes
+                        if (!OPTIONS->Quiet() && reportInterval > 0 && convergence.nSystems() % (size_t)reportInterval == 0) {
+                            SAY("\nConvergence: " << convergence.Summary() << "\n");                          // progress report
+                        }
+                        if (convergence.Converged()) {                                                          // converged?
+                            if (!OPTIONS->Quiet()) SAY("\nConverged: " << convergence.Summary());               // yes - announce (unless in quiet mode)
+                            evolutionStatus = EVOLUTION_STATUS::DONE;                                           // and we're done
+                        }
+                    }
                 }
             }
         }
@@ -580,6 +669,10 @@ std::tuple<int, int> EvolveBinaryStars() {
         }
     }
     
+    if (convergence.Enabled() && !convergence.Converged()) {                                                    // convergence-driven stopping, but not converged?
+        if (!OPTIONS->Quiet()) SAY("\nNot converged: " << convergence.Summary());                               // announce final estimate (unless in quiet mode)
+    }
+
     int nBinariesRequested = evolutionStatus == EVOLUTION_STATUS::DONE ? index : -1;
 
     SAY("\nGenerated " << std::to_string(index) << " of " << (nBinariesRequested < 0 ? "<INCOMPLETE GRID>" : std::to_string(nBinariesRequested)) << " binaries requested");
@@ -594,6 +687,15 @@ std::tuple<int, int> EvolveBinaryStars() {
         }
     }
 
+    // write star-forming mass summary
+    if (!starFormingMass.Write()) SHOW_WARN(ERROR::FILE_WRITE_ERROR, "Star-forming mass summary not written");
+
+    // write histograms
+    if (!LOGGING->WriteHistograms()) SHOW_WARN(ERROR::FILE_WRITE_ERROR, "Histograms not written");
+
+    // write evolution outcomes summary
+    if (!LOGGING->WriteEvolutionOutcomes()) SHOW_WARN(ERROR::FILE_WRITE_ERROR, "Evolution outcomes summary not written");
+
     // close BSE logfiles
     // don't check result here - let log system handle it
 
@@ -685,6 +787,30 @@ int main(int argc, char * argv[]) {
                     }
                 }
 
+                if (programStatus == PROGRAM_STATUS::CONTINUE) {                                    // all ok?
+
+                    bool tabulatedMasses = OPTIONS->RemnantMassPrescription()   == REMNANT_MASS_PRESCRIPTION::TABULATED;
+                    bool tabulatedKicks  = OPTIONS->KickMagnitudeDistribution() == KICK_MAGNITUDE_DISTRIBUTION::TABULATED;
+
+                    ERROR       error = ERROR::NONE;
+                    std::string errorInfo;
+                    if (!OPTIONS->RemnantTableFilename().empty()) {                                 // have remnant table filename?
+                        std::tie(error, errorInfo) = REMNANT_TABLE->Load(OPTIONS->RemnantTableFilename()); // yes - read remnant table
+                        if (error == ERROR::NONE) {                                                 // read ok?
+                            if      (tabulatedMasses && !REMNANT_TABLE->HasMasses()) { error = ERROR::INVALID_REMNANT_TABLE; errorInfo = "no remnant masses tabulated"; }
+                            else if (tabulatedKicks  && !REMNANT_TABLE->HasKicks())  { error = ERROR::INVALID_REMNANT_TABLE; errorInfo = "no kicks tabulated"; }
+                        }
+                    }
+                    else if (tabulatedMasses || tabulatedKicks) {                                   // TABULATED prescription without a table
+                        error = ERROR::EMPTY_FILENAME;
+                    }
+
+                    if (error != ERROR::NONE) {                                                     // remnant table ok?
+                        SHOW_ERROR(error, "Reading remnant table '" + OPTIONS->RemnantTableFilename() + "'" + (errorInfo.empty() ? "" : ": " + errorInfo)); // no - show error
+                        programStatus = PROGRAM_STATUS::STOPPED;                                    // set status
+                    }
+                }
+
                 int objectsRequested = 0;                                                           // for logging
                 int objectsCreated   = 0;                                                           // for logging
 
@@ -0,0 +1,1464 @@
+/*
+ * CosmicIntegration - native, multi-threaded cosmic integration of COMPAS BSE output
+ *
+ * This is a port of postProcessing/Folders/CosmicIntegration/PythonScripts/FastCosmicIntegration.py
+ * (Neijssel et al. 2019, Broekgaarden et al. 2021).  It reads the double compact objects from a
+ * COMPAS HDF5 output file, weights them by the metallicity-specific star formation rate density
+ * (MSSFR), and calculates, for each DCO, the merger rate and the detection rate as a function of
+ * redshift.  The rates are appended to the COMPAS HDF5 output file in the same group, with the same
+ * datasets, as FastCosmicIntegration.py writes:
+ *
+ *     Rates_mu0<mu0>_muz<muz>_alpha<alpha>_sigma0<sigma0>_sigmaz<sigmaz>/
+ *         SEED                     SEED of each DCO selected by the mask
+ *         DCOmask                  Mask of the selected DCOs in BSE_Double_Compact_Objects
+ *         redshifts                Redshifts at which the rates are calculated
+ *         merger_rate              Merger rate [Gpc^-3 yr^-1], per DCO, up to redshift --maxzdet
+ *         merger_rate_z0           Merger rate [Gpc^-3 yr^-1], per DCO, at redshift 0
+ *         detection_rate<sens>     Detection rate [yr^-1], per DCO, up to redshift --maxzdet
+ *
+ * and also the rates summed over the selected DCOs, as a function of redshift:
+ *
+ *         formation_rate_total     Formation rate of the DCOs [Gpc^-3 yr^-1]
+ *         merger_rate_total        Merger rate of the DCOs [Gpc^-3 yr^-1]
+ *         detection_rate<sens>_total   Detection rate of the DCOs [yr^-1], up to redshift --maxzdet
+ *
+ * The input datasets are read a chunk of rows at a time (see ColumnReader), and the DCOs are processed
+ * in blocks of --block-size, each block shared between --threads worker threads.  Each block of rate
+ * matrix rows is appended to the output file before the next block is processed, so memory use does not
+ * grow with the number of DCOs or systems.  The per-redshift kernels are written as simple loops over
+ * contiguous arrays so that the compiler can vectorise them.
+ *
+ * The command line options are those of FastCosmicIntegration.py (so the tool can be used in its place),
+ * plus --threads, --block-size, --snr-grid, --theta-seed, --qmin and --qmax.
+ *
+ * Differences from FastCosmicIntegration.py:
+ *
+ *    - the SNR of a binary at 1 Mpc is interpolated bilinearly in (log M1, log M2) on the SNR grid (as the
+ *      'custom' mode of selection_effects.SNRinterpolator does), rather than with a bicubic spline
+ *    - the star forming mass evolved by COMPAS is read from the Star_Forming_Mass summary table of the
+ *      COMPAS output file, and scaled analytically (for the Kroupa IMF and a flat mass ratio distribution)
+ *      to the star forming mass in the universe, rather than estimated by sampling a mock population
+ *    - the random orientations used to calculate the detection probability as a function of SNR are drawn
+ *      from a seeded generator, so results are reproducible
+ *    - the metallicity of each DCO is matched to its system by SEED (the records of BSE_System_Parameters,
+ *      BSE_Common_Envelopes and BSE_Double_Compact_Objects must be in the order the binaries were evolved,
+ *      as COMPAS writes them)
+ *
+ * The cosmology is WMAP9 (as astropy.cosmology.WMAP9).
+ *
+ * Build with 'make cosmic-integration' in the src directory.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "hdf5.h"
+
+namespace po = boost::program_options;
+
+typedef std::vector<double>        DBL_VECTOR;
+typedef std::vector<int>           INT_VECTOR;
+typedef std::vector<unsigned long> SEED_VECTOR;
+
+
+// WMAP9 cosmology (as astropy.cosmology.WMAP9)
+constexpr double WMAP9_H0                   = 69.32;                                            // Hubble constant [km s^-1 Mpc^-1]
+constexpr double WMAP9_OMEGA_M0             = 0.2865;                                           // Matter density parameter at z = 0
+constexpr double WMAP9_T_CMB0               = 2.725;                                            // CMB temperature at z = 0 [K]
+constexpr double WMAP9_N_EFF                = 3.04;                                             // Effective number of (massless) neutrino species
+
+constexpr double SPEED_OF_LIGHT_KM_S        = 299792.458;                                       // [km s^-1]
+constexpr double MPC_KM                     = 3.0856775814913673E19;                            // Megaparsec [km]
+constexpr double MYR_S                      = 3.15576E13;                                       // Megayear (Julian) [s]
+constexpr double G_SI                       = 6.67430E-11;                                      // Gravitational constant [m^3 kg^-1 s^-2]
+constexpr double STEFAN_BOLTZMANN_SI        = 5.670374419E-8;                                   // Stefan-Boltzmann constant [W m^-2 K^-4]
+constexpr double NEUTRINO_PHOTON_RATIO      = 0.22710731766;                                    // 7/8 (4/11)^(4/3) - neutrino to photon density per species
+
+constexpr int    COSMOLOGY_SIMPSON_STEPS    = 2000;                                             // Simpson's rule intervals for the age integral
+
+// Kroupa (2001) IMF (as ClassCOMPAS.IMF)
+constexpr double KROUPA_BREAKS[]            = { 0.01, 0.08, 0.5, 200.0 };                       // Masses at which the slope changes [Msol]
+constexpr double KROUPA_SLOPES[]            = { 0.3, 1.3, 2.3 };                                // IMF ~ m^-slope between breaks
+
+// grids (as the defaults of FastCosmicIntegration.find_detection_rate())
+constexpr double LOG_Z_MIN                  = -12.0;                                            // Minimum ln(Z) of the metallicity distribution
+constexpr double LOG_Z_MAX                  = 0.0;                                              // Maximum ln(Z) of the metallicity distribution
+constexpr double LOG_Z_STEP                 = 0.01;                                             // Step in ln(Z)
+constexpr double MC_MAX                     = 300.0;                                            // Maximum chirp mass of the SNR grid [Msol]
+constexpr double MC_STEP                    = 0.1;                                              // Step in chirp mass [Msol]
+constexpr double ETA_MAX                    = 0.25;                                             // Maximum symmetric mass ratio of the SNR grid
+constexpr double ETA_STEP                   = 0.01;                                             // Step in symmetric mass ratio
+constexpr double SNR_MAX                    = 1000.0;                                           // Maximum SNR of the detection probability grid
+constexpr double SNR_STEP                   = 0.1;                                              // Step in SNR
+constexpr int    N_THETAS                   = 1000000;                                          // Number of random orientations for the detection probability
+
+constexpr double SNR_BEYOND_GRID            = 0.00001;                                          // SNR at 1 Mpc assumed for chirp masses beyond the grid
+
+constexpr size_t READ_CHUNK_ROWS            = 65536;                                            // Rows read from an input dataset at a time
+
+const std::string SNR_GRID_FILE_NAME        = "SNR_Grid_IMRPhenomPv2_FD_all_noise.hdf5";
+const std::string SNR_GRID_DEFAULT_PATH     = "postProcessing/Folders/CosmicIntegration/PythonScripts/";
+
+const std::unordered_map<std::string, std::string> SENSITIVITY_DATASET = {                     // detector sensitivity -> SNR grid dataset
+    { "design", "SimNoisePSDaLIGODesignSensitivityP1200087" },
+    { "O1",     "P1500238_GW150914_H1-GDS-CALIB_STRAIN.txt" },
+    { "O3",     "SimNoisePSDaLIGOMidHighSensitivityP1200087" }
+};
+
+// COMPAS stellar types
+constexpr int    STELLAR_TYPE_NS            = 13;
+constexpr int    STELLAR_TYPE_BH            = 14;
+
+// COMPAS output groups
+const std::string DCO_GROUP                 = "BSE_Double_Compact_Objects/";
+const std::string SP_GROUP                  = "BSE_System_Parameters/";
+const std::string CE_GROUP                  = "BSE_Common_Envelopes/";
+const std::string SFM_GROUP                 = "Star_Forming_Mass/";
+
+
+// Program options
+struct SettingsT {
+    std::string path;
+    std::string filename;
+    std::string dcoType;
+    std::string weightColumn;
+
+    double      maxRedshift;
+    double      zFirstSF;
+    double      maxRedshiftDetection;
+    double      redshiftStep;
+    std::string sensitivity;
+    double      snrThreshold;
+
+    double      m1Min;
+    double      m1Max;
+    double      m2Min;
+    double      qMin;
+    double      qMax;
+    double      fBinary;
+
+    double      mu0;
+    double      muz;
+    double      sigma0;
+    double      sigmaz;
+    double      alpha;
+    double      aSF;
+    double      bSF;
+    double      cSF;
+    double      dSF;
+
+    bool        dontAppend;
+    bool        deleteRates;
+
+    int         nThreads;
+    size_t      blockSize;
+    std::string snrGrid;
+    unsigned long thetaSeed;
+};
+
+
+// A block of selected DCOs, and their properties needed for the integration
+struct DCOsT {
+    SEED_VECTOR seed;
+    DBL_VECTOR  metallicity;
+    DBL_VECTOR  delayTime;                                                                      // Formation time + coalescence time [Myr]
+    DBL_VECTOR  chirpMass;                                                                      // [Msol]
+    DBL_VECTOR  eta;                                                                            // Symmetric mass ratio
+    DBL_VECTOR  weight;
+};
+
+
+// Redshift grid and cosmological quantities on it
+struct RedshiftGridT {
+    DBL_VECTOR redshifts;
+    DBL_VECTOR times;                                                                           // Age of the universe [Myr]
+    DBL_VECTOR distances;                                                                       // Luminosity distance [Mpc]
+    DBL_VECTOR shellVolumes;                                                                    // Comoving volume of shell [Gpc^3]
+    double     timeFirstSF;                                                                     // Age of the universe at first star formation [Myr]
+    size_t     nDetection;                                                                      // Number of redshifts for which detection rates are calculated
+};
+
+
+// Parameters of the metallicity distribution at each redshift (see MetallicityDistribution())
+struct MetallicityDistributionT {
+    DBL_VECTOR mu;                                                                              // Location of the log-skew-normal
+    DBL_VECTOR sigma;                                                                           // Scale of the log-skew-normal
+    DBL_VECTOR norm;                                                                            // Normalisation over the ln(Z) grid
+};
+
+
+/*
+ * Print an error message and exit
+ *
+ *
+ * void Fatal(const std::string p_Message)
+ *
+ * @param   [IN]    p_Message                   Error message
+ */
+[[noreturn]] void Fatal(const std::string p_Message) {
+    std::cerr << "ERROR: CosmicIntegration: " << p_Message << std::endl;
+    std::exit(EXIT_FAILURE);
+}
+
+
+/*
+ * Format a floating point number as Python's str() does, so that the rates group name matches
+ * the name used by FastCosmicIntegration.py (e.g. 0.035 -> "0.035", 0 -> "0.0", -0.23 -> "-0.23")
+ *
+ *
+ * std::string PyFloatStr(const double p_Value)
+ *
+ * @param   [IN]    p_Value                     Value to format
+ * @return                                      Formatted string
+ */
+std::string PyFloatStr(const double p_Value) {
+
+    char buffer[64];
+    for (int precision = 1; precision <= 17; precision++) {                                     // shortest representation that round-trips
+        std::snprintf(buffer, sizeof(buffer), "%.*g", precision, p_Value);
+        if (std::strtod(buffer, nullptr) == p_Value) break;
+    }
+
+    std::string str(buffer);
+    if (str.find_first_of(".en") == std::string::npos) str += ".0";                             // integral values keep a decimal point
+
+    return str;
+}
+
+
+/*
+ * Run a function over the range [0, p_N), divided into contiguous sub-ranges, one per thread
+ *
+ *
+ * void ParallelFor(const size_t p_N, const int p_nThreads, const std::function<void(size_t, size_t)> p_Fn)
+ *
+ * @param   [IN]    p_N                         Size of the range
+ * @param   [IN]    p_nThreads                  Number of threads
+ * @param   [IN]    p_Fn                        Function to run - called as p_Fn(begin, end)
+ */
+void ParallelFor(const size_t p_N, const int p_nThreads, const std::function<void(size_t, size_t)> p_Fn) {
+
+    size_t nThreads = std::max((size_t)1, std::min((size_t)p_nThreads, p_N));
+    if (nThreads == 1) { p_Fn(0, p_N); return; }
+
+    std::vector<std::thread> threads;
+    size_t chunk = (p_N + nThreads - 1) / nThreads;
+    for (size_t begin = 0; begin < p_N; begin += chunk) {
+        threads.emplace_back(p_Fn, begin, std::min(begin + chunk, p_N));
+    }
+    for (auto& thread : threads) thread.join();
+}
+
+
+/*
+ * Check whether an object (group or dataset) exists in an HDF5 file
+ *
+ *
+ * bool ObjectExists(const hid_t p_FileId, const std::string p_Path)
+ *
+ * @param   [IN]    p_FileId                    HDF5 file (or group) id
+ * @param   [IN]    p_Path                      Path of object, relative to p_FileId
+ * @return                                      True if the object exists, otherwise false
+ */
+bool ObjectExists(const hid_t p_FileId, const std::string p_Path) {
+
+    size_t pos = 0;
+    while ((pos = p_Path.find('/', pos + 1)) != std::string::npos) {                            // each intermediate link must exist
+        if (H5Lexists(p_FileId, p_Path.substr(0, pos).c_str(), H5P_DEFAULT) <= 0) return false;
+    }
+
+    return H5Lexists(p_FileId, p_Path.c_str(), H5P_DEFAULT) > 0;
+}
+
+
+/*
+ * Read a (one dimensional) dataset from an HDF5 file, converting it to the type requested
+ *
+ *
+ * std::vector<T> ReadDataset(const hid_t p_FileId, const std::string p_Path, const hid_t p_MemType)
+ *
+ * @param   [IN]    p_FileId                    HDF5 file id
+ * @param   [IN]    p_Path                      Path of the dataset
+ * @param   [IN]    p_MemType                   HDF5 native type of T
+ * @return                                      Dataset values
+ */
+template <typename T>
+std::vector<T> ReadDataset(const hid_t p_FileId, const std::string p_Path, const hid_t p_MemType) {
+
+    if (!ObjectExists(p_FileId, p_Path)) Fatal("dataset '" + p_Path + "' not found");
+
+    hid_t dataset = H5Dopen(p_FileId, p_Path.c_str(), H5P_DEFAULT);
+    if (dataset < 0) Fatal("unable to open dataset '" + p_Path + "'");
+
+    hid_t fileType = H5Dget_type(dataset);
+    bool  isString = H5Tget_class(fileType) == H5T_STRING;
+    H5Tclose(fileType);
+    if (isString) Fatal("dataset '" + p_Path + "' is a string dataset (was COMPAS run with --print-bool-as-string?)");
+
+    hid_t   space = H5Dget_space(dataset);
+    hssize_t n    = H5Sget_simple_extent_npoints(space);
+    H5Sclose(space);
+
+    std::vector<T> values((size_t)n);
+    if (n > 0 && H5Dread(dataset, p_MemType, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data()) < 0) {
+        Fatal("unable to read dataset '" + p_Path + "'");
+    }
+    H5Dclose(dataset);
+
+    return values;
+}
+
+
+/*
+ * ColumnReader - reads a (one dimensional) dataset of an HDF5 file a chunk of rows at a time
+ *
+ * The rows are read in order: Value() is the value of the current row, and Advance() moves to the
+ * next row.  Only the chunk of rows that holds the current row is kept in memory, so memory use does
+ * not grow with the size of the dataset.
+ */
+template <typename T>
+class ColumnReader {
+
+public:
+
+    ColumnReader(const hid_t p_FileId, const std::string p_Path, const hid_t p_MemType, const size_t p_ChunkSize = READ_CHUNK_ROWS)
+        : m_Path(p_Path), m_MemType(p_MemType), m_ChunkSize(std::max(p_ChunkSize, (size_t)1)), m_Row(0), m_First(0) {
+
+        if (!ObjectExists(p_FileId, p_Path)) Fatal("dataset '" + p_Path + "' not found");
+
+        m_Dataset = H5Dopen(p_FileId, p_Path.c_str(), H5P_DEFAULT);
+        if (m_Dataset < 0) Fatal("unable to open dataset '" + p_Path + "'");
+
+        hid_t fileType = H5Dget_type(m_Dataset);
+        bool  isString = H5Tget_class(fileType) == H5T_STRING;
+        H5Tclose(fileType);
+        if (isString) Fatal("dataset '" + p_Path + "' is a string dataset (was COMPAS run with --print-bool-as-string?)");
+
+        hid_t space = H5Dget_space(m_Dataset);
+        m_Size      = (size_t)H5Sget_simple_extent_npoints(space);
+        H5Sclose(space);
+    }
+
+    ~ColumnReader() { H5Dclose(m_Dataset); }
+
+    ColumnReader(const ColumnReader&) = delete;
+    ColumnReader& operator=(const ColumnReader&) = delete;
+
+
+    bool    AtEnd() const                                                                       { return m_Row >= m_Size; }
+    void    Advance()                                                                           { m_Row++; }
+    size_t  Size() const                                                                        { return m_Size; }
+
+    T Value() {
+        if (m_Row < m_First || m_Row >= m_First + m_Buffer.size()) ReadChunk();                 // current row not in the chunk held?
+        return m_Buffer[m_Row - m_First];
+    }
+
+
+private:
+
+    /*
+     * Read the chunk of rows starting at the current row
+     */
+    void ReadChunk() {
+
+        if (AtEnd()) Fatal("read past the end of dataset '" + m_Path + "'");
+
+        hsize_t start = (hsize_t)m_Row;
+        hsize_t count = (hsize_t)std::min(m_ChunkSize, m_Size - m_Row);
+
+        m_Buffer.resize((size_t)count);
+
+        hid_t memSpace  = H5Screate_simple(1, &count, nullptr);
+        hid_t fileSpace = H5Dget_space(m_Dataset);
+        H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &start, nullptr, &count, nullptr);
+
+        herr_t status = H5Dread(m_Dataset, m_MemType, memSpace, fileSpace, H5P_DEFAULT, m_Buffer.data());
+
+        H5Sclose(fileSpace);
+        H5Sclose(memSpace);
+
+        if (status < 0) Fatal("unable to read dataset '" + m_Path + "'");
+
+        m_First = m_Row;
+    }
+
+
+    std::string    m_Path;
+    hid_t          m_Dataset;
+    hid_t          m_MemType;
+    size_t         m_ChunkSize;                                                                 // Rows read at a time
+    size_t         m_Size;                                                                      // Rows in the dataset
+    size_t         m_Row;                                                                       // Current row
+    size_t         m_First;                                                                     // Row of the first value in m_Buffer
+    std::vector<T> m_Buffer;                                                                    // Chunk of rows held
+};
+
+
+/*
+ * Sum a (one dimensional) dataset of an HDF5 file, reading it a chunk at a time
+ *
+ *
+ * double SumDataset(const hid_t p_FileId, const std::string p_Path)
+ *
+ * @param   [IN]    p_FileId                    HDF5 file id
+ * @param   [IN]    p_Path                      Path of the dataset
+ * @return                                      Sum of the dataset values
+ */
+double SumDataset(const hid_t p_FileId, const std::string p_Path) {
+
+    ColumnReader<double> column(p_FileId, p_Path, H5T_NATIVE_DOUBLE);
+
+    double sum = 0.0;
+    for (; !column.AtEnd(); column.Advance()) sum += column.Value();
+
+    return sum;
+}
+
+
+/*
+ * Create a dataset in an HDF5 group, replacing the dataset if it already exists
+ *
+ * If p_Extendable is true the first dimension of the dataset is unlimited (the dataset is chunked by
+ * rows, about 1MB per chunk), and rows are appended by AppendRows().
+ *
+ *
+ * hid_t CreateDataset(const hid_t p_GroupId, const std::string p_Name, const hid_t p_Type, const std::vector<hsize_t> p_Dims, const bool p_Extendable = false)
+ *
+ * @param   [IN]    p_GroupId                   HDF5 group id
+ * @param   [IN]    p_Name                      Dataset name
+ * @param   [IN]    p_Type                      HDF5 datatype
+ * @param   [IN]    p_Dims                      Dataset dimensions (1 or 2)
+ * @param   [IN]    p_Extendable                True if rows are to be appended to the dataset
+ * @return                                      Dataset id
+ */
+hid_t CreateDataset(const hid_t p_GroupId, const std::string p_Name, const hid_t p_Type, const std::vector<hsize_t> p_Dims, const bool p_Extendable = false) {
+
+    if (H5Lexists(p_GroupId, p_Name.c_str(), H5P_DEFAULT) > 0) H5Ldelete(p_GroupId, p_Name.c_str(), H5P_DEFAULT);
+
+    std::vector<hsize_t> maxDims = p_Dims;
+    hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+
+    if (p_Extendable) {                                                                         // chunk by rows (about 1MB per chunk)
+        maxDims[0] = H5S_UNLIMITED;
+
+        std::vector<hsize_t> chunk = p_Dims;
+        if (chunk.size() == 2 && chunk[1] == 0) { chunk[1] = 1; maxDims[1] = H5S_UNLIMITED; }   // no columns - chunk dimensions must be positive
+        hsize_t rowBytes = (chunk.size() == 2 ? chunk[1] : 1) * H5Tget_size(p_Type);
+        chunk[0] = std::max((hsize_t)1, (hsize_t)(1048576 / rowBytes));
+        H5Pset_chunk(plist, (int)chunk.size(), chunk.data());
+    }
+
+    hid_t space   = H5Screate_simple((int)p_Dims.size(), p_Dims.data(), maxDims.data());
+    hid_t dataset = H5Dcreate(p_GroupId, p_Name.c_str(), p_Type, space, H5P_DEFAULT, plist, H5P_DEFAULT);
+    if (dataset < 0) Fatal("unable to create dataset '" + p_Name + "'");
+
+    H5Pclose(plist);
+    H5Sclose(space);
+
+    return dataset;
+}
+
+
+/*
+ * Write a one dimensional dataset to an HDF5 group, replacing the dataset if it already exists
+ *
+ *
+ * void WriteDataset(const hid_t p_GroupId, const std::string p_Name, const hid_t p_Type, const size_t p_N, const void* p_Data)
+ *
+ * @param   [IN]    p_GroupId                   HDF5 group id
+ * @param   [IN]    p_Name                      Dataset name
+ * @param   [IN]    p_Type                      HDF5 native datatype of p_Data
+ * @param   [IN]    p_N                         Number of values
+ * @param   [IN]    p_Data                      Values
+ */
+void WriteDataset(const hid_t p_GroupId, const std::string p_Name, const hid_t p_Type, const size_t p_N, const void* p_Data) {
+
+    hid_t dataset = CreateDataset(p_GroupId, p_Name, p_Type, { (hsize_t)p_N });
+    if (p_N > 0 && H5Dwrite(dataset, p_Type, H5S_ALL, H5S_ALL, H5P_DEFAULT, p_Data) < 0) Fatal("unable to write dataset '" + p_Name + "'");
+    H5Dclose(dataset);
+}
+
+
+/*
+ * Append a block of rows to an extendable (one or two dimensional) dataset - see CreateDataset()
+ *
+ * The block holds p_nRows rows of p_Stride values; the first p_nCols values of each row are written.
+ * For a one dimensional dataset p_nCols and p_Stride are 1.
+ *
+ *
+ * void AppendRows(const hid_t p_Dataset, const hid_t p_Type, const size_t p_nRows, const size_t p_nCols, const size_t p_Stride, const void* p_Data)
+ *
+ * @param   [IN]    p_Dataset                   HDF5 dataset id
+ * @param   [IN]    p_Type                      HDF5 native datatype of p_Data
+ * @param   [IN]    p_nRows                     Number of rows to append
+ * @param   [IN]    p_nCols                     Number of columns to write
+ * @param   [IN]    p_Stride                    Number of values per row in p_Data
+ * @param   [IN]    p_Data                      Block of rows
+ */
+void AppendRows(const hid_t p_Dataset, const hid_t p_Type, const size_t p_nRows, const size_t p_nCols, const size_t p_Stride, const void* p_Data) {
+
+    if (p_nRows == 0) return;
+
+    hid_t   fileSpace = H5Dget_space(p_Dataset);
+    int     rank      = H5Sget_simple_extent_ndims(fileSpace);
+    hsize_t dims[2]   = { 0, 0 };
+    H5Sget_simple_extent_dims(fileSpace, dims, nullptr);
+    H5Sclose(fileSpace);
+
+    hsize_t firstRow = dims[0];
+    dims[0] += (hsize_t)p_nRows;
+    if (H5Dset_extent(p_Dataset, dims) < 0) Fatal("unable to extend dataset");
+
+    if (p_nCols == 0) return;                                                                   // no columns to write
+
+    hsize_t memDims[2]   = { (hsize_t)p_nRows, (hsize_t)p_Stride };
+    hsize_t memStart[2]  = { 0, 0 };
+    hsize_t count[2]     = { (hsize_t)p_nRows, (hsize_t)p_nCols };
+    hsize_t fileStart[2] = { firstRow, 0 };
+
+    hid_t memSpace = H5Screate_simple(rank, memDims, nullptr);
+    H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, memStart, nullptr, count, nullptr);
+
+    fileSpace = H5Dget_space(p_Dataset);
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, fileStart, nullptr, count, nullptr);
+
+    if (H5Dwrite(p_Dataset, p_Type, memSpace, fileSpace, H5P_DEFAULT, p_Data) < 0) Fatal("unable to append rows to dataset");
+
+    H5Sclose(fileSpace);
+    H5Sclose(memSpace);
+}
+
+
+/*
+ * Dimensionless Hubble parameter E(z) = H(z) / H0, as a function of scale factor, for the WMAP9 cosmology
+ * (flat, with photons and massless neutrinos)
+ *
+ * Returns 1 / (a E(a)), the integrand of the age integral in a.
+ *
+ *
+ * double AgeIntegrand(const double p_A, const double p_OmegaM, const double p_OmegaR, const double p_OmegaL)
+ *
+ * @param   [IN]    p_A                         Scale factor
+ * @param   [IN]    p_OmegaM                    Matter density parameter
+ * @param   [IN]    p_OmegaR                    Radiation density parameter
+ * @param   [IN]    p_OmegaL                    Dark energy density parameter
+ * @return                                      1 / (a E(a))
+ */
+double AgeIntegrand(const double p_A, const double p_OmegaM, const double p_OmegaR, const double p_OmegaL) {
+    return p_A / std::sqrt(p_OmegaM * p_A + p_OmegaR + p_OmegaL * p_A * p_A * p_A * p_A);
+}
+
+
+/*
+ * Calculate the redshift grid, and the age of the universe, luminosity distance and comoving shell
+ * volume at each redshift (as FastCosmicIntegration.calculate_redshift_related_params())
+ *
+ *
+ * RedshiftGridT CalculateRedshiftGrid(const SettingsT& p_Settings)
+ *
+ * @param   [IN]    p_Settings                  Program options
+ * @return                                      Redshift grid
+ */
+RedshiftGridT CalculateRedshiftGrid(const SettingsT& p_Settings) {
+
+    // density parameters
+    double H0SI      = WMAP9_H0 / MPC_KM;                                                       // [s^-1]
+    double rhoCrit   = 3.0 * H0SI * H0SI / (8.0 * M_PI * G_SI);                                 // [kg m^-3]
+    double c         = SPEED_OF_LIGHT_KM_S * 1000.0;                                            // [m s^-1]
+    double omegaG    = 4.0 * STEFAN_BOLTZMANN_SI / (c * c * c) * std::pow(WMAP9_T_CMB0, 4.0) / rhoCrit;
+    double omegaR    = omegaG * (1.0 + NEUTRINO_PHOTON_RATIO * WMAP9_N_EFF);
+    double omegaM    = WMAP9_OMEGA_M0;
+    double omegaL    = 1.0 - omegaM - omegaR;
+
+    double hubbleTime     = MPC_KM / WMAP9_H0 / MYR_S;                                          // [Myr]
+    double hubbleDistance = SPEED_OF_LIGHT_KM_S / WMAP9_H0;                                     // [Mpc]
+
+    auto E   = [&](const double z) { double zp1 = 1.0 + z; return std::sqrt(omegaM * zp1 * zp1 * zp1 + omegaR * zp1 * zp1 * zp1 * zp1 + omegaL); };
+    auto age = [&](const double z) {                                                            // age of the universe at redshift z [Myr]
+        double a = 1.0 / (1.0 + z);
+        double h = a / COSMOLOGY_SIMPSON_STEPS;
+        double sum = AgeIntegrand(0.0, omegaM, omegaR, omegaL) + AgeIntegrand(a, omegaM, omegaR, omegaL);
+        for (int i = 1; i < COSMOLOGY_SIMPSON_STEPS; i++) sum += (i % 2 ? 4.0 : 2.0) * AgeIntegrand(i * h, omegaM, omegaR, omegaL);
+        return hubbleTime * sum * h / 3.0;
+    };
+
+    RedshiftGridT grid;
+
+    size_t nRedshifts = (size_t)std::round(p_Settings.maxRedshift / p_Settings.redshiftStep) + 1;
+    grid.redshifts.resize(nRedshifts);
+    for (size_t i = 0; i < nRedshifts; i++) grid.redshifts[i] = i * p_Settings.redshiftStep;
+
+    grid.nDetection  = std::min((size_t)(p_Settings.maxRedshiftDetection / p_Settings.redshiftStep), nRedshifts);
+    grid.timeFirstSF = age(p_Settings.zFirstSF);
+
+    grid.times.resize(nRedshifts);
+    ParallelFor(nRedshifts, p_Settings.nThreads, [&](size_t p_Begin, size_t p_End) {
+        for (size_t i = p_Begin; i < p_End; i++) grid.times[i] = age(grid.redshifts[i]);
+    });
+
+    // comoving distance by Simpson's rule over each redshift interval
+    DBL_VECTOR comovingDistance(nRedshifts, 0.0);                                               // [Mpc]
+    for (size_t i = 1; i < nRedshifts; i++) {
+        double z0 = grid.redshifts[i - 1];
+        double z1 = grid.redshifts[i];
+        comovingDistance[i] = comovingDistance[i - 1] + hubbleDistance * (z1 - z0) / 6.0 * (1.0 / E(z0) + 4.0 / E(0.5 * (z0 + z1)) + 1.0 / E(z1));
+    }
+
+    grid.distances.resize(nRedshifts);
+    for (size_t i = 0; i < nRedshifts; i++) grid.distances[i] = (1.0 + grid.redshifts[i]) * comovingDistance[i];
+    grid.distances[0] = 0.001;                                                                  // avoid division by zero
+
+    DBL_VECTOR volumes(nRedshifts);                                                             // [Gpc^3]
+    for (size_t i = 0; i < nRedshifts; i++) volumes[i] = 4.0 / 3.0 * M_PI * std::pow(comovingDistance[i] / 1000.0, 3.0);
+
+    grid.shellVolumes.resize(nRedshifts);
+    for (size_t i = 0; i + 1 < nRedshifts; i++) grid.shellVolumes[i] = volumes[i + 1] - volumes[i];
+    grid.shellVolumes[nRedshifts - 1] = nRedshifts > 1 ? grid.shellVolumes[nRedshifts - 2] : 0.0;  // duplicate last shell
+
+    return grid;
+}
+
+
+/*
+ * Integrate b m^(p) over [p_Lo, p_Hi] - helper for the piecewise power-law IMF
+ *
+ *
+ * double PowerLawIntegral(const double p_Lo, const double p_Hi, const double p_Power)
+ *
+ * @param   [IN]    p_Lo                        Lower limit
+ * @param   [IN]    p_Hi                        Upper limit
+ * @param   [IN]    p_Power                     Power of m
+ * @return                                      Integral of m^p_Power over [p_Lo, p_Hi] (0 if p_Hi <= p_Lo)
+ */
+double PowerLawIntegral(const double p_Lo, const double p_Hi, const double p_Power) {
+    if (p_Hi <= p_Lo) return 0.0;
+    return std::abs(p_Power + 1.0) < 1.0E-12 ? std::log(p_Hi / p_Lo) : (std::pow(p_Hi, p_Power + 1.0) - std::pow(p_Lo, p_Power + 1.0)) / (p_Power + 1.0);
+}
+
+
+/*
+ * Integrate IMF(m) m^k over [p_Lo, p_Hi] for the (normalised) Kroupa IMF
+ *
+ *
+ * double KroupaMoment(const double p_Lo, const double p_Hi, const double p_K)
+ *
+ * @param   [IN]    p_Lo                        Lower limit [Msol]
+ * @param   [IN]    p_Hi                        Upper limit [Msol]
+ * @param   [IN]    p_K                         Power of m
+ * @return                                      Integral of IMF(m) m^p_K over [p_Lo, p_Hi]
+ */
+double KroupaMoment(const double p_Lo, const double p_Hi, const double p_K) {
+
+    double b[3] = { 1.0, 0.0, 0.0 };                                                            // continuity at the breaks
+    b[1] = b[0] * std::pow(KROUPA_BREAKS[1], KROUPA_SLOPES[1] - KROUPA_SLOPES[0]);
+    b[2] = b[1] * std::pow(KROUPA_BREAKS[2], KROUPA_SLOPES[2] - KROUPA_SLOPES[1]);
+
+    double norm     = 0.0;
+    double integral = 0.0;
+    for (int i = 0; i < 3; i++) {
+        norm     += b[i] * PowerLawIntegral(KROUPA_BREAKS[i], KROUPA_BREAKS[i + 1], -KROUPA_SLOPES[i]);
+        integral += b[i] * PowerLawIntegral(std::max(p_Lo, KROUPA_BREAKS[i]), std::min(p_Hi, KROUPA_BREAKS[i + 1]), p_K - KROUPA_SLOPES[i]);
+    }
+
+    return integral / norm;
+}
+
+
+/*
+ * Calculate the star forming mass evolved per binary evolved by COMPAS
+ * (as ClassCOMPAS.find_star_forming_mass_per_binary_sampling(), but analytically)
+ *
+ * Primary masses are drawn from the Kroupa IMF, a fraction fbin of stars have a companion with
+ * mass ratio drawn uniformly on [0, 1], and COMPAS evolves binaries with m1min <= m1 <= m1max and
+ * m2 > m2min.  The mass evolved per binary is then the mean mass of a system in the universe,
+ * <m1> (1 + fbin / 2), divided by the number of systems in the COMPAS range per system in the
+ * universe, fbin * integral(IMF(m) (1 - m2min / m), m = max(m1min, m2min)..m1max).
+ *
+ *
+ * double StarFormingMassPerBinary(const SettingsT& p_Settings)
+ *
+ * @param   [IN]    p_Settings                  Program options
+ * @return                                      Star forming mass per binary [Msol]
+ */
+double StarFormingMassPerBinary(const SettingsT& p_Settings) {
+
+    double meanMass = KroupaMoment(KROUPA_BREAKS[0], KROUPA_BREAKS[3], 1.0) * (1.0 + 0.5 * p_Settings.fBinary);
+
+    double lo        = std::max(p_Settings.m1Min, p_Settings.m2Min);
+    double fSampled  = p_Settings.fBinary * (KroupaMoment(lo, p_Settings.m1Max, 0.0) - p_Settings.m2Min * KroupaMoment(lo, p_Settings.m1Max, -1.0));
+
+    if (fSampled <= 0.0) Fatal("no binaries in the COMPAS mass range (check --m1min, --m1max, --m2min and --fbin)");
+
+    return meanMass / fSampled;
+}
+
+
+/*
+ * Calculate the star forming mass in the universe per unit of mass drawn by COMPAS
+ *
+ * COMPAS draws primary masses from the Kroupa IMF on [m1min, m1max], and mass ratios uniformly on
+ * [qmin, qmax] - the mass drawn includes the draws rejected (e.g. because the secondary mass is below
+ * the minimum).  A fraction fbin of stars in the universe have a companion, with mass ratio drawn
+ * uniformly on [0, 1], so the mass drawn by COMPAS per system in the universe is
+ *
+ *     fbin * integral(IMF(m) m, m = m1min..m1max) * ((qmax - qmin) + (qmax^2 - qmin^2) / 2)
+ *
+ * and the mean mass of a system in the universe is <m1> (1 + fbin / 2).
+ *
+ *
+ * double StarFormingMassPerMassDrawn(const SettingsT& p_Settings)
+ *
+ * @param   [IN]    p_Settings                  Program options
+ * @return                                      Star forming mass per unit of mass drawn
+ */
+double StarFormingMassPerMassDrawn(const SettingsT& p_Settings) {
+
+    double meanMass  = KroupaMoment(KROUPA_BREAKS[0], KROUPA_BREAKS[3], 1.0) * (1.0 + 0.5 * p_Settings.fBinary);
+
+    double qRange    = (p_Settings.qMax - p_Settings.qMin) + 0.5 * (p_Settings.qMax * p_Settings.qMax - p_Settings.qMin * p_Settings.qMin);
+    double massDrawn = p_Settings.fBinary * KroupaMoment(p_Settings.m1Min, p_Settings.m1Max, 1.0) * qRange;
+
+    if (massDrawn <= 0.0) Fatal("no binaries in the COMPAS mass range (check --m1min, --m1max, --qmin, --qmax and --fbin)");
+
+    return meanMass / massDrawn;
+}
+
+
+/*
+ * Read the mass drawn by COMPAS from the Star_Forming_Mass summary table of the COMPAS output file
+ *
+ * The table (one row per metallicity bin) has the total mass of the initial conditions drawn, including
+ * the draws rejected because they could not make a valid binary.  If the DCOs are weighted (--weight),
+ * and the table has importance weighted totals (the run used adaptive importance sampling), the weighted
+ * mass drawn is read - it is the mass that normalises weighted counts.
+ *
+ *
+ * double ReadMassDrawn(const hid_t p_FileId, const SettingsT& p_Settings, std::string& p_Column)
+ *
+ * @param   [IN]    p_FileId                    HDF5 file id of the COMPAS output file
+ * @param   [IN]    p_Settings                  Program options
+ * @param   [OUT]   p_Column                    Name of the column read
+ * @return                                      Total mass drawn [Msol], or -1.0 if the file has no Star_Forming_Mass table
+ */
+double ReadMassDrawn(const hid_t p_FileId, const SettingsT& p_Settings, std::string& p_Column) {
+
+    if (!ObjectExists(p_FileId, SFM_GROUP + "Mass_Drawn")) return -1.0;
+
+    p_Column = !p_Settings.weightColumn.empty() && ObjectExists(p_FileId, SFM_GROUP + "Weighted_Mass_Drawn") ? "Weighted_Mass_Drawn" : "Mass_Drawn";
+
+    return SumDataset(p_FileId, SFM_GROUP + p_Column);
+}
+
+
+/*
+ * Standard normal distribution functions
+ */
+inline double NormPDF(const double p_X) { return std::exp(-0.5 * p_X * p_X) / std::sqrt(2.0 * M_PI); }
+inline double NormCDF(const double p_X) { return 0.5 * std::erfc(-p_X / std::sqrt(2.0)); }
+
+
+/*
+ * Calculate the parameters of the metallicity distribution dP/dlogZ at each redshift
+ * (as FastCosmicIntegration.find_metallicity_distribution())
+ *
+ * The distribution is log-skew-normal, normalised over the ln(Z) grid at each redshift.  The distribution
+ * itself is calculated (by MetallicityDistributionColumn()) only for the ln(Z) grid bins of the DCO
+ * metallicities, as the DCOs are read.
+ *
+ *
+ * MetallicityDistributionT MetallicityDistribution(const SettingsT& p_Settings, const DBL_VECTOR& p_Redshifts, const DBL_VECTOR& p_LogZ)
+ *
+ * @param   [IN]    p_Settings                  Program options
+ * @param   [IN]    p_Redshifts                 Redshift grid
+ * @param   [IN]    p_LogZ                      ln(Z) grid
+ * @return                                      Parameters of the distribution at each redshift
+ */
+MetallicityDistributionT MetallicityDistribution(const SettingsT& p_Settings, const DBL_VECTOR& p_Redshifts, const DBL_VECTOR& p_LogZ) {
+
+    size_t nRedshifts = p_Redshifts.size();
+
+    MetallicityDistributionT distribution;
+    distribution.sigma.resize(nRedshifts);
+    distribution.mu.resize(nRedshifts);
+    distribution.norm.resize(nRedshifts);
+
+    double beta = p_Settings.alpha / std::sqrt(1.0 + p_Settings.alpha * p_Settings.alpha);
+
+    ParallelFor(nRedshifts, p_Settings.nThreads, [&](size_t p_Begin, size_t p_End) {
+        for (size_t i = p_Begin; i < p_End; i++) {
+            double sigma = p_Settings.sigma0 * std::pow(10.0, p_Settings.sigmaz * p_Redshifts[i]);
+            double mean  = p_Settings.mu0 * std::pow(10.0, p_Settings.muz * p_Redshifts[i]);
+            double mu    = std::log(mean / 2.0 / (std::exp(0.5 * sigma * sigma) * NormCDF(beta * sigma)));
+
+            double sum = 0.0;
+            for (double logZ : p_LogZ) {
+                double x = (logZ - mu) / sigma;
+                sum += 2.0 / sigma * NormPDF(x) * NormCDF(p_Settings.alpha * x);
+            }
+
+            distribution.sigma[i] = sigma;
+            distribution.mu[i]    = mu;
+            distribution.norm[i]  = sum * LOG_Z_STEP;
+        }
+    });
+
+    return distribution;
+}
+
+
+/*
+ * Calculate the metallicity distribution dP/dlogZ at one ln(Z), at each redshift
+ *
+ * The distribution is returned as a column over redshift, so the formation rate kernel reads
+ * contiguous memory.
+ *
+ *
+ * DBL_VECTOR MetallicityDistributionColumn(const SettingsT& p_Settings, const MetallicityDistributionT& p_Distribution, const double p_LogZ)
+ *
+ * @param   [IN]    p_Settings                  Program options
+ * @param   [IN]    p_Distribution              Parameters of the distribution at each redshift (see MetallicityDistribution())
+ * @param   [IN]    p_LogZ                      ln(Z)
+ * @return                                      dP/dlogZ at each redshift
+ */
+DBL_VECTOR MetallicityDistributionColumn(const SettingsT& p_Settings, const MetallicityDistributionT& p_Distribution, const double p_LogZ) {
+
+    size_t nRedshifts = p_Distribution.norm.size();
+
+    DBL_VECTOR column(nRedshifts);
+    for (size_t i = 0; i < nRedshifts; i++) {
+        double x  = (p_LogZ - p_Distribution.mu[i]) / p_Distribution.sigma[i];
+        column[i] = 2.0 / p_Distribution.sigma[i] * NormPDF(x) * NormCDF(p_Settings.alpha * x) / p_Distribution.norm[i];
+    }
+
+    return column;
+}
+
+
+/*
+ * Calculate the SNR at 1 Mpc on a (symmetric mass ratio, chirp mass) grid, and the detection probability
+ * as a function of SNR (as FastCosmicIntegration.compute_snr_and_detection_grids())
+ *
+ * The SNR is interpolated bilinearly in (log M1, log M2) on the SNR grid for the detector sensitivity,
+ * with masses clamped to the grid.  The detection probability follows Finn & Chernoff (1993), averaged
+ * over N_THETAS random orientations and sky positions (as selection_effects.detection_probability_from_snr()).
+ *
+ *
+ * void DetectionGrids(const SettingsT& p_Settings, DBL_VECTOR& p_SNRGrid, DBL_VECTOR& p_DetectionProbability)
+ *
+ * @param   [IN]    p_Settings                  Program options
+ * @param   [OUT]   p_SNRGrid                   SNR at 1 Mpc - row per eta, column per chirp mass
+ * @param   [OUT]   p_DetectionProbability      Detection probability - per SNR
+ */
+void DetectionGrids(const SettingsT& p_Settings, DBL_VECTOR& p_SNRGrid, DBL_VECTOR& p_DetectionProbability) {
+
+    auto it = SENSITIVITY_DATASET.find(p_Settings.sensitivity);
+    if (it == SENSITIVITY_DATASET.end()) Fatal("unknown sensitivity '" + p_Settings.sensitivity + "' (must be one of design, O1, O3)");
+
+    hid_t file = H5Fopen(p_Settings.snrGrid.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file < 0) Fatal("unable to open SNR grid file '" + p_Settings.snrGrid + "'");
+
+    DBL_VECTOR massAxis = ReadDataset<double>(file, "mass_axis", H5T_NATIVE_DOUBLE);
+    DBL_VECTOR snrs     = ReadDataset<double>(file, "snr_values/" + it->second, H5T_NATIVE_DOUBLE);
+    H5Fclose(file);
+
+    size_t nMass = massAxis.size();
+    if (nMass < 2 || snrs.size() != nMass * nMass) Fatal("SNR grid file '" + p_Settings.snrGrid + "' is malformed");
+
+    DBL_VECTOR logMass(nMass);
+    for (size_t i = 0; i < nMass; i++) logMass[i] = std::log(massAxis[i]);
+
+    auto interpolate = [&](const double p_M1, const double p_M2) {                              // bilinear in (log M1, log M2), clamped
+        double x = std::min(std::max(std::log(p_M1), logMass.front()), logMass.back());
+        double y = std::min(std::max(std::log(p_M2), logMass.front()), logMass.back());
+        size_t i = std::min((size_t)(std::upper_bound(logMass.begin(), logMass.end(), x) - logMass.begin()), nMass - 1);
+        size_t j = std::min((size_t)(std::upper_bound(logMass.begin(), logMass.end(), y) - logMass.begin()), nMass - 1);
+        i = std::max(i, (size_t)1);
+        j = std::max(j, (size_t)1);
+        double tx = (x - logMass[i - 1]) / (logMass[i] - logMass[i - 1]);
+        double ty = (y - logMass[j - 1]) / (logMass[j] - logMass[j - 1]);
+        return (1.0 - tx) * (1.0 - ty) * snrs[(i - 1) * nMass + j - 1] + (1.0 - tx) * ty * snrs[(i - 1) * nMass + j] +
+               tx * (1.0 - ty) * snrs[i * nMass + j - 1] + tx * ty * snrs[i * nMass + j];
+    };
+
+    size_t nEta = (size_t)std::round(ETA_MAX / ETA_STEP);
+    size_t nMc  = (size_t)std::round(MC_MAX / MC_STEP);
+
+    p_SNRGrid.resize(nEta * nMc);
+    for (size_t i = 0; i < nEta; i++) {
+        double eta = (i + 1) * ETA_STEP;
+        for (size_t j = 0; j < nMc; j++) {
+            double Mc = (j + 1) * MC_STEP;
+            double Mt = Mc / std::pow(eta, 0.6);
+            double M1 = Mt * 0.5 * (1.0 + std::sqrt(std::max(0.0, 1.0 - 4.0 * eta)));
+            p_SNRGrid[i * nMc + j] = interpolate(M1, Mt - M1);
+        }
+    }
+
+    // Finn & Chernoff (1993) orientation factors
+    std::mt19937_64 generator(p_Settings.thetaSeed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    DBL_VECTOR thetas(N_THETAS);
+    for (int n = 0; n < N_THETAS; n++) {
+        double cosTheta = 2.0 * uniform(generator) - 1.0;
+        double cosInc   = 2.0 * uniform(generator) - 1.0;
+        double phi      = 2.0 * M_PI * uniform(generator);
+        double zeta     = 2.0 * M_PI * uniform(generator);
+
+        double Fp = 0.5 * std::cos(2.0 * zeta) * (1.0 + cosTheta * cosTheta) * std::cos(2.0 * phi) - std::sin(2.0 * zeta) * cosTheta * std::sin(2.0 * phi);
+        double Fx = 0.5 * std::sin(2.0 * zeta) * (1.0 + cosTheta * cosTheta) * std::cos(2.0 * phi) + std::cos(2.0 * zeta) * cosTheta * std::sin(2.0 * phi);
+
+        thetas[n] = std::sqrt(0.25 * Fp * Fp * (1.0 + cosInc * cosInc) * (1.0 + cosInc * cosInc) + Fx * Fx * cosInc * cosInc);
+    }
+    std::sort(thetas.begin(), thetas.end());
+
+    size_t nSNR = (size_t)std::round(SNR_MAX / SNR_STEP);
+    p_DetectionProbability.assign(nSNR, 0.0);
+    for (size_t i = 0; i < nSNR; i++) {
+        double thetaMin = p_Settings.snrThreshold / ((i + 1) * SNR_STEP);
+        if (thetaMin <= 1.0) {
+            size_t index = std::upper_bound(thetas.begin(), thetas.end(), thetaMin) - thetas.begin();
+            p_DetectionProbability[i] = 1.0 - ((double)index - 1.0) / (double)N_THETAS;
+        }
+    }
+}
+
+
+/*
+ * Find the range of the metallicities of the systems evolved, and the number of systems
+ *
+ *
+ * void SystemMetallicities(const hid_t p_FileId, double& p_MinMetallicity, double& p_MaxMetallicity, size_t& p_nSystems)
+ *
+ * @param   [IN]    p_FileId                    HDF5 file id of the COMPAS output file
+ * @param   [OUT]   p_MinMetallicity            Minimum metallicity of the systems evolved
+ * @param   [OUT]   p_MaxMetallicity            Maximum metallicity of the systems evolved
+ * @param   [OUT]   p_nSystems                  Number of systems evolved
+ */
+void SystemMetallicities(const hid_t p_FileId, double& p_MinMetallicity, double& p_MaxMetallicity, size_t& p_nSystems) {
+
+    ColumnReader<double> metallicity(p_FileId, SP_GROUP + "Metallicity@ZAMS(1)", H5T_NATIVE_DOUBLE);
+    if (metallicity.Size() == 0) Fatal("no systems in " + SP_GROUP);
+
+    p_MinMetallicity = std::numeric_limits<double>::max();
+    p_MaxMetallicity = std::numeric_limits<double>::lowest();
+    for (; !metallicity.AtEnd(); metallicity.Advance()) {
+        double Z = metallicity.Value();
+        p_MinMetallicity = std::min(p_MinMetallicity, Z);
+        p_MaxMetallicity = std::max(p_MaxMetallicity, Z);
+    }
+
+    p_nSystems = metallicity.Size();
+}
+
+
+/*
+ * DCOReader - reads the DCOs from the COMPAS output file, and selects those of interest, a block at a time
+ * (as ClassCOMPAS.setCOMPASDCOmask() and ClassCOMPAS.setCOMPASData())
+ *
+ * DCOs are selected by type (--dco_type), and must merge in a Hubble time, must not have survived
+ * an optimistic common envelope, and must not have had immediate RLOF after a common envelope.
+ *
+ * The datasets are read a chunk at a time (see ColumnReader), and the DCO, common envelope and
+ * system parameters records are matched by SEED as they are read: COMPAS writes the records of
+ * the binaries in the order the binaries are evolved, so the system (and common envelopes) of each
+ * DCO are found by moving forward through the system parameters records.
+ */
+class DCOReader {
+
+public:
+
+    DCOReader(const hid_t p_FileId, const SettingsT& p_Settings);
+
+    bool NextBlock(DCOsT& p_DCOs, std::vector<unsigned char>& p_Mask);
+
+
+private:
+
+    bool FindSystem(const unsigned long p_Seed);
+
+
+    const SettingsT&                         m_Settings;
+
+    ColumnReader<unsigned long>              m_SystemSeed;
+    ColumnReader<double>                     m_SystemMetallicity;
+    std::unique_ptr<ColumnReader<double>>    m_SystemWeight;                                    // If --weight is a system parameters column
+
+    std::unique_ptr<ColumnReader<unsigned long>> m_CESeed;                                      // If the file has common envelopes
+    std::unique_ptr<ColumnReader<int>>       m_CEImmediateRLOF;
+    std::unique_ptr<ColumnReader<int>>       m_CEOptimistic;
+    bool                                     m_CEsRead;                                         // True if the common envelopes of the current system have been read
+    bool                                     m_CERejected;                                      // True if the current system had an optimistic CE, or immediate RLOF after a CE
+
+    ColumnReader<unsigned long>              m_Seed;
+    ColumnReader<int>                        m_Type1;
+    ColumnReader<int>                        m_Type2;
+    ColumnReader<int>                        m_MergesHubbleTime;
+    ColumnReader<double>                     m_Mass1;
+    ColumnReader<double>                     m_Mass2;
+    ColumnReader<double>                     m_Time;
+    ColumnReader<double>                     m_CoalescenceTime;
+    std::unique_ptr<ColumnReader<double>>    m_Weight;                                          // If --weight is a DCO column
+};
+
+
+DCOReader::DCOReader(const hid_t p_FileId, const SettingsT& p_Settings)
+    : m_Settings(p_Settings),
+      m_SystemSeed(p_FileId, SP_GROUP + "SEED", H5T_NATIVE_ULONG),
+      m_SystemMetallicity(p_FileId, SP_GROUP + "Metallicity@ZAMS(1)", H5T_NATIVE_DOUBLE),
+      m_CEsRead(false),
+      m_CERejected(false),
+      m_Seed(p_FileId, DCO_GROUP + "SEED", H5T_NATIVE_ULONG),
+      m_Type1(p_FileId, DCO_GROUP + "Stellar_Type(1)", H5T_NATIVE_INT),
+      m_Type2(p_FileId, DCO_GROUP + "Stellar_Type(2)", H5T_NATIVE_INT),
+      m_MergesHubbleTime(p_FileId, DCO_GROUP + "Merges_Hubble_Time", H5T_NATIVE_INT),
+      m_Mass1(p_FileId, DCO_GROUP + "Mass(1)", H5T_NATIVE_DOUBLE),
+      m_Mass2(p_FileId, DCO_GROUP + "Mass(2)", H5T_NATIVE_DOUBLE),
+      m_Time(p_FileId, DCO_GROUP + "Time", H5T_NATIVE_DOUBLE),
+      m_CoalescenceTime(p_FileId, DCO_GROUP + "Coalescence_Time", H5T_NATIVE_DOUBLE) {
+
+    if (p_Settings.dcoType != "all" && p_Settings.dcoType != "BBH" && p_Settings.dcoType != "BHNS" && p_Settings.dcoType != "BNS") {
+        Fatal("unknown DCO type '" + p_Settings.dcoType + "' (must be one of all, BBH, BHNS, BNS)");
+    }
+
+    if (ObjectExists(p_FileId, CE_GROUP + "SEED")) {
+        m_CESeed.reset(new ColumnReader<unsigned long>(p_FileId, CE_GROUP + "SEED", H5T_NATIVE_ULONG));
+        m_CEImmediateRLOF.reset(new ColumnReader<int>(p_FileId, CE_GROUP + "Immediate_RLOF>CE", H5T_NATIVE_INT));
+        m_CEOptimistic.reset(new ColumnReader<int>(p_FileId, CE_GROUP + "Optimistic_CE", H5T_NATIVE_INT));
+    }
+
+    if (!p_Settings.weightColumn.empty()) {                                                     // weights from the DCOs, else from the systems
+        if (ObjectExists(p_FileId, DCO_GROUP + p_Settings.weightColumn)) m_Weight.reset(new ColumnReader<double>(p_FileId, DCO_GROUP + p_Settings.weightColumn, H5T_NATIVE_DOUBLE));
+        else                                                             m_SystemWeight.reset(new ColumnReader<double>(p_FileId, SP_GROUP + p_Settings.weightColumn, H5T_NATIVE_DOUBLE));
+    }
+}
+
+
+/*
+ * Move forward through the system parameters records to the system with the SEED given
+ *
+ * The common envelope records of each system passed (and of the system found) are read, and
+ * m_CERejected set for the system found.
+ *
+ *
+ * bool FindSystem(const unsigned long p_Seed)
+ *
+ * @param   [IN]    p_Seed                      SEED of the system
+ * @return                                      True if the system was found, otherwise false
+ */
+bool DCOReader::FindSystem(const unsigned long p_Seed) {
+
+    while (!m_SystemSeed.AtEnd()) {
+
+        unsigned long seed = m_SystemSeed.Value();
+
+        if (!m_CEsRead) {                                                                       // common envelopes of the system
+            while (m_CESeed && !m_CESeed->AtEnd() && m_CESeed->Value() == seed) {
+                if (m_CEImmediateRLOF->Value() || m_CEOptimistic->Value()) m_CERejected = true;
+                m_CESeed->Advance();
+                m_CEImmediateRLOF->Advance();
+                m_CEOptimistic->Advance();
+            }
+            m_CEsRead = true;
+        }
+
+        if (seed == p_Seed) return true;                                                        // found
+
+        m_SystemSeed.Advance();                                                                 // next system
+        m_SystemMetallicity.Advance();
+        if (m_SystemWeight) m_SystemWeight->Advance();
+        m_CEsRead    = false;
+        m_CERejected = false;
+    }
+
+    return false;
+}
+
+
+/*
+ * Read the next block of DCOs, and select those of interest
+ *
+ * Reads DCO records until --block-size DCOs have been selected, READ_CHUNK_ROWS records have been
+ * read, or all records have been read.
+ *
+ *
+ * bool NextBlock(DCOsT& p_DCOs, std::vector<unsigned char>& p_Mask)
+ *
+ * @param   [OUT]   p_DCOs                      The DCOs selected
+ * @param   [OUT]   p_Mask                      Mask of the DCOs selected, per DCO record read
+ * @return                                      True if any DCO records were read, otherwise false (all records have been read)
+ */
+bool DCOReader::NextBlock(DCOsT& p_DCOs, std::vector<unsigned char>& p_Mask) {
+
+    p_DCOs = DCOsT();
+    p_Mask.clear();
+
+    while (!m_Seed.AtEnd() && p_DCOs.seed.size() < m_Settings.blockSize && p_Mask.size() < READ_CHUNK_ROWS) {
+
+        unsigned long seed = m_Seed.Value();
+        if (!FindSystem(seed)) Fatal("DCO SEED " + std::to_string(seed) + " not found in " + SP_GROUP + " (records must be in the order the binaries were evolved)");
+
+        int  type1 = m_Type1.Value();
+        int  type2 = m_Type2.Value();
+        bool BH1   = type1 == STELLAR_TYPE_BH, NS1 = type1 == STELLAR_TYPE_NS;
+        bool BH2   = type2 == STELLAR_TYPE_BH, NS2 = type2 == STELLAR_TYPE_NS;
+
+        bool selected = false;
+        if      (m_Settings.dcoType == "all")  selected = true;
+        else if (m_Settings.dcoType == "BBH")  selected = BH1 && BH2;
+        else if (m_Settings.dcoType == "BHNS") selected = (BH1 && NS2) || (NS1 && BH2);
+        else if (m_Settings.dcoType == "BNS")  selected = NS1 && NS2;
+
+        selected = selected && m_MergesHubbleTime.Value() && !m_CERejected;
+        p_Mask.push_back(selected);
+
+        if (selected) {
+            double mass1 = m_Mass1.Value();
+            double mass2 = m_Mass2.Value();
+            double M     = mass1 + mass2;
+
+            p_DCOs.seed.push_back(seed);
+            p_DCOs.metallicity.push_back(m_SystemMetallicity.Value());
+            p_DCOs.delayTime.push_back(m_Time.Value() + m_CoalescenceTime.Value());
+            p_DCOs.chirpMass.push_back(std::pow(mass1 * mass2, 0.6) / std::pow(M, 0.2));
+            p_DCOs.eta.push_back(mass1 * mass2 / (M * M));
+            p_DCOs.weight.push_back(m_Weight ? m_Weight->Value() : (m_SystemWeight ? m_SystemWeight->Value() : 1.0));
+        }
+
+        m_Seed.Advance();                                                                       // next DCO
+        m_Type1.Advance();
+        m_Type2.Advance();
+        m_MergesHubbleTime.Advance();
+        m_Mass1.Advance();
+        m_Mass2.Advance();
+        m_Time.Advance();
+        m_CoalescenceTime.Advance();
+        if (m_Weight) m_Weight->Advance();
+    }
+
+    return !p_Mask.empty();
+}
+
+
+/*
+ * Parse the command line
+ *
+ *
+ * SettingsT ParseCommandLine(int argc, char* argv[])
+ *
+ * @param   [IN]    argc                        Argument count
+ * @param   [IN]    argv                        Argument values
+ * @return                                      Program options
+ */
+SettingsT ParseCommandLine(int argc, char* argv[]) {
+
+    SettingsT settings;
+
+    const char* root = std::getenv("COMPAS_ROOT_DIR");
+    std::string defaultSNRGrid = (root ? std::string(root) + "/" : std::string("../")) + SNR_GRID_DEFAULT_PATH + SNR_GRID_FILE_NAME;
+
+    po::options_description options("Options");
+    options.add_options()
+        ("help,h",       "Print this help message")
+
+        ("path",         po::value<std::string>(&settings.path)->default_value("./"),                          "Path to the COMPAS file that contains the output")
+        ("filename",     po::value<std::string>(&settings.filename)->default_value("COMPAS_Output.h5"),        "Name of the COMPAS file")
+        ("dco_type",     po::value<std::string>(&settings.dcoType)->default_value("BBH"),                      "Which DCO type to calculate rates for, one of: all, BBH, BHNS, BNS")
+        ("weight",       po::value<std::string>(&settings.weightColumn)->default_value(""),                    "Name of column with sampling weights, e.g. 'Mixture_Weight' (leave empty for unweighted samples)")
+
+        ("maxz",         po::value<double>(&settings.maxRedshift)->default_value(10.0),                        "Maximum redshift to use in array")
+        ("zSF",          po::value<double>(&settings.zFirstSF)->default_value(10.0),                           "Redshift of first star formation")
+        ("maxzdet",      po::value<double>(&settings.maxRedshiftDetection)->default_value(1.0),                "Maximum redshift to calculate detection rates")
+        ("zstep",        po::value<double>(&settings.redshiftStep)->default_value(0.001),                      "Size of step to take in redshift")
+        ("sens",         po::value<std::string>(&settings.sensitivity)->default_value("O3"),                   "Which detector sensitivity to use: one of design, O1, O3")
+        ("snr",          po::value<double>(&settings.snrThreshold)->default_value(8.0),                        "What SNR threshold required for a detection")
+
+        ("m1min",        po::value<double>(&settings.m1Min)->default_value(5.0),                               "Minimum primary mass sampled by COMPAS")
+        ("m1max",        po::value<double>(&settings.m1Max)->default_value(150.0),                             "Maximum primary mass sampled by COMPAS")
+        ("m2min",        po::value<double>(&settings.m2Min)->default_value(0.1),                               "Minimum secondary mass sampled by COMPAS")
+        ("qmin",         po::value<double>(&settings.qMin)->default_value(0.01),                               "Minimum mass ratio sampled by COMPAS (--mass-ratio-min)")
+        ("qmax",         po::value<double>(&settings.qMax)->default_value(1.0),                                "Maximum mass ratio sampled by COMPAS (--mass-ratio-max)")
+        ("fbin",         po::value<double>(&settings.fBinary)->default_value(0.7),                             "Binary fraction used by COMPAS")
+
+        ("mu0",          po::value<double>(&settings.mu0)->default_value(0.035),                               "Mean metallicity at redshift 0")
+        ("muz",          po::value<double>(&settings.muz)->default_value(-0.23),                               "Redshift evolution of mean metallicity, dPdlogZ")
+        ("sigma0",       po::value<double>(&settings.sigma0)->default_value(0.39),                             "Variance in metallicity density distribution, dPdlogZ")
+        ("sigmaz",       po::value<double>(&settings.sigmaz)->default_value(0.0),                              "Redshift evolution of variance, dPdlogZ")
+        ("alpha",        po::value<double>(&settings.alpha)->default_value(0.0),                               "Skewness of metallicity density distribution, dPdlogZ")
+        ("aSF",          po::value<double>(&settings.aSF)->default_value(0.01),                                "Parameter for shape of SFR(z)")
+        ("bSF",          po::value<double>(&settings.bSF)->default_value(2.77),                                "Parameter for shape of SFR(z)")
+        ("cSF",          po::value<double>(&settings.cSF)->default_value(2.90),                                "Parameter for shape of SFR(z)")
+        ("dSF",          po::value<double>(&settings.dSF)->default_value(4.70),                                "Parameter for shape of SFR(z)")
+
+        ("dontAppend",   po::bool_switch(&settings.dontAppend)->default_value(false),                          "Prevent the rates being appended to the COMPAS file")
+        ("delete",       po::bool_switch(&settings.deleteRates)->default_value(false),                         "Delete the rate group from the COMPAS file (group name based on dP/dZ parameters)")
+
+        ("threads",      po::value<int>(&settings.nThreads)->default_value((int)std::max(1u, std::thread::hardware_concurrency())), "Number of worker threads")
+        ("block-size",   po::value<size_t>(&settings.blockSize)->default_value(256),                           "Number of DCOs processed (and written) per block")
+        ("snr-grid",     po::value<std::string>(&settings.snrGrid)->default_value(defaultSNRGrid),             "SNR grid file")
+        ("theta-seed",   po::value<unsigned long>(&settings.thetaSeed)->default_value(0),                      "Seed for the random orientations used for the detection probability")
+    ;
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, options), vm);
+        po::notify(vm);
+    }
+    catch (po::error& e) {
+        Fatal(e.what());
+    }
+
+    if (vm.count("help")) {
+        std::cout << "Native cosmic integration of COMPAS output (see FastCosmicIntegration.py)\n\n" << options << std::endl;
+        std::exit(EXIT_SUCCESS);
+    }
+
+    // sanity checks (as FastCosmicIntegration.find_detection_rate())
+    if (settings.maxRedshift <= 0.0 || settings.maxRedshiftDetection <= 0.0 || settings.redshiftStep <= 0.0) Fatal("redshifts must be positive");
+    if (settings.maxRedshiftDetection > settings.maxRedshift) Fatal("maximum detection redshift must be no greater than the maximum redshift");
+    if (settings.zFirstSF > settings.maxRedshift)             Fatal("redshift of first star formation must be no greater than the maximum redshift");
+    if (settings.m1Min <= 0.0 || settings.m1Max <= settings.m1Min || settings.m2Min < 0.0) Fatal("invalid COMPAS mass range");
+    if (settings.qMin < 0.0 || settings.qMax <= settings.qMin || settings.qMax > 1.0) Fatal("invalid COMPAS mass ratio range");
+    if (settings.fBinary <= 0.0 || settings.fBinary > 1.0)   Fatal("binary fraction must be in (0, 1]");
+    if (settings.sigma0 <= 0.0)                               Fatal("sigma0 must be positive");
+    if (settings.snrThreshold <= 0.0)                         Fatal("SNR threshold must be positive");
+    if (settings.nThreads < 1)                                Fatal("number of threads must be at least 1");
+    if (settings.blockSize < 1)                               Fatal("block size must be at least 1");
+
+    if (settings.redshiftStep > settings.maxRedshiftDetection) std::cerr << "WARNING: redshift step is greater than maximum detection redshift" << std::endl;
+
+    return settings;
+}
+
+
+int main(int argc, char* argv[]) {
+
+    auto wallStart = std::chrono::steady_clock::now();
+
+    SettingsT settings = ParseCommandLine(argc, argv);
+
+    std::string fileName  = settings.path + (settings.path.empty() || settings.path.back() == '/' ? "" : "/") + settings.filename;
+    std::string groupName = "Rates_mu0" + PyFloatStr(settings.mu0) + "_muz" + PyFloatStr(settings.muz) + "_alpha" + PyFloatStr(settings.alpha) +
+                            "_sigma0" + PyFloatStr(settings.sigma0) + "_sigmaz" + PyFloatStr(settings.sigmaz);
+
+    bool  append = !settings.dontAppend || settings.deleteRates;
+    hid_t file   = H5Fopen(fileName.c_str(), append ? H5F_ACC_RDWR : H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file < 0) Fatal("unable to open COMPAS file '" + fileName + "'");
+
+    if (settings.deleteRates) {                                                                 // delete the rates group and exit
+        if (H5Lexists(file, groupName.c_str(), H5P_DEFAULT) > 0) {
+            H5Ldelete(file, groupName.c_str(), H5P_DEFAULT);
+            std::cout << "Deleted " << groupName << " from " << fileName << std::endl;
+        }
+        else std::cout << groupName << " not found in " << fileName << std::endl;
+        H5Fclose(file);
+        return EXIT_SUCCESS;
+    }
+
+    // the systems evolved
+    double minMetallicity, maxMetallicity;
+    size_t nSystems;
+    SystemMetallicities(file, minMetallicity, maxMetallicity, nSystems);
+    if (minMetallicity == maxMetallicity) Fatal("cannot perform cosmic integration with just one metallicity");
+
+    // redshift grid, star formation and metallicity distribution
+    RedshiftGridT grid = CalculateRedshiftGrid(settings);
+    size_t nRedshifts  = grid.redshifts.size();
+    size_t nDetection  = grid.nDetection;
+
+    std::string massColumn;
+    double      sfMassNeeded = ReadMassDrawn(file, settings, massColumn);
+    if (sfMassNeeded >= 0.0) {                                                                  // mass drawn by COMPAS
+        sfMassNeeded *= StarFormingMassPerMassDrawn(settings);
+        std::cout << "Star forming mass from " << SFM_GROUP << massColumn << std::endl;
+    }
+    else {                                                                                      // no Star_Forming_Mass table (older COMPAS output)
+        std::cerr << "WARNING: no " << SFM_GROUP << " table in " << fileName << " - star forming mass calculated from the number of systems" << std::endl;
+        sfMassNeeded = StarFormingMassPerBinary(settings) * (double)nSystems;
+    }
+    std::cout << "Average_SF_mass_needed = " << sfMassNeeded << " Msol" << std::endl;
+
+    double pDrawMetallicity = 1.0 / (std::log(maxMetallicity) - std::log(minMetallicity));
+
+    DBL_VECTOR formedPerDraw(nRedshifts);                                                       // n_formed / p_draw_metallicity
+    for (size_t i = 0; i < nRedshifts; i++) {
+        double zp1 = 1.0 + grid.redshifts[i];
+        double sfr = settings.aSF * std::pow(zp1, settings.bSF) / (1.0 + std::pow(zp1 / settings.cSF, settings.dSF)) * 1.0E9;    // [Msol yr^-1 Gpc^-3]
+        formedPerDraw[i] = sfr / sfMassNeeded / pDrawMetallicity;
+    }
+
+    size_t nLogZ = (size_t)std::round((LOG_Z_MAX - LOG_Z_MIN) / LOG_Z_STEP) + 1;
+    DBL_VECTOR logZ(nLogZ), metallicities(nLogZ);
+    for (size_t k = 0; k < nLogZ; k++) {
+        logZ[k]          = LOG_Z_MIN + k * LOG_Z_STEP;
+        metallicities[k] = std::exp(logZ[k]);
+    }
+
+    MetallicityDistributionT               mssfr = MetallicityDistribution(settings, grid.redshifts, logZ);
+    std::unordered_map<size_t, DBL_VECTOR> dPdlogZ;                                             // ln(Z) grid index -> dP/dlogZ at each redshift, for the bins of the DCOs read
+
+    // detectability
+    DBL_VECTOR snrGrid, detectionProbability;
+    DetectionGrids(settings, snrGrid, detectionProbability);
+
+    size_t nEta = (size_t)std::round(ETA_MAX / ETA_STEP);
+    size_t nMc  = (size_t)std::round(MC_MAX / MC_STEP);
+    size_t nSNR = detectionProbability.size();
+
+    DBL_VECTOR volumeFactor(nDetection);                                                        // shell volume / (1 + z)
+    for (size_t j = 0; j < nDetection; j++) volumeFactor[j] = grid.shellVolumes[j] / (1.0 + grid.redshifts[j]);
+
+    // what is saved (as FastCosmicIntegration.append_rates()) - the per-DCO datasets are appended to a block at a time
+    size_t nSaveMerger    = (size_t)(std::upper_bound(grid.redshifts.begin(), grid.redshifts.end(), settings.maxRedshiftDetection) - grid.redshifts.begin()) - 1;
+    size_t nSaveDetection = std::min(nSaveMerger, nDetection);
+    std::string detectionName = "detection_rate" + settings.sensitivity;
+
+    hid_t group = -1, seedDataset = -1, maskDataset = -1, mergerZ0Dataset = -1, mergerDataset = -1, detectionDataset = -1;
+    if (append) {
+        group = H5Lexists(file, groupName.c_str(), H5P_DEFAULT) > 0 ? H5Gopen(file, groupName.c_str(), H5P_DEFAULT)
+                                                                    : H5Gcreate(file, groupName.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        if (group < 0) Fatal("unable to create group '" + groupName + "'");
+
+        seedDataset      = CreateDataset(group, "SEED", H5T_NATIVE_ULONG, { 0 }, true);
+        maskDataset      = CreateDataset(group, "DCOmask", H5T_NATIVE_UCHAR, { 0 }, true);
+        mergerZ0Dataset  = CreateDataset(group, "merger_rate_z0", H5T_NATIVE_DOUBLE, { 0 }, true);
+        mergerDataset    = CreateDataset(group, "merger_rate", H5T_NATIVE_DOUBLE, { 0, (hsize_t)nSaveMerger }, true);
+        detectionDataset = CreateDataset(group, detectionName, H5T_NATIVE_DOUBLE, { 0, (hsize_t)nSaveDetection }, true);
+    }
+
+    // the integration - blocks of DCOs, each shared between the worker threads
+    DBL_VECTOR formationTotal(nRedshifts, 0.0);
+    DBL_VECTOR mergerTotal(nRedshifts, 0.0);
+    DBL_VECTOR detectionTotal(nDetection, 0.0);
+
+    size_t              blockSize = settings.blockSize;
+    DBL_VECTOR          formationBlock(blockSize * nRedshifts);
+    DBL_VECTOR          mergerBlock(blockSize * nRedshifts);
+    DBL_VECTOR          detectionBlock(blockSize * std::max(nDetection, (size_t)1));
+    DBL_VECTOR          mergerZ0Block(blockSize);
+    std::vector<size_t> zIndex(blockSize);
+
+    double redshiftStep = grid.redshifts.size() > 1 ? grid.redshifts[1] - grid.redshifts[0] : settings.redshiftStep;
+
+    DCOReader                  reader(file, settings);
+    DCOsT                      dcos;
+    std::vector<unsigned char> mask;
+    size_t                     nDCOs = 0;
+
+    while (reader.NextBlock(dcos, mask)) {
+
+        size_t nBlock = dcos.seed.size();
+
+        for (size_t b = 0; b < nBlock; b++) {                                                   // np.digitize(Z, metallicities)
+            zIndex[b] = std::min((size_t)(std::upper_bound(metallicities.begin(), metallicities.end(), dcos.metallicity[b]) - metallicities.begin()), nLogZ - 1);
+            if (dPdlogZ.find(zIndex[b]) == dPdlogZ.end()) dPdlogZ[zIndex[b]] = MetallicityDistributionColumn(settings, mssfr, logZ[zIndex[b]]);
+        }
+
+        ParallelFor(nBlock, settings.nThreads, [&](size_t p_Begin, size_t p_End) {
+            for (size_t b = p_Begin; b < p_End; b++) {
+                double* formation = &formationBlock[b * nRedshifts];
+                double* merger    = &mergerBlock[b * nRedshifts];
+                double* detection = &detectionBlock[b * nDetection];
+
+                // formation rate (Neijssel+19 Section 4)
+                const double* dP     = dPdlogZ.at(zIndex[b]).data();
+                double        weight = dcos.weight[b];
+                for (size_t j = 0; j < nRedshifts; j++) formation[j] = formedPerDraw[j] * dP[j] * weight;
+
+                // merger rate - the formation rate at the redshift of formation
+                std::fill(merger, merger + nRedshifts, 0.0);
+
+                double delay  = dcos.delayTime[b];
+                size_t nEarly = 0;                                                              // number of formation times after first star formation
+                while (nEarly < nRedshifts && grid.times[nEarly] - delay > grid.timeFirstSF) nEarly++;
+                if (nEarly == nRedshifts) nEarly++;
+
+                size_t k = 0;
+                for (size_t j = 0; j + 1 < nEarly; j++) {
+                    double t = grid.times[j] - delay;                                           // time of formation
+                    while (k + 2 < nRedshifts && grid.times[k + 1] > t) k++;                    // times[k] >= t >= times[k + 1]
+                    double zForm = grid.redshifts[k] + (t - grid.times[k]) * (grid.redshifts[k + 1] - grid.redshifts[k]) / (grid.times[k + 1] - grid.times[k]);
+                    merger[j] = formation[std::min((size_t)std::ceil(zForm / redshiftStep), nRedshifts - 1)];
+                }
+
+                // detection rate (Neijssel+19 Eq. 2)
+                size_t etaIndex = (size_t)std::min(std::max(std::nearbyint(dcos.eta[b] / ETA_STEP) - 1.0, 0.0), (double)(nEta - 1));
+                const double* snrRow = &snrGrid[etaIndex * nMc];
+                for (size_t j = 0; j < nDetection; j++) {
+                    double mcIndex = std::max(std::nearbyint(dcos.chirpMass[b] * (1.0 + grid.redshifts[j]) / MC_STEP) - 1.0, 0.0);
+                    double snr     = (mcIndex < (double)nMc ? snrRow[(size_t)mcIndex] : SNR_BEYOND_GRID) / grid.distances[j];
+                    double pIndex  = std::nearbyint(snr / SNR_STEP) - 1.0;
+                    double pDetect = pIndex < 0.0 ? 0.0 : (pIndex < (double)nSNR ? detectionProbability[(size_t)pIndex] : 1.0);
+                    detection[j]   = merger[j] * pDetect * volumeFactor[j];
+                }
+            }
+        });
+
+        // totals, in DCO order so results do not depend on the number of threads
+        for (size_t b = 0; b < nBlock; b++) {
+            const double* formation = &formationBlock[b * nRedshifts];
+            const double* merger    = &mergerBlock[b * nRedshifts];
+            const double* detection = &detectionBlock[b * nDetection];
+            for (size_t j = 0; j < nRedshifts; j++) formationTotal[j] += formation[j];
+            for (size_t j = 0; j < nRedshifts; j++) mergerTotal[j]    += merger[j];
+            for (size_t j = 0; j < nDetection; j++) detectionTotal[j] += detection[j];
+            mergerZ0Block[b] = merger[0];
+        }
+
+        if (append) {
+            AppendRows(maskDataset, H5T_NATIVE_UCHAR, mask.size(), 1, 1, mask.data());
+            AppendRows(seedDataset, H5T_NATIVE_ULONG, nBlock, 1, 1, dcos.seed.data());
+            AppendRows(mergerZ0Dataset, H5T_NATIVE_DOUBLE, nBlock, 1, 1, mergerZ0Block.data());
+            AppendRows(mergerDataset, H5T_NATIVE_DOUBLE, nBlock, nSaveMerger, nRedshifts, mergerBlock.data());
+            AppendRows(detectionDataset, H5T_NATIVE_DOUBLE, nBlock, nSaveDetection, nDetection, detectionBlock.data());
+        }
+
+        nDCOs += nBlock;
+    }
+
+    double totalMergerRateZ0  = nRedshifts > 0 ? mergerTotal[0] : 0.0;
+    double totalDetectionRate = 0.0;
+    for (double rate : detectionTotal) totalDetectionRate += rate;
+
+    std::cout << nDCOs << " " << settings.dcoType << " DCOs of " << nSystems << " systems" << std::endl;
+    std::cout << "Merger rate at z = 0  = " << totalMergerRateZ0 << " Gpc^-3 yr^-1" << std::endl;
+    std::cout << "Detection rate (" << settings.sensitivity << ")   = " << totalDetectionRate << " yr^-1" << std::endl;
+
+    if (append) {
+        H5Dclose(detectionDataset);
+        H5Dclose(mergerDataset);
+        H5Dclose(mergerZ0Dataset);
+        H5Dclose(maskDataset);
+        H5Dclose(seedDataset);
+
+        WriteDataset(group, "redshifts", H5T_NATIVE_DOUBLE, nRedshifts, grid.redshifts.data());
+        WriteDataset(group, "formation_rate_total", H5T_NATIVE_DOUBLE, nRedshifts, formationTotal.data());
+        WriteDataset(group, "merger_rate_total", H5T_NATIVE_DOUBLE, nRedshifts, mergerTotal.data());
+        WriteDataset(group, detectionName + "_total", H5T_NATIVE_DOUBLE, nDetection, detectionTotal.data());
+
+        H5Gclose(group);
+        std::cout << "Rates written to " << fileName << ", group " << groupName << std::endl;
+    }
+
+    H5Fclose(file);
+
+    double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    std::cout << "Cosmic integration took " << wallTime << " seconds (" << settings.nThreads << " threads)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -9,7 +9,7 @@
 typedef std::tuple<bool, COMPAS_VARIABLE_TYPE> COMPAS_VARIABLE;
 typedef std::initializer_list<STELLAR_TYPE>    STELLAR_TYPE_LIST;
 typedef std::initializer_list<SN_EVENT>        SN_EVENT_LIST;
-typedef std::vector<STELLAR_TYPE>              STYPE_VECTOR;
+typedef std::vector<STELLAR_TYPE, ArenaAllocator<STELLAR_TYPE>> STYPE_VECTOR;   // allocates from the current arena, if any (see Arena.h)
 
 
 // Log file details
@@ -25,6 +25,23 @@ typedef struct LogfileDetails {
 } LogfileDetailsT;
 
 
+// Summary table column details (see Log::WriteSummaryTable())
+typedef struct SummaryTableColumn {
+    std::string                       header;               // column header
+    std::string                       units;                // units string
+    TYPENAME                          dataType;             // COMPAS data type of the values
+    std::vector<COMPAS_VARIABLE_TYPE> values;               // column values - one per row
+} SummaryTableColumnT;
+
+
+// Record filter term - property <operator> value (see Log::ParseRecordFilter())
+typedef struct PropertyFilter {
+    T_ANY_PROPERTY  property;                               // property compared
+    FILTER_OPERATOR op;                                     // comparison operator
+    double          value;                                  // value compared against (booleans are 0.0 or 1.0)
+} PropertyFilterT;
+
+
 // Grid file details
 typedef struct Gridfile {
     std::string   filename;                                 // filename for grid file
@@ -38,6 +55,15 @@ typedef struct Gridfile {
 } GridfileT;
 
 
+// Initial conditions drawn for a binary - kept for star-forming mass accounting (see StarFormingMass.h)
+typedef struct InitialConditionsDraw {
+    double mass;                                            // total mass (Msol) of the draw
+    double metallicity;                                     // metallicity of the draw
+    bool   accepted;                                        // true if the binary was evolved from the draw, false if the draw was rejected
+    double weight;                                          // importance sampling weight of the draw (1.0 unless drawn by AIS)
+} InitialConditionsDrawT;
+
+
 // RotationalVelocityParams struct for gsl root solver
 struct RotationalVelocityParams {                           // Structure containing parameter (u) for the root solving function using gsl_root_solver
     double u;                                               // Value of CDF, draw in U(0,1)
@@ -253,6 +279,43 @@ typedef struct BinaryCEDetails {                            // Common Envelope d
 } BinaryCEDetailsT;
 
 
+// Sampled logfiles: detailed output decimation (see program options --detailed-output-tolerance and --detailed-output-interval),
+// and pulsar evolution and Be binary sampling (see program options --pulsar-evolution-sampling and --be-binary-sampling)
+typedef struct LogfileSnapshot {                            // binary state when the last record of a sampled logfile was written
+    bool                valid;                              // false until the first record is written
+    bool                pending;                            // true if a record has been skipped since the last record was written
+    double              time;                               // simulation time
+    STELLAR_TYPE        stellarType1;                       // event state...
+    STELLAR_TYPE        stellarType2;
+    bool                isRLOF1;
+    bool                isRLOF2;
+    unsigned int        CEEcount;
+    SN_STATE            SNState;
+    MT_TRACKING         MTHistory;
+    std::vector<double> values;                             // monitored property values
+} LogfileSnapshotT;
+
+
+// Per-system drawn option values (see Options::OptionValues::SetCalculatedOptionDefaults())
+// These are held outside the Boost variables map, which is not modified after the options are parsed
+typedef struct DrawnParameter {
+    bool   drawn;                                           // true if the value is drawn from a distribution for each system (user did not specify a value)
+    double value;                                           // value for the current system - drawn, or the user-specified value
+} DrawnParameterT;
+
+typedef struct DrawnParameters {
+    DrawnParameterT kickMagnitudeRandom;
+    DrawnParameterT kickMagnitudeRandom1;
+    DrawnParameterT kickMagnitudeRandom2;
+    DrawnParameterT kickMeanAnomaly1;
+    DrawnParameterT kickMeanAnomaly2;
+    DrawnParameterT kickPhi1;
+    DrawnParameterT kickPhi2;
+    DrawnParameterT kickTheta1;
+    DrawnParameterT kickTheta2;
+} DrawnParametersT;
+
+
 typedef struct StellarCEESavedValues {
     double       bindingEnergy;
     double       dynamicalTimescale;
@@ -2,7 +2,13 @@
 #include <stdarg.h>
 #include <fstream>
 #include <algorithm>
+#include <cctype>
 #include <cstring>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <sys/resource.h>
+#include <unistd.h>
 #include "profiling.h"
 #include "utils.h"
 #include "Rand.h"
@@ -264,16 +270,21 @@ namespace utils {
      * Note that std::string has an == operator to test for equality (actually calls std::strcmp)
      *
      *
-     * bool Equals(std::string p_Str1, std::string p_Str2)
+     * bool Equals(const std::string& p_Str1, const std::string& p_Str2)
      *
      * @param   [IN]    p_Str1                      String to be compared
      * @param   [IN]    p_Str2                      String to be compared
      * @return                                      Boolean indicating equality (true = equal)
      */
-    bool Equals(std::string p_Str1, std::string p_Str2) {
-        std::transform(p_Str1.begin(), p_Str1.end(), p_Str1.begin(), ::tolower);
-        std::transform(p_Str2.begin(), p_Str2.end(), p_Str2.begin(), ::tolower);
-        return (std::strcmp(p_Str1.c_str(), p_Str2.c_str()) == 0);
+    bool Equals(const std::string& p_Str1, const std::string& p_Str2) {
+
+        if (p_Str1.size() != p_Str2.size()) return false;                                           // different lengths - not equal
+
+        for (size_t i = 0; i < p_Str1.size(); i++) {                                                // compare characters, without copying the strings
+            if (std::tolower(static_cast<unsigned char>(p_Str1[i])) != std::tolower(static_cast<unsigned char>(p_Str2[i]))) return false;
+        }
+
+        return true;
     }
 
 
@@ -306,6 +317,128 @@ namespace utils {
     }
 
 
+    /*
+     * Calculate the SHA-256 digest of the contents of a file
+     *
+     * The digest is calculated as specified in FIPS 180-4.  The file is read in blocks of 1 MiB,
+     * so files of any size can be digested.
+     *
+     * Used to store a reference to an input file (rather than a copy) in the output container -
+     * see program option --store-input-files-mode.
+     *
+     *
+     * std::tuple<ERROR, std::string> FileSHA256(const std::string& p_Filename)
+     *
+     * @param   [IN]    p_Filename                  Filename of the file to be digested - should be fully qualified
+     * @return                                      Tuple containing error value and the digest (as 64 lowercase hexadecimal digits)
+     *                                              Error value will be one of:
+     *                                                ERROR::NONE if no error occurred
+     *                                                ERROR::FILE_OPEN_ERROR if the file could not be opened
+     *                                                ERROR::FILE_READ_ERROR if the file could not be read
+     *                                              If the error returned is not ERROR:NONE, the digest returned is empty
+     */
+    std::tuple<ERROR, std::string> FileSHA256(const std::string& p_Filename) {
+
+        static const std::uint32_t K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+
+        std::uint32_t H[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+        auto rotr = [](const std::uint32_t x, const int n) { return (x >> n) | (x << (32 - n)); };
+
+        auto compress = [&](const unsigned char* p_Block) {                                                 // process one 64-byte block
+            std::uint32_t W[64];
+            for (int t = 0; t < 16; t++) {
+                W[t] = (std::uint32_t(p_Block[4 * t]) << 24) | (std::uint32_t(p_Block[4 * t + 1]) << 16) | (std::uint32_t(p_Block[4 * t + 2]) << 8) | std::uint32_t(p_Block[4 * t + 3]);
+            }
+            for (int t = 16; t < 64; t++) {
+                std::uint32_t s0 = rotr(W[t - 15], 7) ^ rotr(W[t - 15], 18) ^ (W[t - 15] >> 3);
+                std::uint32_t s1 = rotr(W[t - 2], 17) ^ rotr(W[t - 2], 19) ^ (W[t - 2] >> 10);
+                W[t] = W[t - 16] + s0 + W[t - 7] + s1;
+            }
+
+            std::uint32_t a = H[0], b = H[1], c = H[2], d = H[3], e = H[4], f = H[5], g = H[6], h = H[7];
+            for (int t = 0; t < 64; t++) {
+                std::uint32_t T1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[t] + W[t];
+                std::uint32_t T2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                h = g; g = f; f = e; e = d + T1; d = c; c = b; b = a; a = T1 + T2;
+            }
+            H[0] += a; H[1] += b; H[2] += c; H[3] += d; H[4] += e; H[5] += f; H[6] += g; H[7] += h;
+        };
+
+        std::ifstream file(p_Filename, std::ios::in | std::ios::binary);
+        if (!file) return std::make_tuple(ERROR::FILE_OPEN_ERROR, "");
+
+        std::vector<unsigned char> buffer(1 << 20);                                                         // read buffer - a multiple of the block size
+        std::uint64_t length = 0;                                                                           // message length (bytes)
+        std::size_t   nBytes = 0;                                                                           // bytes in the final (partial) buffer
+
+        while (true) {
+            file.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+            nBytes  = static_cast<std::size_t>(file.gcount());
+            length += nBytes;
+            if (file.bad()) return std::make_tuple(ERROR::FILE_READ_ERROR, "");
+            if (nBytes < buffer.size()) break;                                                              // end of file
+            for (std::size_t i = 0; i < nBytes; i += 64) compress(&buffer[i]);
+            nBytes = 0;
+        }
+
+        std::size_t nFull = nBytes - nBytes % 64;                                                           // full blocks in the final buffer
+        for (std::size_t i = 0; i < nFull; i += 64) compress(&buffer[i]);
+
+        unsigned char tail[128] = {};                                                                       // remaining bytes plus padding - one or two blocks
+        std::size_t   nTail     = nBytes - nFull;
+        std::memcpy(tail, &buffer[nFull], nTail);
+        tail[nTail] = 0x80;
+        std::size_t tailSize = nTail < 56 ? 64 : 128;
+        std::uint64_t nBits = length * 8;
+        for (int i = 0; i < 8; i++) tail[tailSize - 1 - i] = static_cast<unsigned char>(nBits >> (8 * i));
+        for (std::size_t i = 0; i < tailSize; i += 64) compress(&tail[i]);
+
+        std::ostringstream digest;
+        for (auto &word: H) digest << std::hex << std::setfill('0') << std::setw(8) << word;
+
+        return std::make_tuple(ERROR::NONE, digest.str());
+    }
+
+
+    /*
+     * Determine whether a value satisfies a record filter term
+     *
+     * Filter terms are of the form value <operator> filter value - see PropertyFilterT in typedefs.h.
+     * A value of NaN (e.g. a property that can't be expressed as a number) never satisfies the term.
+     *
+     *
+     * bool FilterPasses(const PropertyFilterT& p_Filter, const double p_Value)
+     *
+     * @param   [IN]    p_Filter                    The filter term
+     * @param   [IN]    p_Value                     The value of the filter property
+     * @return                                      Boolean indicating whether p_Value satisfies the filter term
+     */
+    bool FilterPasses(const PropertyFilterT& p_Filter, const double p_Value) {
+
+        if (std::isnan(p_Value)) return false;                          // not a number - fails
+
+        switch (p_Filter.op) {
+            case FILTER_OPERATOR::EQ: return p_Value == p_Filter.value;
+            case FILTER_OPERATOR::NE: return p_Value != p_Filter.value;
+            case FILTER_OPERATOR::LE: return p_Value <= p_Filter.value;
+            case FILTER_OPERATOR::GE: return p_Value >= p_Filter.value;
+            case FILTER_OPERATOR::LT: return p_Value <  p_Filter.value;
+            case FILTER_OPERATOR::GT: return p_Value >  p_Filter.value;
+            default                 : return false;                     // unknown operator - shouldn't happen
+        }
+    }
+
+
     /*
      * Calculate x^y where x is double and y is an integer
      *
@@ -342,19 +475,33 @@ namespace utils {
      * @return                              Drawn sample
      */
     double InverseSampleFromPowerLaw(const double p_Power, const double p_Xmax, const double p_Xmin) {
+        return InverseSampleFromPowerLaw(p_Power, p_Xmax, p_Xmin, RAND->Random());     // Draw a random number between 0 and 1
+    }
 
-        double result;
 
-        double rand = RAND->Random();                   // Draw a random number between 0 and 1
+    /*
+     * Transform a uniform deviate to a sample from a power law distribution p(x) ~ x^(n) between p_Xmin and p_Xmax
+     *
+     * double InverseSampleFromPowerLaw(const double p_Power, const double p_Xmax, const double p_Xmin, const double p_Rand)
+     *
+     * @param   [IN]    p_Power             The power for the power law
+     * @param   [IN]    p_Xmax              Maximum of the X-interval from which to sample
+     * @param   [IN]    p_Xmin              Minimum of the X-interval from which to sample
+     * @param   [IN]    p_Rand              Uniform deviate in [0, 1) - the value of the CDF at the sample
+     * @return                              Sample
+     */
+    double InverseSampleFromPowerLaw(const double p_Power, const double p_Xmax, const double p_Xmin, const double p_Rand) {
+
+        double result;
 
         if (p_Power == -1.0) {                          // JR: todo: find a better way of doing this
-            result = exp(rand * log(p_Xmax / p_Xmin)) * p_Xmin;
+            result = exp(p_Rand * log(p_Xmax / p_Xmin)) * p_Xmin;
         }
         else {
             double powerPlus1     = p_Power + 1.0;
             double min_powerPlus1 = PPOW(p_Xmin, powerPlus1);
 
-            result = PPOW((rand * (PPOW(p_Xmax, powerPlus1) - min_powerPlus1) + min_powerPlus1), 1.0 / powerPlus1);
+            result = PPOW((p_Rand * (PPOW(p_Xmax, powerPlus1) - min_powerPlus1) + min_powerPlus1), 1.0 / powerPlus1);
         }
 
         return result;
@@ -681,6 +828,161 @@ namespace utils {
     }
 
 
+    /*
+     * Calculate a point of a scrambled low-discrepancy (quasi-random) sequence in the unit cube
+     *
+     * The point is calculated directly from its index - there is no generator state - so a given
+     * index always gives the same point.  Populations evolved in several runs (e.g. runs with
+     * --random-seed offsets) together form a single sequence, provided all runs use the same
+     * scramble seed.
+     *
+     *    SOBOL : Sobol' sequence (Joe & Kuo 2008 direction numbers) in natural (not Gray code)
+     *            order, with a hash-based nested uniform (Owen) scramble (Burley 2020)
+     *    HALTON: Halton sequence (the bases are the first QUASI_RANDOM_DIMENSIONS primes), with
+     *            a random shift modulo 1 (Cranley & Patterson 1976)
+     *
+     * The scramble depends only on the scramble seed and the dimension, so it is common to all
+     * points of the sequence.  Only the low 32 bits of the index are used.
+     *
+     *
+     * DBL_VECTOR QuasiRandomPoint(const QUASI_RANDOM_SEQUENCE p_Sequence, const unsigned long int p_Index, const unsigned long int p_ScrambleSeed)
+     *
+     * @param   [IN]    p_Sequence                  The sequence (NONE is not valid)
+     * @param   [IN]    p_Index                     Index of the point in the sequence
+     * @param   [IN]    p_ScrambleSeed              Seed for the scramble
+     * @return                                      Point in [0, 1)^QUASI_RANDOM_DIMENSIONS (see QUASI_RANDOM_DIMENSION for the order of the coordinates)
+     */
+    DBL_VECTOR QuasiRandomPoint(const QUASI_RANDOM_SEQUENCE p_Sequence, const unsigned long int p_Index, const unsigned long int p_ScrambleSeed) {
+
+        // Sobol' direction numbers, calculated once
+        // dimension 1 is the van der Corput sequence; dimensions 2.. are from the {s, a, m_1..m_s}
+        // primitive polynomial parameters of Joe & Kuo (2008) (new-joe-kuo-6.21201)
+        static const std::vector<std::vector<uint32_t>> sobolDirections = [] {
+            const std::vector<std::vector<uint32_t>> parameters = { {1, 0, 1}, {2, 1, 1, 3}, {3, 1, 1, 3, 1}, {3, 2, 1, 1, 1} };
+
+            std::vector<std::vector<uint32_t>> directions(QUASI_RANDOM_DIMENSIONS, std::vector<uint32_t>(32, 0));
+            for (int j = 0; j < 32; j++) directions[0][j] = 1u << (31 - j);
+
+            for (int d = 1; d < QUASI_RANDOM_DIMENSIONS; d++) {
+                uint32_t sDegree = parameters[d - 1][0];
+                uint32_t aCoeffs = parameters[d - 1][1];
+                for (uint32_t j = 0; j < 32; j++) {
+                    if (j < sDegree) directions[d][j] = parameters[d - 1][j + 2] << (31 - j);
+                    else {
+                        directions[d][j] = directions[d][j - sDegree] ^ (directions[d][j - sDegree] >> sDegree);
+                        for (uint32_t k = 1; k < sDegree; k++) {
+                            if ((aCoeffs >> (sDegree - 1 - k)) & 1u) directions[d][j] ^= directions[d][j - k];
+                        }
+                    }
+                }
+            }
+            return directions;
+        }();
+
+        static const int haltonBases[QUASI_RANDOM_DIMENSIONS] = { 2, 3, 5, 7, 11 };
+
+        DBL_VECTOR point(QUASI_RANDOM_DIMENSIONS, 0.0);
+
+        uint32_t index = (uint32_t)p_Index;
+
+        for (int d = 0; d < QUASI_RANDOM_DIMENSIONS; d++) {
+
+            uint64_t hash = (uint64_t)p_ScrambleSeed * 0x9E3779B97F4A7C15ull + (uint64_t)(d + 1) * 0xBF58476D1CE4E5B9ull;   // scramble for this dimension (splitmix64 finaliser)
+            hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+            hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+            hash =  hash ^ (hash >> 31);
+
+            switch (p_Sequence) {
+
+                case QUASI_RANDOM_SEQUENCE::SOBOL: {
+                    uint32_t x = 0;
+                    for (uint32_t n = index, j = 0; n != 0; n >>= 1, j++) {
+                        if (n & 1u) x ^= sobolDirections[d][j];
+                    }
+
+                    // nested uniform scramble: Laine-Karras permutation of the bit-reversed value
+                    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+                    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+                    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+                    x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+                    x = (x >> 16) | (x << 16);
+
+                    x += (uint32_t)hash;
+                    x ^= x * 0x6C50B47Cu;
+                    x ^= x * 0xB82F1E52u;
+                    x ^= x * 0xC7AFE638u;
+                    x ^= x * 0x8D22F6E6u;
+
+                    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+                    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+                    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+                    x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+                    x = (x >> 16) | (x << 16);
+
+                    point[d] = ((double)x + 0.5) / 4294967296.0;                                    // centre of the 2^-32 interval
+                } break;
+
+                case QUASI_RANDOM_SEQUENCE::HALTON: {
+                    double base    = (double)haltonBases[d];
+                    double inverse = 0.0;
+                    double factor  = 1.0 / base;
+                    for (uint32_t n = index; n != 0; n /= haltonBases[d]) {                         // radical inverse of the index
+                        inverse += factor * (double)(n % haltonBases[d]);
+                        factor  /= base;
+                    }
+                    double shift = (double)(hash >> 11) / 9007199254740992.0;                       // 53-bit shift in [0, 1)
+                    point[d] = inverse + shift;
+                    if (point[d] >= 1.0) point[d] -= 1.0;
+                } break;
+
+                default:                                                                            // NONE - not a sequence
+                    point[d] = 0.0;
+            }
+        }
+
+        return point;
+    }
+
+
+    /*
+     * Get the resident set size (physical memory in use) of the program
+     *
+     * The current resident set size is read from /proc/self/statm (Linux only - on other systems
+     * the peak resident set size is returned as the current size).  The peak resident set size is
+     * from getrusage().
+     *
+     * Used for memory footprint reporting - see program options --memory-report-interval and --memory-budget.
+     *
+     *
+     * std::tuple<std::size_t, std::size_t> ResidentSetSize()
+     *
+     * @return                                      Tuple containing the current and peak resident set sizes (bytes) - 0 if not available
+     */
+    std::tuple<std::size_t, std::size_t> ResidentSetSize() {
+
+        std::size_t peak = 0;
+
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+            peak = static_cast<std::size_t>(usage.ru_maxrss);                                           // bytes on macOS
+#else
+            peak = static_cast<std::size_t>(usage.ru_maxrss) * 1024;                                    // KiB on Linux
+#endif
+        }
+
+        std::size_t current = peak;                                                                     // default - peak
+
+#if defined(__linux__)
+        std::ifstream statm("/proc/self/statm");
+        unsigned long int totalPages, residentPages;
+        if (statm >> totalPages >> residentPages) current = static_cast<std::size_t>(residentPages) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+
+        return std::make_tuple(current, peak);
+    }
+
+
     /*
      * Trim leading whitespace characters from a string.
      *
@@ -815,43 +1117,72 @@ namespace utils {
                 eccentricity = 0.0;
                 break;
 
+            case ECCENTRICITY_DISTRIBUTION::FLAT:                                                       // inverse transform sampling
+            case ECCENTRICITY_DISTRIBUTION::THERMAL:
+            case ECCENTRICITY_DISTRIBUTION::GELLER_2013:
+            case ECCENTRICITY_DISTRIBUTION::DUQUENNOYMAYOR1991:
+            case ECCENTRICITY_DISTRIBUTION::SANA2012:
+                eccentricity = SampleEccentricity(p_Edist, p_Max, p_Min, RAND->Random());               // draw a random number between 0 and 1
+                break;
+
+            default:                                                                                    // unknown distribution - should not be possible (options code should prevent this)
+                eccentricity = 0.0;
+        }
+
+        return eccentricity;
+    }
+
+
+    /*
+     * Transform a uniform deviate to an eccentricity drawn from the distribution specified by the user
+     *
+     *
+     * double SampleEccentricity(const ECCENTRICITY_DISTRIBUTION p_Edist, const double p_Max, const double p_Min, const double p_Rand)
+     *
+     * @param   [IN]    p_Edist                     The eccentricity distribution to use to draw the eccentricity
+     * @param   [IN]    p_Max                       Distribution maximum
+     * @param   [IN]    p_Min                       Distribution minimum
+     * @param   [IN]    p_Rand                      Uniform deviate in [0, 1)
+     * @return                                      Eccentricity
+     */
+    double SampleEccentricity(const ECCENTRICITY_DISTRIBUTION p_Edist, const double p_Max, const double p_Min, const double p_Rand) {
+
+        double eccentricity;
+
+        switch (p_Edist) {                                                                              // which distribution?
+
             case ECCENTRICITY_DISTRIBUTION::FLAT:                                                       // FLAT
-                eccentricity = utils::InverseSampleFromPowerLaw(0.0, p_Max, p_Min);
+                eccentricity = utils::InverseSampleFromPowerLaw(0.0, p_Max, p_Min, p_Rand);
                 break;
 
             case ECCENTRICITY_DISTRIBUTION::THERMAL:                                                    // THERMAL eccentricity distribution p(e) = 2e
-                eccentricity = utils::InverseSampleFromPowerLaw(1.0, p_Max, p_Min);
+                eccentricity = utils::InverseSampleFromPowerLaw(1.0, p_Max, p_Min, p_Rand);
+                break;
+
+            case ECCENTRICITY_DISTRIBUTION::SANA2012:                                                   // Sana et al 2012
+                // (http://science.sciencemag.org/content/sci/337/6093/444.full.pdf) distribution of eccentricities.
+                // Taken from table S3 in http://science.sciencemag.org/content/sci/suppl/2012/07/25/337.6093.444.DC1/1223344.Sana.SM.pdf
+                // See also de Mink and Belczynski 2015 http://arxiv.org/pdf/1506.03573v2.pdf
+
+                eccentricity = utils::InverseSampleFromPowerLaw(-0.42, p_Max, p_Min, p_Rand);
                 break;
 
             case ECCENTRICITY_DISTRIBUTION::GELLER_2013:                                                // M35 eccentricity distribution from Geller, Hurley and Mathieu 2013
-                // Gaussian with mean 0.38 and sigma 0.23
+                // Gaussian with mean 0.38 and sigma 0.23, truncated to [min, max]
                 // http://iopscience.iop.org/article/10.1088/0004-6256/145/1/8/pdf
-                // Sampling function taken from binpop.f in NBODY6
 
-                do {
-                    eccentricity = 0.23 * sqrt(-2.0 * log(RAND->Random())) * cos(2.0 * M_PI * RAND->Random()) + 0.38;
-                } while (eccentricity < p_Min || eccentricity > p_Max);                                 // JR: don't use utils::Compare() here
+                eccentricity = Rand::TruncatedGaussianInverseCDF(0.38, 0.23, p_Min, p_Max, p_Rand);
                 break;
 
             case ECCENTRICITY_DISTRIBUTION::DUQUENNOYMAYOR1991:                                        // eccentricity distribution from Duquennoy & Mayor (1991)
+                // Gaussian with mean 0.3 and sigma 0.15, truncated to [min, max]
                 // http://adsabs.harvard.edu/abs/1991A%26A...248..485D
-                // Sampling function taken from binpop.f in NBODY6
-
-                do {
-                    eccentricity = 0.15 * sqrt(-2.0 * log(RAND->Random())) * cos(2.0 * M_PI * RAND->Random()) + 0.3;
-                } while (eccentricity < p_Min or eccentricity > p_Max);                                 // JR: don't use utils::Compare() here
-                break;
 
-            case ECCENTRICITY_DISTRIBUTION::SANA2012:                                                   // Sana et al 2012
-                // (http://science.sciencemag.org/content/sci/337/6093/444.full.pdf) distribution of eccentricities.
-                // Taken from table S3 in http://science.sciencemag.org/content/sci/suppl/2012/07/25/337.6093.444.DC1/1223344.Sana.SM.pdf
-                // See also de Mink and Belczynski 2015 http://arxiv.org/pdf/1506.03573v2.pdf
-
-                eccentricity = utils::InverseSampleFromPowerLaw(-0.42, p_Max, p_Min);
+                eccentricity = Rand::TruncatedGaussianInverseCDF(0.3, 0.15, p_Min, p_Max, p_Rand);
                 break;
 
-            default:                                                                                    // unknown distribution - should not be possible (options code should prevent this)
-                eccentricity = 0.0;
+            default:                                                                                    // ZERO
+                eccentricity = SampleEccentricity(p_Edist, p_Max, p_Min);
         }
 
         return eccentricity;
@@ -923,6 +1254,27 @@ namespace utils {
      * @return                                      Mass
      */
     double SampleInitialMass(const INITIAL_MASS_FUNCTION p_IMF, const double p_Max, const double p_Min, const double p_Power) {
+        return SampleInitialMass(p_IMF, p_Max, p_Min, p_Power, RAND->Random());                                   // draw a random number between 0 and 1
+    }
+
+
+    /*
+     * Transform a uniform deviate to a mass drawn from the distribution specified by the user
+     *
+     * All supported IMFs are sampled by inverse transform, so p_Rand is the value of the
+     * IMF's CDF at the returned mass.
+     *
+     *
+     * double SampleInitialMass(const INITIAL_MASS_FUNCTION p_IMF, const double p_Max, const double p_Min, const double p_Power, const double p_Rand)
+     *
+     * @param   [IN]    p_IMF                       The IMF to use to draw the mass
+     * @param   [IN]    p_Max                       IMF maximum
+     * @param   [IN]    p_Min                       IMF minimum
+     * @param   [IN]    p_Power                     IMF power (for IMF::POWERLAW)
+     * @param   [IN]    p_Rand                      Uniform deviate in [0, 1)
+     * @return                                      Mass
+     */
+    double SampleInitialMass(const INITIAL_MASS_FUNCTION p_IMF, const double p_Max, const double p_Min, const double p_Power, const double p_Rand) {
 
         double thisMass = 0.0;
 
@@ -930,33 +1282,33 @@ namespace utils {
 
             case INITIAL_MASS_FUNCTION::SALPETER:                                                                   // SALPETER
 
-                thisMass = utils::InverseSampleFromPowerLaw(SALPETER_POWER, p_Max, p_Min);
+                thisMass = utils::InverseSampleFromPowerLaw(SALPETER_POWER, p_Max, p_Min, p_Rand);
                 break;
 
             case INITIAL_MASS_FUNCTION::POWERLAW:                                                                   // POWER LAW
 
-                thisMass = utils::InverseSampleFromPowerLaw(p_Power, p_Max, p_Min);
+                thisMass = utils::InverseSampleFromPowerLaw(p_Power, p_Max, p_Min, p_Rand);
                 break;
 
             case INITIAL_MASS_FUNCTION::UNIFORM:                                                                    // UNIFORM - convienience function for POWERLAW with slope of 0
 
-                thisMass = RAND->Random(p_Min, p_Max);
+                thisMass = (p_Rand * (p_Max - p_Min)) + p_Min;
                 break;
 
             case INITIAL_MASS_FUNCTION::KROUPA:                                                                     // KROUPA
 
                 // find out where the user specificed their minimum and maximum masses to generate
                 if (utils::Compare(p_Min, KROUPA_BREAK_1) <= 0 && utils::Compare(p_Max, KROUPA_BREAK_1) <= 0) {
-                    thisMass = utils::InverseSampleFromPowerLaw(KROUPA_POWER_1, p_Max, p_Min);                      // draw mass using inverse sampling
+                    thisMass = utils::InverseSampleFromPowerLaw(KROUPA_POWER_1, p_Max, p_Min, p_Rand);                  // draw mass using inverse sampling
                 }
                 else if (utils::Compare(p_Min, KROUPA_BREAK_1) > 0 && utils::Compare(p_Min, KROUPA_BREAK_2) <= 0 &&
                          utils::Compare(p_Max, KROUPA_BREAK_1) > 0 && utils::Compare(p_Max, KROUPA_BREAK_2) <= 0) {
 
-                    thisMass = utils::InverseSampleFromPowerLaw(KROUPA_POWER_2, p_Max, p_Min);                      // draw mass using inverse sampling
+                    thisMass = utils::InverseSampleFromPowerLaw(KROUPA_POWER_2, p_Max, p_Min, p_Rand);                  // draw mass using inverse sampling
                 }
                 else if (utils::Compare(p_Min, KROUPA_BREAK_2) > 0 && utils::Compare(p_Max, KROUPA_BREAK_2) > 0) {
 
-                    thisMass = utils::InverseSampleFromPowerLaw(KROUPA_POWER_3, p_Max, p_Min);                      // draw mass using inverse sampling
+                    thisMass = utils::InverseSampleFromPowerLaw(KROUPA_POWER_3, p_Max, p_Min, p_Rand);                  // draw mass using inverse sampling
                 }
                 else if (utils::Compare(p_Min, KROUPA_BREAK_1) <= 0 &&
                          utils::Compare(p_Max, KROUPA_BREAK_1)  > 0 && utils::Compare(p_Max, KROUPA_BREAK_2) <= 0) {
@@ -968,7 +1320,7 @@ namespace utils {
                     double C2    = C1 * KROUPA_BREAK_1_POWER_1_2;
                     double A     = ONE_OVER_KROUPA_POWER_1_PLUS1 * C1 * (KROUPA_BREAK_1_PLUS1_1 - PPOW(p_Min, KROUPA_POWER_PLUS1_1));
 
-                    double rand  = RAND->Random();                                                                  // draw a random number between 0 and 1
+                    double rand  = p_Rand;
                     thisMass = utils::Compare(rand, CalculateCDFKroupa(KROUPA_BREAK_1, p_Max, p_Min)) < 0
                                 ? PPOW(rand * (KROUPA_POWER_PLUS1_1 / C1) + PPOW(p_Min, KROUPA_POWER_PLUS1_1), ONE_OVER_KROUPA_POWER_1_PLUS1)
                                 : PPOW((rand - A) * (KROUPA_POWER_PLUS1_2 / C2) + KROUPA_BREAK_1_PLUS1_2, ONE_OVER_KROUPA_POWER_2_PLUS1);
@@ -986,7 +1338,7 @@ namespace utils {
                     double A     = ONE_OVER_KROUPA_POWER_1_PLUS1 * C1 * (KROUPA_BREAK_1_PLUS1_1 - PPOW(p_Min, KROUPA_POWER_PLUS1_1));
                     double B     = ONE_OVER_KROUPA_POWER_2_PLUS1 * C2 * (KROUPA_BREAK_2_PLUS1_2 - KROUPA_BREAK_1_PLUS1_2);
 
-                    double rand  = RAND->Random();                                                                  // draw a random number between 0 and 1
+                    double rand  = p_Rand;
 
                     if (utils::Compare(rand, CalculateCDFKroupa(KROUPA_BREAK_1, p_Max, p_Min)) < 0)
                         thisMass = PPOW(rand * (KROUPA_POWER_PLUS1_1 / C1) + PPOW(p_Min, KROUPA_POWER_PLUS1_1), ONE_OVER_KROUPA_POWER_1_PLUS1);
@@ -1005,7 +1357,7 @@ namespace utils {
                     double C3    = C2 * KROUPA_BREAK_2_POWER_2_3;
                     double B     = ONE_OVER_KROUPA_POWER_2_PLUS1 * C2 * (KROUPA_BREAK_2_PLUS1_2 - PPOW(p_Min, KROUPA_POWER_PLUS1_2));
 
-                    double rand  = RAND->Random();                                                                  // draw a random number between 0 and 1
+                    double rand  = p_Rand;
 
                     thisMass = utils::Compare(rand, CalculateCDFKroupa(KROUPA_BREAK_2, p_Max, p_Min)) < 0
                                 ? PPOW(rand * (KROUPA_POWER_PLUS1_2 / C2) + PPOW(p_Min, KROUPA_POWER_PLUS1_2), ONE_OVER_KROUPA_POWER_2_PLUS1)
@@ -1015,7 +1367,7 @@ namespace utils {
                 break;
 
             default:                                                                                                // unknown IMF
-                thisMass = utils::InverseSampleFromPowerLaw(KROUPA_POWER, KROUPA_MAXIMUM, KROUPA_MINIMUM);          // calculate mass using power law with default values
+                thisMass = utils::InverseSampleFromPowerLaw(KROUPA_POWER, KROUPA_MAXIMUM, KROUPA_MINIMUM, p_Rand);  // calculate mass using power law with default values
         }
 
         return thisMass;
@@ -1035,30 +1387,45 @@ namespace utils {
      */
     double SampleMassRatio(const MASS_RATIO_DISTRIBUTION p_Qdist, const double p_Max, const double p_Min) {
 
+        return SampleMassRatio(p_Qdist, p_Max, p_Min, RAND->Random());                                         // inverse transform sampling - draw a random number between 0 and 1
+    }
+
+
+    /*
+     * Transform a uniform deviate to a mass ratio q drawn from the distribution specified by the user
+     *
+     *
+     * double SampleMassRatio(const MASS_RATIO_DISTRIBUTION p_Qdist, const double p_Max, const double p_Min, const double p_Rand)
+     *
+     * @param   [IN]    p_IMF                       The distribution to use to draw the ratio
+     * @param   [IN]    p_Max                       Distribution maximum
+     * @param   [IN]    p_Min                       Distribution minimum
+     * @param   [IN]    p_Rand                      Uniform deviate in [0, 1)
+     * @return                                      Mass ratio q
+     */
+    double SampleMassRatio(const MASS_RATIO_DISTRIBUTION p_Qdist, const double p_Max, const double p_Min, const double p_Rand) {
+
         double q;
 
         switch (p_Qdist) {
 
             case MASS_RATIO_DISTRIBUTION::FLAT:                                                                 // FLAT mass ratio distriution
-                q = utils::InverseSampleFromPowerLaw(0.0, p_Max, p_Min);
+                q = utils::InverseSampleFromPowerLaw(0.0, p_Max, p_Min, p_Rand);
                 break;
 
             case MASS_RATIO_DISTRIBUTION::DUQUENNOYMAYOR1991:                                                   // mass ratio distribution from Duquennoy & Mayor (1991) (http://adsabs.harvard.edu/abs/1991A%26A...248..485D)
-
-                do {                                                                                            // JR: todo: catch non-convergence?
-                    q = 0.42 * sqrt(-2.0 * log(RAND->Random())) * cos(2.0 * M_PI * RAND->Random()) + 0.23;
-                } while (q < p_Min || q > p_Max);                                                               // JR: don't use utils::Compare() here
+                q = Rand::TruncatedGaussianInverseCDF(0.23, 0.42, p_Min, p_Max, p_Rand);                        // Gaussian with mean 0.23 and sigma 0.42, truncated to [min, max]
                 break;
 
             case MASS_RATIO_DISTRIBUTION::SANA2012:                                                             // Sana et al 2012 (http://science.sciencemag.org/content/sci/337/6093/444.full.pdf) distribution of eccentricities.
                 // Taken from table S3 in http://science.sciencemag.org/content/sci/suppl/2012/07/25/337.6093.444.DC1/1223344.Sana.SM.pdf
                 // See also de Mink and Belczynski 2015 http://arxiv.org/pdf/1506.03573v2.pdf
 
-                q = utils::InverseSampleFromPowerLaw(-0.1, p_Max, p_Min);                                       // de Mink and Belczynski use min = 0.1, max = 1.0
+                q = utils::InverseSampleFromPowerLaw(-0.1, p_Max, p_Min, p_Rand);                               // de Mink and Belczynski use min = 0.1, max = 1.0
                 break;
 
             default:                                                                                            // unknown q-distribution
-                q = utils::InverseSampleFromPowerLaw(0.0, 1.0, 0.0);                                            // calculate q using power law with default values
+                q = utils::InverseSampleFromPowerLaw(0.0, 1.0, 0.0, p_Rand);                                    // calculate q using power law with default values
         }
 
         return std::min(std::max(p_Min, q), p_Max);                                                             // clamp to [min, max]
@@ -1077,6 +1444,25 @@ namespace utils {
      * @return                                      Metallicity
      */
     double SampleMetallicity(const METALLICITY_DISTRIBUTION p_Zdist, const double p_Max, const double p_Min) {
+        return p_Zdist == METALLICITY_DISTRIBUTION::LOGUNIFORM
+                ? SampleMetallicity(p_Zdist, p_Max, p_Min, RAND->Random())                              // draw a random number between 0 and 1
+                : SampleMetallicity(p_Zdist, p_Max, p_Min, 0.0);                                        // no random number required
+    }
+
+
+    /*
+     * Transform a uniform deviate to a metallicity drawn from the distribution specified by the user
+     *
+     *
+     * double SampleMetallicity(const METALLICITY_DISTRIBUTION p_Zdist, const double p_Max, const double p_Min, const double p_Rand)
+     *
+     * @param   [IN]    p_Zdist                     The metallicity distribution to use to draw the metallicity
+     * @param   [IN]    p_Max                       Distribution maximum
+     * @param   [IN]    p_Min                       Distribution minimum
+     * @param   [IN]    p_Rand                      Uniform deviate in [0, 1)
+     * @return                                      Metallicity
+     */
+    double SampleMetallicity(const METALLICITY_DISTRIBUTION p_Zdist, const double p_Max, const double p_Min, const double p_Rand) {
 
         double metallicity;
 
@@ -1089,7 +1475,7 @@ namespace utils {
             case METALLICITY_DISTRIBUTION::LOGUNIFORM: {                                                // LOGUNIFORM - sample Z uniformly in the log
                 double logMin = log10(p_Min);
                 double logMax = log10(p_Max);
-                metallicity = PPOW(10, (logMin + ((logMax - logMin) * RAND->Random())));
+                metallicity = PPOW(10, (logMin + ((logMax - logMin) * p_Rand)));
             } break;
 
             default:                                                                                    // unknown distribution - should not be possible (options code should prevent this)
@@ -1116,6 +1502,29 @@ namespace utils {
     double SampleOrbitalPeriod(const ORBITAL_PERIOD_DISTRIBUTION p_Pdist, 
                                const double                      p_PdistMax, 
                                const double                      p_PdistMin) {
+        return SampleOrbitalPeriod(p_Pdist, p_PdistMax, p_PdistMin, RAND->Random());                                   // draw a random number between 0 and 1
+    }
+
+
+    /*
+     * Transform a uniform deviate to an orbital period drawn from the distribution specified by the user
+     * 
+     * 
+     * double SampleOrbitalPeriod(const ORBITAL_PERIOD_DISTRIBUTION p_Pdist, 
+     *                            const double                      p_PdistMax, 
+     *                            const double                      p_PdistMin,
+     *                            const double                      p_Rand)
+     *
+     * @param   [IN]    p_Pdist                     The distribution to use to draw orbital period
+     * @param   [IN]    p_PdistMax                  Orbital period distribution maximum
+     * @param   [IN]    p_PdistMin                  Orbital period distribution minimum
+     * @param   [IN]    p_Rand                      Uniform deviate in [0, 1)
+     * @return                                      Orbital period in days
+     */
+    double SampleOrbitalPeriod(const ORBITAL_PERIOD_DISTRIBUTION p_Pdist, 
+                               const double                      p_PdistMax, 
+                               const double                      p_PdistMin,
+                               const double                      p_Rand) {
 
         double orbitalPeriod;
 
@@ -1123,11 +1532,11 @@ namespace utils {
 
             case ORBITAL_PERIOD_DISTRIBUTION::FLATINLOG:                                                                // FLAT IN LOG
 
-                orbitalPeriod = utils::InverseSampleFromPowerLaw(-1.0, p_PdistMax, p_PdistMin);
+                orbitalPeriod = utils::InverseSampleFromPowerLaw(-1.0, p_PdistMax, p_PdistMin, p_Rand);
                 break;
 
             default:                                                                                                    // unknown distribution
-                orbitalPeriod = utils::InverseSampleFromPowerLaw(-1.0, 1000.0, 1.1);                                    // calculate orbitalPeriod using power law with default values
+                orbitalPeriod = utils::InverseSampleFromPowerLaw(-1.0, 1000.0, 1.1, p_Rand);                            // calculate orbitalPeriod using power law with default values
         }
 
         return orbitalPeriod;
@@ -1166,32 +1575,70 @@ namespace utils {
                                const double                       p_Mass1, 
                                const double                       p_Mass2) {
 
+        return SampleSemiMajorAxis(p_Adist, p_AdistMax, p_AdistMin, p_AdistPower, p_PdistMax, p_PdistMin, p_Mass1, p_Mass2, RAND->Random());  // inverse transform sampling - draw a random number between 0 and 1
+    }
+
+
+    /*
+     * Transform a uniform deviate to a semi-major axis drawn from the distribution specified by the user
+     * 
+     * 
+     * double SampleSemiMajorAxisDistribution(const SEMI_MAJOR_AXIS_DISTRIBUTION p_Adist, 
+     *                                        const double                       p_AdistMax, 
+     *                                        const double                       p_AdistMin, 
+     *                                        const double                       p_AdistPower, 
+     *                                        const double                       p_PdistMax, 
+     *                                        const double                       p_PdistMin, 
+     *                                        const double                       p_Mass1, 
+     *                                        const double                       p_Mass2,
+     *                                        const double                       p_Rand)
+     *
+     * @param   [IN]    p_Adist                     The distribution to use to draw semi-major axis
+     * @param   [IN]    p_AdistMax                  Semi-major axis distribution maximum
+     * @param   [IN]    p_AdistMin                  Semi-major axis distribution minimum
+     * @param   [IN]    p_AdistPower                Semi-major axis distribution power (for CUSTOM distribution)
+     * @param   [IN]    p_PdistMax                  Period distribution maximum (for SANA2012 distribution)
+     * @param   [IN]    p_PdistMin                  Period distribution minimum (for SANA2012 distribution)
+     * @param   [IN]    p_Mass1                     Mass of the primary
+     * @param   [IN]    p_Mass2                     Mass of the secondary
+     * @param   [IN]    p_Rand                      Uniform deviate in [0, 1)
+     * @return                                      Semi-major axis in AU
+     */
+    double SampleSemiMajorAxis(const SEMI_MAJOR_AXIS_DISTRIBUTION p_Adist, 
+                               const double                       p_AdistMax, 
+                               const double                       p_AdistMin, 
+                               const double                       p_AdistPower, 
+                               const double                       p_PdistMax, 
+                               const double                       p_PdistMin, 
+                               const double                       p_Mass1, 
+                               const double                       p_Mass2,
+                               const double                       p_Rand) {
+
         double semiMajorAxis;
 
         switch (p_Adist) {                                                                                              // which distribution?
 
             case SEMI_MAJOR_AXIS_DISTRIBUTION::FLATINLOG:                                                               // FLAT IN LOG
 
-                semiMajorAxis = utils::InverseSampleFromPowerLaw(-1.0, p_AdistMax, p_AdistMin);
+                semiMajorAxis = utils::InverseSampleFromPowerLaw(-1.0, p_AdistMax, p_AdistMin, p_Rand);
                 break;
 
-            case SEMI_MAJOR_AXIS_DISTRIBUTION::DUQUENNOYMAYOR1991:                                                      // Duquennoy & Mayor (1991) period distribution
+            case SEMI_MAJOR_AXIS_DISTRIBUTION::DUQUENNOYMAYOR1991: {                                                    // Duquennoy & Mayor (1991) period distribution
                 // http://adsabs.harvard.edu/abs/1991A%26A...248..485D
                 // See also the period distribution (Figure 1) of M35 in Geller+ 2013 https://arxiv.org/abs/1210.1575
                 // See also the period distribution (Figure 13) of local solar type binaries from Raghavan et al 2010 https://arxiv.org/abs/1007.0414
-                // They have log-normal distribution with a mean of 5.03 and a standard deviation of 2.28, with a minimum period of around 0.1 days
-                // Sampling function taken from binpop.f in NBODY6
-
-                // Make sure that the drawn semi-major axis is in the range specified by the user
-                do {                                                                                                    // JR: todo: catch for non-convergence?
-                    double periodInDays = PPOW(10.0, 2.3 * sqrt(-2.0 * log(RAND->Random())) * cos(2.0 * M_PI * RAND->Random()) + 4.8);
-                    semiMajorAxis = utils::ConvertPeriodInDaysToSemiMajorAxisInAU(p_Mass1, p_Mass2, periodInDays);      // convert period in days to semi-major axis in AU
-                } while (semiMajorAxis < p_AdistMin || semiMajorAxis > p_AdistMax);                                     // JR: don't use utils::Compare() here
-                break;
+                // Log-normal period distribution: log10(P/day) has mean 4.8 and sigma 2.3 (as in binpop.f in NBODY6),
+                // truncated to the periods of the semi-major axis range specified by the user (a ~ P^(2/3))
+
+                double periodPerAU  = PPOW(utils::ConvertPeriodInDaysToSemiMajorAxisInAU(p_Mass1, p_Mass2, 1.0), -1.5);  // period in days at a = 1 AU
+                double periodInDays = Rand::TruncatedLogNormalInverseCDF(4.8, 2.3, periodPerAU * PPOW(p_AdistMin, 1.5), periodPerAU * PPOW(p_AdistMax, 1.5), p_Rand);
+
+                semiMajorAxis = std::min(std::max(utils::ConvertPeriodInDaysToSemiMajorAxisInAU(p_Mass1, p_Mass2, periodInDays), p_AdistMin), p_AdistMax);
+                } break;
 
             case SEMI_MAJOR_AXIS_DISTRIBUTION::CUSTOM:                                                                  // CUSTOM
 
-                semiMajorAxis = utils::InverseSampleFromPowerLaw(p_AdistPower, p_AdistMax, p_AdistMin);
+                semiMajorAxis = utils::InverseSampleFromPowerLaw(p_AdistPower, p_AdistMax, p_AdistMin, p_Rand);
                 break;
 
             case SEMI_MAJOR_AXIS_DISTRIBUTION::SANA2012: {                                                              // Sana et al 2012
@@ -1203,13 +1650,13 @@ namespace utils {
                 double logPeriodMin = p_PdistMin > 1.0 ? log(p_PdistMin) : 0.0;                                         // smallest initial log period  JR: don't use utils::Compare() here
                 double logPeriodMax = p_PdistMax > 1.0 ? log(p_PdistMax) : 0.0;                                         // largest initial log period   JR: don't use utils::Compare() here
 
-                double periodInDays = exp(utils::InverseSampleFromPowerLaw(-0.55, logPeriodMax, logPeriodMin));         // draw a period in days from their distribution
+                double periodInDays = exp(utils::InverseSampleFromPowerLaw(-0.55, logPeriodMax, logPeriodMin, p_Rand));  // draw a period in days from their distribution
 
                 semiMajorAxis = utils::ConvertPeriodInDaysToSemiMajorAxisInAU(p_Mass1, p_Mass2, periodInDays);          // convert period in days to semi-major axis in AU
                 } break;
 
             default:                                                                                                    // unknown distribution
-                semiMajorAxis = utils::InverseSampleFromPowerLaw(-1.0, 100.0, 0.5);                                     // calculate semiMajorAxis using power law with default values
+                semiMajorAxis = utils::InverseSampleFromPowerLaw(-1.0, 100.0, 0.5, p_Rand);                             // calculate semiMajorAxis using power law with default values
         }
 
         return semiMajorAxis;
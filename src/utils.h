@@ -27,11 +27,15 @@ namespace utils {
 
     DBL_DBL                             DrawKickDirection(const KICK_DIRECTION_DISTRIBUTION p_KickDirectionDistribution, const double p_KickDirectionPower);
     
-    bool                                Equals(std::string p_Str1, std::string p_Str2);
+    bool                                Equals(const std::string& p_Str1, const std::string& p_Str2);
 
     bool                                FileExists(const std::string& p_Filename);
     bool                                FileExists(const char *p_Filename);
 
+    std::tuple<ERROR, std::string>      FileSHA256(const std::string& p_Filename);
+
+    bool                                FilterPasses(const PropertyFilterT& p_Filter, const double p_Value);
+
 
     /*
      * Generic function to find an element in a vector
@@ -90,6 +94,7 @@ namespace utils {
     double                              intPow(const double p_Base, const int p_Exponent);
 
     double                              InverseSampleFromPowerLaw(const double p_Power, const double p_Xmax, const double p_Xmin);
+    double                              InverseSampleFromPowerLaw(const double p_Power, const double p_Xmax, const double p_Xmin, const double p_Rand);
     double                              InverseSampleFromTabulatedCDF(const double p_Y, const std::map<double, double> p_Table);
 
     int                                 IsBOOL(const std::string p_Str);
@@ -105,6 +110,10 @@ namespace utils {
 
     std::string                         PadLeadingZeros(const std::string p_Str, const std::size_t p_MaxLength);
     std::string                         PadTrailingSpaces(const std::string p_Str, const std::size_t p_MaxLength);
+
+    DBL_VECTOR                          QuasiRandomPoint(const QUASI_RANDOM_SEQUENCE p_Sequence, const unsigned long int p_Index, const unsigned long int p_ScrambleSeed);
+
+    std::tuple<std::size_t, std::size_t> ResidentSetSize();
     
     std::string&                        ltrim(std::string& p_Str);
     std::string&                        rtrim(std::string& p_Str);
@@ -117,11 +126,16 @@ namespace utils {
 
 
     double                              SampleEccentricity(const ECCENTRICITY_DISTRIBUTION p_Edist, const double p_Max, const double p_Min);
+    double                              SampleEccentricity(const ECCENTRICITY_DISTRIBUTION p_Edist, const double p_Max, const double p_Min, const double p_Rand);
     double                              SampleFromTabulatedCDF(const double p_X, const std::map<double, double> pTable);
     double                              SampleInitialMass(const INITIAL_MASS_FUNCTION p_IMF, const double p_Max, const double p_Min, const double p_Power);
+    double                              SampleInitialMass(const INITIAL_MASS_FUNCTION p_IMF, const double p_Max, const double p_Min, const double p_Power, const double p_Rand);
     double                              SampleMassRatio(const MASS_RATIO_DISTRIBUTION p_Qdist, const double p_Max, const double p_Min);
+    double                              SampleMassRatio(const MASS_RATIO_DISTRIBUTION p_Qdist, const double p_Max, const double p_Min, const double p_Rand);
     double                              SampleMetallicity(const METALLICITY_DISTRIBUTION p_Zdist, const double p_Max, const double p_Min);
+    double                              SampleMetallicity(const METALLICITY_DISTRIBUTION p_Zdist, const double p_Max, const double p_Min, const double p_Rand);
     double                              SampleOrbitalPeriod(const ORBITAL_PERIOD_DISTRIBUTION p_Pdist, const double p_PdistMax, const double p_PdistMin);
+    double                              SampleOrbitalPeriod(const ORBITAL_PERIOD_DISTRIBUTION p_Pdist, const double p_PdistMax, const double p_PdistMin, const double p_Rand);
     double                              SampleSemiMajorAxis(const SEMI_MAJOR_AXIS_DISTRIBUTION p_Adist, 
                                                             const double                       p_AdistMax, 
                                                             const double                       p_AdistMin, 
@@ -130,6 +144,15 @@ namespace utils {
                                                             const double                       p_PdistMin, 
                                                             const double                       p_Mass1, 
                                                             const double                       p_Mass2);
+    double                              SampleSemiMajorAxis(const SEMI_MAJOR_AXIS_DISTRIBUTION p_Adist, 
+                                                            const double                       p_AdistMax, 
+                                                            const double                       p_AdistMin, 
+                                                            const double                       p_AdistPower, 
+                                                            const double                       p_PdistMax, 
+                                                            const double                       p_PdistMin, 
+                                                            const double                       p_Mass1, 
+                                                            const double                       p_Mass2,
+                                                            const double                       p_Rand);
 
     SN_EVENT                            SNEventType(const SN_EVENT p_SNEvent);
 